@@ -0,0 +1,99 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/code/Analyze/CMakeLists.txt"
+  "/root/repo/code/Archivist/CMakeLists.txt"
+  "/root/repo/code/Archivist/LODwAPArchivist/CMakeLists.txt"
+  "/root/repo/code/Archivist/SSwDArchivist/CMakeLists.txt"
+  "/root/repo/code/Brain/ANNBrain/CMakeLists.txt"
+  "/root/repo/code/Brain/BiLogBrain/CMakeLists.txt"
+  "/root/repo/code/Brain/CGPBrain/CMakeLists.txt"
+  "/root/repo/code/Brain/CMakeLists.txt"
+  "/root/repo/code/Brain/ConstantValuesBrain/CMakeLists.txt"
+  "/root/repo/code/Brain/HumanBrain/CMakeLists.txt"
+  "/root/repo/code/Brain/LSTMBrain/CMakeLists.txt"
+  "/root/repo/code/Brain/MarkovBrain/CMakeLists.txt"
+  "/root/repo/code/Brain/RNNBrain/CMakeLists.txt"
+  "/root/repo/code/Brain/WireBrain/CMakeLists.txt"
+  "/root/repo/code/CMakeLists.txt"
+  "/root/repo/code/Genome/CMakeLists.txt"
+  "/root/repo/code/Genome/CircularGenome/CMakeLists.txt"
+  "/root/repo/code/Genome/MultiGenome/CMakeLists.txt"
+  "/root/repo/code/Group/CMakeLists.txt"
+  "/root/repo/code/Optimizer/CMakeLists.txt"
+  "/root/repo/code/Optimizer/IslandsOptimizer/CMakeLists.txt"
+  "/root/repo/code/Optimizer/LexicaseOptimizer/CMakeLists.txt"
+  "/root/repo/code/Optimizer/RouletteOptimizer/CMakeLists.txt"
+  "/root/repo/code/Optimizer/TournamentOptimizer/CMakeLists.txt"
+  "/root/repo/code/Organism/CMakeLists.txt"
+  "/root/repo/code/Testing/CMakeLists.txt"
+  "/root/repo/code/Utilities/CMakeLists.txt"
+  "/root/repo/code/World/BerryWorld/CMakeLists.txt"
+  "/root/repo/code/World/BlockCatchWorld/CMakeLists.txt"
+  "/root/repo/code/World/CMakeLists.txt"
+  "/root/repo/code/World/KarWorld/CMakeLists.txt"
+  "/root/repo/code/World/Logic16World/CMakeLists.txt"
+  "/root/repo/code/World/NBackWorld/CMakeLists.txt"
+  "/root/repo/code/World/PathFollowWorld/CMakeLists.txt"
+  "/root/repo/code/World/TPM_GENERATORWorld/CMakeLists.txt"
+  "/root/repo/code/World/TestWorld/CMakeLists.txt"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkConfig.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkConfigVersion.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkTargets-none.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/benchmark/benchmarkTargets.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeFindDependencyMacro.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindGit.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/FindZLIB.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/cmake-3.25/Modules/SelectLibraryConfigurations.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/mabe.dir/DependInfo.cmake"
+  "CMakeFiles/mabe_bench.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,96 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/code/Analyze/brainTools.cpp" "CMakeFiles/mabe_bench.dir/code/Analyze/brainTools.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Analyze/brainTools.cpp.o.d"
+  "/root/repo/code/Analyze/entropy.cpp" "CMakeFiles/mabe_bench.dir/code/Analyze/entropy.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Analyze/entropy.cpp.o.d"
+  "/root/repo/code/Analyze/fragmentation.cpp" "CMakeFiles/mabe_bench.dir/code/Analyze/fragmentation.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Analyze/fragmentation.cpp.o.d"
+  "/root/repo/code/Analyze/neurocorrelates.cpp" "CMakeFiles/mabe_bench.dir/code/Analyze/neurocorrelates.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Analyze/neurocorrelates.cpp.o.d"
+  "/root/repo/code/Analyze/smearedness.cpp" "CMakeFiles/mabe_bench.dir/code/Analyze/smearedness.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Analyze/smearedness.cpp.o.d"
+  "/root/repo/code/Analyze/stateToState.cpp" "CMakeFiles/mabe_bench.dir/code/Analyze/stateToState.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Analyze/stateToState.cpp.o.d"
+  "/root/repo/code/Analyze/timeSeries.cpp" "CMakeFiles/mabe_bench.dir/code/Analyze/timeSeries.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Analyze/timeSeries.cpp.o.d"
+  "/root/repo/code/Archivist/DefaultArchivist.cpp" "CMakeFiles/mabe_bench.dir/code/Archivist/DefaultArchivist.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Archivist/DefaultArchivist.cpp.o.d"
+  "/root/repo/code/Archivist/LODwAPArchivist/LODwAPArchivist.cpp" "CMakeFiles/mabe_bench.dir/code/Archivist/LODwAPArchivist/LODwAPArchivist.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Archivist/LODwAPArchivist/LODwAPArchivist.cpp.o.d"
+  "/root/repo/code/Archivist/SSwDArchivist/SSwDArchivist.cpp" "CMakeFiles/mabe_bench.dir/code/Archivist/SSwDArchivist/SSwDArchivist.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Archivist/SSwDArchivist/SSwDArchivist.cpp.o.d"
+  "/root/repo/code/Brain/ANNBrain/ANNBrain.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/ANNBrain/ANNBrain.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/ANNBrain/ANNBrain.cpp.o.d"
+  "/root/repo/code/Brain/AbstractBrain.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/AbstractBrain.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/AbstractBrain.cpp.o.d"
+  "/root/repo/code/Brain/BiLogBrain/BiLogBrain.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/BiLogBrain/BiLogBrain.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/BiLogBrain/BiLogBrain.cpp.o.d"
+  "/root/repo/code/Brain/CGPBrain/CGPBrain.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/CGPBrain/CGPBrain.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/CGPBrain/CGPBrain.cpp.o.d"
+  "/root/repo/code/Brain/ConstantValuesBrain/ConstantValuesBrain.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/ConstantValuesBrain/ConstantValuesBrain.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/ConstantValuesBrain/ConstantValuesBrain.cpp.o.d"
+  "/root/repo/code/Brain/HumanBrain/HumanBrain.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/HumanBrain/HumanBrain.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/HumanBrain/HumanBrain.cpp.o.d"
+  "/root/repo/code/Brain/LSTMBrain/LSTMBrain.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/LSTMBrain/LSTMBrain.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/LSTMBrain/LSTMBrain.cpp.o.d"
+  "/root/repo/code/Brain/MarkovBrain/CompiledGates.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/CompiledGates.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/CompiledGates.cpp.o.d"
+  "/root/repo/code/Brain/MarkovBrain/Gate/AbstractGate.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/AbstractGate.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/AbstractGate.cpp.o.d"
+  "/root/repo/code/Brain/MarkovBrain/Gate/AnnGate.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/AnnGate.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/AnnGate.cpp.o.d"
+  "/root/repo/code/Brain/MarkovBrain/Gate/ComparatorGate.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/ComparatorGate.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/ComparatorGate.cpp.o.d"
+  "/root/repo/code/Brain/MarkovBrain/Gate/DecomposableDirectGate.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/DecomposableDirectGate.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/DecomposableDirectGate.cpp.o.d"
+  "/root/repo/code/Brain/MarkovBrain/Gate/DecomposableFeedbackGate.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/DecomposableFeedbackGate.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/DecomposableFeedbackGate.cpp.o.d"
+  "/root/repo/code/Brain/MarkovBrain/Gate/DecomposableGate.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/DecomposableGate.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/DecomposableGate.cpp.o.d"
+  "/root/repo/code/Brain/MarkovBrain/Gate/DeterministicGate.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/DeterministicGate.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/DeterministicGate.cpp.o.d"
+  "/root/repo/code/Brain/MarkovBrain/Gate/EpsilonGate.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/EpsilonGate.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/EpsilonGate.cpp.o.d"
+  "/root/repo/code/Brain/MarkovBrain/Gate/FeedbackGate.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/FeedbackGate.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/FeedbackGate.cpp.o.d"
+  "/root/repo/code/Brain/MarkovBrain/Gate/GPGate.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/GPGate.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/GPGate.cpp.o.d"
+  "/root/repo/code/Brain/MarkovBrain/Gate/IzhikevichGate.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/IzhikevichGate.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/IzhikevichGate.cpp.o.d"
+  "/root/repo/code/Brain/MarkovBrain/Gate/NeuronGate.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/NeuronGate.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/NeuronGate.cpp.o.d"
+  "/root/repo/code/Brain/MarkovBrain/Gate/PassthroughGate.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/PassthroughGate.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/PassthroughGate.cpp.o.d"
+  "/root/repo/code/Brain/MarkovBrain/Gate/ProbabilisticGate.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/ProbabilisticGate.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/ProbabilisticGate.cpp.o.d"
+  "/root/repo/code/Brain/MarkovBrain/Gate/TritDeterministicGate.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/TritDeterministicGate.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/TritDeterministicGate.cpp.o.d"
+  "/root/repo/code/Brain/MarkovBrain/Gate/VoidGate.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/VoidGate.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/VoidGate.cpp.o.d"
+  "/root/repo/code/Brain/MarkovBrain/GateBuilder/GateBuilder.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/GateBuilder/GateBuilder.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/GateBuilder/GateBuilder.cpp.o.d"
+  "/root/repo/code/Brain/MarkovBrain/GateListBuilder/GateListBuilder.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/GateListBuilder/GateListBuilder.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/GateListBuilder/GateListBuilder.cpp.o.d"
+  "/root/repo/code/Brain/MarkovBrain/MarkovBrain.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/MarkovBrain.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/MarkovBrain.cpp.o.d"
+  "/root/repo/code/Brain/RNNBrain/RNNBrain.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/RNNBrain/RNNBrain.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/RNNBrain/RNNBrain.cpp.o.d"
+  "/root/repo/code/Brain/WireBrain/WireBrain.cpp" "CMakeFiles/mabe_bench.dir/code/Brain/WireBrain/WireBrain.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Brain/WireBrain/WireBrain.cpp.o.d"
+  "/root/repo/code/Genome/AbstractGenome.cpp" "CMakeFiles/mabe_bench.dir/code/Genome/AbstractGenome.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Genome/AbstractGenome.cpp.o.d"
+  "/root/repo/code/Genome/CircularGenome/CircularGenome.cpp" "CMakeFiles/mabe_bench.dir/code/Genome/CircularGenome/CircularGenome.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Genome/CircularGenome/CircularGenome.cpp.o.d"
+  "/root/repo/code/Genome/MultiGenome/Chromosome/AbstractChromosome.cpp" "CMakeFiles/mabe_bench.dir/code/Genome/MultiGenome/Chromosome/AbstractChromosome.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Genome/MultiGenome/Chromosome/AbstractChromosome.cpp.o.d"
+  "/root/repo/code/Genome/MultiGenome/Chromosome/TemplatedChromosome.cpp" "CMakeFiles/mabe_bench.dir/code/Genome/MultiGenome/Chromosome/TemplatedChromosome.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Genome/MultiGenome/Chromosome/TemplatedChromosome.cpp.o.d"
+  "/root/repo/code/Genome/MultiGenome/MultiGenome.cpp" "CMakeFiles/mabe_bench.dir/code/Genome/MultiGenome/MultiGenome.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Genome/MultiGenome/MultiGenome.cpp.o.d"
+  "/root/repo/code/Global.cpp" "CMakeFiles/mabe_bench.dir/code/Global.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Global.cpp.o.d"
+  "/root/repo/code/Group/Group.cpp" "CMakeFiles/mabe_bench.dir/code/Group/Group.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Group/Group.cpp.o.d"
+  "/root/repo/code/Optimizer/AbstractOptimizer.cpp" "CMakeFiles/mabe_bench.dir/code/Optimizer/AbstractOptimizer.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Optimizer/AbstractOptimizer.cpp.o.d"
+  "/root/repo/code/Optimizer/IslandsOptimizer/IslandsOptimizer.cpp" "CMakeFiles/mabe_bench.dir/code/Optimizer/IslandsOptimizer/IslandsOptimizer.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Optimizer/IslandsOptimizer/IslandsOptimizer.cpp.o.d"
+  "/root/repo/code/Optimizer/LexicaseOptimizer/LexicaseOptimizer.cpp" "CMakeFiles/mabe_bench.dir/code/Optimizer/LexicaseOptimizer/LexicaseOptimizer.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Optimizer/LexicaseOptimizer/LexicaseOptimizer.cpp.o.d"
+  "/root/repo/code/Optimizer/RouletteOptimizer/RouletteOptimizer.cpp" "CMakeFiles/mabe_bench.dir/code/Optimizer/RouletteOptimizer/RouletteOptimizer.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Optimizer/RouletteOptimizer/RouletteOptimizer.cpp.o.d"
+  "/root/repo/code/Optimizer/TournamentOptimizer/TournamentOptimizer.cpp" "CMakeFiles/mabe_bench.dir/code/Optimizer/TournamentOptimizer/TournamentOptimizer.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Optimizer/TournamentOptimizer/TournamentOptimizer.cpp.o.d"
+  "/root/repo/code/Organism/Organism.cpp" "CMakeFiles/mabe_bench.dir/code/Organism/Organism.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Organism/Organism.cpp.o.d"
+  "/root/repo/code/Organism/Phylogeny.cpp" "CMakeFiles/mabe_bench.dir/code/Organism/Phylogeny.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Organism/Phylogeny.cpp.o.d"
+  "/root/repo/code/Testing/benchmarks.cpp" "CMakeFiles/mabe_bench.dir/code/Testing/benchmarks.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Testing/benchmarks.cpp.o.d"
+  "/root/repo/code/Utilities/AsyncFileWriter.cpp" "CMakeFiles/mabe_bench.dir/code/Utilities/AsyncFileWriter.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Utilities/AsyncFileWriter.cpp.o.d"
+  "/root/repo/code/Utilities/BinaryTable.cpp" "CMakeFiles/mabe_bench.dir/code/Utilities/BinaryTable.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Utilities/BinaryTable.cpp.o.d"
+  "/root/repo/code/Utilities/CSV.cpp" "CMakeFiles/mabe_bench.dir/code/Utilities/CSV.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Utilities/CSV.cpp.o.d"
+  "/root/repo/code/Utilities/CompiledMTree.cpp" "CMakeFiles/mabe_bench.dir/code/Utilities/CompiledMTree.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Utilities/CompiledMTree.cpp.o.d"
+  "/root/repo/code/Utilities/Data.cpp" "CMakeFiles/mabe_bench.dir/code/Utilities/Data.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Utilities/Data.cpp.o.d"
+  "/root/repo/code/Utilities/DenseLayer.cpp" "CMakeFiles/mabe_bench.dir/code/Utilities/DenseLayer.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Utilities/DenseLayer.cpp.o.d"
+  "/root/repo/code/Utilities/Filesystem.cpp" "CMakeFiles/mabe_bench.dir/code/Utilities/Filesystem.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Utilities/Filesystem.cpp.o.d"
+  "/root/repo/code/Utilities/Loader.cpp" "CMakeFiles/mabe_bench.dir/code/Utilities/Loader.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Utilities/Loader.cpp.o.d"
+  "/root/repo/code/Utilities/MTree.cpp" "CMakeFiles/mabe_bench.dir/code/Utilities/MTree.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Utilities/MTree.cpp.o.d"
+  "/root/repo/code/Utilities/Parameters.cpp" "CMakeFiles/mabe_bench.dir/code/Utilities/Parameters.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Utilities/Parameters.cpp.o.d"
+  "/root/repo/code/Utilities/PopulationTable.cpp" "CMakeFiles/mabe_bench.dir/code/Utilities/PopulationTable.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Utilities/PopulationTable.cpp.o.d"
+  "/root/repo/code/Utilities/PowerSet.cpp" "CMakeFiles/mabe_bench.dir/code/Utilities/PowerSet.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Utilities/PowerSet.cpp.o.d"
+  "/root/repo/code/Utilities/ThreadPool.cpp" "CMakeFiles/mabe_bench.dir/code/Utilities/ThreadPool.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Utilities/ThreadPool.cpp.o.d"
+  "/root/repo/code/Utilities/Timing.cpp" "CMakeFiles/mabe_bench.dir/code/Utilities/Timing.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/Utilities/Timing.cpp.o.d"
+  "/root/repo/code/World/AbstractWorld.cpp" "CMakeFiles/mabe_bench.dir/code/World/AbstractWorld.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/World/AbstractWorld.cpp.o.d"
+  "/root/repo/code/World/BerryWorld/BerryWorld.cpp" "CMakeFiles/mabe_bench.dir/code/World/BerryWorld/BerryWorld.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/World/BerryWorld/BerryWorld.cpp.o.d"
+  "/root/repo/code/World/BlockCatchWorld/BlockCatchWorld.cpp" "CMakeFiles/mabe_bench.dir/code/World/BlockCatchWorld/BlockCatchWorld.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/World/BlockCatchWorld/BlockCatchWorld.cpp.o.d"
+  "/root/repo/code/World/KarWorld/KarWorld.cpp" "CMakeFiles/mabe_bench.dir/code/World/KarWorld/KarWorld.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/World/KarWorld/KarWorld.cpp.o.d"
+  "/root/repo/code/World/Logic16World/Logic16World.cpp" "CMakeFiles/mabe_bench.dir/code/World/Logic16World/Logic16World.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/World/Logic16World/Logic16World.cpp.o.d"
+  "/root/repo/code/World/NBackWorld/NBackWorld.cpp" "CMakeFiles/mabe_bench.dir/code/World/NBackWorld/NBackWorld.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/World/NBackWorld/NBackWorld.cpp.o.d"
+  "/root/repo/code/World/PathFollowWorld/PathFollowWorld.cpp" "CMakeFiles/mabe_bench.dir/code/World/PathFollowWorld/PathFollowWorld.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/World/PathFollowWorld/PathFollowWorld.cpp.o.d"
+  "/root/repo/code/World/TPM_GENERATORWorld/TPM_GENERATORWorld.cpp" "CMakeFiles/mabe_bench.dir/code/World/TPM_GENERATORWorld/TPM_GENERATORWorld.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/World/TPM_GENERATORWorld/TPM_GENERATORWorld.cpp.o.d"
+  "/root/repo/code/World/TestWorld/TestWorld.cpp" "CMakeFiles/mabe_bench.dir/code/World/TestWorld/TestWorld.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/World/TestWorld/TestWorld.cpp.o.d"
+  "/root/repo/code/module_factories.cpp" "CMakeFiles/mabe_bench.dir/code/module_factories.cpp.o" "gcc" "CMakeFiles/mabe_bench.dir/code/module_factories.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
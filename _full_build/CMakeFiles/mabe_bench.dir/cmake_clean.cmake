@@ -0,0 +1,165 @@
+file(REMOVE_RECURSE
+  "/root/repo/work/mabe_bench"
+  "/root/repo/work/mabe_bench.pdb"
+  "CMakeFiles/mabe_bench.dir/code/Analyze/brainTools.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Analyze/brainTools.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Analyze/entropy.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Analyze/entropy.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Analyze/fragmentation.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Analyze/fragmentation.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Analyze/neurocorrelates.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Analyze/neurocorrelates.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Analyze/smearedness.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Analyze/smearedness.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Analyze/stateToState.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Analyze/stateToState.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Analyze/timeSeries.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Analyze/timeSeries.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Archivist/DefaultArchivist.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Archivist/DefaultArchivist.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Archivist/LODwAPArchivist/LODwAPArchivist.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Archivist/LODwAPArchivist/LODwAPArchivist.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Archivist/SSwDArchivist/SSwDArchivist.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Archivist/SSwDArchivist/SSwDArchivist.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/ANNBrain/ANNBrain.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/ANNBrain/ANNBrain.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/AbstractBrain.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/AbstractBrain.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/BiLogBrain/BiLogBrain.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/BiLogBrain/BiLogBrain.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/CGPBrain/CGPBrain.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/CGPBrain/CGPBrain.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/ConstantValuesBrain/ConstantValuesBrain.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/ConstantValuesBrain/ConstantValuesBrain.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/HumanBrain/HumanBrain.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/HumanBrain/HumanBrain.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/LSTMBrain/LSTMBrain.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/LSTMBrain/LSTMBrain.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/CompiledGates.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/CompiledGates.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/AbstractGate.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/AbstractGate.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/AnnGate.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/AnnGate.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/ComparatorGate.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/ComparatorGate.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/DecomposableDirectGate.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/DecomposableDirectGate.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/DecomposableFeedbackGate.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/DecomposableFeedbackGate.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/DecomposableGate.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/DecomposableGate.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/DeterministicGate.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/DeterministicGate.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/EpsilonGate.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/EpsilonGate.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/FeedbackGate.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/FeedbackGate.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/GPGate.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/GPGate.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/IzhikevichGate.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/IzhikevichGate.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/NeuronGate.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/NeuronGate.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/PassthroughGate.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/PassthroughGate.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/ProbabilisticGate.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/ProbabilisticGate.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/TritDeterministicGate.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/TritDeterministicGate.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/VoidGate.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/Gate/VoidGate.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/GateBuilder/GateBuilder.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/GateBuilder/GateBuilder.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/GateListBuilder/GateListBuilder.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/GateListBuilder/GateListBuilder.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/MarkovBrain.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/MarkovBrain/MarkovBrain.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/RNNBrain/RNNBrain.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/RNNBrain/RNNBrain.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Brain/WireBrain/WireBrain.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Brain/WireBrain/WireBrain.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Genome/AbstractGenome.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Genome/AbstractGenome.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Genome/CircularGenome/CircularGenome.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Genome/CircularGenome/CircularGenome.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Genome/MultiGenome/Chromosome/AbstractChromosome.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Genome/MultiGenome/Chromosome/AbstractChromosome.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Genome/MultiGenome/Chromosome/TemplatedChromosome.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Genome/MultiGenome/Chromosome/TemplatedChromosome.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Genome/MultiGenome/MultiGenome.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Genome/MultiGenome/MultiGenome.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Global.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Global.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Group/Group.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Group/Group.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Optimizer/AbstractOptimizer.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Optimizer/AbstractOptimizer.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Optimizer/IslandsOptimizer/IslandsOptimizer.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Optimizer/IslandsOptimizer/IslandsOptimizer.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Optimizer/LexicaseOptimizer/LexicaseOptimizer.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Optimizer/LexicaseOptimizer/LexicaseOptimizer.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Optimizer/RouletteOptimizer/RouletteOptimizer.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Optimizer/RouletteOptimizer/RouletteOptimizer.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Optimizer/TournamentOptimizer/TournamentOptimizer.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Optimizer/TournamentOptimizer/TournamentOptimizer.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Organism/Organism.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Organism/Organism.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Organism/Phylogeny.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Organism/Phylogeny.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Testing/benchmarks.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Testing/benchmarks.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/AsyncFileWriter.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/AsyncFileWriter.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/BinaryTable.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/BinaryTable.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/CSV.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/CSV.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/CompiledMTree.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/CompiledMTree.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/Data.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/Data.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/DenseLayer.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/DenseLayer.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/Filesystem.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/Filesystem.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/Loader.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/Loader.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/MTree.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/MTree.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/Parameters.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/Parameters.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/PopulationTable.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/PopulationTable.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/PowerSet.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/PowerSet.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/ThreadPool.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/ThreadPool.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/Timing.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/Utilities/Timing.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/World/AbstractWorld.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/World/AbstractWorld.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/World/BerryWorld/BerryWorld.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/World/BerryWorld/BerryWorld.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/World/BlockCatchWorld/BlockCatchWorld.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/World/BlockCatchWorld/BlockCatchWorld.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/World/KarWorld/KarWorld.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/World/KarWorld/KarWorld.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/World/Logic16World/Logic16World.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/World/Logic16World/Logic16World.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/World/NBackWorld/NBackWorld.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/World/NBackWorld/NBackWorld.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/World/PathFollowWorld/PathFollowWorld.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/World/PathFollowWorld/PathFollowWorld.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/World/TPM_GENERATORWorld/TPM_GENERATORWorld.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/World/TPM_GENERATORWorld/TPM_GENERATORWorld.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/World/TestWorld/TestWorld.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/World/TestWorld/TestWorld.cpp.o.d"
+  "CMakeFiles/mabe_bench.dir/code/module_factories.cpp.o"
+  "CMakeFiles/mabe_bench.dir/code/module_factories.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mabe_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -61,6 +61,11 @@ std::shared_ptr<ParameterLink<std::string>>
                                        "prefix for files saved by "
                                        "this archivst. \"NONE\" "
                                        "indicates no prefix.");
+std::shared_ptr<ParameterLink<std::string>>
+    DefaultArchivist::Arch_fileFormatPL = Parameters::register_parameter(
+        "ARCHIVIST-fileFormat", std::string("csv"),
+        "format of snapshot data, snapshot organisms and LOD files. csv or "
+        "binary (compact .mbt files, which can be loaded like csv files)");
 std::shared_ptr<ParameterLink<bool>>
     DefaultArchivist::SS_Arch_writeDataFilesPL = Parameters::register_parameter(
         "ARCHIVIST_DEFAULT-writeSnapshotDataFiles", false,
@@ -115,6 +120,17 @@ DefaultArchivist::DefaultArchivist(std::shared_ptr<ParametersTable> PT_,
                            ? OrganismFilePrefix
                            : Arch_FilePrefixPL->get(PT) + OrganismFilePrefix;
 
+  if (Arch_fileFormatPL->get(PT) == "csv") {
+    FileExtension = ".csv";
+  } else if (Arch_fileFormatPL->get(PT) == "binary") {
+    FileExtension = BinaryTable::extension;
+  } else {
+    std::cout << "  In DefaultArchivist :: ARCHIVIST-fileFormat is \""
+              << Arch_fileFormatPL->get(PT)
+              << "\" but must be csv or binary. Exiting." << std::endl;
+    exit(1);
+  }
+
   writeSnapshotDataFiles = SS_Arch_writeDataFilesPL->get(PT);
   writeSnapshotGenomeFiles = SS_Arch_writeOrganismsFilesPL->get(PT);
 
@@ -124,10 +140,12 @@ DefaultArchivist::DefaultArchivist(std::shared_ptr<ParametersTable> PT_,
         seq(Arch_realtimeSequencePL->get(PT), Global::updatesPL->get(), true);
   
 
-  if (writeSnapshotDataFiles) 
+  if (writeSnapshotDataFiles) {
     realtimeDataSequence =
         seq(SS_Arch_dataSequencePL->get(PT), Global::updatesPL->get(), true);
-  
+    // (snapshotAncestors are kept for organisms whose parents are cleared)
+    Phylogeny::get().trackAncestors(Phylogeny::SNAPSHOT_ANCESTORS);
+  }
 
   if (writeSnapshotGenomeFiles) 
     realtimeOrganismSequence =
@@ -151,6 +169,7 @@ DefaultArchivist::DefaultArchivist(std::vector<std::string> & popFileColumns,
 
   convertCSVListToVector(PopFileColumnNames, default_pop_file_columns_);
   max_formula_ = std::move(max_formula);
+  max_program_.compile(max_formula_);
 
   if (default_pop_file_columns_.empty()) // hack because somehow getting passed empty string
     default_pop_file_columns_ = popFileColumns;
@@ -184,15 +203,23 @@ void DefaultArchivist::writeRealTimeFiles(
   // write out population data
 
   if (writePopFile) {
-    DataMap PopMap;
-    for (auto &kv : unique_column_name_to_output_behaviors_) {
-      if (kv.first != "update")
-        for (auto const &org : population)
-          if (org->timeOfBirth < Global::update || save_new_orgs_)
-            PopMap.append(kv.first, org->dataMap.getAverage(kv.first));
-
-      PopMap.setOutputBehavior(kv.first, kv.second);
+    if (pop_table_output_behaviors_.empty()) { // first time, set up columns
+      std::vector<std::string> keys;
+      for (auto &kv : unique_column_name_to_output_behaviors_) {
+        if (kv.first != "update") {
+          keys.push_back(kv.first);
+          pop_table_output_behaviors_.push_back(kv.second);
+        }
+      }
+      pop_table_.setKeys(keys);
     }
+    pop_table_.clearRows();
+    for (auto const &org : population)
+      if (org->timeOfBirth < Global::update || save_new_orgs_)
+        pop_table_.addRow(org->dataMap);
+
+    // PopMap holds the average value of each organism for each key
+    DataMap PopMap = pop_table_.summarize(pop_table_output_behaviors_);
     PopMap.set("update", Global::update);
     PopMap.openAndWriteToFile(
         PopFileName, {}); // write the PopMap to file with empty list (save all)
@@ -205,7 +232,7 @@ void DefaultArchivist::writeRealTimeFiles(
     auto score = std::numeric_limits<double>::lowest();
     for (auto const &org : population)
       if (org->timeOfBirth < Global::update || save_new_orgs_) {
-        auto sc = max_formula_->eval(org->dataMap, org->PT)[0];
+        auto sc = max_program_.eval(org->dataMap, org->PT);
         if (sc > score) {
           score = sc;
           best_org = org;
@@ -229,7 +256,7 @@ void DefaultArchivist::saveSnapshotData(
 
   	// write out data
   std::string dataFileName =
-      DataFilePrefix + "_" + std::to_string(Global::update) + ".csv";
+      DataFilePrefix + "_" + std::to_string(Global::update) + FileExtension;
 
   if (files_.find("snapshotData") ==
       files_.end()) { // first make sure that the dataFile has been set up.
@@ -241,6 +268,7 @@ void DefaultArchivist::saveSnapshotData(
                                           // same keys in their dataMaps)
 	files_["snapshotData"].push_back("snapshotAncestors");
 	files_["snapshotData"].push_back("update");
+	snapshot_table_.setKeys(files_["snapshotData"]);
   }
 
   // first, determine which orgs in population need to be saved.
@@ -253,31 +281,34 @@ void DefaultArchivist::saveSnapshotData(
                                   }),
                    std::end(saveList));
 
-  // now for each org, update ancestors and save if in saveList
+  // now for each org, update ancestors and add to table if in saveList
+  snapshot_table_.clearRows();
   for (auto const &org : population) {
     // now that we know that ancestor list is good for this org...
     if (org->timeOfBirth < Global::update || save_new_orgs_) 
-		saveOrgToFile(org,dataFileName);
+		addOrgToSnapshotTable(org);
   }
+  snapshot_table_.openAndWriteToFile(dataFileName);
 
   FileManager::closeFile(dataFileName); // since this is a snapshot, we will not
                                         // be writting to this file again.
 }
 
-void DefaultArchivist::saveOrgToFile(const std::shared_ptr<Organism> &org, const std::string &data_file_name) {
+void DefaultArchivist::addOrgToSnapshotTable(const std::shared_ptr<Organism> &org) {
 
-  for (auto ancestorID : org->snapshotAncestors) {
+  for (auto ancestorID : Phylogeny::get().getAncestors(
+           Phylogeny::SNAPSHOT_ANCESTORS, org->phylogenyNode)) {
     org->dataMap.append("snapshotAncestors", ancestorID);
   }
 
   org->dataMap.setOutputBehavior("snapshotAncestors", DataMap::LIST);
 
-  org->snapshotAncestors.clear(); // now that we have saved the ancestor data, set ancestors to self (so that others will inherit correctly)
-  org->snapshotAncestors.insert(org->ID);
+  // now that we have saved the ancestor data, set ancestors to self (so that others will inherit correctly)
+  Phylogeny::get().setSaved(Phylogeny::SNAPSHOT_ANCESTORS, org->phylogenyNode);
 
   org->dataMap.set("update", Global::update);
   org->dataMap.setOutputBehavior("update", DataMap::FIRST);
-  org->dataMap.openAndWriteToFile(data_file_name, files_["snapshotData"]); // append new data to the file
+  snapshot_table_.addRow(org->dataMap);
   org->dataMap.clear("snapshotAncestors");
   org->dataMap.clear("update");
 }
@@ -308,7 +339,7 @@ void DefaultArchivist::saveOrgToFile(const std::shared_ptr<Organism> &org, const
 
 
     /*
-  auto parent_check_list = org->parents;
+  auto parent_check_list = org->getParents();
 
   while (!parent_check_list.empty()) {
     auto parent = parent_check_list.back(); // this is "this parent"
@@ -339,7 +370,7 @@ void DefaultArchivist::saveOrgToFile(const std::shared_ptr<Organism> &org, const
 
 	// this parent not old enough (see if above), add this
     // parents parents to check list (we need to keep looking)
-    for (auto const &p : parent->parents) {
+    for (auto const &p : parent->getParents()) {
       parent_check_list.push_back(p);
     }
   }
@@ -352,7 +383,7 @@ void DefaultArchivist::saveSnapshotOrganisms(
     std::vector<std::shared_ptr<Organism>> & population) {
   // write out organims
   std::string organismFileName =
-      OrganismFilePrefix + "_" + std::to_string(Global::update) + ".csv";
+      OrganismFilePrefix + "_" + std::to_string(Global::update) + FileExtension;
 
   for (auto const &org : population) {
     if (org->timeOfBirth < Global::update || save_new_orgs_) {
@@ -422,7 +453,7 @@ bool DefaultArchivist::archive(
     // we don't need to worry about tracking parents or
     // lineage, so we clear out this data every generation.
     for (auto const &org : population)
-      org->parents.clear();
+      org->clearParents();
   } else {
 	cleanUpParents(population);
   }
@@ -439,10 +470,11 @@ void DefaultArchivist::cleanUpParents(
   //need_to_clean.clear(); // we haven't cleaned anything yet
 
   for (auto const &org : population)
-    if (org->snapshotAncestors.find(org->ID) != org->snapshotAncestors.end())
+    if (Phylogeny::get().isSaved(Phylogeny::SNAPSHOT_ANCESTORS,
+                                 org->phylogenyNode))
       // if ancestors contains self, then this org has been saved
       // and it's ancestor list has been collapsed
-      org->parents.clear();
+      org->clearParents();
     //else                            // org has not ever been saved to file...
       //need_to_clean.push_back(org); // we will need to check to see if we can do
                                     // clean up related to this org
@@ -462,9 +494,9 @@ void DefaultArchivist::cleanUpParents(
     need_to_clean.pop_back();
     if (org->timeOfBirth < minBirthTime)
       // no living org can be this orgs ancestor
-      org->parents.clear(); // so we can safely release parents
+      org->clearParents(); // so we can safely release parents
     else
-      for (auto const &parent : org->parents) // we need to check parents (if any)
+      for (auto const &parent : org->getParents()) // we need to check parents (if any)
         if (std::find(std::begin(logged), std::end(logged), parent) ==
             logged.end()) { // if parent is not already in
                             // logged list (i.e. either
@@ -20,6 +20,8 @@
 #include "../Global.h"
 #include "../Organism/Organism.h"
 #include "../Utilities/MTree.h"
+#include "../Utilities/CompiledMTree.h"
+#include "../Utilities/PopulationTable.h"
 
 class DefaultArchivist {
 //protected:
@@ -37,6 +39,7 @@ public:
 
   std::string DataFilePrefix;     // name of the Data file
   std::string OrganismFilePrefix; // name of the Genome file (genomes on LOD)
+  std::string FileExtension;      // ".csv" or ".mbt" (see ARCHIVIST-fileFormat)
   bool writeSnapshotDataFiles;    // if true, write data file
   bool writeSnapshotGenomeFiles;  // if true, write genome file
 
@@ -52,6 +55,7 @@ public:
   std::shared_ptr<Abstract_MTree>
       max_formula_; // what value will be used to determine
                     // which organism to write to max file
+  CompiledMTree max_program_; // max_formula_, compiled
 
   bool save_new_orgs_ = false;
 
@@ -63,6 +67,12 @@ public:
 
   std::map<std::string, int> unique_column_name_to_output_behaviors_;
 
+  // population data for the pop file (all unique columns except "update")
+  // and for snapshot data files, refilled each time the files are written
+  PopulationTable pop_table_;
+  std::vector<int> pop_table_output_behaviors_;
+  PopulationTable snapshot_table_;
+
   bool finished_ =
       false; // if finished, then as far as the archivist is concerned, we
              // can stop the run.
@@ -83,8 +93,8 @@ public:
   void saveSnapshotOrganisms(
       std::vector<std::shared_ptr<Organism>> & /*population*/);
 
-  void saveOrgToFile(const std::shared_ptr<Organism> &/*org*/,
-                     const std::string & /*data_file_name*/);
+  // add org (with its snapshotAncestors and update) to snapshot_table_
+  void addOrgToSnapshotTable(const std::shared_ptr<Organism> &/*org*/);
 
   void cleanUpParents(std::vector<std::shared_ptr<Organism>> & /*population*/);
 
@@ -113,6 +123,8 @@ public:
 
   static std::shared_ptr<ParameterLink<std::string>>
       Arch_FilePrefixPL; // name of the Data file
+  static std::shared_ptr<ParameterLink<std::string>>
+      Arch_fileFormatPL; // format of snapshot and LOD files
   static std::shared_ptr<ParameterLink<bool>>
       SS_Arch_writeDataFilesPL; // if true, write data file
   static std::shared_ptr<ParameterLink<bool>>
@@ -60,16 +60,16 @@ LODwAPArchivist::LODwAPArchivist(std::vector<std::string> popFileColumns,
                       ? ""
                       : LODwAP_Arch_FilePrefixPL->get(PT)) +
                  (group_prefix_.empty()
-                       ? "LOD_data.csv"
+                       ? "LOD_data" + FileExtension
                        : group_prefix_.substr(0, group_prefix_.size() - 2) +
-                             "__" + "LOD_data.csv");
+                             "__" + "LOD_data" + FileExtension);
   organism_file_name_ = (LODwAP_Arch_FilePrefixPL->get(PT) == "NONE"
                           ? ""
                           : LODwAP_Arch_FilePrefixPL->get(PT)) +
                      (group_prefix_.empty()
-                           ? "LOD_organisms.csv"
+                           ? "LOD_organisms" + FileExtension
                            : group_prefix_.substr(0, group_prefix_.size() - 2) +
-                                 "__" + "LOD_organisms.csv");
+                                 "__" + "LOD_organisms" + FileExtension);
 
   writeDataFile = LODwAP_Arch_writeDataFilePL->get(PT);
   writeOrganismFile = LODwAP_Arch_writeOrganismFilePL->get(PT);
@@ -82,6 +82,33 @@ LODwAPArchivist::LODwAPArchivist(std::vector<std::string> popFileColumns,
 
   next_data_write_ = dataSequence[data_seq_index];
   next_organism_write_ = organismSequence[organism_seq_index];
+
+  lineage_tracker_ = Phylogeny::get().addLineageTracker();
+}
+
+bool LODwAPArchivist::getLODFromRoot(
+    const std::shared_ptr<Organism> &some_org,
+    std::vector<Phylogeny::Node> &LOD) {
+  auto &phylogeny = Phylogeny::get();
+  if (lineage_root_ == Phylogeny::none ||
+      !phylogeny.descendsFromRoot(lineage_tracker_, some_org->phylogenyNode)) {
+    return false;
+  }
+  LOD = phylogeny.getOnlyChildChain(lineage_root_);
+  // (this fails if the chain ends at an organism with no linked offspring,
+  // and the LOD is then found from some_org)
+  if (!phylogeny.hasLinkedChildren(LOD.back())) {
+    return false;
+  }
+  // organisms on the chain before the new MRCA which are still alive are
+  // about to be pruned from it, so they (and their future offspring) will not
+  // descend from the new root
+  for (size_t i = 0; i + 1 < LOD.size(); i++) {
+    if (phylogeny.getDeath(LOD[i]) == -1) {
+      phylogeny.detach(lineage_tracker_, LOD[i]);
+    }
+  }
+  return true;
 }
 
 void LODwAPArchivist::constructLODFiles(const std::shared_ptr<Organism> &org) {
@@ -94,14 +121,17 @@ void LODwAPArchivist::constructLODFiles(const std::shared_ptr<Organism> &org) {
   }
 }
 
-void LODwAPArchivist::writeLODDataFile(
-    std::vector<std::shared_ptr<Organism>> &LOD,
-    const std::shared_ptr<Organism> &real_MRCA,
-    const std::shared_ptr<Organism> &effective_MRCA) {
+void LODwAPArchivist::writeLODDataFile(std::vector<Phylogeny::Node> &LOD,
+                                       Phylogeny::Node real_MRCA,
+                                       Phylogeny::Node effective_MRCA) {
+  auto &phylogeny = Phylogeny::get();
 
+  // LOD is in order of birth, and writes are in order of time, so each write
+  // starts looking where the last one stopped
+  size_t nextIndex = 0;
   while (next_data_write_ <=
          std::min(
-             effective_MRCA->timeOfBirth,
+             phylogeny.getBirth(effective_MRCA),
              Global::updatesPL->get())) { // if there is convergence before the
                                           // next data interval
 
@@ -109,39 +139,38 @@ void LODwAPArchivist::writeLODDataFile(
     //auto current = LOD[(next_data_write_ - last_prune_) - 1];
 
     // new version
-    std::shared_ptr<Organism> current;
-    int currentIndex = 0;
-    while (LOD[currentIndex]->timeOfBirth < next_data_write_) {
-        currentIndex++;
+    while (phylogeny.getBirth(LOD[nextIndex]) < next_data_write_) {
+        nextIndex++;
     }
-    currentIndex--;
-    current = LOD[currentIndex];
+    auto current = LOD[nextIndex - 1];
     // end new version
 
-    current->dataMap.set("update", next_data_write_);
-    current->dataMap.setOutputBehavior("update", DataMap::FIRST);
-    time_to_coalescence =
-        std::max(0, current->timeOfBirth - real_MRCA->timeOfBirth);
-    current->dataMap.set("timeToCoalescence", time_to_coalescence);
-    current->dataMap.setOutputBehavior("timeToCoalescence", DataMap::FIRST);
-    current->dataMap.openAndWriteToFile(
+    auto &dataMap = phylogeny.getDataMap(current);
+    dataMap.set("update", next_data_write_);
+    dataMap.setOutputBehavior("update", DataMap::FIRST);
+    time_to_coalescence = std::max(
+        0, phylogeny.getBirth(current) - phylogeny.getBirth(real_MRCA));
+    dataMap.set("timeToCoalescence", time_to_coalescence);
+    dataMap.setOutputBehavior("timeToCoalescence", DataMap::FIRST);
+    dataMap.openAndWriteToFile(
         data_file_name_,
         files_[data_file_name_]); // append new data to the file
-    current->dataMap.clear("update");
-    current->dataMap.clear("timeToCoalescence");
+    dataMap.clear("update");
+    dataMap.clear("timeToCoalescence");
 
 	next_data_write_ = dataSequence[++data_seq_index];
   }
 }
 
 
-void LODwAPArchivist::writeLODOrganismFile(
-    std::vector<std::shared_ptr<Organism>> &LOD,
-    const std::shared_ptr<Organism> &effective_MRCA) {
+void LODwAPArchivist::writeLODOrganismFile(std::vector<Phylogeny::Node> &LOD,
+                                           Phylogeny::Node effective_MRCA) {
+  auto &phylogeny = Phylogeny::get();
 
+  size_t nextIndex = 0;
   while (next_organism_write_ <=
          std::min(
-             effective_MRCA->timeOfBirth,
+             phylogeny.getBirth(effective_MRCA),
              Global::updatesPL->get())) { // if there is convergence before the
                                           // next data interval
 
@@ -149,25 +178,22 @@ void LODwAPArchivist::writeLODOrganismFile(
     //auto current = LOD[(next_organism_write_ - last_prune_) - 1];
 
     // new version
-    std::shared_ptr<Organism> current;
-    int currentIndex = 0;
-    while (LOD[currentIndex]->timeOfBirth < next_organism_write_) {
-        currentIndex++;
+    while (phylogeny.getBirth(LOD[nextIndex]) < next_organism_write_) {
+        nextIndex++;
     }
-    currentIndex--;
-    current = LOD[currentIndex];
+    auto current = LOD[nextIndex - 1];
     // end new version
 
     DataMap OrgMap;
-    OrgMap.set("ID", current->ID);
+    OrgMap.set("ID", phylogeny.getID(current));
     OrgMap.set("update", next_organism_write_);
     OrgMap.setOutputBehavior("update", DataMap::FIRST);
 
-    for (auto & genome : current->genomes) {
+    for (auto & genome : phylogeny.getGenomes(current)) {
       auto name = "GENOME_" + genome.first;
       OrgMap.merge(genome.second->serialize(name));
     }
-    for (auto & brain : current->brains) {
+    for (auto & brain : phylogeny.getBrains(current)) {
       auto name = "BRAIN_" + brain.first;
       OrgMap.merge(brain.second->serialize(name));
     }
@@ -210,29 +236,39 @@ bool LODwAPArchivist::archive(std::vector<std::shared_ptr<Organism>> &population
     constructLODFiles(population[0]);
 
   // get the MRCA
+  auto &phylogeny = Phylogeny::get();
   auto some_org = population[0];
-  auto LOD = some_org->getLOD(some_org); // get line of descent
-
-  if (flush) // if flush then we don't care about coalescence
-    std::cout << "flushing LODwAP: organism with ID " << population[0]->ID <<
-      " has been selected to generate Line of Descent."
-      << std::endl;
-
-  auto effective_MRCA =
-      flush // this assumes that a population was created, but not tested at
-          // the end of the evolution loop!
-          ? some_org->parents[0]
-          : some_org->getMostRecentCommonAncestor(
-                LOD); // find the convergence point in the LOD.
-  auto real_MRCA =
-      flush ? some_org->getMostRecentCommonAncestor(LOD)
-            : effective_MRCA; // find the convergence point in the LOD.
+  std::vector<Phylogeny::Node> LOD;
+  Phylogeny::Node effective_MRCA;
+  Phylogeny::Node real_MRCA;
+  bool fromRoot = !flush && getLODFromRoot(some_org, LOD);
+  if (fromRoot) {
+    // LOD runs from the last MRCA to the new one (which is its last node)
+    effective_MRCA = real_MRCA = LOD.back();
+  } else {
+    LOD = some_org->getLOD(some_org); // get line of descent
+
+    if (flush) // if flush then we don't care about coalescence
+      std::cout << "flushing LODwAP: organism with ID " << population[0]->ID <<
+        " has been selected to generate Line of Descent."
+        << std::endl;
+
+    effective_MRCA =
+        flush // this assumes that a population was created, but not tested at
+            // the end of the evolution loop!
+            ? phylogeny.getParents(some_org->phylogenyNode)[0]
+            : some_org->getMostRecentCommonAncestor(
+                  LOD); // find the convergence point in the LOD.
+    real_MRCA =
+        flush ? some_org->getMostRecentCommonAncestor(LOD)
+              : effective_MRCA; // find the convergence point in the LOD.
+  }
 
   // Save Data
   if (writeDataFile) {
 	  writeLODDataFile(LOD, real_MRCA, effective_MRCA);
 	  if (flush) {
-		  if (real_MRCA->timeOfBirth == -2) {
+		  if (phylogeny.getBirth(real_MRCA) == -2) {
 			  std::cout << "This run has not coalesced. There is no Most Recent Common Ancestor.\n" <<
 				  "None of the organisms in LOD_data.csv are guaranteed to be on LOD." << std::endl;
 		  }
@@ -259,9 +295,28 @@ bool LODwAPArchivist::archive(std::vector<std::shared_ptr<Organism>> &population
 
   // data and genomes have now been written out up till the MRCA
   // so all data and genomes from before the MRCA can be deleted
-  effective_MRCA->parents.clear();
-  last_prune_ = effective_MRCA->timeOfBirth; // this will hold the time of the
-                                             // oldest genome in RAM
+  phylogeny.clearParents(effective_MRCA);
+  last_prune_ = phylogeny.getBirth(effective_MRCA); // this will hold the time
+                                                    // of the oldest genome in
+                                                    // RAM
+
+  // the MRCA is the root of the next LOD. if it was found by walking up from
+  // some_org, which organisms descend from it is not yet known
+  if (!fromRoot) {
+    std::vector<Phylogeny::Node> living;
+    living.reserve(population.size());
+    for (auto const &org : population) {
+      living.push_back(org->phylogenyNode);
+    }
+    phylogeny.setRoot(lineage_tracker_, effective_MRCA, living);
+  }
+  // (the new root is held before the old one is released, as they may be the
+  // same node)
+  phylogeny.hold(effective_MRCA);
+  if (lineage_root_ != Phylogeny::none) {
+    phylogeny.release(lineage_root_);
+  }
+  lineage_root_ = effective_MRCA;
 
   return finished_;
 
@@ -278,12 +333,12 @@ bool LODwAPArchivist::archive(std::vector<std::shared_ptr<Organism>> &population
   for (auto org : population) {  // we don't need to worry about tracking
   parents or lineage, so we clear out this data every generation.
           if (!writeSnapshotDataFiles) {
-                  org->parents.clear();
+                  org->clearParents();
           }
           else if (org->snapshotAncestors.find(org->ID) !=
   org->snapshotAncestors.end()) { // if ancestors contains self, then this org
   has been saved and it's ancestor list has been collapsed
-                  org->parents.clear();
+                  org->clearParents();
                   checked.insert(org); // make a note, so we don't check this
   org later
                   minBirthTime = min(org->timeOfBirth, minBirthTime);
@@ -39,15 +39,22 @@ public:
   bool writeDataFile;           // if true, write data file
   bool writeOrganismFile;       // if true, write genome file
 
+  // the LOD from lineage_root_ to the current MRCA, found by following only
+  // children down from the root. false if some_org does not descend from the
+  // root (or there is no root yet), and the LOD must be found from some_org
+  bool getLODFromRoot(const std::shared_ptr<Organism> &some_org,
+                      std::vector<Phylogeny::Node> &LOD);
+
   void constructLODFiles(const std::shared_ptr<Organism> &/*org*/);
 
-  void writeLODDataFile(std::vector<std::shared_ptr<Organism>> & /*LOD*/,
-                        const std::shared_ptr<Organism> &/*real_MRCA*/,
-                        const std::shared_ptr<Organism> &/*effective_MRCA*/);
+  // (the LOD, and the MRCAs, are Phylogeny nodes, as the organisms on the LOD
+  // before the MRCA are only kept in Phylogeny)
+  void writeLODDataFile(std::vector<Phylogeny::Node> & /*LOD*/,
+                        Phylogeny::Node /*real_MRCA*/,
+                        Phylogeny::Node /*effective_MRCA*/);
 
-  void
-  writeLODOrganismFile(std::vector<std::shared_ptr<Organism>> & /*LOD*/,
-                       const std::shared_ptr<Organism> & /*effective_MRCA*/);
+  void writeLODOrganismFile(std::vector<Phylogeny::Node> & /*LOD*/,
+                            Phylogeny::Node /*effective_MRCA*/);
 
   LODwAPArchivist() = delete;
   LODwAPArchivist(std::vector<std::string> popFileColumns = {},
@@ -64,6 +71,9 @@ public:
   std::string data_file_name_;          // name of the Data file
   std::string organism_file_name_;      // name of the Genome file (genomes on LOD)
   int last_prune_ = -1; // last time Genome was Pruned
+  Phylogeny::Node lineage_root_ =
+      Phylogeny::none; // MRCA at the last prune (held in Phylogeny)
+  int lineage_tracker_; // this archivists lineage tracker in Phylogeny
   int time_to_coalescence = -1;
 
   //// info about files under management
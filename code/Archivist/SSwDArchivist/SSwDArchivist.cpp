@@ -75,6 +75,10 @@ SSwDArchivist::SSwDArchivist(std::vector<std::string> popFileColumns,
           : SSwD_Arch_FilePrefixPL->get(PT) + OrganismFilePrefix;
 
   writeDataFiles = SSwD_Arch_writeDataFilesPL->get(PT);
+  if (writeDataFiles) {
+    // (ancestors are kept for organisms whose parents are cleared)
+    Phylogeny::get().trackAncestors(Phylogeny::DATA_ANCESTORS);
+  }
   writeOrganismFiles = SSwD_Arch_writeOrganismFilesPL->get(PT);
 
   auto dataSequenceStr = SSwD_Arch_dataSequenceStrPL->get(PT);
@@ -120,6 +124,7 @@ SSwDArchivist::SSwDArchivist(std::vector<std::string> popFileColumns,
 // job keeping memory down.
 void SSwDArchivist::cleanup() {
 
+  auto &phylogeny = Phylogeny::get();
   {
     std::vector<int> expiredCheckPoints;
     bool checkpointEmpty;
@@ -129,17 +134,18 @@ void SSwDArchivist::cleanup() {
            std::max(dataDelay, organismDelay))) { // if that checkpoint is older then
                                              // the longest intervalDelay
         checkpointEmpty = true;
-        for (auto weakPtrToOrg :
+        for (auto weakNode :
              checkpoints[checkpoint.first]) {   // than for each element in that
                                                 // checkpoint
-          if (auto org = weakPtrToOrg.lock()) { // if this ptr is still good
-            if ((!org->alive) &&
-                (org->timeOfDeath <
+          if (!phylogeny.expired(weakNode)) { // if this node is still good
+            int timeOfDeath = phylogeny.getDeath(weakNode.node);
+            if ((timeOfDeath != -1) &&
+                (timeOfDeath <
                  (Global::update -
                   std::max(dataDelay, organismDelay)))) { // and if the organism was
                                                      // dead before the current
                                                      // interesting data
-              // org->parents.clear();  // clear this organisms parents :: NOTE
+              // org->clearParents();  // clear this organisms parents :: NOTE
               // this was assuming that Default snapshot was not interested in
               // parents.
               // really we can only clear parents if org is older then oldest in
@@ -223,7 +229,8 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
 
       // if this is a data snapshot update we need to collect some info (who
       // will be saved and oldest org to be saved)
-      std::vector<std::shared_ptr<Organism>> saveList;
+      auto &phylogeny = Phylogeny::get();
+      std::unordered_set<Phylogeny::Node> saveList;
       int minBirthTime =
           population[0]->timeOfBirth; // time of birth of oldest org being saved
                                       // in this update (init with random value)
@@ -231,14 +238,14 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
           Global::update <= Global::updatesPL->get()) {
 
         if (save_new_orgs_) {
-          saveList = population;
           for (auto org : population) {
+            saveList.insert(org->phylogenyNode);
             minBirthTime = std::min(org->timeOfBirth, minBirthTime);
           }
         } else {
           for (auto org : population) {
             if (org->timeOfBirth < Global::update) {
-              saveList.push_back(org);
+              saveList.insert(org->phylogenyNode);
             }
             minBirthTime = std::min(org->timeOfBirth, minBirthTime);
           }
@@ -252,7 +259,8 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
                                                  // this org is atleast 1 update
                                                  // old...
           // ... checkpoint org
-          checkpoints[Global::update].push_back(org);
+          checkpoints[Global::update].push_back(
+              phylogeny.getWeakNode(org->phylogenyNode));
           org->snapShotDataMaps[Global::update] =
               std::make_shared<DataMap>(org->dataMap); // back up state of dataMap
         }
@@ -261,8 +269,9 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
           // if this is a data interval, add ancestors to snapshot dataMap
           // first we need to make sure that ancestor lists are up to date
 
-          if (org->ancestors.size() != 1 ||
-              org->ancestors.find(org->ID) == org->ancestors.end()) {
+          std::vector<int> ancestors;
+          if (!phylogeny.isSaved(Phylogeny::DATA_ANCESTORS,
+                                 org->phylogenyNode)) {
             // if this org does not only contain only itself in
             // snapshotAncestors then it has not been saved before.
             // we must confirm that snapshotAncestors is correct because things
@@ -283,8 +292,8 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
             // if they are at least as old as the oldest org being saved to this
             // file then we can simply append their ancestors
 
-            org->ancestors.clear();
-            std::vector<std::shared_ptr<Organism>> parentCheckList = org->parents;
+            std::vector<Phylogeny::Node> parentCheckList =
+                phylogeny.getParents(org->phylogenyNode);
 
             while (parentCheckList.size() > 0) {
               auto parent = parentCheckList.back(); // this is "this parent"
@@ -292,15 +301,13 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
 
               // cout << "\n org: " << org->ID << " parent: " << parent->ID <<
               // endl;
-              if (find(saveList.begin(), saveList.end(), parent) !=
+              if (saveList.find(parent) !=
                   saveList.end()) { // if this parent is being saved, they will
                                     // serve as an ancestor
-                org->ancestors.insert(parent->ID);
+                ancestors.push_back(phylogeny.getID(parent));
               } else { // this parent is not being saved
-                if (parent->timeOfBirth < minBirthTime ||
-                    (parent->ancestors.size() == 1 &&
-                     parent->ancestors.find(parent->ID) !=
-                         parent->ancestors.end())) {
+                if (phylogeny.getBirth(parent) < minBirthTime ||
+                    phylogeny.isSaved(Phylogeny::DATA_ANCESTORS, parent)) {
                   // if this parent is old enough that it can not have a parent
                   // in the save list (and is not in save list),
                   // or this parent has self in it's ancestor list (i.e. it has
@@ -309,15 +316,17 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
                   // cout << "getting ancestors for " << org->ID << " parent "
                   // << parent->ID << " is old enough or has self as
                   // ancestor..." << endl;
-                  for (auto ancestorID : parent->ancestors) {
+                  for (auto ancestorID :
+                       phylogeny.getAncestors(Phylogeny::DATA_ANCESTORS,
+                                              parent)) {
                     // cout << "adding from parent " << parent->ID << " ancestor
                     // " << ancestorID << endl;
-                    org->ancestors.insert(ancestorID);
+                    ancestors.push_back(ancestorID);
                   }
                 } else { // this parent not old enough (see if above), add this
                          // parents parents to check list (we need to keep
                          // looking)
-                  for (auto p : parent->parents) {
+                  for (auto p : phylogeny.getParents(parent)) {
                     parentCheckList.push_back(p);
                   }
                 }
@@ -332,7 +341,12 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
             cout << endl;
             */
 
+            // (the org's offspring will inherit this list, unless it is
+            // saved below)
+            phylogeny.setAncestors(Phylogeny::DATA_ANCESTORS,
+                                   org->phylogenyNode, ancestors);
           } else { // org has self for ancestor
+            ancestors.push_back(org->ID);
             if (org->timeOfBirth >= Global::update) { // if this is a new org...
               std::cout
                   << "  WARRNING :: in SSwD::archive(), while adding to a "
@@ -355,16 +369,19 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
           if (save_new_orgs_ ||
               org->timeOfBirth < Global::update) { // if this org is set up to
                                                    // be saved in this snapshot
-            for (auto ancestor : org->ancestors) {
+            std::sort(ancestors.begin(), ancestors.end());
+            ancestors.erase(std::unique(ancestors.begin(), ancestors.end()),
+                            ancestors.end());
+            for (auto ancestor : ancestors) {
               org->snapShotDataMaps[Global::update].append("ancestors",
                                                            ancestor);
             }
-            org->ancestors.clear(); // clear ancestors (this data is safe in the
-                                    // checkPoint)
-            org->ancestors.insert(org->ID); // now that we have saved the
-                                            // ancestor data, set ancestors to
-                                            // self (so that others will inherit
-                                            // correctly)
+            phylogeny.setSaved(
+                Phylogeny::DATA_ANCESTORS,
+                org->phylogenyNode); // now that we have saved the ancestor
+                                     // data (it is safe in the checkPoint),
+                                     // set ancestors to self (so that others
+                                     // will inherit correctly)
             // also, if this survives over intervals, it'll be pointing to self
             // as ancestor in files (which is good)
           }
@@ -411,30 +428,32 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
         writeOrganismFiles) { // now it's time to write genomes in the
                               // checkpoint at time nextGenomeWrite
       auto organismFileName =
-          OrganismFilePrefix + "_" + std::to_string(nextOrganismWrite) + ".csv";
+          OrganismFilePrefix + "_" + std::to_string(nextOrganismWrite) + FileExtension;
 
       // string dataString;
+      auto &phylogeny = Phylogeny::get();
       size_t index = 0;
       while (index < checkpoints[nextOrganismWrite].size()) {
-        if (auto org = checkpoints[nextOrganismWrite][index]
-                           .lock()) { // this ptr is still good
+        auto node = checkpoints[nextOrganismWrite][index].node;
+        if (!phylogeny.expired(checkpoints[nextOrganismWrite]
+                                          [index])) { // this node is still good
 
           DataMap OrgMap;
-          OrgMap.set("ID", org->ID);
+          OrgMap.set("ID", phylogeny.getID(node));
           std::string tempName;
 
-          for (auto genome : org->genomes) {
+          for (auto genome : phylogeny.getGenomes(node)) {
             tempName = "GENOME_" + genome.first;
             OrgMap.merge(genome.second->serialize(tempName));
           }
-          for (auto brain : org->brains) {
+          for (auto brain : phylogeny.getBrains(node)) {
             tempName = "BRAIN_" + brain.first;
             OrgMap.merge(brain.second->serialize(tempName));
           }
           OrgMap.openAndWriteToFile(organismFileName); // append new data to the file
           index++;
-        } else { // this ptr is expired - cut it out of the vector
-          swap(checkpoints[nextOrganismWrite][index],
+        } else { // this node is expired - cut it out of the vector
+          std::swap(checkpoints[nextOrganismWrite][index],
                checkpoints[nextOrganismWrite]
                    .back()); // swap expired ptr to back of vector
           checkpoints[nextOrganismWrite]
@@ -462,22 +481,23 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
         writeDataFiles) { // now it's time to write data in the checkpoint at
                           // time nextDataWrite
       std::string dataFileName =
-          DataFilePrefix + "_" + std::to_string(nextDataWrite) + ".csv";
+          DataFilePrefix + "_" + std::to_string(nextDataWrite) + FileExtension;
 
       // if file info has not been initialized yet, find a valid org and extract
       // it's keys
+      auto &phylogeny = Phylogeny::get();
       if (files_.find("data") == files_.end()) {
         bool found = false;
-        std::shared_ptr<Organism> org;
+        Phylogeny::Node node = Phylogeny::none;
 
         while (!found) { // check each org in checkPointTraker[nextDataWrite]
                          // until we find a valid org
-          if (auto temp_org = checkpoints[nextDataWrite][0]
-                                  .lock()) { // this ptr is still good
-            org = temp_org;
+          if (!phylogeny.expired(
+                  checkpoints[nextDataWrite][0])) { // this node is still good
+            node = checkpoints[nextDataWrite][0].node;
             found = true;
           } else { // it' empty, swap to back and remove.
-            swap(checkpoints[nextDataWrite][0],
+            std::swap(checkpoints[nextDataWrite][0],
                  checkpoints[nextDataWrite]
                      .back()); // swap expired ptr to back of vector
             checkpoints[nextDataWrite]
@@ -486,7 +506,8 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
         }
         // processAllLists(org->snapShotDataMaps[nextDataWrite]);
         std::vector<std::string> tempKeysList =
-            org->snapShotDataMaps[nextDataWrite].getKeys(); // get all keys from
+            phylogeny.getSnapShotDataMaps(node)[nextDataWrite]
+                .getKeys(); // get all keys from
                                                             // the valid orgs
                                                             // dataMap (all orgs
                                                             // should have the
@@ -505,17 +526,18 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
 
       size_t index = 0;
       while (index < checkpoints[nextDataWrite].size()) {
-        if (auto org = checkpoints[nextDataWrite][index]
-                           .lock()) { // this ptr is still good
+        if (!phylogeny.expired(
+                checkpoints[nextDataWrite][index])) { // this node is still good
+          auto &snapShotDataMap = phylogeny.getSnapShotDataMaps(
+              checkpoints[nextDataWrite][index].node)[nextDataWrite];
           // processAllLists(org->snapShotDataMaps[nextDataWrite]);
-          org->snapShotDataMaps[nextDataWrite].set("update", nextDataWrite);
-          org->snapShotDataMaps[nextDataWrite].setOutputBehavior(
-              "update", DataMap::FIRST);
-          org->snapShotDataMaps[nextDataWrite].openAndWriteToFile(
+          snapShotDataMap.set("update", nextDataWrite);
+          snapShotDataMap.setOutputBehavior("update", DataMap::FIRST);
+          snapShotDataMap.openAndWriteToFile(
               dataFileName, files_["data"]); // append new data to the file
           index++;                           // advance to nex element
-        } else { // this ptr is expired - cut it out of the vector
-          swap(checkpoints[nextDataWrite][index],
+        } else { // this node is expired - cut it out of the vector
+          std::swap(checkpoints[nextDataWrite][index],
                checkpoints[nextDataWrite]
                    .back()); // swap expired ptr to back of vector
           checkpoints[nextDataWrite]
@@ -541,8 +563,9 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
   ////////////////////////////////////////////////
   //
   ////////////////////////////////////////////////
-  std::vector<std::shared_ptr<Organism>> toCheck;
-  std::unordered_set<std::shared_ptr<Organism>> checked;
+  auto &phylogeny = Phylogeny::get();
+  std::vector<Phylogeny::Node> toCheck;
+  std::unordered_set<Phylogeny::Node> checked;
   int minBirthTime = population[0]->timeOfBirth; // time of birth of oldest org
                                                  // being saved in this update
                                                  // (init with random value)
@@ -551,11 +574,12 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
        population) { // we don't need to worry about tracking parents or
                      // lineage, so we clear out this data every generation.
     if (!writeSnapshotDataFiles && !writeDataFiles && !writeOrganismFiles) {
-      org->parents.clear();
+      org->clearParents();
       // cout << "HERE?" << endl;
-    } else if (org->snapshotAncestors.find(org->ID) !=
-                   org->snapshotAncestors.end() &&
-               org->ancestors.find(org->ID) != org->ancestors.end() &&
+    } else if (phylogeny.isSaved(Phylogeny::SNAPSHOT_ANCESTORS,
+                                 org->phylogenyNode) &&
+               phylogeny.isSaved(Phylogeny::DATA_ANCESTORS,
+                                 org->phylogenyNode) &&
                (org->timeOfDeath <
                 (Global::update -
                  std::max(dataDelay,
@@ -563,22 +587,24 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
                                          // contains self, then this org has
                                          // been saved and it's ancestor list
                                          // has been collapsed
-      org->parents.clear();
-      checked.insert(org); // make a note, so we don't check this org later
+      org->clearParents();
+      checked.insert(org->phylogenyNode); // make a note, so we don't check
+                                          // this org later
       minBirthTime = std::min(org->timeOfBirth, minBirthTime);
     } else { // org has not ever been saved to either snapshot_Data or SSwD_Data
-      toCheck.push_back(org); // we will need to check to see if we can do clean
-                              // up related to this org
-      checked.insert(org);    // make a note, so we don't check twice
+      toCheck.push_back(org->phylogenyNode); // we will need to check to see if
+                                             // we can do clean up related to
+                                             // this org
+      checked.insert(org->phylogenyNode); // make a note, so we don't check twice
       minBirthTime = std::min(org->timeOfBirth, minBirthTime);
     }
   }
 
   while (toCheck.size() > 0) {
-    auto org = toCheck.back();
+    auto node = toCheck.back();
     toCheck.pop_back();
-    if ((org->timeOfBirth < minBirthTime) &&
-        (org->timeOfDeath <
+    if ((phylogeny.getBirth(node) < minBirthTime) &&
+        (phylogeny.getDeath(node) <
          (Global::update -
           std::max(dataDelay, organismDelay)))) { // no living org can be this orgs
                                              // ancestor and this org died long
@@ -588,14 +614,14 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
       // org->timeOfBirth << " org->timeOfDeath: " << org->timeOfDeath <<
       // "max(dataDelay, organismDelay): " << max(dataDelay, organismDelay) <<
       // endl;
-      org->parents.clear(); // we can safely release parents
+      phylogeny.clearParents(node); // we can safely release parents
     } else {
-      for (auto p : org->parents) { // we need to check parents (if any)
+      for (auto p : phylogeny.getParents(node)) { // we need to check parents (if any)
         if (checked.find(p) == checked.end()) { // if parent is not already in
                                                 // checked list (i.e. either
                                                 // checked or going to be)
           toCheck.push_back(p);
-          checked.insert(org); // make a note, so we don't check twice
+          checked.insert(p); // make a note, so we don't check twice
         }
       }
     }
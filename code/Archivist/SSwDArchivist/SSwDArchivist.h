@@ -59,7 +59,7 @@ public:
                               // checkpointed (this is needed particularly to
                               // handle delay > interval)
 
-  std::map<int, std::vector<std::weak_ptr<Organism>>> checkpoints; // used by SSwD only - this
+  std::map<int, std::vector<Phylogeny::WeakNode>> checkpoints; // used by SSwD only - this
                                                     // keeps lists of orgs that
                                                     // may be written (if they
                                                     // have living decendents)
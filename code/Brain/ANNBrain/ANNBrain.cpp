@@ -22,6 +22,8 @@ std::shared_ptr<ParameterLink<std::string>> ANNBrain::biasRangePL = Parameters::
 	"When each nodes value is calculated a bias in this range (derived from the genome) will be added to the node value before thresholding.  (min,max)");
 std::shared_ptr<ParameterLink<std::string>> ANNBrain::thresholdMethodPL = Parameters::register_parameter("BRAIN_ANN-thresholdMethod", (std::string)"Tanh",
 	"Threshold method applied to node values after summation. Must be one of: NONE, Sigmoid, Tanh, ReLU, Binary");
+std::shared_ptr<ParameterLink<bool>> ANNBrain::singlePrecisionPL = Parameters::register_parameter("BRAIN_ANN-singlePrecision", false,
+	"if true, weights are stored as 32 bit floats (node values are still 64 bit). This halves the memory used by the weights, but the weights read from the genome are rounded.");
 
 // Layers... ANNBrain has 0 or more hidden layers
 // if 0 hidden layers then brain will have (number of outputs + number of recurrent nodes) nodes on the last layer. each last layer node will
@@ -30,8 +32,8 @@ std::shared_ptr<ParameterLink<std::string>> ANNBrain::thresholdMethodPL = Parame
 //   will recive inputs to all nodes in the prior layer.
 
 // The weight matrix
-// weights defines how every node will contribute to each node in the next layer
-// The weight matrix is organized as [layers[nodes[next_layer_node]]]. So weights[2][4][7] would define contribution
+// layers (see Utilities/DenseLayer.h) defines how every node will contribute to each node in the next layer
+// The weight matrix is organized as layers[layer].weight(node, next_layer_node). So layers[2].weight(4,7) would define contribution
 //   of the fourth node in the second layer to the seventh node in the third layer.
 
 ANNBrain::ANNBrain(int _nrInNodes, int _nrOutNodes, std::shared_ptr<ParametersTable> _PT) : AbstractBrain(_nrInNodes, _nrOutNodes, _PT) {
@@ -56,6 +58,21 @@ ANNBrain::ANNBrain(int _nrInNodes, int _nrOutNodes, std::shared_ptr<ParametersTa
 		std::cout << "  In ANN Brain constructor :: found unknown thresholdMethod \"" << thresholdMethodPL->get(PT) << "\".\n  Please check config file and correct.\n  exiting..." << std::endl;
 		exit(1);
 	}
+	switch (thresholdMethod) {
+	case Sigmoid:
+		layerActivation = DenseLayer::SIGMOID;
+		break;
+	case Tanh:
+		layerActivation = DenseLayer::TANH;
+		break;
+	case ReLU:
+		layerActivation = DenseLayer::RELU;
+		break;
+	default: // NONE (and Binary, which update has never applied)
+		layerActivation = DenseLayer::NONE;
+		break;
+	}
+	singlePrecision = singlePrecisionPL->get(PT);
 	convertCSVListToVector(biasRangePL->get(PT), biasRange);
 	convertCSVListToVector(weightRangePL->get(PT), weightRange);
 
@@ -102,34 +119,32 @@ std::shared_ptr<AbstractBrain> ANNBrain::makeBrain(std::unordered_map<std::strin
 	newBrain->nodes[newBrain->nodes.size() - 1].resize(_O + nrOfRecurringNodes); // outputs w/ recurrent nodes
 
 	// set up wights
- 	newBrain->weights.resize((int)newBrain->nodes.size()-1); // first dim of weights is numlayers-1 (not the output/recurrent layer)
-	for(int i=0;i<(int)newBrain->weights.size();i++) {
-        // for each weight layer (numlayers-1) resize to (ins+recurrent) or (outs+recurrent)
-        newBrain->weights[i].resize((int)newBrain->nodes[i].size());
-        // this is where we create the weight matrix (each node from the previous layer has a weight for each node in the next layer
-        for(int j=0;j<(int)newBrain->weights[i].size();j++) {
-            // resize weights to same size as next layer
-            newBrain->weights[i][j].resize((int)newBrain->nodes[i+1].size());
-        }
-    }
-	for (int i = 0; i < (int)newBrain->weights.size(); i++) { // for each weights layer
-		for (int j = 0; j < (int)newBrain->weights[i].size(); j++) { // for each weight set (i.e. the output weights for each node) in that layer
-			for (int k = 0; k < (int)newBrain->weights[i][j].size(); k++) { // for each weight (i.e. for each node in the next layer)
+	// one layer for each node layer but the last (each node from a layer has a weight for each node in the next layer)
+	for (int i = 0; i < (int)newBrain->nodes.size() - 1; i++) {
+		newBrain->layers.emplace_back((int)newBrain->nodes[i].size(), (int)newBrain->nodes[i + 1].size(), singlePrecision);
+	}
+	std::vector<double> values;
+	for (int i = 0; i < (int)newBrain->layers.size(); i++) { // for each weights layer
+		values.resize(newBrain->layers[i].outputs());
+		for (int j = 0; j < newBrain->layers[i].inputs(); j++) { // for each weight set (i.e. the output weights for each node) in that layer
+			// get a value in range [-1.0,1.0) from genome for each weight (i.e. for each node in the next layer)
+			genomeHandler->readDoubles(values.data(), (int)values.size(), weightRange[0], weightRange[1]);
+			for (int k = 0; k < newBrain->layers[i].outputs(); k++) {
 				//double value=doCPPN(x,y,weightsCPPN);
-				double value = genomeHandler->readDouble(weightRange[0], weightRange[1]); // get a value in range [-1.0,1.0) from genome
-				newBrain->weights[i][j][k] = value; // create a 'normal' distribution
+				newBrain->layers[i].setWeight(j, k, values[k]); // create a 'normal' distribution
 			}
 		}
 	}
 
 	
 	// set up biases
-	newBrain->biases.resize((int)newBrain->nodes.size() - 1); // first dim of weights is numlayers-1 (not the input layer)
-	for (int i = 0; i < (int)newBrain->biases.size(); i++) {
+	for (int i = 0; i < (int)newBrain->layers.size(); i++) {
 		// create the bias values for each node (each node except for the input layer needs a bias)
-		for (int j = 0; j < (int)newBrain->nodes[i+1].size(); j++) { // index is off by one because layer 0 (inputs) have not bias
+		values.resize(newBrain->nodes[i+1].size()); // index is off by one because layer 0 (inputs) have not bias
+		genomeHandler->readDoubles(values.data(), (int)values.size(), biasRange[0], biasRange[1]);
+		for (int j = 0; j < (int)newBrain->nodes[i+1].size(); j++) {
 			// add a bias for each node
-			newBrain->biases[i].push_back(genomeHandler->readDouble(biasRange[0], biasRange[1]));
+			newBrain->layers[i].setBias(j, values[j]);
 		}
 	}
 
@@ -163,30 +178,9 @@ double ANNBrain::readOutput(const int& outputAddress){
 
 void ANNBrain::update() {
     // starting with second layer, compute forward activations
+    // (bias + the weighted sum of the previous layer, then the threshold)
     for(int layer=1;layer<(int)nodes.size();layer++) {
-        // reset summation for current layer
-		for (int i = 0; i < (int)nodes[layer].size(); i++) {
-			nodes[layer][i] = biases[layer - 1][i]; // indexing from 1, and biases starts at layer 1 (hence the - 1)
-		}
-        // sum activations for current layer assuming well-connected to previous layer
-        for(int i=0;i<(int)nodes[layer-1].size();i++) { // for each node in the previous layer
-            for(int j=0;j<(int)nodes[layer].size();j++) { // for each output weight associated with that node
-                nodes[layer][j] += weights[layer-1][i][j]*nodes[layer-1][i]; // add the nodes weighted value to each node in this layer
-            }
-        }
-		switch (thresholdMethod) {
-		case NONE:
-			break; // do nothing
-		case Sigmoid:
-			vectorMathSigmoid(nodes[layer]);
-			break;
-		case Tanh:
-			vectorMathTanh(nodes[layer]);
-			break;
-		case ReLU:
-			vectorMathReLU(nodes[layer]);
-			break;
-		}
+		layers[layer - 1].update(nodes[layer - 1].data(), nodes[layer].data(), layerActivation);
     }
 
 	// copy recurrent values to nodes layer 0
@@ -216,22 +210,58 @@ void ANNBrain::initializeGenomes(std::unordered_map<std::string, std::shared_ptr
     _genomes[genomeName]->fillRandom(); // randomize the genome
 }
 
-void ANNBrain::vectorMathSigmoid(std::vector<double> &V){
-	for (auto&& v : V) {
-		v = 2.0*((1.0 / (1.0 + exp(-1.0 * v)))-.5); // Logistic function
+void ANNBrain::updateBatch(const std::vector<std::vector<double>>& inputs,
+	std::vector<std::vector<double>>& outputs, int updates) {
+	if (recordActivity) { // activity is recorded one update at a time
+		AbstractBrain::updateBatch(inputs, outputs, updates);
+		return;
+	}
+	// batchNodes[layer] holds nodes[layer] for every run, one run after another
+	const int batchSize = (int)inputs.size();
+	const int layerCount = (int)nodes.size();
+	batchNodes.resize(layerCount);
+	for (int layer = 0; layer < layerCount; layer++) {
+		batchNodes[layer].assign(batchSize * nodes[layer].size(), 0.0);
+	}
+	const int inputLayerSize = (int)nodes[0].size();
+	for (int b = 0; b < batchSize; b++) {
+		checkBatchInputs(inputs[b]);
+		std::copy(inputs[b].begin(), inputs[b].end(), batchNodes[0].begin() + b * inputLayerSize);
 	}
+
+	for (int u = 0; u < updates; u++) {
+		// the same sums as update, but each weight is used for every run before moving on
+		for (int layer = 1; layer < layerCount; layer++) {
+			layers[layer - 1].updateBatch(batchNodes[layer - 1].data(), batchNodes[layer].data(), batchSize, layerActivation);
+		}
+		// copy recurrent values to nodes layer 0
+		const int lastSize = (int)nodes[layerCount - 1].size();
+		for (int b = 0; b < batchSize; b++) {
+			for (int i = 0; i < nrOfRecurringNodes; i++) {
+				batchNodes[0][b * inputLayerSize + _I + i] = batchNodes[layerCount - 1][b * lastSize + _O + i];
+			}
+		}
+	}
+
+	outputs.resize(batchSize);
+	const int lastSize = (int)nodes[layerCount - 1].size();
+	for (int b = 0; b < batchSize; b++) {
+		auto first = batchNodes[layerCount - 1].begin() + b * lastSize;
+		outputs[b].assign(first, first + nrOutputValues);
+	}
+	resetBrain();
+}
+
+void ANNBrain::vectorMathSigmoid(std::vector<double> &V){
+	DenseLayer::applyActivation(DenseLayer::SIGMOID, V.data(), (int)V.size());
 }
 
 void ANNBrain::vectorMathTanh(std::vector<double> &V) {
-	for (auto&& v : V) {
-		v = tanh(v);
-	}
+	DenseLayer::applyActivation(DenseLayer::TANH, V.data(), (int)V.size());
 }
 
 void ANNBrain::vectorMathReLU(std::vector<double> &V) {
-	for (auto&& v : V) {
-		v = std::max(0.0,v);
-	}
+	DenseLayer::applyActivation(DenseLayer::RELU, V.data(), (int)V.size());
 }
 
 void ANNBrain::vectorMathBinary(std::vector<double> &V) {
@@ -249,8 +279,7 @@ std::shared_ptr<AbstractBrain> ANNBrain::makeCopy(std::shared_ptr<ParametersTabl
     newBrain->_I=_I;
     newBrain->_O=_O;
     newBrain->nodes=nodes;
-	newBrain->weights = weights;
-	newBrain->biases = biases;
+	newBrain->layers = layers;
 
     return newBrain;
 }
@@ -260,20 +289,20 @@ void ANNBrain::showBrain(){
     for(int l=0;l<(int)nodes.size();l++){
         printf("layer %i has %i nodes.\n",l,(int)nodes[l].size());
     }
-	for (int i = 0; i < (int)weights.size(); i++) {
+	for (int i = 0; i < (int)layers.size(); i++) {
 		printf("layer(%d)\n", i);
-		for (int j = 0; j < (int)weights[i].size(); j++) {
+		for (int j = 0; j < layers[i].inputs(); j++) {
 			printf("  node(%d) weights [", j);
-			for (int k = 0; k < (int)weights[i][j].size(); k++) {
-				printf("  %f,", weights[i][j][k]);
+			for (int k = 0; k < layers[i].outputs(); k++) {
+				printf("  %f,", layers[i].weight(j, k));
 			}
 			printf("]\n");
 		}
 	}
-	for (int i = 0; i < (int)biases.size(); i++) {
+	for (int i = 0; i < (int)layers.size(); i++) {
 		printf("layer(%d) biases: [", i + 1);
-		for (int j = 0; j < (int)biases[i].size(); j++) {
-			printf("  %f,", biases[i][j]);
+		for (int j = 0; j < layers[i].outputs(); j++) {
+			printf("  %f,", layers[i].bias(j));
 		}
 		printf("]\n");
 	}
@@ -21,6 +21,7 @@
 #include <Genome/AbstractGenome.h>
 #include <Utilities/Random.h>
 #include <Brain/AbstractBrain.h>
+#include <Utilities/DenseLayer.h>
 
 
 //using namespace std;
@@ -35,6 +36,7 @@ public:
 	static std::shared_ptr<ParameterLink<std::string>> weightRangePL;
 	static std::shared_ptr<ParameterLink<std::string>> thresholdMethodPL;
 	static std::shared_ptr<ParameterLink<std::string>> genomeNamePL;
+	static std::shared_ptr<ParameterLink<bool>> singlePrecisionPL;
 
 	int nrOfRecurringNodes;
 	int nrOfHiddenLayers;
@@ -43,13 +45,16 @@ public:
 
 	enum ThresholdMethods { NONE, Sigmoid, Tanh, ReLU, Binary};
 	ThresholdMethods thresholdMethod;
+	DenseLayer::Activation layerActivation; // thresholdMethod, as applied by the layers
+	bool singlePrecision;
 
 	std::string genomeName;
 	std::vector<int> hiddenLayerSizes;
 
     int _I,_O;
-	std::vector<std::vector<double>> nodes, biases;
-	std::vector<std::vector<std::vector<double>>> weights;
+	std::vector<std::vector<double>> nodes;
+	std::vector<DenseLayer> layers; // layers[i] holds the weights and biases from nodes[i] to nodes[i+1]
+	std::vector<std::vector<double>> batchNodes; // nodes for each run in updateBatch
 	ANNBrain() = delete;
 
 	ANNBrain(int _nrInNodes, int _nrOutNodes, std::shared_ptr<ParametersTable> _PT = Parameters::root);
@@ -57,6 +62,8 @@ public:
 	virtual ~ANNBrain() = default;
 
 	virtual void update() override;
+	virtual void updateBatch(const std::vector<std::vector<double>>& inputs,
+		std::vector<std::vector<double>>& outputs, int updates = 1) override;
 
 	virtual std::shared_ptr<AbstractBrain> makeBrain(std::unordered_map<std::string, std::shared_ptr<AbstractGenome>>& _genomes) override;
 
@@ -134,6 +134,33 @@ void AbstractBrain::resetBrain() {
     }
 }
 
+void AbstractBrain::updateBatch(const std::vector<std::vector<double>>& inputs,
+    std::vector<std::vector<double>>& outputs, int updates) {
+    outputs.resize(inputs.size());
+    for (size_t b = 0; b < inputs.size(); b++) {
+        checkBatchInputs(inputs[b]);
+        resetBrain();
+        for (int i = 0; i < nrInputValues; i++) {
+            setInput(i, inputs[b][i]);
+        }
+        for (int u = 0; u < updates; u++) {
+            update();
+        }
+        outputs[b].resize(nrOutputValues);
+        for (int o = 0; o < nrOutputValues; o++) {
+            outputs[b][o] = readOutput(o);
+        }
+    }
+    resetBrain();
+}
+
+void AbstractBrain::checkBatchInputs(const std::vector<double>& values) {
+    if ((int)values.size() != nrInputValues) {
+        std::cout << "in AbstractBrain::updateBatch() : Size of provided input vector (" << values.size() << ") does not match number of brain inputs (" << nrInputValues << ").\nExiting" << std::endl;
+        exit(1);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 // these functions need to be filled in if genomes are being used in this brain
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -81,6 +81,16 @@ public:
 
     virtual void resetBrain();
 
+    // run a batch of independent runs of this brain: for each b the brain is
+    // reset, inputs[b] (one value for each input) is set, the brain is updated
+    // updates times and outputs[b] is set to the brain's outputs. The runs
+    // share no state, so brains can run them all together (see ANNBrain,
+    // RNNBrain and LSTMBrain). The brain is left reset.
+    virtual void updateBatch(const std::vector<std::vector<double>>& inputs,
+        std::vector<std::vector<double>>& outputs, int updates = 1);
+    // exits with an error if values is not one value for each input
+    void checkBatchInputs(const std::vector<double>& values);
+
 
     // I dont this this is being used anywhere....
                 //// setRecordActivity and setRecordFileName provide a standard way to set up brain
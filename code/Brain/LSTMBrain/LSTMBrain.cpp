@@ -16,11 +16,19 @@ std::shared_ptr<ParameterLink<std::string>> LSTMBrain::genomeNamePL =
                                    "namespace used to set parameters for "
                                    "genome used to encode this brain");
 
+std::shared_ptr<ParameterLink<bool>> LSTMBrain::singlePrecisionPL =
+    Parameters::register_parameter(
+        "BRAIN_LSTM-singlePrecision", false,
+        "if true, weights are stored as 32 bit floats (node values are still "
+        "64 bit). This halves the memory used by the weights, but the "
+        "weights read from the genome are rounded.");
+
 LSTMBrain::LSTMBrain(int _nrInNodes, int _nrOutNodes,
                      std::shared_ptr<ParametersTable> PT_)
     : AbstractBrain(_nrInNodes, _nrOutNodes, PT_) {
 
   genomeName = genomeNamePL->get(PT);
+  singlePrecision = singlePrecisionPL->get(PT);
 
   I_ = _nrInNodes;
   O_ = _nrOutNodes;
@@ -62,10 +70,8 @@ std::shared_ptr<AbstractBrain> LSTMBrain::makeBrain(
   newBrain->C.resize(O_);
   newBrain->H.resize(O_);
   newBrain->X.resize(I_ + O_);
-  newBrain->Wf.resize(I_ + O_);
-  newBrain->Wi.resize(I_ + O_);
-  newBrain->Wc.resize(I_ + O_);
-  newBrain->Wo.resize(I_ + O_);
+  newBrain->W = DenseLayer(I_ + O_, 4 * O_, newBrain->singlePrecision);
+  newBrain->gateSums.resize(4 * O_);
   newBrain->bt.resize(O_);
   newBrain->bi.resize(O_);
   newBrain->bC.resize(O_);
@@ -83,15 +89,11 @@ std::shared_ptr<AbstractBrain> LSTMBrain::makeBrain(
     newBrain->bO[i] = genomeHandler->readDouble(-1.0, 1.0);
   }
   for (int i = 0; i < I_ + O_; i++) {
-    newBrain->Wf[i].clear();
-    newBrain->Wi[i].clear();
-    newBrain->Wc[i].clear();
-    newBrain->Wo[i].clear();
     for (int j = 0; j < O_; j++) {
-      newBrain->Wf[i].push_back(genomeHandler->readDouble(-1.0, 1.0));
-      newBrain->Wi[i].push_back(genomeHandler->readDouble(-1.0, 1.0));
-      newBrain->Wc[i].push_back(genomeHandler->readDouble(-1.0, 1.0));
-      newBrain->Wo[i].push_back(genomeHandler->readDouble(-1.0, 1.0));
+      newBrain->W.setWeight(i, j, genomeHandler->readDouble(-1.0, 1.0)); // Wf
+      newBrain->W.setWeight(i, O_ + j, genomeHandler->readDouble(-1.0, 1.0)); // Wi
+      newBrain->W.setWeight(i, 2 * O_ + j, genomeHandler->readDouble(-1.0, 1.0)); // Wc
+      newBrain->W.setWeight(i, 3 * O_ + j, genomeHandler->readDouble(-1.0, 1.0)); // Wo
     }
   }
 
@@ -137,19 +139,22 @@ void LSTMBrain::resetBrain() {
 void LSTMBrain::update() {
   for (int i = 0; i < I_; i++)
     X[i] = inputValues[i];
-  singleLayerUpdate(X, ft, Wf);
+  W.update(X.data(), gateSums.data());
+  for (int o = 0; o < O_; o++) {
+    ft[o] = gateSums[o];
+    it[o] = gateSums[O_ + o];
+    Ct[o] = gateSums[2 * O_ + o];
+    Ot[o] = gateSums[3 * O_ + o];
+  }
   vectorMathElementalPlus(ft, bt, ft);
   vectorMathSigmoid(ft);
 
-  singleLayerUpdate(X, it, Wi);
   vectorMathElementalPlus(it, bi, it);
   vectorMathSigmoid(it);
 
-  singleLayerUpdate(X, Ct, Wc);
   vectorMathElementalPlus(Ct, bC, Ct);
   vectorMathTanh(Ct);
 
-  singleLayerUpdate(X, Ot, Wo);
   vectorMathElementalPlus(Ot, bO, Ot);
   vectorMathSigmoid(Ot);
   vectorMathElementalMultiply(C, ft, C);
@@ -165,6 +170,47 @@ void LSTMBrain::update() {
   }
 }
 
+void LSTMBrain::updateBatch(const std::vector<std::vector<double>> &inputs,
+                            std::vector<std::vector<double>> &outputs,
+                            int updates) {
+  // batchX and batchC hold X and C for every run, one run after another
+  const int batchSize = (int)inputs.size();
+  const int width = I_ + O_;
+  batchX.assign(batchSize * width, 0.0);
+  batchC.assign(batchSize * O_, 0.0);
+  batchGateSums.resize(batchSize * 4 * O_);
+  for (int b = 0; b < batchSize; b++) {
+    checkBatchInputs(inputs[b]);
+    std::copy(inputs[b].begin(), inputs[b].end(), batchX.begin() + b * width);
+  }
+
+  for (int u = 0; u < updates; u++) {
+    W.updateBatch(batchX.data(), batchGateSums.data(), batchSize);
+    // the same steps as update, one value at a time
+    for (int b = 0; b < batchSize; b++) {
+      const double *sums = batchGateSums.data() + b * 4 * O_;
+      for (int o = 0; o < O_; o++) {
+        const int k = b * O_ + o;
+        double f = fastSigmoid(sums[o] + bt[o]);
+        double i = fastSigmoid(sums[O_ + o] + bi[o]);
+        double c = tanh(sums[2 * O_ + o] + bC[o]);
+        double out = fastSigmoid(sums[3 * O_ + o] + bO[o]);
+        batchC[k] = batchC[k] * f;
+        c = i * c;
+        batchC[k] = batchC[k] + c;
+        batchX[b * width + I_ + o] = out * tanh(batchC[k]);
+      }
+    }
+  }
+
+  outputs.resize(batchSize);
+  for (int b = 0; b < batchSize; b++) {
+    auto first = batchX.begin() + b * width + I_;
+    outputs[b].assign(first, first + O_);
+  }
+  resetBrain();
+}
+
 void inline LSTMBrain::resetOutputs() {
   for (int o = 0; o < O_; o++) {
     H[o] = 0.0;
@@ -275,19 +321,6 @@ valueMax);
    */
 }
 
-void LSTMBrain::singleLayerUpdate(std::vector<double> &IN,
-                                  std::vector<double> &OUT,
-                                  std::vector<std::vector<double>> &W) {
-  int I = (int)IN.size();
-  int O = (int)OUT.size();
-  for (int o = 0; o < O; o++)
-    OUT[o] = 0.0;
-  for (int i = 0; i < I; i++)
-    for (int o = 0; o < O; o++) {
-      OUT[o] += IN[i] * W[i][o];
-    }
-}
-
 void LSTMBrain::vectorMathSigmoid(std::vector<double> &V) {
   for (auto &&v : V)
     v = fastSigmoid(v);
@@ -331,10 +364,8 @@ LSTMBrain::makeCopy(std::shared_ptr<ParametersTable> PT_) {
   newBrain->I_ = I_;
   newBrain->O_ = O_;
 
-  newBrain->Wf = Wf;
-  newBrain->Wi = Wi;
-  newBrain->Wc = Wc;
-  newBrain->Wo = Wo;
+  newBrain->W = W;
+  newBrain->gateSums = gateSums;
   newBrain->ft = ft;
   newBrain->it = it;
   newBrain->Ct = Ct;
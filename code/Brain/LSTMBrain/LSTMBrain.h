@@ -22,17 +22,26 @@
 
 #include "../AbstractBrain.h"
 
+#include "../../Utilities/DenseLayer.h"
+
 class LSTMBrain : public AbstractBrain {
 public:
   static std::shared_ptr<ParameterLink<std::string>> genomeNamePL;
+  static std::shared_ptr<ParameterLink<bool>> singlePrecisionPL;
 
   std::string genomeName;
+  bool singlePrecision;
 
-  std::vector<std::vector<double>> Wf, Wi, Wc, Wo;
+  // the weights of the four gates (Wf, Wi, Wc and Wo) side by side: output
+  // g * O_ + o of W is output o of gate g (0:f, 1:i, 2:c, 3:o)
+  DenseLayer W;
+  std::vector<double> gateSums;
   std::vector<double> ft, it, Ct, Ot, dt;
   std::vector<double> bt, bi, bC, bO;
   int I_, O_;
   std::vector<double> C, X, H;
+  // X, C and gateSums for each run in updateBatch
+  std::vector<double> batchX, batchC, batchGateSums;
 
   LSTMBrain() = delete;
 
@@ -42,6 +51,9 @@ public:
   virtual ~LSTMBrain() = default;
 
   virtual void update() override;
+  virtual void updateBatch(const std::vector<std::vector<double>> &inputs,
+                           std::vector<std::vector<double>> &outputs,
+                           int updates = 1) override;
 
   virtual std::shared_ptr<AbstractBrain>
   makeBrain(std::unordered_map<std::string, std::shared_ptr<AbstractGenome>>
@@ -59,8 +71,6 @@ public:
           &_genomes) override;
 
   double fastSigmoid(double value) { return value / (1.0 + fabs(value)); }
-  void singleLayerUpdate(std::vector<double> &IN, std::vector<double> &out,
-                         std::vector<std::vector<double>> &W);
   void vectorMathSigmoid(std::vector<double> &V);
   void vectorMathTanh(std::vector<double> &V);
   void vectorMathElementalPlus(std::vector<double> &A, std::vector<double> &B,
@@ -0,0 +1,134 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include "CompiledGates.h"
+
+#include <algorithm>
+#include <typeinfo>
+
+#include "../../Utilities/Random.h"
+#include "Gate/DeterministicGate.h"
+#include "Gate/ProbabilisticGate.h"
+
+void CompiledGates::clear() {
+  operations.clear();
+  inputAddresses.clear();
+  outputAddresses.clear();
+  outputValues.clear();
+  probabilities.clear();
+}
+
+bool CompiledGates::compile(const std::vector<std::shared_ptr<AbstractGate>> &gates,
+                            int nrNodes) {
+  clear();
+  nodeBits.assign((nrNodes + 63) / 64, 0);
+  for (auto &gate : gates) {
+    // the row index is an int and the outputs of a row are 32 bits
+    if (gate->inputs.size() > 30 || gate->outputs.size() > 30) {
+      clear();
+      return false;
+    }
+    Operation operation;
+    operation.inputCount = gate->inputs.size();
+    operation.outputCount = gate->outputs.size();
+    operation.valuesStart = outputValues.size();
+    operation.probabilitiesStart = probabilities.size();
+    inputAddresses.insert(inputAddresses.end(), gate->inputs.begin(),
+                          gate->inputs.end());
+    outputAddresses.insert(outputAddresses.end(), gate->outputs.begin(),
+                           gate->outputs.end());
+
+    // (typeid rather than dynamic_cast, so that gates derived from these are
+    // not compiled with the wrong update)
+    if (typeid(*gate) == typeid(DeterministicGate)) {
+      operation.kind = DETERMINISTIC;
+      for (auto &row : std::static_pointer_cast<DeterministicGate>(gate)->table) {
+        uint32_t values = 0;
+        for (int i = 0; i < operation.outputCount; i++) {
+          if (row[i] != 0 && row[i] != 1) {
+            clear();
+            return false;
+          }
+          values |= static_cast<uint32_t>(row[i]) << i;
+        }
+        outputValues.push_back(values);
+      }
+    } else if (typeid(*gate) == typeid(ProbabilisticGate)) {
+      operation.kind = PROBABILISTIC;
+      for (auto &row : std::static_pointer_cast<ProbabilisticGate>(gate)->table) {
+        probabilities.insert(probabilities.end(), row.begin(), row.end());
+      }
+      // the last bit of the column goes to the first output
+      for (int column = 0; column < (1 << operation.outputCount); column++) {
+        uint32_t values = 0;
+        for (int i = 0; i < operation.outputCount; i++) {
+          values |= static_cast<uint32_t>((column >> (operation.outputCount - 1 - i)) & 1) << i;
+        }
+        outputValues.push_back(values);
+      }
+    } else {
+      clear();
+      return false;
+    }
+    operations.push_back(operation);
+  }
+  return true;
+}
+
+void CompiledGates::update(const std::vector<double> &nodes,
+                           std::vector<double> &nextNodes) {
+  // pack the nodes 64 at a time (Bit(node) is node > 0.0)
+  const size_t nodeCount = nodes.size();
+  for (size_t w = 0; w < nodeBits.size(); w++) {
+    size_t first = w * 64;
+    size_t count = std::min<size_t>(64, nodeCount - first);
+    uint64_t word = 0;
+    for (size_t n = 0; n < count; n++) {
+      word |= static_cast<uint64_t>(nodes[first + n] > 0.0) << n;
+    }
+    nodeBits[w] = word;
+  }
+
+  const uint64_t *bits = nodeBits.data();
+  const int *in = inputAddresses.data();
+  const int *out = outputAddresses.data();
+  double *next = nextNodes.data();
+  for (const Operation &operation : operations) {
+    // the first input is the lowest bit of the row (this is vectorToBitToInt
+    // with reverseOrder)
+    int row = 0;
+    for (int k = 0; k < operation.inputCount; k++) {
+      row |= static_cast<int>((bits[in[k] >> 6] >> (in[k] & 63)) & 1) << k;
+    }
+
+    uint32_t values;
+    if (operation.kind == DETERMINISTIC) {
+      values = outputValues[operation.valuesStart + row];
+    } else { // PROBABILISTIC
+      int columns = 1 << operation.outputCount;
+      const double *probability =
+          probabilities.data() + operation.probabilitiesStart + row * columns;
+      int outputColumn = 0;
+      double r = Random::getDouble(1); // r will determine with set of outputs will be chosen
+      while (outputColumn + 1 < columns && r > probability[outputColumn]) {
+        r -= probability[outputColumn];
+        outputColumn++;
+      }
+      values = outputValues[operation.valuesStart + outputColumn];
+    }
+
+    // every output is added to (0 or 1), as the gates do
+    for (int i = 0; i < operation.outputCount; i++) {
+      next[out[i]] += static_cast<double>((values >> i) & 1);
+    }
+    in += operation.inputCount;
+    out += operation.outputCount;
+  }
+}
@@ -0,0 +1,73 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+// CompiledGates runs a list of Deterministic and Probabilistic gates without
+// calling each gate. The gates are flattened into a program: one small record
+// per gate, and flat arrays for all input addresses, all output addresses and
+// all tables. The node values are packed into bits once per update and each
+// gate reads its inputs from there. Each row of a deterministic table (and
+// each column of a probabilistic table) is stored as one word with a bit for
+// each output, so running every gate is one loop with no virtual calls, no
+// vector<vector<>> tables and no bounds checks.
+// update gives exactly the same nextNodes (and uses the same random numbers,
+// in the same order) as calling update on each gate.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Gate/AbstractGate.h"
+
+class CompiledGates {
+public:
+  // build the program for gates. returns false (and the program is empty) if
+  // any gate is not a Deterministic or Probabilistic gate, or a gate can not
+  // be compiled (i.e. a deterministic table value other than 0 or 1)
+  bool compile(const std::vector<std::shared_ptr<AbstractGate>> &gates,
+               int nrNodes);
+
+  // number of gates in the program
+  size_t size() const { return operations.size(); }
+
+  // the same as calling gate->update(nodes, nextNodes) for each gate in order
+  void update(const std::vector<double> &nodes, std::vector<double> &nextNodes);
+
+private:
+  enum Kind : unsigned char { DETERMINISTIC, PROBABILISTIC };
+
+  // one per gate
+  struct Operation {
+    Kind kind;
+    unsigned char inputCount;
+    unsigned char outputCount;
+    // DETERMINISTIC: first row in outputValues
+    // PROBABILISTIC: first column in outputValues
+    int valuesStart;
+    // PROBABILISTIC: first value in probabilities
+    int probabilitiesStart;
+  };
+
+  void clear();
+
+  std::vector<Operation> operations;
+  // the inputs (and outputs) of every gate, one gate after another
+  std::vector<int> inputAddresses;
+  std::vector<int> outputAddresses;
+  // for each table row (or column) the values of the outputs, bit i is
+  // output i
+  std::vector<uint32_t> outputValues;
+  // probabilistic tables, 2^outputs values for each input pattern
+  std::vector<double> probabilities;
+
+  // node values as bits (node n is bit n % 64 of nodeBits[n / 64])
+  std::vector<uint64_t> nodeBits;
+};
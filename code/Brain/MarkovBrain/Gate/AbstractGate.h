@@ -22,6 +22,7 @@
 #include <Global.h>
 
 #include <Utilities/Parameters.h>
+#include <Utilities/Pool.h>
 #include <Utilities/Random.h>
 
 class AbstractGate {
@@ -42,6 +43,11 @@ public:
 	virtual ~AbstractGate() = default;
 
 	virtual std::shared_ptr<AbstractGate> makeCopy(std::shared_ptr<ParametersTable> _PT = nullptr);
+	// true if makeCopy copies everything read from the genome, so that a copy
+	// of a gate can stand in for reading the gate from the genome again
+	virtual bool copiesExactly() {
+		return false;
+	}
 	std::vector<int> inputs;
 	std::vector<int> outputs;
 
@@ -125,7 +125,7 @@ std::shared_ptr<AbstractGate> AnnGate::makeCopy(std::shared_ptr<ParametersTable>
 	if (_PT == nullptr) {
 		_PT = PT;
 	}
-	auto newGate = std::make_shared<AnnGate>(_PT);
+	auto newGate = Pool::make<AnnGate>(_PT);
 	newGate->inputs = inputs;
 	newGate->outputs = outputs;
 	newGate->weights = weights;
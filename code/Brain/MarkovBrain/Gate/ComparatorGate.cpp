@@ -117,7 +117,7 @@ std::shared_ptr<AbstractGate> ComparatorGate::makeCopy(std::shared_ptr<Parameter
 	if (_PT == nullptr) {
 		_PT = PT;
 	}
-	auto newGate = std::make_shared<ComparatorGate>(_PT);
+	auto newGate = Pool::make<ComparatorGate>(_PT);
 	newGate->action = action;
 	newGate->initalValue = initalValue;
 	newGate->value = value;
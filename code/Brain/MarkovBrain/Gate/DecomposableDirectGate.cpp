@@ -44,7 +44,7 @@ std::shared_ptr<AbstractGate> DecomposableDirectGate::makeCopy(std::shared_ptr<P
 	if (_PT == nullptr) {
 		_PT = PT;
 	}
-	auto newGate = std::make_shared<DecomposableDirectGate>(_PT);
+	auto newGate = Pool::make<DecomposableDirectGate>(_PT);
 	newGate->factorsList = factorsList;
 	newGate->ID = ID;
 	newGate->inputs = inputs;
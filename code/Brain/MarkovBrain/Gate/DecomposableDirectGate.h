@@ -30,6 +30,9 @@ public:
 		return "DecomposableDirect";
 	}
 	virtual std::shared_ptr<AbstractGate> makeCopy(std::shared_ptr<ParametersTable> _PT = nullptr) override;
+	virtual bool copiesExactly() override {
+		return true;
+	}
   virtual std::string getTPMdescription() {
     std::string S="";
     S+="\"ins\":[";
@@ -297,7 +297,7 @@ std::shared_ptr<AbstractGate> DecomposableFeedbackGate::makeCopy(std::shared_ptr
 	if (_PT == nullptr) {
 		_PT = PT;
 	}
-	auto newGate = std::make_shared<DecomposableFeedbackGate>(_PT);
+	auto newGate = Pool::make<DecomposableFeedbackGate>(_PT);
 	newGate->table = originalTable; // non-Lamarkian
     originalTable = originalTable;
     feedbackON = feedbackON;
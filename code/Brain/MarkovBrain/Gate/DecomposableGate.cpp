@@ -62,7 +62,7 @@ std::shared_ptr<AbstractGate> DecomposableGate::makeCopy(std::shared_ptr<Paramet
 	if (_PT == nullptr) {
 		_PT = PT;
 	}
-	auto newGate = std::make_shared<DecomposableGate>(_PT);
+	auto newGate = Pool::make<DecomposableGate>(_PT);
 	newGate->table = table;
 	newGate->ID = ID;
 	newGate->inputs = inputs;
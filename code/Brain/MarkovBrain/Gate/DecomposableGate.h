@@ -31,6 +31,9 @@ public:
 		return "Decomposable";
 	}
 	virtual std::shared_ptr<AbstractGate> makeCopy(std::shared_ptr<ParametersTable> _PT = nullptr) override;
+	virtual bool copiesExactly() override {
+		return true;
+	}
         virtual std::string getTPMdescription() override{
           std::string S="";
           S+="\"ins\":[";
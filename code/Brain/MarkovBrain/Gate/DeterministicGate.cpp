@@ -45,7 +45,7 @@ std::shared_ptr<AbstractGate> DeterministicGate::makeCopy(std::shared_ptr<Parame
 	if (_PT == nullptr) {
 		_PT = PT; 
 	}
-	auto newGate = std::make_shared<DeterministicGate>(_PT);
+	auto newGate = Pool::make<DeterministicGate>(_PT);
 	newGate->table = table; 
 	newGate->ID = ID;	
 	newGate->inputs = inputs;
@@ -27,6 +27,9 @@ public:
 	virtual ~DeterministicGate() = default;
 	virtual void update(std::vector<double> & states, std::vector<double> & nextStates) override;
 	virtual std::shared_ptr<AbstractGate> makeCopy(std::shared_ptr<ParametersTable> _PT = nullptr) override;
+	virtual bool copiesExactly() override {
+		return true;
+	}
 	//void setupForBits(int* Ins, int nrOfIns, int Out, int logic);
 	virtual std::string gateType() override{
 		return "Deterministic";
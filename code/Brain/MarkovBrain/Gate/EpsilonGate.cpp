@@ -54,7 +54,7 @@ std::shared_ptr<AbstractGate> EpsilonGate::makeCopy(std::shared_ptr<ParametersTa
 	if (_PT == nullptr) {
 		_PT = PT;
 	}
-	auto newGate = std::make_shared<EpsilonGate>(_PT);
+	auto newGate = Pool::make<EpsilonGate>(_PT);
 	newGate->table = table;
 	newGate->ID = ID;
 	newGate->inputs = inputs;
@@ -32,5 +32,8 @@ public:
 		return "Epsilon";
 	}
 	virtual std::shared_ptr<AbstractGate> makeCopy(std::shared_ptr<ParametersTable> _PT = nullptr) override;
+	virtual bool copiesExactly() override {
+		return true;
+	}
 
 };
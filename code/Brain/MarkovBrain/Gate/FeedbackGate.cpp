@@ -249,7 +249,7 @@ std::shared_ptr<AbstractGate> FeedbackGate::makeCopy(std::shared_ptr<ParametersT
 	if (_PT == nullptr) {
 		_PT = PT;
 	}
-	auto newGate = std::make_shared<FeedbackGate>(_PT);
+	auto newGate = Pool::make<FeedbackGate>(_PT);
 	newGate->table = originalTable; // non-Lamarkian
     originalTable = originalTable;
     feedbackON = feedbackON;
@@ -113,7 +113,7 @@ std::shared_ptr<AbstractGate> GPGate::makeCopy(std::shared_ptr<ParametersTable>
 	if (_PT == nullptr) {
 		_PT = PT;
 	}
-	auto newGate = std::make_shared<GPGate>(_PT);
+	auto newGate = Pool::make<GPGate>(_PT);
 	newGate->ID = ID;
 	newGate->inputs = inputs;
 	newGate->outputs = outputs;
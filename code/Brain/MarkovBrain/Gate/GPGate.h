@@ -39,6 +39,9 @@ class GPGate : public AbstractGate {
 		return "GeneticPrograming";
 	}
 	virtual std::shared_ptr<AbstractGate> makeCopy(std::shared_ptr<ParametersTable> _PT = nullptr) override;
+	virtual bool copiesExactly() override {
+		return true;
+	}
 
 };
 
@@ -192,7 +192,7 @@ std::shared_ptr<AbstractGate> IzhikevichGate::makeCopy(std::shared_ptr<Parameter
 	if (_PT == nullptr) {
 		_PT = PT;
 	}
-	auto newGate = std::make_shared<IzhikevichGate>(_PT);
+	auto newGate = Pool::make<IzhikevichGate>(_PT);
 	newGate->ID = ID;
 	newGate->inputs = inputs;
 	newGate->outputs = outputs;
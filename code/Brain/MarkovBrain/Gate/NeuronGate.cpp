@@ -226,7 +226,7 @@ std::shared_ptr<AbstractGate> NeuronGate::makeCopy(std::shared_ptr<ParametersTab
 	if (_PT == nullptr) {
 		_PT = PT;
 	}
-	auto newGate = std::make_shared<NeuronGate>(_PT);
+	auto newGate = Pool::make<NeuronGate>(_PT);
 	newGate->ID = ID;
 	newGate->inputs = inputs;
 	newGate->outputs = outputs;
@@ -28,7 +28,7 @@ std::shared_ptr<AbstractGate> PassThroughGate::makeCopy(std::shared_ptr<Paramete
 	if (_PT == nullptr) {
 		_PT = PT;
 	}
-	auto newGate = std::make_shared<PassThroughGate>(_PT);
+	auto newGate = Pool::make<PassThroughGate>(_PT);
 	newGate->ID = ID;
 	newGate->inputs = inputs;
 	newGate->outputs = outputs;
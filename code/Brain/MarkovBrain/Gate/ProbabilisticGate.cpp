@@ -62,7 +62,7 @@ std::shared_ptr<AbstractGate> ProbabilisticGate::makeCopy(std::shared_ptr<Parame
 	if (_PT == nullptr) {
 		_PT = PT;
 	}
-	auto newGate = std::make_shared<ProbabilisticGate>(_PT);
+	auto newGate = Pool::make<ProbabilisticGate>(_PT);
 	newGate->table = table;
 	newGate->ID = ID;
 	newGate->inputs = inputs;
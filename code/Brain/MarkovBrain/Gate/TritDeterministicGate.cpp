@@ -32,7 +32,7 @@ std::shared_ptr<AbstractGate> TritDeterministicGate::makeCopy(std::shared_ptr<Pa
 	if (_PT == nullptr) {
 		_PT = PT;
 	}
-	auto newGate = std::make_shared<TritDeterministicGate>(_PT);
+	auto newGate = Pool::make<TritDeterministicGate>(_PT);
 	newGate->table = table;
 	newGate->ID = ID;
 	newGate->inputs = inputs;
@@ -36,6 +36,9 @@ class TritDeterministicGate : public AbstractGate {
 	}
 
 	virtual std::shared_ptr<AbstractGate> makeCopy(std::shared_ptr<ParametersTable> _PT = nullptr) override;
+	virtual bool copiesExactly() override {
+		return true;
+	}
 
 	//double voidOutput;
 };
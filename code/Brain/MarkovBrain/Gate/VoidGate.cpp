@@ -38,7 +38,7 @@ std::shared_ptr<AbstractGate> VoidGate::makeCopy(std::shared_ptr<ParametersTable
 	if (_PT == nullptr) {
 		_PT = PT;
 	}
-	auto newGate = std::make_shared<VoidGate>(_PT);
+	auto newGate = Pool::make<VoidGate>(_PT);
 	newGate->table = table;
 	newGate->ID = ID;
 	newGate->inputs = inputs;
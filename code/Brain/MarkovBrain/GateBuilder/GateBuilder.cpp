@@ -10,6 +10,7 @@
 
 #include "GateBuilder.h"
 
+#include <algorithm>
 #include <cmath>
 
 std::shared_ptr<ParameterLink<bool>> Gate_Builder::usingProbGatePL = Parameters::register_parameter("BRAIN_MARKOV_GATES_PROBABILISTIC-allow", false, "set to true to enable probabilistic gates");
@@ -65,13 +66,14 @@ std::shared_ptr<ParameterLink<int>> Gate_Builder::bitsPerCodonPL = Parameters::r
 
 // Gets "howMany" addresses, advances the genome_index buy "howManyMax" addresses and updates "codingRegions" with the addresses being used.
 void Gate_Builder::getSomeBrainAddresses(const int& howMany, const int& howManyMax, std::vector<int>& addresses, std::shared_ptr<AbstractGenome::Handler> genomeHandler, int code, int gateID, std::shared_ptr<ParametersTable> _PT) {
-	int i;
-	for (i = 0; i < howMany; i++) {  // for the number of addresses we need
-		addresses[i] = genomeHandler->readInt(0, (1 << bitsPerBrainAddressPL->get(_PT)) - 1, code, gateID);  // get an address
-	}
-	while (i < howManyMax) { // leave room in the genome in case this gate gets more IO later
-		genomeHandler->readInt(0, (1 << bitsPerBrainAddressPL->get(_PT)) - 1);
-		i++;
+	int addressMax = (1 << bitsPerBrainAddressPL->get(_PT)) - 1;
+	genomeHandler->readInts(addresses.data(), howMany, 0, addressMax, code, gateID);  // get the addresses
+	// leave room in the genome in case this gate gets more IO later (skipped
+	// addresses are read into a small buffer, so building a gate does not
+	// allocate for them)
+	int unused[16];
+	for (int skip = howManyMax - howMany; skip > 0; skip -= 16) {
+		genomeHandler->readInts(unused, std::min(skip, 16), 0, addressMax);
 	}
 }
 
@@ -191,7 +193,7 @@ void Gate_Builder::setupGates() {
 				std::shared_ptr<ProbabilisticGate> nullObj = nullptr;
 				return nullObj;
 			}
-			return std::make_shared<ProbabilisticGate>(addresses,rawTable,gateID, _PT);
+			return Pool::make<ProbabilisticGate>(addresses,rawTable,gateID, _PT);
 		});
 	}
 	if ( usingDecoGatePL->get(PT)) {
@@ -329,7 +331,7 @@ void Gate_Builder::setupGates() {
 				std::shared_ptr<DecomposableGate> nullObj = nullptr;
 				return nullObj;
 			}
-			return std::make_shared<DecomposableGate>(addresses,rawTable,gateID,factorsListHandover, _PT);
+			return Pool::make<DecomposableGate>(addresses,rawTable,gateID,factorsListHandover, _PT);
 		});
 	}
         if ( usingDecoDirectGatePL->get(PT)) {
@@ -375,7 +377,7 @@ void Gate_Builder::setupGates() {
 				std::shared_ptr<DecomposableDirectGate> nullObj = nullptr;
 				return nullObj;
 			}
-			return std::make_shared<DecomposableDirectGate>(addresses,factorsList,gateID, _PT);
+			return Pool::make<DecomposableDirectGate>(addresses,factorsList,gateID, _PT);
 		});
 	}
 	if (usingDetGatePL->get(PT)) {
@@ -396,7 +398,7 @@ void Gate_Builder::setupGates() {
 				std::shared_ptr<DeterministicGate> nullObj = nullptr;
 				return nullObj;
 			}
-			return std::make_shared<DeterministicGate>(addresses,table,gateID, _PT);
+			return Pool::make<DeterministicGate>(addresses,table,gateID, _PT);
 		});
 	}
 	if (usingEpsiGatePL->get(PT)) {
@@ -429,7 +431,7 @@ void Gate_Builder::setupGates() {
 				epsilon = cleanGenomeHandler->readDouble(0, 1, AbstractGate::DATA_CODE, gateID);
 			}
 
-			return std::make_shared<EpsilonGate>(addresses,table,gateID, epsilon, _PT);
+			return Pool::make<EpsilonGate>(addresses,table,gateID, epsilon, _PT);
 		});
 	}
 	if (usingVoidGatePL->get(PT)) {
@@ -462,7 +464,7 @@ void Gate_Builder::setupGates() {
 				epsilon = cleanGenomeHandler->readDouble(0, 1, AbstractGate::DATA_CODE, gateID);
 			}
 
-			return std::make_shared<VoidGate>(addresses,table,gateID, epsilon, _PT);
+			return Pool::make<VoidGate>(addresses,table,gateID, epsilon, _PT);
 		});
 	}
 	if (usingGPGatePL->get(PT)) {
@@ -489,7 +491,7 @@ void Gate_Builder::setupGates() {
 				std::shared_ptr<GPGate> nullObj = nullptr;;
 				return nullObj;
 			}
-			return std::make_shared<GPGate>(addresses,operation, constValues, gateID, _PT);
+			return Pool::make<GPGate>(addresses,operation, constValues, gateID, _PT);
 		});
 	}
 	if (usingTritDeterministicGatePL->get(PT)) {
@@ -511,7 +513,7 @@ void Gate_Builder::setupGates() {
 				std::shared_ptr<TritDeterministicGate> nullObj = nullptr;;
 				return nullObj;
 			}
-			return std::make_shared<TritDeterministicGate>(addresses,table,gateID, _PT);
+			return Pool::make<TritDeterministicGate>(addresses,table,gateID, _PT);
 		});
 	}
 	if (usingNeuronGatePL->get(PT)) {
@@ -580,7 +582,7 @@ void Gate_Builder::setupGates() {
 				std::shared_ptr<NeuronGate> nullObj = nullptr;;
 				return nullObj;
 			}
-			return std::make_shared<NeuronGate>(inputs, output, dischargeBehavior, thresholdValue, thresholdActivates, decayRate, deliveryCharge, deliveryError, ThresholdFromNode, DeliveryChargeFromNode, gateID, _PT);
+			return Pool::make<NeuronGate>(inputs, output, dischargeBehavior, thresholdValue, thresholdActivates, decayRate, deliveryCharge, deliveryError, ThresholdFromNode, DeliveryChargeFromNode, gateID, _PT);
 		});
 	}
 	if (usingFeedbackGatePL->get(PT)) {
@@ -613,13 +615,13 @@ void Gate_Builder::setupGates() {
 				return nullObj;
 			}
             
-			return std::make_shared<FeedbackGate>(addresses,rawTable,posFBNode,negFBNode,nrPos,nrNeg,posLevelOfFB,negLevelOfFB,gateID, _PT);
+			return Pool::make<FeedbackGate>(addresses,rawTable,posFBNode,negFBNode,nrPos,nrNeg,posLevelOfFB,negLevelOfFB,gateID, _PT);
             //std::pair<std::vector<int>,vector<int>> thepair = std::make_pair(std::vector<int>(),std::vector<int>());
             //std::vector<std::vector<int>> dvec;
             //unsigned int uint = 0;
             //unsigned char uchar = '\0';
             //std::vector<double> vdouble;
-			//return std::make_shared<FeedbackGate>(thepair,dvec,uint,uint,uchar,uchar,vdouble,vdouble,gateID, _PT);
+			//return Pool::make<FeedbackGate>(thepair,dvec,uint,uint,uchar,uchar,vdouble,vdouble,gateID, _PT);
 		});
 	}
 	if (usingDecomposableFeedbackGatePL->get(PT)) {
@@ -673,7 +675,7 @@ void Gate_Builder::setupGates() {
 				std::shared_ptr<DecomposableFeedbackGate> nullObj = nullptr;
 				return nullObj;
 			}
-			return std::make_shared<DecomposableFeedbackGate>(addresses, rawTable, factorsList, posFBNode, negFBNode, nrPos, nrNeg, posLevelOfFB, negLevelOfFB, gateID, _PT);
+			return Pool::make<DecomposableFeedbackGate>(addresses, rawTable, factorsList, posFBNode, negFBNode, nrPos, nrNeg, posLevelOfFB, negLevelOfFB, gateID, _PT);
 		});
 	}
 
@@ -706,7 +708,7 @@ void Gate_Builder::setupGates() {
 				return nullObj;
 			}
 			//std::cout << "reading gate: " << programAddress << " " << valueAddress << " " << outputAddress << " " << action << " " << initalValue << " " << gateID << std::endl;
-			return std::make_shared<ComparatorGate>(programAddress, valueAddress, outputAddress, action, mode, initalValue, gateID, _PT);
+			return Pool::make<ComparatorGate>(programAddress, valueAddress, outputAddress, action, mode, initalValue, gateID, _PT);
 		});
 	}
 
@@ -726,7 +728,7 @@ void Gate_Builder::setupGates() {
 				std::shared_ptr<PassThroughGate> nullObj = nullptr;
 				return nullObj;
 			}
-			return std::make_shared<PassThroughGate>(inAddress, outputAddress, gateID, _PT);
+			return Pool::make<PassThroughGate>(inAddress, outputAddress, gateID, _PT);
 		});
 	}
 
@@ -952,7 +954,7 @@ void Gate_Builder::setupGates() {
 				return nullObj;
 			}
 
-			return std::make_shared<IzhikevichGate>(inAddresses, weights, outputAddress, initU, initV, A, B, C, D, threshold, V2_scale, V_scale, V_const, gateID, _PT);
+			return Pool::make<IzhikevichGate>(inAddresses, weights, outputAddress, initU, initV, A, B, C, D, threshold, V2_scale, V_scale, V_const, gateID, _PT);
 			});
 	}
 
@@ -1016,7 +1018,7 @@ void Gate_Builder::setupGates() {
 			convertCSVListToVector(AnnGate::biasRangePL->get(_PT), biasRange);
 			double initalValue = genomeHandler->readDouble(biasRange[0], biasRange[1]);
 
-			return std::make_shared<AnnGate>(inputs, output, weights, initalValue, gateID, _PT);
+			return Pool::make<AnnGate>(inputs, output, weights, initalValue, gateID, _PT);
 			});
 	}
 }
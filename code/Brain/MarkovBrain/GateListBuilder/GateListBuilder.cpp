@@ -10,7 +10,28 @@
 
 #include "GateListBuilder.h"
 
-std::vector<std::shared_ptr<AbstractGate>> ClassicGateListBuilder::buildGateListAndGetAllValues(std::shared_ptr<AbstractGenome> genome, int nrOfBrainStates, int maxValue, std::vector<int> &genomeHeadValues, int genomeHeadValuesCount, std::vector<std::vector<int>> &genomePerGateValues, int genomePerGateValuesCount, std::shared_ptr<ParametersTable> gatePT) {
+#include <algorithm>
+
+std::shared_ptr<ParameterLink<bool>> ClassicGateListBuilder::useCodonIndexPL =
+	Parameters::register_parameter("BRAIN_MARKOV_ADVANCED-useCodonIndex", true,
+		"if true, gates are found using a start codon index kept by the genome (if the genome keeps one), and "
+		"gates in parts of the genome which did not change since the parent's brain was built are copied "
+		"from the parent's brain (faster, with the same results)");
+
+ClassicGateListBuilder::ClassicGateListBuilder(std::shared_ptr<ParametersTable> _PT) : AbstractGateListBuilder(_PT) {
+	auto codons = std::make_shared<StartCodons>();
+	codons->codonMax = (1 << Gate_Builder::bitsPerCodonPL->get(PT)) - 1;
+	codons->second.assign(codons->codonMax + 1, -1);
+	for (int codon = 0; codon <= codons->codonMax; codon++) {
+		if (gateBuilder.gateStartCodes[codon].size() != 0) {
+			codons->second[codon] = gateBuilder.gateStartCodes[codon][1];
+		}
+	}
+	startCodons = codons;
+}
+
+std::vector<std::shared_ptr<AbstractGate>> ClassicGateListBuilder::buildGateListAndGetAllValues(std::shared_ptr<AbstractGenome> genome, int nrOfBrainStates, int maxValue, std::vector<int> &genomeHeadValues, int genomeHeadValuesCount, std::vector<std::vector<int>> &genomePerGateValues, int genomePerGateValuesCount, std::shared_ptr<ParametersTable> gatePT,
+	std::shared_ptr<const GateListDecoding> parentDecoding, std::shared_ptr<const GateListDecoding> *decoding) {
 
 	std::vector<std::shared_ptr<AbstractGate>> gates;
 	int codonMax = (1 << Gate_Builder::bitsPerCodonPL->get(PT)) - 1;
@@ -34,6 +55,19 @@ std::vector<std::shared_ptr<AbstractGate>> ClassicGateListBuilder::buildGateList
 			i++;
 		}
 
+		// if the genome has a start codon index, only read the gates it lists.
+		// (if codons are more than one site and fit in a site value, reading
+		// every site would read codons a whole codon apart rather than a site
+		// apart, which the index does not do)
+		std::shared_ptr<const CodonIndex> codonIndex = nullptr;
+		if (useCodonIndexPL->get(PT)) {
+			codonIndex = genome->getCodonIndex(startCodons);
+		}
+		if (codonIndex != nullptr && (mustReadAll || codonIndex->codonWidth == 1)) {
+			buildGateListFromIndex(genome, codonIndex, gateGenomeHandler, maxValue, gates, genomePerGateValues, genomePerGateValuesCount, gatePT, parentDecoding, decoding);
+			return gates;
+		}
+
 		int gateCount = 0;
 
 		int testSite1Value, testSite2Value;
@@ -89,3 +123,93 @@ std::vector<std::shared_ptr<AbstractGate>> ClassicGateListBuilder::buildGateList
 	return gates;
 }
 
+void ClassicGateListBuilder::buildGateListFromIndex(std::shared_ptr<AbstractGenome> genome, std::shared_ptr<const CodonIndex> codonIndex,
+	std::shared_ptr<AbstractGenome::Handler> gateGenomeHandler, int maxValue, std::vector<std::shared_ptr<AbstractGate>> &gates,
+	std::vector<std::vector<int>> &genomePerGateValues, int genomePerGateValuesCount, std::shared_ptr<ParametersTable> gatePT,
+	std::shared_ptr<const GateListDecoding> parentDecoding, std::shared_ptr<const GateListDecoding> *decoding) {
+
+	int codonMax = startCodons->codonMax;
+	// the parent's gates can only be copied if they were read in the same way
+	bool copyParentGates = parentDecoding != nullptr && parentDecoding->codons == startCodons && parentDecoding->gatePT == gatePT &&
+		parentDecoding->maxValue == maxValue && parentDecoding->perGateValuesCount == genomePerGateValuesCount;
+
+	std::shared_ptr<GateListDecoding> newDecoding = nullptr;
+	if (decoding != nullptr) {
+		newDecoding = std::make_shared<GateListDecoding>();
+		newDecoding->codons = startCodons;
+		newDecoding->sitesID = genome->getSitesID();
+		newDecoding->gatePT = gatePT;
+		newDecoding->maxValue = maxValue;
+		newDecoding->perGateValuesCount = genomePerGateValuesCount;
+	}
+
+	// gateGenomeHandler is moved to each start codon with copyTo, which (like
+	// the scan) leaves EOC set once any gate has read past the end of the genome
+	auto startHandler = genome->newHandler(genome, true);
+	AbstractGenome::Handler::ReadSpan span;
+	for (int gateCount = 0; gateCount < (int)codonIndex->starts.size(); gateCount++) {
+		int start = codonIndex->starts[gateCount];
+
+		// find the parent's gate read from these same (unchanged) sites
+		const GateListDecoding::Gate *parentGate = nullptr;
+		if (copyParentGates && !gateGenomeHandler->atEOC()) {
+			int parentStart = genome->parentSiteIndex(parentDecoding->sitesID, start, 1);
+			if (parentStart >= 0) {
+				auto found = std::lower_bound(parentDecoding->gates.begin(), parentDecoding->gates.end(), parentStart,
+					[](const GateListDecoding::Gate &gate, int site) { return gate.start < site; });
+				if (found != parentDecoding->gates.end() && found->start == parentStart) {
+					int shift = start - parentStart;
+					if (genome->parentSiteIndex(parentDecoding->sitesID, found->span.first + shift, found->span.last - found->span.first + 1) == found->span.first) {
+						parentGate = &*found;
+					}
+				}
+			}
+		}
+
+		if (parentGate != nullptr) {
+			auto newGate = parentGate->gate->makeCopy();
+			newGate->ID = gateCount;
+			gates.push_back(newGate);
+			genomePerGateValues.push_back(parentGate->perGateValues);
+			if (newDecoding != nullptr) {
+				int shift = start - parentGate->start;
+				newDecoding->gates.push_back(*parentGate);
+				newDecoding->gates.back().start = start;
+				newDecoding->gates.back().span.first += shift;
+				newDecoding->gates.back().span.last += shift;
+			}
+			continue;
+		}
+
+		startHandler->resetHandler();
+		startHandler->advanceIndex(start);
+		startHandler->copyTo(gateGenomeHandler);
+		span = AbstractGenome::Handler::ReadSpan();
+		gateGenomeHandler->readSpan = &span;
+		int testSite1Value = gateGenomeHandler->readInt(0, codonMax, AbstractGate::START_CODE, gateCount);  // mark start codon in genomes coding region
+		gateGenomeHandler->readInt(0, codonMax, AbstractGate::START_CODE, gateCount);
+		std::shared_ptr<AbstractGate> newGate = gateBuilder.makeGate[testSite1Value](gateGenomeHandler, gateCount, gatePT);
+		if (newGate != nullptr) {
+			// now read perGate values from genome
+			std::vector<int> thisGatesValues;
+			int i = 0;
+			while (i < genomePerGateValuesCount && !gateGenomeHandler->atEOC()) {
+				thisGatesValues.push_back(gateGenomeHandler->readInt(0, maxValue));
+				i++;
+			}
+			if (!gateGenomeHandler->atEOC()) {  // we may run out of space while reading the perGate sites...
+				if (newDecoding != nullptr && newGate->copiesExactly() && !span.jumped) {
+					// keep the gate as read, and give the brain a copy (the brain will map the copy's inputs and outputs)
+					newDecoding->gates.push_back({ start, span, newGate, thisGatesValues });
+					newGate = newGate->makeCopy();
+				}
+				gates.push_back(newGate);
+				genomePerGateValues.push_back(thisGatesValues);
+			}
+		}
+		gateGenomeHandler->readSpan = nullptr;
+	}
+	if (decoding != nullptr) {
+		*decoding = newDecoding;
+	}
+}
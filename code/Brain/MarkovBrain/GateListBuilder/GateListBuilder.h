@@ -21,6 +21,25 @@
 #include <Genome/AbstractGenome.h>
 #include <Utilities/Parameters.h>
 
+// what ClassicGateListBuilder read from a genome to make a gate list. A brain
+// keeps the decoding of its genome, so that brains made from mutated copies of
+// that genome can copy the gates found in sites which did not change, rather
+// than reading those gates again (see SiteHistory.h).
+struct GateListDecoding {
+	struct Gate {
+		int start; // site where the gate's start codon begins
+		AbstractGenome::Handler::ReadSpan span; // sites the gate was read from
+		std::shared_ptr<AbstractGate> gate; // as read from the genome (before inputs and outputs are mapped to nodes)
+		std::vector<int> perGateValues;
+	};
+	std::shared_ptr<const StartCodons> codons;
+	long long sitesID; // contents of the genome which was decoded
+	std::shared_ptr<ParametersTable> gatePT;
+	int maxValue;
+	int perGateValuesCount;
+	std::vector<Gate> gates; // gates which can be copied, in order of start
+};
+
 class AbstractGateListBuilder {
 
  public:
@@ -43,10 +62,14 @@ class AbstractGateListBuilder {
 	virtual std::set<std::string> getInUseGateNames(){
 		return gateBuilder.inUseGateNames;
 	}
-	virtual std::vector<std::shared_ptr<AbstractGate>> buildGateList(std::shared_ptr<AbstractGenome> genome, int nrOfBrainStates, std::shared_ptr<ParametersTable> gatePT){
+	// parentDecoding (if given) is the decoding of the genome that genome was
+	// copied from; if decoding is given, it is set to the decoding of genome
+	// (if the builder makes one)
+	virtual std::vector<std::shared_ptr<AbstractGate>> buildGateList(std::shared_ptr<AbstractGenome> genome, int nrOfBrainStates, std::shared_ptr<ParametersTable> gatePT,
+	        std::shared_ptr<const GateListDecoding> parentDecoding = nullptr, std::shared_ptr<const GateListDecoding> *decoding = nullptr){
 		std::vector<int> temp1;
 		std::vector<std::vector<int>> temp2;
-		return buildGateListAndGetAllValues(genome, nrOfBrainStates, 0, temp1, 0, temp2, 0, gatePT);
+		return buildGateListAndGetAllValues(genome, nrOfBrainStates, 0, temp1, 0, temp2, 0, gatePT, parentDecoding, decoding);
 	}
 
 	virtual std::vector<std::shared_ptr<AbstractGate>> buildGateListAndGetHeadValues(std::shared_ptr<AbstractGenome> genome, int nrOfBrainStates, int maxValue, std::vector<int> &genomeHeadValues, int genomeHeadValuesCount, std::shared_ptr<ParametersTable> gatePT){
@@ -54,14 +77,16 @@ class AbstractGateListBuilder {
 		return buildGateListAndGetAllValues(genome, nrOfBrainStates, maxValue, genomeHeadValues, genomeHeadValuesCount, temp, 0, gatePT);
 	}
 
-	virtual std::vector<std::shared_ptr<AbstractGate>> buildGateListAndGetPerGateValues(std::shared_ptr<AbstractGenome> genome, int nrOfBrainStates, int maxValue, std::vector<std::vector<int>> &genomePerGateValues, int genomePerGateValuesCount, std::shared_ptr<ParametersTable> gatePT){
+	virtual std::vector<std::shared_ptr<AbstractGate>> buildGateListAndGetPerGateValues(std::shared_ptr<AbstractGenome> genome, int nrOfBrainStates, int maxValue, std::vector<std::vector<int>> &genomePerGateValues, int genomePerGateValuesCount, std::shared_ptr<ParametersTable> gatePT,
+	        std::shared_ptr<const GateListDecoding> parentDecoding = nullptr, std::shared_ptr<const GateListDecoding> *decoding = nullptr){
 		std::vector<int> temp;
-		return buildGateListAndGetAllValues(genome, nrOfBrainStates, maxValue, temp, 0, genomePerGateValues, genomePerGateValuesCount, gatePT);
+		return buildGateListAndGetAllValues(genome, nrOfBrainStates, maxValue, temp, 0, genomePerGateValues, genomePerGateValuesCount, gatePT, parentDecoding, decoding);
 	}
 
 	virtual std::vector<std::shared_ptr<AbstractGate>> buildGateListAndGetAllValues(std::shared_ptr<AbstractGenome> genome, int nrOfBrainStates,
             int maxValue, std::vector<int> &genomeHeadValues, int genomeHeadValuesCount,
-            std::vector<std::vector<int>> &genomePerGateValues, int genomePerGateValuesCount, std::shared_ptr<ParametersTable> gatePT) = 0;
+            std::vector<std::vector<int>> &genomePerGateValues, int genomePerGateValuesCount, std::shared_ptr<ParametersTable> gatePT,
+            std::shared_ptr<const GateListDecoding> parentDecoding = nullptr, std::shared_ptr<const GateListDecoding> *decoding = nullptr) = 0;
 
 };
 
@@ -71,13 +96,26 @@ class ClassicGateListBuilder : public AbstractGateListBuilder {
 //	ClassicGateListBuilder() {
 //		gateBuilder.setupGates();
 //	}
-	ClassicGateListBuilder(std::shared_ptr<ParametersTable> _PT = nullptr) : AbstractGateListBuilder(_PT){
-	}
+	static std::shared_ptr<ParameterLink<bool>> useCodonIndexPL;
+
+	// the start codons of the gates in use (see CodonIndex.h)
+	std::shared_ptr<const StartCodons> startCodons;
+
+	ClassicGateListBuilder(std::shared_ptr<ParametersTable> _PT = nullptr);
 
 	virtual ~ClassicGateListBuilder() = default;
 
 	virtual std::vector<std::shared_ptr<AbstractGate>> buildGateListAndGetAllValues(std::shared_ptr<AbstractGenome> genome, int nrOfBrainStates,
 	                                               int maxValue, std::vector<int> &genomeHeadValues, int genomeHeadValuesCount,
-	                                               std::vector<std::vector<int>> &genomePerGateValues, int genomePerGateValuesCount, std::shared_ptr<ParametersTable> gatePT);
+	                                               std::vector<std::vector<int>> &genomePerGateValues, int genomePerGateValuesCount, std::shared_ptr<ParametersTable> gatePT,
+	                                               std::shared_ptr<const GateListDecoding> parentDecoding = nullptr, std::shared_ptr<const GateListDecoding> *decoding = nullptr) override;
+
+private:
+	// read the gates that start at the sites in codonIndex (gives the same
+	// gates as reading every site, as buildGateListAndGetAllValues does)
+	void buildGateListFromIndex(std::shared_ptr<AbstractGenome> genome, std::shared_ptr<const CodonIndex> codonIndex,
+	                            std::shared_ptr<AbstractGenome::Handler> gateGenomeHandler, int maxValue, std::vector<std::shared_ptr<AbstractGate>> &gates,
+	                            std::vector<std::vector<int>> &genomePerGateValues, int genomePerGateValuesCount, std::shared_ptr<ParametersTable> gatePT,
+	                            std::shared_ptr<const GateListDecoding> parentDecoding, std::shared_ptr<const GateListDecoding> *decoding);
 };
 
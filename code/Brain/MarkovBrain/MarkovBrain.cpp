@@ -89,6 +89,12 @@ std::shared_ptr<ParameterLink<std::string>> MarkovBrain::genomeNamePL =
                                    (std::string) "root::",
                                    "namespace used to set parameters for "
                                    "genome used to encode this brain");
+std::shared_ptr<ParameterLink<bool>> MarkovBrain::useCompiledGatesPL =
+    Parameters::register_parameter(
+        "BRAIN_MARKOV_ADVANCED-useCompiledGates", true,
+        "if true (and useGateRegulation is false), brains with only "
+        "Deterministic and Probabilistic gates are run from a flattened copy "
+        "of the gates (faster, with the same results)");
 
 void MarkovBrain::readParameters() {
     recurrentOutput = recurrentOutputPL->get(PT);
@@ -107,6 +113,7 @@ void MarkovBrain::readParameters() {
   hiddenNodes = hiddenNodesPL->get(PT);
 
   genomeName = genomeNamePL->get(PT);
+  useCompiledGates = useCompiledGatesPL->get(PT);
 
   nrNodes = nrInputValues + nrOutputValues + hiddenNodes;
   nodes.resize(nrNodes, 0);
@@ -158,14 +165,15 @@ MarkovBrain::MarkovBrain(std::shared_ptr<AbstractGateListBuilder> GLB_,
 MarkovBrain::MarkovBrain(
     std::shared_ptr<AbstractGateListBuilder> GLB_,
     std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &_genomes, int _nrInNodes,
-    int _nrOutNodes, std::shared_ptr<ParametersTable> PT_)
+    int _nrOutNodes, std::shared_ptr<ParametersTable> PT_,
+    std::shared_ptr<const GateListDecoding> parentDecoding)
     : MarkovBrain(GLB_, _nrInNodes, _nrOutNodes, PT_) {
   // cout << "in MarkovBrain::MarkovBrain(std::shared_ptr<Base_GateListBuilder> GLB_,
   // std::shared_ptr<AbstractGenome> genome, int _nrOfBrainStates)\n\tabout to -
   // gates = GLB->buildGateList(genome, nrOfBrainStates);" << endl;
 
     if (!useGateRegulation) {
-        gates = GLB->buildGateList(_genomes[genomeName], nrNodes, PT_);
+        gates = GLB->buildGateList(_genomes[genomeName], nrNodes, PT_, parentDecoding, &gateListDecoding);
     }
     else { // useGateRegulation
         std::vector<std::vector<int>> genomePerGateValues;
@@ -174,7 +182,7 @@ MarkovBrain::MarkovBrain(
         gates = GLB->buildGateListAndGetPerGateValues(_genomes[genomeName],
             nrNodes, _genomes[genomeName]->getAlphabetSize(),
             genomePerGateValues, genomePerGateValuesCount,
-            PT_);
+            PT_, parentDecoding, &gateListDecoding);
 
         // now that gates are constructed, determin which will be off, on, and regulated
         gateRegulationAdresses.clear();
@@ -202,11 +210,21 @@ MarkovBrain::MarkovBrain(
 // initalizing other elements.
 std::shared_ptr<AbstractBrain> MarkovBrain::makeBrain(
     std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &_genomes) {
-  std::shared_ptr<MarkovBrain> newBrain = std::make_shared<MarkovBrain>(
+  std::shared_ptr<MarkovBrain> newBrain = Pool::make<MarkovBrain>(
       GLB, _genomes, nrInputValues, nrOutputValues, PT);
   return newBrain;
 }
 
+std::shared_ptr<AbstractBrain> MarkovBrain::makeBrainFrom(
+    std::shared_ptr<AbstractBrain> parent,
+    std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &_genomes) {
+  auto markovParent = std::dynamic_pointer_cast<MarkovBrain>(parent);
+  std::shared_ptr<MarkovBrain> newBrain = Pool::make<MarkovBrain>(
+      GLB, _genomes, nrInputValues, nrOutputValues, PT,
+      markovParent == nullptr ? nullptr : markovParent->gateListDecoding);
+  return newBrain;
+}
+
 void MarkovBrain::resetBrain() {
     AbstractBrain::resetBrain();
     nodes.assign(nrNodes, 0.0);
@@ -280,8 +298,16 @@ void MarkovBrain::update() {
         }
 
         if (!useGateRegulation) {
-            for (auto& g : gates) {// update each gate
-                g->update(nodes, nextNodes);
+            if (useCompiledGates && compiledGatesState == 0) {
+                compileGates();
+            }
+            if (compiledGatesState == 1) {
+                compiledGates.update(nodes, nextNodes);
+            }
+            else {
+                for (auto& g : gates) {// update each gate
+                    g->update(nodes, nextNodes);
+                }
             }
         }
         else { //useGateRegulation
@@ -448,6 +474,10 @@ std::vector<std::vector<int>> MarkovBrain::getConnectivityMatrix() {
   return M;
 }
 
+void MarkovBrain::compileGates() {
+  compiledGatesState = compiledGates.compile(gates, nrNodes) ? 1 : -1;
+}
+
 int MarkovBrain::brainSize() { return gates.size(); }
 
 int MarkovBrain::numGates() { return brainSize(); }
@@ -486,7 +516,8 @@ MarkovBrain::makeCopy(std::shared_ptr<ParametersTable> PT_) {
     _gates.push_back(gate->makeCopy());
   }
   auto newBrain =
-      std::make_shared<MarkovBrain>(_gates, nrInputValues, nrOutputValues, PT_);
+      Pool::make<MarkovBrain>(_gates, nrInputValues, nrOutputValues, PT_);
+  newBrain->gateListDecoding = gateListDecoding;
   return newBrain;
 }
 
@@ -501,7 +532,7 @@ std::vector<std::shared_ptr<AbstractBrain>> MarkovBrain::getAllSingleGateKnockou
       if (c++ != i)
         gmut.push_back(g->makeCopy());
     auto bmut =
-        std::make_shared<MarkovBrain>(gmut, nrInputValues, nrOutputValues, PT);
+        Pool::make<MarkovBrain>(gmut, nrInputValues, nrOutputValues, PT);
     res.push_back(bmut);
   }
   return res;
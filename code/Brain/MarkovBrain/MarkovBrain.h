@@ -16,9 +16,11 @@
 #include <set>
 #include <vector>
 
+#include "CompiledGates.h"
 #include "GateListBuilder/GateListBuilder.h"
 #include "../../Genome/AbstractGenome.h"
 
+#include "../../Utilities/Pool.h"
 #include "../../Utilities/Random.h"
 
 #include "../AbstractBrain.h"
@@ -53,6 +55,7 @@ public:
 
     static std::shared_ptr<ParameterLink<int>> hiddenNodesPL;
     static std::shared_ptr<ParameterLink<std::string>> genomeNamePL;
+    static std::shared_ptr<ParameterLink<bool>> useCompiledGatesPL;
 
     bool useGateRegulation;
     std::vector<int> gateRegulationAdresses; // values are -2 off, -1 on, 0 and up, on if (nodes[value] > 0)
@@ -71,12 +74,21 @@ public:
     int hiddenNodes;
     std::string genomeName;
 
+    // gates flattened for update (see CompiledGates.h). compiled on the first
+    // update; 0 = not compiled yet, 1 = compiled, -1 = use the gates directly
+    bool useCompiledGates;
+    CompiledGates compiledGates;
+    int compiledGatesState = 0;
+
     std::vector<double> nodes;
     std::vector<double> nextNodes;
 
     int nrNodes;
 
     std::shared_ptr<AbstractGateListBuilder> GLB;
+    // how gates were read from the genome (if the GLB made a decoding), passed
+    // on to brains made from this brain (see makeBrainFrom)
+    std::shared_ptr<const GateListDecoding> gateListDecoding;
     std::vector<int> nodesConnections, nextNodesConnections;
 
     //	static bool& cacheResults;
@@ -111,7 +123,8 @@ public:
     MarkovBrain(std::shared_ptr<AbstractGateListBuilder> GLB_,
         std::unordered_map<std::string, std::shared_ptr<AbstractGenome>>& _genomes,
         int _nrInNodes, int _nrOutNodes,
-        std::shared_ptr<ParametersTable> PT_ = nullptr);
+        std::shared_ptr<ParametersTable> PT_ = nullptr,
+        std::shared_ptr<const GateListDecoding> parentDecoding = nullptr);
 
     virtual ~MarkovBrain() = default;
 
@@ -120,6 +133,10 @@ public:
 
     void readParameters();
 
+    // rebuild compiledGates from gates. call this if gates is changed after
+    // the brain has been updated
+    void compileGates();
+
     virtual void update() override;
 
     void inOutReMap();
@@ -129,6 +146,12 @@ public:
     virtual std::shared_ptr<AbstractBrain> makeBrain(
         std::unordered_map<std::string, std::shared_ptr<AbstractGenome>>& _genomes) override;
 
+    // same as makeBrain, but gates in parts of the genome that did not change
+    // since parent was made can be copied from parent (see GateListDecoding)
+    virtual std::shared_ptr<AbstractBrain> makeBrainFrom(
+        std::shared_ptr<AbstractBrain> parent,
+        std::unordered_map<std::string, std::shared_ptr<AbstractGenome>>& _genomes) override;
+
     virtual std::string description() override;
     void fillInConnectionsLists();
     virtual DataMap getStats(std::string& prefix) override;
@@ -405,7 +428,7 @@ public:
 
 inline std::shared_ptr<AbstractBrain>
 MarkovBrain_brainFactory(int ins, int outs, std::shared_ptr<ParametersTable> PT) {
-    return std::make_shared<MarkovBrain>(std::make_shared<ClassicGateListBuilder>(PT), ins,
+    return Pool::make<MarkovBrain>(std::make_shared<ClassicGateListBuilder>(PT), ins,
         outs, PT);
 }
 
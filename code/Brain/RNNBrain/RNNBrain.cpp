@@ -41,12 +41,16 @@ std::shared_ptr<ParameterLink<std::string>> RNNBrain::activationFunctionPL = Par
     "choose from \"linear\"(or \"none\"),\"tanh\",\"tanh(0-1)\",\"bit\",\"triangle\",\"invtriangle\",\"sin\",\n"
     "or, \"genome\" to allow evolution to pick");
 
+std::shared_ptr<ParameterLink<bool>> RNNBrain::singlePrecisionPL = Parameters::register_parameter("BRAIN_RNN-singlePrecision", false,
+    "if true, weights are stored as 32 bit floats (node values are still 64 bit). This halves the memory used by the weights, but the weights read from the genome are rounded.");
+
 
 
 RNNBrain::RNNBrain(int _nrInNodes, int _nrOutNodes, std::shared_ptr<ParametersTable> _PT) : AbstractBrain(_nrInNodes, _nrOutNodes, _PT) {
     genomeName = genomeNamePL->get(_PT);
     nrRecurrentValues = nrOfRecurrentNodesPL->get(_PT);
     discretizeRecurrent = discretizeRecurrentPL->get(_PT);
+    singlePrecision = singlePrecisionPL->get(_PT);
     if (activationFunctionPL->get(_PT) == "none" || activationFunctionPL->get(_PT) == "linear") {
         activationFunction = 1;
     }
@@ -109,22 +113,18 @@ std::shared_ptr<AbstractBrain> RNNBrain::makeBrain(std::unordered_map<std::strin
     }
 
     // create the "layers" of weights (between each node layer
-    newBrain->weights.resize((int)newBrain->nodes.size() - 1);
-    // now for each weight layer
-    for (size_t i = 0; i < (int)newBrain->weights.size(); i++) {
-        // add space for a vector of weights for each node
-        newBrain->weights[i].resize((int)newBrain->nodes[i].size());
-        // for each node in this layer
-        for (size_t j = 0; j < (int)newBrain->weights[i].size(); j++) {
-            // add a weight for the wire from this node to each node in the next node layer
-            newBrain->weights[i][j].resize((int)newBrain->nodes[i + 1].size());
-        }
+    // each node in a layer has a weight for the wire from it to each node in the next node layer
+    for (size_t i = 0; i + 1 < newBrain->nodes.size(); i++) {
+        newBrain->layers.emplace_back((int)newBrain->nodes[i].size(), (int)newBrain->nodes[i + 1].size(), newBrain->singlePrecision);
     }
 
-    for (size_t i = 0; i < newBrain->weights.size(); i++) {
-        for (size_t j = 0; j < newBrain->weights[i].size(); j++) {
-            for (size_t k = 0; k < newBrain->weights[i][j].size(); k++) {
-                double value = genomeHandler->readDouble(0, weightRangeMappingSums[4]);
+    std::vector<double> values;
+    for (size_t i = 0; i < newBrain->layers.size(); i++) {
+        values.resize(newBrain->layers[i].outputs());
+        for (int j = 0; j < newBrain->layers[i].inputs(); j++) {
+            genomeHandler->readDoubles(values.data(), (int)values.size(), 0, weightRangeMappingSums[4]);
+            for (int k = 0; k < newBrain->layers[i].outputs(); k++) {
+                double value = values[k];
                 //std::cout << value << " ";
                 if (value < weightRangeMappingSums[0]) { // first range, map to -1
                     //std::cout << "-1 -> ";
@@ -147,19 +147,18 @@ std::shared_ptr<AbstractBrain> RNNBrain::makeBrain(std::unordered_map<std::strin
                     value = 1.0;
                 }
                 //std::cout << value << std::endl;
-                newBrain->weights[i][j][k] = value;
-                //newBrain->weights[i][j][k] = (value * value * value) * 4.0;
+                newBrain->layers[i].setWeight(j, k, value);
+                //newBrain->layers[i].setWeight(j, k, (value * value * value) * 4.0);
             }
         }
     }
 
     newBrain->activationFunctions.push_back({}); // first row empty because it's inputs
-    newBrain->initialValues.push_back({}); // first row empty because it's inputs
     for (size_t i = 1; i < newBrain->nodes.size(); i++) {
-        newBrain->initialValues.push_back(std::vector<double>(newBrain->nodes[i].size()));
         newBrain->activationFunctions.push_back(std::vector<int>(newBrain->nodes[i].size()));
-        for (size_t j = 0; j < newBrain->initialValues[i].size(); j++) {
-            newBrain->initialValues[i][j] = genomeHandler->readDouble(biasRange[0], biasRange[1]);
+        for (size_t j = 0; j < newBrain->nodes[i].size(); j++) {
+            // the initial value of each node is the bias of the layer that computes it
+            newBrain->layers[i - 1].setBias(j, genomeHandler->readDouble(biasRange[0], biasRange[1]));
             newBrain->activationFunctions[i][j] = (activationFunction == 8) ? genomeHandler->readInt(1,7) : activationFunction;
         }
     }
@@ -235,43 +234,16 @@ void RNNBrain::update() {
     //std::cout << std::endl;
 
     for (size_t layer = 1; layer < nodes.size(); layer++) {
-        for (size_t i = 0; i < nodes[layer].size(); i++) {
-            nodes[layer][i] = initialValues[layer][i];
-            //std::cout << "init val: " << layer << "," << i << "  " << nodes[layer][i] << std::endl;
-        }
-        // for each node in the prior layer
+        // each node is its initial value + the node values from the prior layer * that nodes weight for this node
+        layers[layer - 1].update(nodes[layer - 1].data(), nodes[layer].data());
+        // apply apply Activation Function to this layer
         for (size_t j = 0; j < nodes[layer].size(); j++) {
-            // for each node in this layer
-            for (size_t i = 0; i < nodes[layer - 1].size(); i++) {
-                //std::cout << ":: " << layer << "  " << j << "," << i << "  " << nodes[layer][j] << " + " << weights[(size_t)(layer)-1][i][j] << " * " << nodes[(size_t)(layer)-1][i] <<std::endl;
-                // add the node value from the prior layer * that nodes weight for this node to this node
-                nodes[layer][j] += weights[(size_t)(layer) - 1][i][j] * nodes[(size_t)(layer) - 1][i];
-            }
             applyActivation(nodes[layer][j], activationFunctions[layer][j]);
         }
-        // apply apply Activation Function to this layer
     }
     int lastLayer = nodes.size() - 1;
     for (size_t i = 0; i < nrRecurrentValues; i++) {
-        if (discretizeRecurrent < 1) {
-            nodes[0][(size_t)(nrInputValues) + i] = nodes[lastLayer][(size_t)(nrOutputValues) + i];
-        }
-        else if (discretizeRecurrent == 1) {
-            nodes[0][(size_t)(nrInputValues) + i] = Bit(nodes[lastLayer][(size_t)(nrOutputValues) + i]);
-        }
-        else {
-            // move value is in to range 0 to discretizeRecurrent
-            nodes[0][(size_t)(nrInputValues)+i] = std::max(-1.0, std::min(1.0, nodes[lastLayer][(size_t)(nrOutputValues)+i]));
-            nodes[0][(size_t)(nrInputValues)+i] = (((nodes[0][(size_t)(nrInputValues)+i]) + 1.0)/2.0)* discretizeRecurrent;
-            // use int to discretize
-            nodes[0][(size_t)(nrInputValues)+i] = (double)(int)(nodes[0][(size_t)(nrInputValues)+i]);
-            
-            if (nodes[0][(size_t)(nrInputValues)+i] == discretizeRecurrent) { // if node value was exactly 1
-                nodes[0][(size_t)(nrInputValues)+i]--;
-            }
-            // move back to [0..1] (with / discretizeRecurrent-1) and then to [-1...1] (with * 2 - 1)
-            nodes[0][(size_t)(nrInputValues)+i]  = (nodes[0][(size_t)(nrInputValues)+i] / (double)(discretizeRecurrent-1) * 2.0) - 1.0;
-        }
+        nodes[0][(size_t)(nrInputValues) + i] = recurrentValue(nodes[lastLayer][(size_t)(nrOutputValues) + i]);
     }
 
     // output and hidden+1 have been set so it's time to record state...
@@ -300,6 +272,74 @@ void RNNBrain::update() {
     
 }
 
+double RNNBrain::recurrentValue(double value) {
+    if (discretizeRecurrent < 1) {
+        return value;
+    }
+    if (discretizeRecurrent == 1) {
+        return Bit(value);
+    }
+    // move value is in to range 0 to discretizeRecurrent
+    value = std::max(-1.0, std::min(1.0, value));
+    value = ((value + 1.0) / 2.0) * discretizeRecurrent;
+    // use int to discretize
+    value = (double)(int)(value);
+
+    if (value == discretizeRecurrent) { // if node value was exactly 1
+        value--;
+    }
+    // move back to [0..1] (with / discretizeRecurrent-1) and then to [-1...1] (with * 2 - 1)
+    return (value / (double)(discretizeRecurrent - 1) * 2.0) - 1.0;
+}
+
+void RNNBrain::updateBatch(const std::vector<std::vector<double>>& inputs,
+    std::vector<std::vector<double>>& outputs, int updates) {
+    if (recordActivity) { // activity is recorded one update at a time
+        AbstractBrain::updateBatch(inputs, outputs, updates);
+        return;
+    }
+    // batchNodes[layer] holds nodes[layer] for every run, one run after another
+    const size_t batchSize = inputs.size();
+    const size_t layerCount = nodes.size();
+    batchNodes.resize(layerCount);
+    for (size_t layer = 0; layer < layerCount; layer++) {
+        batchNodes[layer].assign(batchSize * nodes[layer].size(), 0.0);
+    }
+    const size_t inputLayerSize = nodes[0].size();
+    for (size_t b = 0; b < batchSize; b++) {
+        checkBatchInputs(inputs[b]);
+        std::copy(inputs[b].begin(), inputs[b].end(), batchNodes[0].begin() + b * inputLayerSize);
+    }
+
+    const size_t lastLayer = layerCount - 1;
+    const size_t lastSize = nodes[lastLayer].size();
+    for (int u = 0; u < updates; u++) {
+        // the same sums as update, but each weight is used for every run before moving on
+        for (size_t layer = 1; layer < layerCount; layer++) {
+            const size_t size = nodes[layer].size();
+            double* current = batchNodes[layer].data();
+            layers[layer - 1].updateBatch(batchNodes[layer - 1].data(), current, (int)batchSize);
+            for (size_t b = 0; b < batchSize; b++) {
+                for (size_t j = 0; j < size; j++) {
+                    applyActivation(current[b * size + j], activationFunctions[layer][j]);
+                }
+            }
+        }
+        for (size_t b = 0; b < batchSize; b++) {
+            for (size_t i = 0; i < nrRecurrentValues; i++) {
+                batchNodes[0][b * inputLayerSize + nrInputValues + i] = recurrentValue(batchNodes[lastLayer][b * lastSize + nrOutputValues + i]);
+            }
+        }
+    }
+
+    outputs.resize(batchSize);
+    for (size_t b = 0; b < batchSize; b++) {
+        auto first = batchNodes[lastLayer].begin() + b * lastSize;
+        outputs[b].assign(first, first + nrOutputValues);
+    }
+    resetBrain();
+}
+
 void inline RNNBrain::resetOutputs() {
     for (int o = 0; o < nrOutputValues; o++) {
         nodes[(int)nodes.size() - 1][o] = 0.0;
@@ -318,13 +358,13 @@ DataMap RNNBrain::getStats(std::string& prefix) {
     int zeroCount = 0;
 
     double th = 0;
-    for (size_t i = 0; i < weights.size(); i++) {
-        for (size_t j = 0; j < weights[i].size(); j++) {
-            for (size_t k = 0; k < weights[i][j].size(); k++) {
-                if (weights[i][j][k] > th) {
+    for (size_t i = 0; i < layers.size(); i++) {
+        for (int j = 0; j < layers[i].inputs(); j++) {
+            for (int k = 0; k < layers[i].outputs(); k++) {
+                if (layers[i].weight(j, k) > th) {
                     posCount++;
                 }
-                else if (weights[i][j][k] < th) {
+                else if (layers[i].weight(j, k) < th) {
                     negCount++;
                 }
                 else {
@@ -396,8 +436,7 @@ std::shared_ptr<AbstractBrain> RNNBrain::makeCopy(std::shared_ptr<ParametersTabl
     }
     auto newBrain = std::make_shared<RNNBrain>(nrInputValues, nrOutputValues, _PT);
     newBrain->nodes = nodes;
-    newBrain->weights = weights;
-    newBrain->initialValues = initialValues;
+    newBrain->layers = layers;
     
     return newBrain;
 }
@@ -23,6 +23,8 @@
 
 #include "../AbstractBrain.h"
 
+#include "../../Utilities/DenseLayer.h"
+
 
 class RNNBrain: public AbstractBrain {
 public:
@@ -36,6 +38,7 @@ public:
 
     static std::shared_ptr<ParameterLink<std::string>> biasRangePL;
     static std::shared_ptr<ParameterLink<std::string>> activationFunctionPL;
+    static std::shared_ptr<ParameterLink<bool>> singlePrecisionPL;
 
 
     int nrRecurrentValues;
@@ -47,10 +50,12 @@ public:
     std::vector<double> weightRangeMappingSums;
 
     std::vector<double> biasRange = { 0,0 };
-    std::vector<std::vector<double>> initialValues;
+    bool singlePrecision;
 
     std::vector<std::vector<double>> nodes;
-    std::vector<std::vector<std::vector<double>>> weights;
+    // layers[i] holds the weights from nodes[i] to nodes[i+1], and the initial values (biases) of nodes[i+1]
+    std::vector<DenseLayer> layers;
+    std::vector<std::vector<double>> batchNodes; // nodes for each run in updateBatch
 
 
     //   activation Function Types: 0:none, 1:linear, 2:tanh, 3:tanh0_1, 4:bit, 5:triangle, 6:invtriangle, 7:sin, 8:genome
@@ -65,6 +70,8 @@ public:
 	virtual ~RNNBrain() = default;
 
 	virtual void update() override;
+	virtual void updateBatch(const std::vector<std::vector<double>>& inputs,
+		std::vector<std::vector<double>>& outputs, int updates = 1) override;
 
 	virtual std::shared_ptr<AbstractBrain> makeBrain(std::unordered_map<std::string, std::shared_ptr<AbstractGenome>>& _genomes) override;
 
@@ -78,6 +85,8 @@ public:
 	virtual void resetOutputs() override;
 
     void applyActivation(double &val, int functionID);
+    // the value a recurrent node gets from the last layer (see discretizeRecurrent)
+    double recurrentValue(double value);
 
     virtual std::shared_ptr<AbstractBrain> makeCopy(std::shared_ptr<ParametersTable> _PT = nullptr) override;
 
@@ -129,12 +138,12 @@ public:
             }
         }
 
-        int lastLayerIndex = weights.size() - 1;
+        int lastLayerIndex = layers.size() - 1;
         for (size_t c = 0; c < brainHiddenCount + brainOutCount; c++) {
             // index c from last nodes layer
             // we need to determin if there is a connection from c to which nodes on first layer
             // we will start at c and trace back to create a set of input and recurrent from the first layer
-            // weights to c are weights[lastLayerIndex-1][n][r]; that is, for each node in the prior layer, the [c]th value
+            // weights to c are layers[lastLayerIndex].weight(n,c); that is, for each node in the prior layer, the [c]th value
             // if there are more then 2 layers (ie. input and output), we need to keep a temp list for intermidate layers
             std::set<size_t> priorLayerLinks;
             std::set<size_t> priorPriorLayerLinks;
@@ -142,9 +151,9 @@ public:
             int currentLayerIndex = lastLayerIndex; // start looking at last weights layer
             while (currentLayerIndex >= 0) {
                 priorPriorLayerLinks = {};
-                for (size_t pn = 0; pn < weights[currentLayerIndex].size(); pn++) {
+                for (size_t pn = 0; pn < layers[currentLayerIndex].inputs(); pn++) {
                     for (auto pc : priorLayerLinks) {
-                        if (weights[currentLayerIndex][pn][pc] != 0) {
+                        if (layers[currentLayerIndex].weight(pn, pc) != 0) {
                             priorPriorLayerLinks.insert(pn);
                         }
                     }
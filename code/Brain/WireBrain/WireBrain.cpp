@@ -251,9 +251,9 @@ WireBrain::WireBrain(
       // load genome into allCells
       auto genomeHandler =
           _genomes[genomeName]->newHandler(_genomes[genomeName], true);
+      // 1 (WIRE) will be assigned initialFillRatio % of the time
+      genomeHandler->readInts(allCells.data(), width * depth * height, 0, 1);
       for (int l = 0; l < width * depth * height; l++) {
-        allCells[l] = genomeHandler->readInt(
-            0, 1); // 1 (WIRE) will be assigned initialFillRatio % of the time
         if (allCells[l] == WIRE) {
           wireAddresses.push_back(l);
         }
@@ -27,4 +27,23 @@ std::shared_ptr<ParameterLink<std::string>> AbstractGenome::genomeSitesTypePL =
         "type for sites in genome [char, int, double, bool]"); // string
                                                                // parameter for
                                                                // outputMethod;
+std::shared_ptr<ParameterLink<std::string>> AbstractGenome::sitesEncodingPL =
+    Parameters::register_parameter(
+        "GENOME-sitesEncoding", std::string("text"),
+        "how genome sites are saved in organisms files [text, binary]\n"
+        "text: comma separated list of sites\n"
+        "binary: sites packed into bytes and saved as base64 (smaller, and "
+        "faster to save and load)\nfiles in either encoding can be loaded");
+
+bool AbstractGenome::useBinarySites(std::shared_ptr<ParametersTable> PT) {
+  std::string encoding = sitesEncodingPL->get(PT);
+  if (encoding != "text" && encoding != "binary") {
+    std::cout << "\n\nERROR: Unrecognized GENOME-sitesEncoding in "
+                 "configuration!\n  \""
+              << encoding << "\" is not defined (use text or binary).\n\nExiting.\n"
+              << std::endl;
+    exit(1);
+  }
+  return encoding == "binary";
+}
 
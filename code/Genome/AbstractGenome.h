@@ -11,6 +11,7 @@
 #pragma once
 
 #include <cstdlib>
+#include <limits>
 #include <vector>
 
 #include <fstream>
@@ -22,6 +23,7 @@
 #include <Utilities/Data.h>
 #include <Utilities/Parameters.h>
 #include <Utilities/Random.h>
+#include <Genome/CodonIndex.h>
 
 class AbstractGenome {
 
@@ -29,6 +31,11 @@ public:
   static std::shared_ptr<ParameterLink<std::string>> genomeTypeStrPL;
   static std::shared_ptr<ParameterLink<double>> alphabetSizePL;
   static std::shared_ptr<ParameterLink<std::string>> genomeSitesTypePL;
+  static std::shared_ptr<ParameterLink<std::string>> sitesEncodingPL;
+
+  // true if genomes made with PT should serialize their sites as packed
+  // binary (see Utilities/SitesEncoding.h), false for text
+  static bool useBinarySites(std::shared_ptr<ParametersTable> PT);
 
   const std::shared_ptr<ParametersTable> PT;
 
@@ -43,6 +50,20 @@ public:
               // of the genome
     // which after having passed we may want to perform some different behavior
 
+    // the range of sites a handler reads (or moves over), see readSpan
+    struct ReadSpan {
+      int first = std::numeric_limits<int>::max();
+      int last = -1;
+      bool jumped = false; // moved to a site not relative to where it was
+      void add(int siteIndex) {
+        first = std::min(first, siteIndex);
+        last = std::max(last, siteIndex);
+      }
+    };
+    // if set, handlers that support it record what they read here (as do
+    // handlers made from them with makeCopy)
+    ReadSpan *readSpan = nullptr;
+
     Handler() {
       readDirection = true;
       EOG = false;
@@ -90,6 +111,23 @@ public:
       exit(1);
     }
 
+    // read count values into values, the same as calling readInt (or
+    // readDouble) count times with the same range. genomes can override these
+    // to read many sites with one call
+    virtual void readInts(int *values, int count, int valueMin, int valueMax,
+                          int code = -1, int CodingRegionIndex = 0) {
+      for (int i = 0; i < count; i++) {
+        values[i] = readInt(valueMin, valueMax, code, CodingRegionIndex);
+      }
+    }
+    virtual void readDoubles(double *values, int count, double valueMin,
+                             double valueMax, int code = -1,
+                             int CodingRegionIndex = 0) {
+      for (int i = 0; i < count; i++) {
+        values[i] = readDouble(valueMin, valueMax, code, CodingRegionIndex);
+      }
+    }
+
     virtual void writeInt(int value, int valueMin, int valueMax) = 0;
     virtual void writeDouble(double value, double valueMin, double valueMax) {
       std::cout << "ERROR: writeDouble(double value, double valueMin, double "
@@ -235,5 +273,25 @@ public:
   }
 
   virtual void recordDataMap() = 0;
+
+  // start codon index (see CodonIndex.h)
+  // genomes that keep an index return one listing codons in their current
+  // sites. the undefined action is to return nullptr (and the caller must read
+  // the genome to find start codons)
+  virtual std::shared_ptr<const CodonIndex>
+  getCodonIndex(std::shared_ptr<const StartCodons> codons) {
+    return nullptr;
+  }
+
+  // identifies the current contents of this genome (see SiteHistory.h)
+  // the undefined action is to return 0 (contents are not tracked)
+  virtual long long getSitesID() { return 0; }
+
+  // if the count sites starting at index are unchanged from a genome with
+  // contents sitesID which this genome was copied from (or is), return their
+  // index in that genome, else -1
+  virtual int parentSiteIndex(long long sitesID, int index, int count) {
+    return -1;
+  }
 };
 
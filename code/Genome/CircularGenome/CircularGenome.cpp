@@ -12,6 +12,7 @@
 #include <Global.h>
 #include <cmath> // std::nextbefore
 #include <cfloat> // DBL_MAX
+#include <mutex>
 
 // Initialize Parameters
 std::shared_ptr<ParameterLink<int>> CircularGenomeParameters::sizeInitialPL = Parameters::register_parameter("GENOME_CIRCULAR-sizeInitial", 5000, "starting size for genome");
@@ -36,6 +37,39 @@ std::shared_ptr<ParameterLink<double>> CircularGenomeParameters::mutationPointOf
 std::shared_ptr<ParameterLink<double>> CircularGenomeParameters::mutationPointOffsetRangePL = Parameters::register_parameter("GENOME_CIRCULAR-mutationPointOffsetRange", 1.0, "range of PointOffset mutation");
 std::shared_ptr<ParameterLink<bool>> CircularGenomeParameters::mutationPointOffsetUniformPL = Parameters::register_parameter("GENOME_CIRCULAR-mutationPointOffsetUniform", true, "if true, offset will be from a uniform distribution, if false, from a normal distribution (where mean is 0 and std_dev is mutationPointOffsetRange)");
 
+std::shared_ptr<const CircularGenomeParameters::Mutation> CircularGenomeParameters::getMutation(std::shared_ptr<ParametersTable> PT) {
+	static std::mutex lock; // (genomes may be made on more then one thread)
+	static std::unordered_map<long long, std::shared_ptr<const Mutation>> mutations;
+	if (PT == nullptr) {
+		PT = Parameters::root;
+	}
+	std::lock_guard<std::mutex> guard(lock);
+	auto &cached = mutations[PT->getID()];
+	if (cached == nullptr) {
+		auto mutation = std::make_shared<Mutation>();
+		mutation->point = SiteSampler(mutationPointRatePL->get(PT));
+		mutation->pointOffset = SiteSampler(mutationPointOffsetRatePL->get(PT));
+		mutation->pointOffsetRange = mutationPointOffsetRangePL->get(PT);
+		mutation->pointOffsetUniform = mutationPointOffsetUniformPL->get(PT);
+		mutation->copy = SiteSampler(mutationCopyRatePL->get(PT));
+		mutation->copyMinSize = mutationCopyMinSizePL->get(PT);
+		mutation->copyMaxSize = mutationCopyMaxSizePL->get(PT);
+		mutation->deletion = SiteSampler(mutationDeleteRatePL->get(PT));
+		mutation->deleteMinSize = mutationDeleteMinSizePL->get(PT);
+		mutation->deleteMaxSize = mutationDeleteMaxSizePL->get(PT);
+		mutation->sizeMax = sizeMaxPL->get(PT);
+		mutation->sizeMin = sizeMinPL->get(PT);
+		mutation->indel = SiteSampler(mutationIndelRatePL->get(PT));
+		mutation->indelMinSize = mutationIndelMinSizePL->get(PT);
+		mutation->indelMaxSize = mutationIndelMaxSizePL->get(PT);
+		mutation->indelInsertMethod = mutationIndelInsertMethodPL->get(PT);
+		mutation->indelCopyFirst = mutationIndelCopyFirstPL->get(PT);
+		mutation->crossCount = mutationCrossCountPL->get(PT);
+		cached = mutation;
+	}
+	return cached;
+}
+
 
 // constructor
 template<class T>
@@ -47,6 +81,9 @@ CircularGenome<T>::Handler::Handler(std::shared_ptr<AbstractGenome> _genome, boo
 
 template<class T>
 void CircularGenome<T>::Handler::resetHandler() {
+	if (readSpan != nullptr) {
+		readSpan->jumped = true;
+	}
 	if (readDirection) {  // if reading forward
 		siteIndex = 0;
 	} else {  // if reading backwards
@@ -58,6 +95,9 @@ void CircularGenome<T>::Handler::resetHandler() {
 
 template<class T>
 void CircularGenome<T>::Handler::resetHandlerOnChromosome() {
+	if (readSpan != nullptr) {
+		readSpan->jumped = true;
+	}
 	if (readDirection) {  // if reading forward
 		siteIndex = 0;
 	} else {  // if reading backwards
@@ -99,11 +139,17 @@ void CircularGenome<T>::Handler::modulateIndex() {
 // site 5 of the next chromosome. Should this be fixed?!??
 template<class T>
 void CircularGenome<T>::Handler::advanceIndex(int distance) {
+	if (readSpan != nullptr) {
+		readSpan->add(siteIndex);
+	}
 	if (readDirection) {  // reading forward
 		siteIndex += distance;  // if there are enough sites left in the current chromosome, just move siteIndex
 	} else {  // reading backwards
 		siteIndex -= distance;  // if there are enough sites in the current chromosome (between siteIndex and start of chromosome) just move siteIndex
 	}
+	if (readSpan != nullptr) {
+		readSpan->add(siteIndex); // (before it is wrapped, so reaching the end of the genome is seen)
+	}
 	modulateIndex();
 }
 
@@ -136,11 +182,11 @@ int CircularGenome<T>::Handler::readInt(int valueMin, int valueMax, int code, in
 		valueMin = temp;
 	}
 	double currentMax = genome->alphabetSize;
-	value = (int) genome->sites[siteIndex];
+	value = (int) genome->sites.get(siteIndex, blockHint);
 	//codingRegions.assignCode(code, siteIndex, CodingRegionIndex);
 	advanceIndex();  // EOC = end of chromosome
 	while ((valueMax - valueMin + 1) > currentMax) {  // we don't have enough bits of information
-		value = (value * (int)genome->alphabetSize) + (int) genome->sites[siteIndex];  // next site
+		value = (value * (int)genome->alphabetSize) + (int) genome->sites.get(siteIndex, blockHint);  // next site
 		//codingRegions.assignCode(code, siteIndex, CodingRegionIndex);
 		advanceIndex();
 		currentMax = currentMax * genome->alphabetSize;
@@ -159,7 +205,7 @@ int CircularGenome<double>::Handler::readInt(int valueMin, int valueMax, int cod
 		valueMin = temp;
 	}
 	valueMax += 1; // do this so that range is inclusive!
-	value = genome->sites[siteIndex];
+	value = genome->sites.get(siteIndex, blockHint);
 	advanceIndex();
 	//cout << "  value: " << value << "  valueMin: " << valueMin << "  valueMax: " << valueMax << "  final: " << (value * ((valueMax - valueMin) / genome->alphabetSize)) + valueMin << endl;
 	//cout << "  value: " << value << "  valueMin: " << valueMin << "  valueMax: " << valueMax << "  final: " << ((value / genome->alphabetSize) * (valueMax - valueMin)) + valueMin << endl;
@@ -175,7 +221,7 @@ double CircularGenome<T>::Handler::readDouble(double valueMin, double valueMax,
 		valueMax = valueMin;
 		valueMin = temp;
 	}
-	value = (double) genome->sites[siteIndex];
+	value = (double) genome->sites.get(siteIndex, blockHint);
 	//codingRegions.assignCode(code, siteIndex, CodingRegionIndex);
 	advanceIndex();
 	//scale the value
@@ -192,7 +238,7 @@ double CircularGenome<double>::Handler::readDouble(double valueMin, double value
 		valueMax = valueMin;
 		valueMin = temp;
 	}
-	value = (double)genome->sites[siteIndex];
+	value = (double)genome->sites.get(siteIndex, blockHint);
 	//codingRegions.assignCode(code, siteIndex, CodingRegionIndex);
 	advanceIndex();
 	//scale the value
@@ -200,6 +246,74 @@ double CircularGenome<double>::Handler::readDouble(double valueMin, double value
 	return ((value / genome->alphabetSize) * (valueMax - valueMin)) + valueMin;
 }
 
+template<class T>
+inline T CircularGenome<T>::Handler::nextSite() {
+	T site = genome->sites.get(siteIndex, blockHint);
+	Handler::advanceIndex();
+	return site;
+}
+
+// read count ints, as readInt would. the number of sites per value is only
+// worked out once, and sites are read without a virtual call per site
+template<class T>
+void CircularGenome<T>::Handler::readInts(int *values, int count, int valueMin, int valueMax, int code, int CodingRegionIndex) {
+	if (valueMin > valueMax) {
+		int temp = valueMin;
+		valueMax = valueMin;
+		valueMin = temp;
+	}
+	int range = valueMax - valueMin + 1;
+	int width = genome->codonWidth(range - 1);
+	int alphabetSize = (int)genome->alphabetSize;
+	for (int i = 0; i < count; i++) {
+		int value = (int)nextSite();
+		for (int w = 1; w < width; w++) {
+			value = (value * alphabetSize) + (int)nextSite();
+		}
+		values[i] = (value % range) + valueMin;
+	}
+}
+
+template<>
+void CircularGenome<double>::Handler::readInts(int *values, int count, int valueMin, int valueMax, int code, int CodingRegionIndex) {
+	if (valueMin > valueMax) {
+		int temp = valueMin;
+		valueMax = valueMin;
+		valueMin = temp;
+	}
+	valueMax += 1; // do this so that range is inclusive!
+	for (int i = 0; i < count; i++) {
+		double value = nextSite();
+		values[i] = (int)(((value / genome->alphabetSize) * (valueMax - valueMin)) + valueMin);
+	}
+}
+
+template<class T>
+void CircularGenome<T>::Handler::readDoubles(double *values, int count, double valueMin, double valueMax, int code, int CodingRegionIndex) {
+	if (valueMin > valueMax) {
+		double temp = valueMin;
+		valueMax = valueMin;
+		valueMin = temp;
+	}
+	for (int i = 0; i < count; i++) {
+		double value = (double)nextSite();
+		values[i] = (value / (genome->alphabetSize - 1.0)) * (valueMax - valueMin) + valueMin;
+	}
+}
+
+template<>
+void CircularGenome<double>::Handler::readDoubles(double *values, int count, double valueMin, double valueMax, int code, int CodingRegionIndex) {
+	if (valueMin > valueMax) {
+		double temp = valueMin;
+		valueMax = valueMin;
+		valueMin = temp;
+	}
+	for (int i = 0; i < count; i++) {
+		double value = nextSite();
+		values[i] = ((value / genome->alphabetSize) * (valueMax - valueMin)) + valueMin;
+	}
+}
+
 template<class T>
 void CircularGenome<T>::Handler::writeInt(int value, int valueMin, int valueMax) {
 	if (valueMin > valueMax) {
@@ -221,7 +335,8 @@ void CircularGenome<T>::Handler::writeInt(int value, int valueMin, int valueMax)
 	}
 	decomposedValue.push_back(value);
 	while ((int)decomposedValue.size() > 0) {  // starting with the last element in decomposedValue, copy into genome.
-		genome->sites[siteIndex] = decomposedValue[(int)decomposedValue.size() - 1];
+		genome->sites.set(siteIndex, decomposedValue[(int)decomposedValue.size() - 1], blockHint);
+		genome->sitesChanged();
 		advanceIndex();
 		decomposedValue.pop_back();
 	}
@@ -242,7 +357,8 @@ void CircularGenome<double>::Handler::writeInt(int value, int valueMin, int valu
 	//	cout << "ERROR : attempting to write value to <double> Circular Genome. \n value is too large!" << endl;
 	//	exit(1);
 	//}
-	genome->sites[siteIndex] = (((double)(value - valueMin) / (double)(valueMax - valueMin)) * genome->alphabetSize);
+	genome->sites.set(siteIndex, (((double)(value - valueMin) / (double)(valueMax - valueMin)) * genome->alphabetSize), blockHint);
+	genome->sitesChanged();
 	advanceIndex();
 }
 
@@ -264,7 +380,8 @@ void CircularGenome<T>::Handler::writeDouble(double value, double valueMin, doub
 	//std::cout << value << "   " << valueMax << "   " << valueMin << " = ";
 	value = ((value - valueMin) / (valueMax - valueMin)) * (genome->alphabetSize - 1.0);
 	//std::cout << value << std::endl;
-	genome->sites[siteIndex] = (T)value;
+	genome->sites.set(siteIndex, (T)value, blockHint);
+	genome->sitesChanged();
 	advanceIndex();
 }
 
@@ -280,17 +397,19 @@ void CircularGenome<double>::Handler::writeDouble(double value, double valueMin,
 		exit(1);
 	}
 	value = ((value - valueMin) / (valueMax - valueMin)) * genome->alphabetSize;
-	genome->sites[siteIndex] = value;
+	genome->sites.set(siteIndex, value, blockHint);
+	genome->sitesChanged();
 	advanceIndex();
 }
 
 
 template<class T>
 std::shared_ptr<AbstractGenome::Handler> CircularGenome<T>::Handler::makeCopy() {
-	auto newGenomeHandler = std::make_shared<CircularGenome<T>::Handler>(genome, readDirection);
+	auto newGenomeHandler = Pool::make<CircularGenome<T>::Handler>(genome, readDirection);
 	newGenomeHandler->EOG = EOG;
 	newGenomeHandler->EOC = EOC;
 	newGenomeHandler->siteIndex = siteIndex;
+	newGenomeHandler->readSpan = readSpan;
 	return(newGenomeHandler);
 }
 
@@ -318,13 +437,15 @@ bool CircularGenome<T>::Handler::inTelomere(int length) {
 
 template<class T>
 void CircularGenome<T>::Handler::randomize() {
+	if (readSpan != nullptr) {
+		readSpan->jumped = true;
+	}
 	siteIndex = Random::getIndex((int)genome->size());
 }
 
 template<class T>
 std::vector<std::vector<int>> CircularGenome<T>::Handler::readTable(std::pair<int, int> tableSize, std::pair<int, int> tableMaxSize, std::pair<int, int> valueRange, int code, int CodingRegionIndex) {
 	std::vector<std::vector<int>> table;
-	int x = 0;
 	int y = 0;
 	int Y = tableSize.first;
 	int X = tableSize.second;
@@ -333,20 +454,16 @@ std::vector<std::vector<int>> CircularGenome<T>::Handler::readTable(std::pair<in
 
 	table.resize(Y);  // set the number of rows in the table
 
+	// each row uses maxX values (or more if X > maxX), the unused values
+	// account for unused entries in the max sized table for this row
+	std::vector<int> row(std::max(X, maxX));
 	for (; y < (Y); y++) {
-		table[y].resize(X);  // set the number of columns in this row
-		for (x = 0; x < X; x++) {
-			//table[y][x] = (Type) (sites[index]);
-			table[y][x] = readInt(valueRange.first, valueRange.second, code, CodingRegionIndex);
-		}
-		for (; x < maxX; x++) {
-			readInt(valueRange.first, valueRange.second);  // advance genomeIndex to account for unused entries in the max sized table for this row
-		}
+		readInts(row.data(), (int)row.size(), valueRange.first, valueRange.second, code, CodingRegionIndex);
+		table[y].assign(row.begin(), row.begin() + X);  // set the number of columns in this row
 	}
-	for (; y < (maxY); y++) {
-		for (x = 0; x < maxX; x++) {
-			readInt(valueRange.first, valueRange.second);  // advance to account for unused rows
-		}
+	if (maxY > Y && maxX > 0) {
+		row.resize((maxY - Y) * maxX);
+		readInts(row.data(), (int)row.size(), valueRange.first, valueRange.second);  // advance to account for unused rows
 	}
 	return table;
 }
@@ -355,6 +472,8 @@ template<class T>
 void CircularGenome<T>::setupCircularGenome(int _size, double _alphabetSize) {
 	sites.resize(_size);
 	alphabetSize = _alphabetSize;
+	mutation = CircularGenomeParameters::getMutation(PT);
+	sitesChanged();
 	// define columns to be written to genome files
 	genomeFileColumns.clear();
 	genomeFileColumns.push_back("update");
@@ -425,9 +544,12 @@ std::shared_ptr<AbstractGenome> CircularGenome<T>::makeCopy(std::shared_ptr<Para
 		PT_ = PT;
 	}
 
-	auto newGenome = std::make_shared<CircularGenome>(alphabetSize, 1, PT_);
+	auto newGenome = Pool::make<CircularGenome>(alphabetSize, 1, PT_);
 
 	newGenome->sites = sites; 
+	newGenome->sitesID = sitesID;
+	newGenome->history = history;
+	newGenome->codonIndex = codonIndex;
 	newGenome->countPoint = countPoint;
 	newGenome->countPointOffset = countPointOffset;
 	newGenome->countDelete = countDelete;
@@ -442,7 +564,7 @@ std::shared_ptr<AbstractGenome> CircularGenome<T>::makeCopy(std::shared_ptr<Para
 template<class T>
 std::shared_ptr<AbstractGenome::Handler> CircularGenome<T>::newHandler(std::shared_ptr<AbstractGenome> _genome, bool _readDirection) {
 	//cout << "In Genome::newHandler()" << endl;
-	return std::make_shared<Handler>(_genome, _readDirection);
+	return Pool::make<Handler>(_genome, _readDirection);
 }
 
 template<class T> int CircularGenome<T>::size() {
@@ -457,30 +579,38 @@ double CircularGenome<T>::getAlphabetSize() {
 // randomize this genomes contents
 template<class T>
 void CircularGenome<T>::fillRandom() {
+	size_t hint = 0;
 	for (size_t i = 0; i < sites.size(); i++) {
-		sites[i] = (T) Random::getDouble(alphabetSize);
+		sites.set(i, (T) Random::getDouble(alphabetSize), hint);
 	}
+	sitesChanged();
 }
 
 template<> inline void CircularGenome<double>::fillRandom() {
+	size_t hint = 0;
 	for (size_t i = 0; i < sites.size(); i++) {
-		sites[i] = Random::getDouble(0, alphabetSize);
+		sites.set(i, Random::getDouble(0, alphabetSize), hint);
 	}
+	sitesChanged();
 }
 
 template<> inline void CircularGenome<bool>::fillRandom() {
+	size_t hint = 0;
 	for (size_t i = 0; i < sites.size(); i++) {
-		sites[i] = (bool)((int)Random::getDouble(alphabetSize));
+		sites.set(i, (bool)((int)Random::getDouble(alphabetSize)), hint);
 	}
+	sitesChanged();
 }
 
 // fill all sites of this genome with ascending values
 // This function is to make testing easy.
 template<class T>
 void CircularGenome<T>::fillAcending() {
+	size_t hint = 0;
 	for (size_t i = 0; i < sites.size(); i++) {
-		sites[i] = ((int)i) % (int) alphabetSize;
+		sites.set(i, ((int)i) % (int) alphabetSize, hint);
 	}
+	sitesChanged();
 }
 
 // fill all sites of this genome with value
@@ -488,9 +618,11 @@ void CircularGenome<T>::fillAcending() {
 // This function is to make testing easy.
 template<class T>
 void CircularGenome<T>::fillConstant(int value) {
+	size_t hint = 0;
 	for (size_t i = 0; i < sites.size(); i++) {
-		sites[i] = value;
+		sites.set(i, value, hint);
 	}
+	sitesChanged();
 }
 
 // Copy functions
@@ -501,10 +633,10 @@ template<class T>
 void CircularGenome<T>::copyFrom(std::shared_ptr<AbstractGenome> from) {
 	auto castFrom = std::dynamic_pointer_cast<CircularGenome<T>>(from);  // we will be pulling all sorts of stuff from this genome so lets just cast it once.
 	alphabetSize = castFrom->alphabetSize;
-	sites.clear();
-	for (auto site : castFrom->sites) {
-		sites.push_back(site);
-	}
+	sites = castFrom->sites; // (shares all blocks until either genome changes)
+	sitesID = castFrom->sitesID;
+	history.copied(castFrom->sitesID, (int)sites.size());
+	codonIndex = castFrom->codonIndex;
 	countPoint = castFrom->countPoint;
 	countPointOffset = castFrom->countPointOffset;
 	countDelete = castFrom->countDelete;
@@ -536,13 +668,21 @@ bool CircularGenome<T>::isEmpty() {
 // if range is provied (not -1) then the new value will be within +/- range of current value
 template<class T>
 void CircularGenome<T>::pointMutate(double range) {
+	size_t hint = 0;
+	int siteIndex = Random::getIndex((int)sites.size());
+	pointMutateAt(siteIndex, range, hint);
+	sitesID = SiteHistory::newSitesID();
+	history.changed(siteIndex, 1);
+}
+
+template<class T>
+void CircularGenome<T>::pointMutateAt(int siteIndex, double range, size_t &hint) {
 	if (range == -1) {
-		sites[Random::getIndex((int)sites.size())] = Random::getIndex((int)alphabetSize);
+		sites.set(siteIndex, Random::getIndex((int)alphabetSize), hint);
 	}
 	else {
-		int siteIndex = Random::getIndex((int)sites.size());
 		int offsetValue;
-		if (CircularGenomeParameters::mutationPointOffsetUniformPL->get(PT) == true) {
+		if (mutation->pointOffsetUniform) {
 			offsetValue = Random::getInt(1, range) * ((Random::getIndex(2) * 2.0) - 1.0);
 			// note! if range < 1 then all offsetValues will be 0, if range >= 1 offsetValues
 			// will always be either >= 1 or <= -1
@@ -550,27 +690,25 @@ void CircularGenome<T>::pointMutate(double range) {
 		else { //normal/gaussian
 			offsetValue = (int)Random::getNormal(0, range);
 		}
-		sites[siteIndex] = std::max(0, std::min((int)alphabetSize - 1, sites[siteIndex] + offsetValue));
+		sites.set(siteIndex, std::max(0, std::min((int)alphabetSize - 1, sites.get(siteIndex, hint) + offsetValue)), hint);
 	}
 }
 
 template<>
-void CircularGenome<double>::pointMutate(double range) {
+void CircularGenome<double>::pointMutateAt(int siteIndex, double range, size_t &hint) {
 	if (range == -1) {
-		sites[Random::getIndex((int)sites.size())] = Random::getDouble(alphabetSize);
+		sites.set(siteIndex, Random::getDouble(alphabetSize), hint);
 	}
 	else {
-		int siteIndex = Random::getIndex((int)sites.size());
-		bool pointOffsetUniform = false;
 		double offsetValue;
-		if (CircularGenomeParameters::mutationPointOffsetUniformPL->get(PT) == true) {
+		if (mutation->pointOffsetUniform) {
 			offsetValue = Random::getDouble(-range, range);
 		}
 		else { //normal/gaussian
 			offsetValue = Random::getNormal(0, range);
 		}
 		double maxValue = alphabetSize - (std::nextafter(alphabetSize, DBL_MAX) - alphabetSize); // next smallest double value for alphabetSize
-		sites[siteIndex] = std::max(0.0, std::min(maxValue, sites[siteIndex] + (offsetValue)));
+		sites.set(siteIndex, std::max(0.0, std::min(maxValue, sites.get(siteIndex, hint) + (offsetValue))), hint);
 	}
 }
 
@@ -602,26 +740,37 @@ int CircularGenome<T>::incrementIndel() {
 // apply mutations to this genome
 template<class T>
 void CircularGenome<T>::mutate() {
-	int howManyPoint = Random::getBinomial((int)sites.size(), CircularGenomeParameters::mutationPointRatePL->get(PT));
-	int howManyPointOffset = Random::getBinomial((int)sites.size(), CircularGenomeParameters::mutationPointOffsetRatePL->get(PT));
-	int howManyCopy = Random::getBinomial((int)sites.size(), CircularGenomeParameters::mutationCopyRatePL->get(PT));
-	int howManyDelete = Random::getBinomial((int)sites.size(), CircularGenomeParameters::mutationDeleteRatePL->get(PT));
-	int howManyIndel = Random::getBinomial((int)sites.size(), CircularGenomeParameters::mutationIndelRatePL->get(PT));
-	// do some point mutations
-	for (int i = 0; i < howManyPoint; i++) {
-		pointMutate();
-		incrementPoint();
-	}
-	// do some pointOffset mutations
-	double pointOffsetRange = CircularGenomeParameters::mutationPointOffsetRangePL->get(PT);
-	for (int i = 0; i < howManyPointOffset; i++) {
-		pointMutate(pointOffsetRange);
-		incrementPointOffset();
+	int sitesCount = (int)sites.size();
+	sitesID = SiteHistory::newSitesID();
+	// do some point and pointOffset mutations. each site is hit with the point
+	// rate and (separately) with the pointOffset rate; the hits of both are
+	// visited in one pass, in site order (a site hit by both gets the point
+	// mutation first)
+	size_t hint = 0;
+	int nextPoint = mutation->point.next(0);
+	int nextPointOffset = mutation->pointOffset.next(0);
+	while (nextPoint < sitesCount || nextPointOffset < sitesCount) {
+		if (nextPoint <= nextPointOffset) {
+			pointMutateAt(nextPoint, -1, hint);
+			history.changed(nextPoint, 1);
+			incrementPoint();
+			nextPoint = mutation->point.next(nextPoint + 1);
+		}
+		else {
+			pointMutateAt(nextPointOffset, mutation->pointOffsetRange, hint);
+			history.changed(nextPointOffset, 1);
+			incrementPointOffset();
+			nextPointOffset = mutation->pointOffset.next(nextPointOffset + 1);
+		}
 	}
+	// counts for the other mutations are drawn from the size before any of them
+	int howManyCopy = mutation->copy.count(sitesCount);
+	int howManyDelete = mutation->deletion.count(sitesCount);
+	int howManyIndel = mutation->indel.count(sitesCount);
 	// do some copy mutations
-	int MaxGenomeSize = CircularGenomeParameters::sizeMaxPL->get(PT);
-	int IMax = CircularGenomeParameters::mutationCopyMaxSizePL->get(PT);
-	int IMin = CircularGenomeParameters::mutationCopyMinSizePL->get(PT);
+	int MaxGenomeSize = mutation->sizeMax;
+	int IMax = mutation->copyMaxSize;
+	int IMin = mutation->copyMinSize;
 	for (int i = 0; (i < howManyCopy) && (((int)sites.size()) < MaxGenomeSize); i++) {
 		//chromosome->mutateCopy(PT.lookup("mutationCopyMinSize"), PT.lookup("mutationCopyMaxSize"), PT.lookup("chromosomeSizeMax"));
 
@@ -636,23 +785,20 @@ void CircularGenome<T>::mutate() {
 			exit(1);
 		}
 		int segmentStart = Random::getInt((int)sites.size() - segmentSize);
-		std::vector<T> segment;
-		segment.clear();
-		auto it = sites.begin();
-		segment.insert(segment.begin(), it + segmentStart, it + segmentStart + segmentSize);
 
 		////insertSegment(segment);
-		it = sites.begin();
-		sites.insert(it + Random::getInt((int)sites.size()), segment.begin(), segment.end());
+		int insertIndex = Random::getInt((int)sites.size());
+		sites.insert(insertIndex, sites, segmentStart, segmentStart + segmentSize);
+		history.inserted(insertIndex, segmentSize);
 
 		//cout << sites.size() << endl;
 
 		incrementCopy();
 	}
 	// do some deletion mutations
-	int MinGenomeSize = CircularGenomeParameters::sizeMinPL->get(PT);
-	int DMax = CircularGenomeParameters::mutationDeleteMaxSizePL->get(PT);
-	int DMin = CircularGenomeParameters::mutationDeleteMinSizePL->get(PT);
+	int MinGenomeSize = mutation->sizeMin;
+	int DMax = mutation->deleteMaxSize;
+	int DMin = mutation->deleteMinSize;
 	for (int i = 0; (i < howManyDelete) && (((int)sites.size()) > MinGenomeSize); i++) {
 		//chromosome->mutateDelete(PT.lookup("mutationDeletionMinSize"), PT.lookup("mutationDeletionMaxSize"), PT.lookup("chromosomeSizeMin"));
 
@@ -665,15 +811,16 @@ void CircularGenome<T>::mutate() {
 			exit(1);
 		}
 		int segmentStart = Random::getInt(((int)sites.size()) - segmentSize);
-		sites.erase(sites.begin() + segmentStart, sites.begin() + segmentStart + segmentSize);
+		sites.erase(segmentStart, segmentStart + segmentSize);
+		history.erased(segmentStart, segmentSize);
 
 		incrementDelete();
 	}
 	// do some combination insertion-deletion (indel) mutations
-	int IDMax = CircularGenomeParameters::mutationIndelMaxSizePL->get(PT);
-	int IDMin = CircularGenomeParameters::mutationIndelMinSizePL->get(PT);
-	bool copyFirst = CircularGenomeParameters::mutationIndelCopyFirstPL->get(PT);
-	int insertMethod = CircularGenomeParameters::mutationIndelInsertMethodPL->get(PT);
+	int IDMax = mutation->indelMaxSize;
+	int IDMin = mutation->indelMinSize;
+	bool copyFirst = mutation->indelCopyFirst;
+	int insertMethod = mutation->indelInsertMethod;
 
 	for (int i = 0; i < howManyIndel; i++) {
 
@@ -686,16 +833,14 @@ void CircularGenome<T>::mutate() {
 		}
 
 		// create a new genome segment
-		std::vector<T> segment;
-		auto it = sites.begin(); // i.e. iterator
+		ChunkedVector<T> segment;
 
 		if (copyFirst) {
 			// if copy before delete
 			// copy a portion of the genome into segment
 			int segmentStart = Random::getInt((int)sites.size() - segmentSize); // where to copy from
 			int deleteStart = Random::getInt((int)sites.size() - segmentSize); // where to delete from
-			segment.clear();
-			segment.insert(segment.begin(), it + segmentStart, it + segmentStart + segmentSize);
+			segment = sites.slice(segmentStart, segmentStart + segmentSize);
 
 /*
             std::cout << "\ncopyFirst\ngenome: ";
@@ -711,7 +856,8 @@ void CircularGenome<T>::mutate() {
 */
 
 			// delete a portion of the genome of the same size
-			sites.erase(it + deleteStart, it + deleteStart + segmentSize);
+			sites.erase(deleteStart, deleteStart + segmentSize);
+			history.erased(deleteStart, segmentSize);
 
 /*
 			std::cout << "\ngenome after delete: ";
@@ -722,18 +868,22 @@ void CircularGenome<T>::mutate() {
 			// insert the copied sites back into genome
 			if (insertMethod == 0) {
 				// copy to random location
-				sites.insert(it + Random::getInt((int)sites.size()), segment.begin(), segment.end());
+				int insertIndex = Random::getInt((int)sites.size());
+				sites.insert(insertIndex, segment, 0, segment.size());
+				history.inserted(insertIndex, segmentSize);
 			}
 			else if (insertMethod == 1) {
 				// replace deleted segment
-				sites.insert(it + deleteStart, segment.begin(), segment.end());
+				sites.insert(deleteStart, segment, 0, segment.size());
+				history.inserted(deleteStart, segmentSize);
 			}
 			else if (insertMethod == 2) {
 				// insert segment just in front of copied sites
 				if (segmentStart > deleteStart) { // note if deleteStart is in copied segment things are weird.
 					segmentStart -= deleteStart;  // but no matter what we do, it's going to be weird...
 				}
-				sites.insert(it + segmentStart, segment.begin(), segment.end());
+				sites.insert(segmentStart, segment, 0, segment.size());
+				history.inserted(segmentStart, segmentSize);
 			}
 /*
 			std::cout << "\ngenome after insert: ";
@@ -746,7 +896,8 @@ void CircularGenome<T>::mutate() {
 			// delete before copy (deleted sites cannot be copied)
 			// delete a portion of the genome
 			int deleteStart = Random::getInt((int)sites.size() - segmentSize); // where to delete from
-			sites.erase(it + deleteStart, it + deleteStart + segmentSize);
+			sites.erase(deleteStart, deleteStart + segmentSize);
+			history.erased(deleteStart, segmentSize);
 
             if (segmentSize > sites.size()){
                 std::cout << "ERROR: in curlarGenome<T>::mutate(), segmentSize for indel is > then sites.size() after deletion!\nUse a larger genome relitive to Indel min/max.\nExiting!" << std::endl;
@@ -755,21 +906,24 @@ void CircularGenome<T>::mutate() {
             }
 			// copy a portion of the genome into segment
 			int segmentStart = Random::getInt((int)sites.size() - segmentSize);
-			segment.clear();
-			segment.insert(segment.begin(), it + segmentStart, it + segmentStart + segmentSize);
+			segment = sites.slice(segmentStart, segmentStart + segmentSize);
 
 			// insert the copied sites back into genome
 			if (insertMethod == 0) {
 				// copy to random location
-				sites.insert(it + Random::getInt((int)sites.size()), segment.begin(), segment.end());
+				int insertIndex = Random::getInt((int)sites.size());
+				sites.insert(insertIndex, segment, 0, segment.size());
+				history.inserted(insertIndex, segmentSize);
 			}
 			else if (insertMethod == 1) {
 				// replace deleted segment
-				sites.insert(it + deleteStart, segment.begin(), segment.end());
+				sites.insert(deleteStart, segment, 0, segment.size());
+				history.inserted(deleteStart, segmentSize);
 			}
 			else if (insertMethod == 2) {
 				// insert segment just in front of copied sites
-				sites.insert(it + segmentStart, segment.begin(), segment.end());
+				sites.insert(segmentStart, segment, 0, segment.size());
+				history.inserted(segmentStart, segmentSize);
 			}
 		}
 		incrementIndel();
@@ -780,7 +934,7 @@ void CircularGenome<T>::mutate() {
 // inherit the ParamatersTable from the calling instance
 template<class T>
 std::shared_ptr<AbstractGenome> CircularGenome<T>::makeMutatedGenomeFrom(std::shared_ptr<AbstractGenome> parent) {
-	auto newGenome = std::make_shared<CircularGenome<T>>(PT);
+	auto newGenome = Pool::make<CircularGenome<T>>(PT);
 	newGenome->copyFrom(parent);
     newGenome->mutate();
 	newGenome->recordDataMap();
@@ -800,7 +954,7 @@ std::shared_ptr<AbstractGenome> CircularGenome<T>::makeMutatedGenomeFromMany(std
 	// first, check to make sure that parent genomes are conpatable.
 	auto castParent0 = std::dynamic_pointer_cast<CircularGenome<T>>(parents[0]);  // we will be pulling all sorts of stuff from this genome so lets just cast it once.
 
-	auto newGenome = std::make_shared<CircularGenome<T>>(castParent0->alphabetSize,0,PT);
+	auto newGenome = Pool::make<CircularGenome<T>>(castParent0->alphabetSize,0,PT);
 	//newGenome->alphabetSize = castParent0->alphabetSize;
 
 //	vector<std::shared_ptr<AbstractChromosome>> parentChromosomes;
@@ -821,14 +975,14 @@ std::shared_ptr<AbstractGenome> CircularGenome<T>::makeMutatedGenomeFromMany(std
 		//cout << "many parent" << endl;
 
 		// extract the sites list from each parent
-		std::vector<std::vector<T>> parentSites;
+		std::vector<ChunkedVector<T>> parentSites;
 		for (auto parent : parents) {
 			parentSites.push_back(std::dynamic_pointer_cast<CircularGenome<T>>(parent)->sites);
 		}
 
 		// randomly determine crossCount number crossLocations
 		std::vector<double> crossLocations;
-		int crossCount = CircularGenomeParameters::mutationCrossCountPL->get(PT);
+		int crossCount = mutation->crossCount;
 		for (int i = 0; i < crossCount; i++) {  // get some cross locations (% of length of chromosome)
 			crossLocations.push_back(Random::getDouble(1.0));
 		}
@@ -856,9 +1010,10 @@ std::shared_ptr<AbstractGenome> CircularGenome<T>::makeMutatedGenomeFromMany(std
 			lastPick = pick;
 			// add the segment to this chromosome
 			//cout << "(" << parentSites[pick].size() << ") "<< c << ": " << (int)((double)parentSites[pick].size()*crossLocations[c]) << " " << (int)((double)parentSites[pick].size()*crossLocations[c+1]) << " " << flush;
-			newGenome->sites.insert(newGenome->sites.end(), parentSites[pick].begin() + (int) ((double) parentSites[pick].size() * crossLocations[c]), parentSites[pick].begin() + (int) ((double) parentSites[pick].size() * crossLocations[c + 1]));
+			newGenome->sites.insert(newGenome->sites.size(), parentSites[pick], (int) ((double) parentSites[pick].size() * crossLocations[c]), (int) ((double) parentSites[pick].size() * crossLocations[c + 1]));
 			//cout << " ++ " << flush;
 		}
+		newGenome->sitesChanged();
 	}
 	newGenome->mutate();
 	newGenome->recordDataMap();
@@ -866,6 +1021,123 @@ std::shared_ptr<AbstractGenome> CircularGenome<T>::makeMutatedGenomeFromMany(std
 	return newGenome;
 }
 
+// Site history and start codon index functions (see SiteHistory.h and CodonIndex.h)
+
+template<class T>
+void CircularGenome<T>::sitesChanged() {
+	sitesID = SiteHistory::newSitesID();
+	history.forget();
+}
+
+template<class T>
+int CircularGenome<T>::parentSiteIndex(long long _sitesID, int index, int count) {
+	if (_sitesID == 0) {
+		return -1;
+	}
+	if (_sitesID == sitesID) {
+		return (index >= 0 && count >= 0 && index + count <= (int)sites.size()) ? index : -1;
+	}
+	if (_sitesID == history.parentSitesID) {
+		return history.parentIndex(index, count);
+	}
+	return -1;
+}
+
+// the same number of sites Handler::readInt(0, codonMax) reads
+template<class T>
+int CircularGenome<T>::codonWidth(int codonMax) {
+	int width = 1;
+	double currentMax = alphabetSize;
+	while ((codonMax + 1) > currentMax) {
+		width++;
+		currentMax = currentMax * alphabetSize;
+	}
+	return width;
+}
+
+template<>
+int CircularGenome<double>::codonWidth(int codonMax) {
+	return 1;
+}
+
+template<class T>
+int CircularGenome<T>::codonAt(int siteIndex, int codonMax, int width, size_t &hint) {
+	int value = (int)sites.get(siteIndex, hint);
+	for (int i = 1; i < width; i++) {
+		value = (value * (int)alphabetSize) + (int)sites.get(siteIndex + i, hint);
+	}
+	return value % (codonMax + 1);
+}
+
+template<>
+int CircularGenome<double>::codonAt(int siteIndex, int codonMax, int width, size_t &hint) {
+	return (int)((sites.get(siteIndex, hint) / alphabetSize) * (codonMax + 1));
+}
+
+// the index is made from the index of the parent (if this genome is a
+// mutated copy of a genome which had an index), or else by reading all sites
+template<class T>
+std::shared_ptr<const CodonIndex> CircularGenome<T>::getCodonIndex(std::shared_ptr<const StartCodons> codons) {
+	if (sitesID == 0) {
+		sitesChanged();
+	}
+	if (codonIndex != nullptr && codonIndex->codons == codons && codonIndex->sitesID == sitesID) {
+		return codonIndex;
+	}
+	int width = codonWidth(codons->codonMax);
+	int lastStart = (int)sites.size() - (2 * width) - 1; // (the scan stops when the start codon would reach the end of the genome)
+	auto newIndex = Pool::make<CodonIndex>();
+	newIndex->codons = codons;
+	newIndex->sitesID = sitesID;
+	newIndex->genomeSize = (int)sites.size();
+	newIndex->codonWidth = width;
+
+	size_t hint = 0;
+	auto tryStart = [&](int siteIndex) {
+		int first = codonAt(siteIndex, codons->codonMax, width, hint);
+		int second = codons->second[first];
+		if (second >= 0 && codonAt(siteIndex + width, codons->codonMax, width, hint) == second) {
+			newIndex->starts.push_back(siteIndex);
+		}
+	};
+
+	auto parentIndex = codonIndex;
+	if (parentIndex != nullptr && parentIndex->codons == codons && parentIndex->codonWidth == width &&
+		history.parentSitesID != 0 && parentIndex->sitesID == history.parentSitesID) {
+		// runs of sites copied from the parent keep the parent's start codons, as
+		// long as the whole start codon is in the run (and the parent checked there)
+		int parentLastStart = parentIndex->genomeSize - (2 * width) - 1;
+		int runStart = 0;
+		for (auto &run : history.runs) {
+			int runEnd = std::min(runStart + run.size, lastStart + 1); // (exclusive)
+			int siteIndex = runStart;
+			if (run.parentIndex >= 0) {
+				int copiedEnd = std::min(runStart + run.size - (2 * width) + 1, runEnd);
+				copiedEnd = std::min(copiedEnd, runStart + (parentLastStart - run.parentIndex) + 1);
+				if (copiedEnd > siteIndex) {
+					int shift = runStart - run.parentIndex;
+					auto start = std::lower_bound(parentIndex->starts.begin(), parentIndex->starts.end(), siteIndex - shift);
+					auto end = std::lower_bound(start, parentIndex->starts.end(), copiedEnd - shift);
+					for (; start != end; ++start) {
+						newIndex->starts.push_back(*start + shift);
+					}
+					siteIndex = copiedEnd;
+				}
+			}
+			for (; siteIndex < runEnd; siteIndex++) {
+				tryStart(siteIndex);
+			}
+			runStart += run.size;
+		}
+	} else {
+		for (int siteIndex = 0; siteIndex <= lastStart; siteIndex++) {
+			tryStart(siteIndex);
+		}
+	}
+	codonIndex = newIndex;
+	return codonIndex;
+}
+
 // IO and Data Management functions
 
 // gets data about genome which can be added to a data map
@@ -889,10 +1161,32 @@ template<class T>
 DataMap CircularGenome<T>::serialize(std::string& name) {
 	DataMap serialDataMap;
 	serialDataMap.set(name + "_genomeLength", countSites());
-	serialDataMap.set(name + "_sites", genomeToStr());
+	serialDataMap.set(name + "_sites", AbstractGenome::useBinarySites(PT) ? genomeToBinary() : genomeToStr());
 	return serialDataMap;
 }
 
+template<class T>
+std::string CircularGenome<T>::genomeToBinary() {
+	std::string bytes;
+	SitesEncoding::SiteWriter<T> writer(bytes);
+	sites.forEach([&writer](T site) { writer.add(site); });
+	writer.finish();
+	return SitesEncoding::toBase64(bytes);
+}
+
+template<class T>
+void CircularGenome<T>::genomeFromBinary(const std::string& allSites, int genomeLength) {
+	std::string bytes = SitesEncoding::fromBase64(allSites);
+	size_t position = 0;
+	SitesEncoding::SiteReader<T> reader(bytes, position);
+	sites.clear();
+	sitesChanged();
+	for (int i = 0; i < genomeLength; i++) {
+		sites.push_back(reader.next());
+	}
+	SitesEncoding::checkAllRead(bytes, position);
+}
+
 // given a DataMap and PT, return genome [name] from the DataMap
 template<class T>
 void CircularGenome<T>::deserialize(std::shared_ptr<ParametersTable> PT, std::unordered_map<std::string, std::string>& orgData, std::string& name) {
@@ -908,10 +1202,15 @@ void CircularGenome<T>::deserialize(std::shared_ptr<ParametersTable> PT, std::un
 	convertString(orgData[name + "_genomeLength"], genomeLength);
 
 	std::string allSites = orgData[name + "_sites"];
+	if (SitesEncoding::isBinary(allSites)) {
+		genomeFromBinary(allSites, genomeLength);
+		return;
+	}
 	std::stringstream ss(allSites);
 
   bool streamNotEmpty(true);
 	sites.clear();
+	sitesChanged();
   streamNotEmpty = static_cast<bool>(ss >> nextChar);
 	for (int i = 0; i < genomeLength; i++) {
 		nextString = "";
@@ -942,9 +1241,14 @@ void CircularGenome<unsigned char>::deserialize(std::shared_ptr<ParametersTable>
 	convertString(orgData[name + "_genomeLength"], genomeLength);
 
 	std::string allSites = orgData[name + "_sites"];
+	if (SitesEncoding::isBinary(allSites)) {
+		genomeFromBinary(allSites, genomeLength);
+		return;
+	}
 	std::stringstream ss(allSites);
 
 	sites.clear();
+	sitesChanged();
   bool streamNotEmpty(true);
   streamNotEmpty = static_cast<bool>(ss >> nextChar);
 	for (int i = 0; i < genomeLength; i++) {
@@ -1052,10 +1356,13 @@ std::string CircularGenome<T>::genomeToStr() {
 	std::stringstream ss;
 	ss << "";
 
-	for (size_t i = 0; i < sites.size()-1; i++) {
-		ss << sites[i] << FileManager::separator;
-	}
-	ss << sites[sites.size() - 1];
+	size_t i = 0;
+	sites.forEach([&](T site) {
+		ss << site;
+		if (++i < sites.size()) {
+			ss << FileManager::separator;
+		}
+	});
 	return ss.str();
 }
 
@@ -1064,10 +1371,13 @@ std::string CircularGenome<unsigned char>::genomeToStr() {
 	std::stringstream ss;
 	ss << "";
 
-	for (size_t i = 0; i < sites.size() - 1; i++) {
-		ss << (int)sites[i] << FileManager::separator;
-	}
-	ss << (int)sites[sites.size() - 1] << "";
+	size_t i = 0;
+	sites.forEach([&](unsigned char site) {
+		ss << (int)site;
+		if (++i < sites.size()) {
+			ss << FileManager::separator;
+		}
+	});
 	return ss.str();
 }
 
@@ -23,7 +23,12 @@
 #include <Utilities/Data.h>
 #include <Utilities/Parameters.h>
 #include <Utilities/Random.h>
+#include <Utilities/ChunkedVector.h>
+#include <Utilities/Pool.h>
+#include <Utilities/SiteSampler.h>
+#include <Utilities/SitesEncoding.h>
 #include <Genome/AbstractGenome.h>
+#include <Genome/SiteHistory.h>
 
 // needed to move static values to own class because of templating.
 class CircularGenomeParameters {
@@ -49,6 +54,31 @@ public:
 	static std::shared_ptr<ParameterLink<int>> mutationIndelInsertMethodPL;
 	static std::shared_ptr<ParameterLink<bool>> mutationIndelCopyFirstPL;
 
+	// the mutation parameters, as looked up in one ParametersTable
+	struct Mutation {
+		SiteSampler point;
+		SiteSampler pointOffset;
+		double pointOffsetRange;
+		bool pointOffsetUniform;
+		SiteSampler copy;
+		int copyMinSize;
+		int copyMaxSize;
+		SiteSampler deletion;
+		int deleteMinSize;
+		int deleteMaxSize;
+		int sizeMax;
+		int sizeMin;
+		SiteSampler indel;
+		int indelMinSize;
+		int indelMaxSize;
+		int indelInsertMethod;
+		bool indelCopyFirst;
+		int crossCount;
+	};
+	// mutation parameters for PT. These are looked up the first time a genome
+	// is made with PT and then shared by all genomes made with it, so changes to
+	// PT after that are not seen by mutate.
+	static std::shared_ptr<const Mutation> getMutation(std::shared_ptr<ParametersTable> PT);
 };
 
 template<class T>
@@ -60,6 +90,7 @@ public:
 	public:
 		std::shared_ptr<CircularGenome> genome;
 		int siteIndex;
+		size_t blockHint = 0; // block of sites used by the last read or write
 
 		Handler() = delete;
 
@@ -93,6 +124,8 @@ public:
 		virtual void printIndex() override;
 		virtual int readInt(int valueMin, int valueMax, int code = -1, int CodingRegionIndex = 0) override;
 		virtual double readDouble(double valueMin, double valueMax, int code = -1, int CodingRegionIndex = 0) override;
+		virtual void readInts(int *values, int count, int valueMin, int valueMax, int code = -1, int CodingRegionIndex = 0) override;
+		virtual void readDoubles(double *values, int count, double valueMin, double valueMax, int code = -1, int CodingRegionIndex = 0) override;
 
 		virtual void writeInt(int value, int valueMin, int valueMax) override;
 		virtual void writeDouble(double value, double valueMin, double valueMax) override;
@@ -107,10 +140,21 @@ public:
 		virtual void randomize() override;
 		virtual std::vector<std::vector<int>> readTable(std::pair<int, int> tableSize, std::pair<int, int> tableMaxSize, std::pair<int, int> valueRange, int code = -1, int CodingRegionIndex = 0) override;
 
+	private:
+		// read the site at siteIndex and advance (the same as advanceIndex(), without a virtual call)
+		T nextSite();
 	};
 
-	std::vector<T> sites;
+	ChunkedVector<T> sites; // offspring share unchanged blocks of sites with their parents
 	double alphabetSize;
+	std::shared_ptr<const CircularGenomeParameters::Mutation> mutation; // (set up from PT)
+
+	// sitesID changes whenever sites change; history records how sites changed
+	// since this genome was copied from its parent (see SiteHistory.h)
+	long long sitesID = 0;
+	SiteHistory history;
+	// the last start codon index made (for this genome, or inherited from the parent)
+	std::shared_ptr<const CodonIndex> codonIndex;
 
 	CircularGenome() = delete;
 
@@ -164,6 +208,8 @@ public:
 	virtual bool isEmpty() override;
 
 	virtual void pointMutate(double range = -1);
+	// mutate the site at siteIndex (see pointMutate). hint is passed on to sites
+	virtual void pointMutateAt(int siteIndex, double range, size_t &hint);
 
 	int countPoint = 0;
 	int countPointOffset = 0;
@@ -207,8 +253,26 @@ public:
 	virtual DataMap serialize(std::string& name) override;
 	virtual void deserialize(std::shared_ptr<ParametersTable> PT, std::unordered_map<std::string, std::string>& orgData, std::string& name) override;
 
+	// sites packed into bytes, in base64 (see Utilities/SitesEncoding.h)
+	virtual std::string genomeToBinary();
+	// set sites from genomeToBinary output
+	virtual void genomeFromBinary(const std::string& allSites, int genomeLength);
+
 	virtual void recordDataMap() override;
 
+	// call when sites have been changed other than by mutate
+	void sitesChanged();
+
+	virtual std::shared_ptr<const CodonIndex> getCodonIndex(std::shared_ptr<const StartCodons> codons) override;
+	virtual long long getSitesID() override {
+		return sitesID;
+	}
+	virtual int parentSiteIndex(long long _sitesID, int index, int count) override;
+	// sites per codon when reading codons in [0, codonMax]
+	int codonWidth(int codonMax);
+	// the codon read from sites starting at siteIndex (as Handler::readInt(0, codonMax) would read it)
+	int codonAt(int siteIndex, int codonMax, int width, size_t &hint);
+
 	// load all genomes from a file
 	//virtual void loadGenomeFile(string fileName, vector<std::shared_ptr<AbstractGenome>> &genomes) override;
 // load a genome from CSV file with headers - will return genome from saved organism with key / keyvalue pair
@@ -0,0 +1,39 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+// A CodonIndex lists where start codons are in a genome, so that genes can be
+// found without reading every site (see AbstractGenome::getCodonIndex).
+// Codons are read as ints in [0, codonMax], the same way Handler::readInt
+// reads them; a start codon is two codons read one after the other. Every
+// site is tried as the start of a start codon, except the last sites (where
+// reading the start codon would reach the end of the genome).
+// Genomes which keep an index update it from their parent's index when they
+// are mutated (see SiteHistory.h), rather than reading all their sites again.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+// the start codons to look for
+struct StartCodons {
+	int codonMax;
+	// second[codon] is the codon which must follow codon to make a start
+	// codon, or -1 if codon does not begin a start codon (size codonMax + 1)
+	std::vector<int> second;
+};
+
+struct CodonIndex {
+	std::shared_ptr<const StartCodons> codons;
+	long long sitesID;   // contents of the genome this index was made from (see SiteHistory.h)
+	int genomeSize;
+	int codonWidth;      // sites read for each codon
+	std::vector<int> starts; // sites where start codons begin, in order
+};
@@ -19,6 +19,7 @@
 #include "../../../Utilities/Data.h"
 #include "../../../Utilities/Parameters.h"
 #include "../../../Utilities/Random.h"
+#include "../../../Utilities/SiteSampler.h"
 
 class AbstractChromosome {
 public:
@@ -88,6 +89,24 @@ public:
 
   virtual std::string chromosomeToStr() = 0;
 
+  // append the sites of this chromosome to bytes, packed as described in
+  // Utilities/SitesEncoding.h
+  virtual void writeSites(std::string &bytes) {
+    std::cout << "ERROR: writeSites(std::string &bytes) in AbstractChromosome "
+            "was called!\n This has not been implemented yet the chromosome "
+            "class you are using!\n";
+    exit(1);
+  }
+  // set this chromosome to _chromosomeLength sites read from bytes (written by
+  // writeSites), starting at position (which is moved past them)
+  virtual void readSites(const std::string &bytes, size_t &position,
+                         int _chromosomeLength) {
+    std::cout << "ERROR: readSites(const std::string &bytes, size_t &position, "
+            "int _chromosomeLength) in AbstractChromosome was called!\n This "
+            "has not been implemented yet the chromosome class you are using!\n";
+    exit(1);
+  }
+
   virtual void resize(int size) {
     std::cout << "ERROR: resize(int size) in AbstractChromosome was called!\n This "
             "has not been implemented yet the chromosome class you are "
@@ -148,6 +167,14 @@ public:
     exit(1);
   }
 
+  // point mutate each site hit by sampler
+  virtual void mutatePoints(const SiteSampler &sampler) {
+    std::cout << "ERROR: mutatePoints(const SiteSampler &sampler) in "
+            "AbstractChromosome was called!\n This has not been implemented "
+            "yet the chromosome class you are using!\n";
+    exit(1);
+  }
+
   virtual void mutateCopy(int minSize, int maxSize, int chromosomeSizeMax) {
     std::cout << "ERROR: mutateCopy(int minSize, int maxSize, int "
             "chromosomeSizeMax) in AbstractChromosome was called!\n This has "
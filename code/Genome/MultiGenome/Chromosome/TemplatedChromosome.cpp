@@ -411,6 +411,27 @@ void TemplatedChromosome<unsigned char>::readChromosomeFromSS(
   // cout << endl;
 }
 
+template <class T>
+void TemplatedChromosome<T>::writeSites(std::string &bytes) {
+  SitesEncoding::SiteWriter<T> writer(bytes);
+  for (auto site : sites) {
+    writer.add(site);
+  }
+  writer.finish();
+}
+
+template <class T>
+void TemplatedChromosome<T>::readSites(const std::string &bytes,
+                                       size_t &position,
+                                       int _chromosomeLength) {
+  SitesEncoding::SiteReader<T> reader(bytes, position);
+  sites.clear();
+  sites.reserve(_chromosomeLength);
+  for (int i = 0; i < _chromosomeLength; i++) {
+    sites.push_back(reader.next());
+  }
+}
+
 // convert a chromosome to a string
 template <class T> std::string TemplatedChromosome<T>::chromosomeToStr() {
   //	string S = "";
@@ -524,6 +545,13 @@ template <class T> void TemplatedChromosome<T>::mutatePoint() {
   sites[Random::getIndex(sites.size())] = (T)Random::getDouble(alphabetSize);
 }
 
+template <class T>
+void TemplatedChromosome<T>::mutatePoints(const SiteSampler &sampler) {
+  sampler.forEach((int)sites.size(), [this](int site) {
+    sites[site] = (T)Random::getDouble(alphabetSize);
+  });
+}
+
 // mutate chromosome by getting a copy of a segment of this chromosome and
 // inserting that segment randomly into this chromosome
 template <class T>
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "AbstractChromosome.h"
+#include "../../../Utilities/SitesEncoding.h"
 
 template <class T> class TemplatedChromosome : public AbstractChromosome {
   std::vector<T> sites;
@@ -73,9 +74,7 @@ public:
   // return true if siteIndex went out of range
   virtual inline bool advanceIndex(int &siteIndex, bool readDirection = 1,
                                    int distance = 1) override {
-    std::string rd = (readDirection) ? "forward " + std::to_string(distance)
-                                : "backward " + std::to_string(distance);
-    // cout << " In advanceIndex " << rd << endl;
+    // cout << " In advanceIndex " << (readDirection ? "forward " : "backward ") << distance << endl;
     siteIndex += (readDirection) ? distance : (-1 * distance); // move index
     return modulateIndex(siteIndex); // confirm that new index is in range
   }
@@ -126,6 +125,9 @@ public:
                                     int _chromosomeLength) override;
   // convert a chromosome to a string
   virtual std::string chromosomeToStr() override;
+  virtual void writeSites(std::string &bytes) override;
+  virtual void readSites(const std::string &bytes, size_t &position,
+                         int _chromosomeLength) override;
   virtual void resize(int size) override;
   virtual int size() override;
   virtual DataMap getFixedStats() override;
@@ -147,6 +149,8 @@ public:
   // random.
   virtual void insertSegment(std::shared_ptr<AbstractChromosome> segment) override;
   virtual void mutatePoint() override;
+  // point mutate each site hit by sampler, in one pass over the sites
+  virtual void mutatePoints(const SiteSampler &sampler) override;
   // mutate chromosome by getting a copy of a segment of this chromosome and
   // inserting that segment randomly into this chromosome
   virtual void mutateCopy(int minSize, int maxSize,
@@ -11,6 +11,8 @@
 #include "MultiGenome.h"
 #include <Global.h>
 
+#include <mutex>
+
 // Initialize Parameters
 
 std::shared_ptr<ParameterLink<int>> MultiGenome::initialPloidyPL = Parameters::register_parameter("GENOME_MULTI-chromosome_ploidy", 1, "number of chromosomes in each chromosome_set");
@@ -267,8 +269,34 @@ std::vector<std::vector<int>> MultiGenome::Handler::readTable(
 	return table;
 }
 
+std::shared_ptr<const MultiGenome::Mutation> MultiGenome::getMutation(std::shared_ptr<ParametersTable> PT) {
+	static std::mutex lock; // (genomes may be made on more then one thread)
+	static std::unordered_map<long long, std::shared_ptr<const Mutation>> mutations;
+	if (PT == nullptr) {
+		PT = Parameters::root;
+	}
+	std::lock_guard<std::mutex> guard(lock);
+	auto &cached = mutations[PT->getID()];
+	if (cached == nullptr) {
+		auto mutation = std::make_shared<Mutation>();
+		mutation->point = SiteSampler(pointMutationRatePL->get(PT));
+		mutation->insertion = SiteSampler(insertionRatePL->get(PT));
+		mutation->insertionMinSize = insertionMinSizePL->get(PT);
+		mutation->insertionMaxSize = insertionMaxSizePL->get(PT);
+		mutation->deletion = SiteSampler(deletionRatePL->get(PT));
+		mutation->deletionMinSize = deletionMinSizePL->get(PT);
+		mutation->deletionMaxSize = deletionMaxSizePL->get(PT);
+		mutation->maxChromosomeSize = maxChromosomeSizePL->get(PT);
+		mutation->minChromosomeSize = minChromosomeSizePL->get(PT);
+		mutation->crossCount = crossCountPL->get(PT);
+		cached = mutation;
+	}
+	return cached;
+}
+
 // make an empty genome and ploidy = 1
 MultiGenome::MultiGenome(std::shared_ptr<ParametersTable> PT_) : AbstractGenome(PT_){
+	mutation = getMutation(PT);
 
 	//initialPloidyLPL = (PT == nullptr) ? initialGenomeSizePL : Parameters::getIntLink("GENOME_CIRCULAR-sizeInitial", PT);;
 	//initialChromosomesLPL = ;
@@ -415,19 +443,16 @@ void MultiGenome::mutate() {
 	for (auto chromosome : chromosomes) {
 		int nucleotides = chromosome->size();
 
-		int howManyPoint = Random::getBinomial(nucleotides, pointMutationRatePL->get(PT));
-		int howManyCopy = Random::getBinomial(nucleotides, insertionRatePL->get(PT));
-		int howManyDelete = Random::getBinomial(nucleotides, deletionRatePL->get(PT));
+		int howManyCopy = mutation->insertion.count(nucleotides);
+		int howManyDelete = mutation->deletion.count(nucleotides);
 
 
-		// do some point mutations
-		for (int i = 0; i < howManyPoint; i++) {
-			chromosome->mutatePoint();
-		}
+		// do some point mutations (each site is hit with the point rate)
+		chromosome->mutatePoints(mutation->point);
 		// do some copy mutations
-		int MaxChromosomeSize = maxChromosomeSizePL->get(PT);
-		int IMax = insertionMaxSizePL->get(PT);
-		int IMin = insertionMinSizePL->get(PT);
+		int MaxChromosomeSize = mutation->maxChromosomeSize;
+		int IMax = mutation->insertionMaxSize;
+		int IMin = mutation->insertionMinSize;
 		//if (nucleotides < (PT == nullptr) ? *deletionRate : PT->lookupInt("GENOME_MULTI_chromosomeSizeMax")) {
 		for (int i = 0; i < howManyCopy && (nucleotides < MaxChromosomeSize); i++) {
 			chromosome->mutateCopy(IMin, IMax, MaxChromosomeSize);
@@ -436,9 +461,9 @@ void MultiGenome::mutate() {
 		//}
 		// do some deletion mutations
 
-		int MinChromosomeSize = minChromosomeSizePL->get(PT);
-		int DMax = deletionMaxSizePL->get(PT);
-		int DMin = deletionMinSizePL->get(PT);
+		int MinChromosomeSize = mutation->minChromosomeSize;
+		int DMax = mutation->deletionMaxSize;
+		int DMin = mutation->deletionMinSize;
 
 		//if (nucleotides > PT.lookup("GENOME_MULTI_chromosomeSizeMin")) {
 			for (int i = 0; i < howManyDelete && (nucleotides > MinChromosomeSize); i++) {
@@ -494,7 +519,7 @@ std::shared_ptr<AbstractGenome> MultiGenome::makeMutatedGenomeFromMany(std::vect
 	}
 	auto newGenome = std::make_shared<MultiGenome>(PT);
 	newGenome->ploidy = castParent0->ploidy;  // copy ploidy from 0th parent
-	int crossCount = crossCountPL->get(PT);
+	int crossCount = mutation->crossCount;
 	if (ploidy == 1) {  // if haploid then cross chromosomes from all parents
 		for (size_t i = 0; i < castParent0->chromosomes.size(); i++) {
 			newGenome->chromosomes.push_back(castParent0->chromosomes[0]->makeLike());
@@ -552,7 +577,16 @@ DataMap MultiGenome::serialize(std::string& name) {
 	chromosomeLengths.pop_back();
 	chromosomeLengths += "";
 	serialDataMap.set(name + "_chromosomeLengths", chromosomeLengths);
-	serialDataMap.set(name + "_sites", genomeToStr());
+	if (AbstractGenome::useBinarySites(PT)) {
+		std::string bytes;
+		for (auto chromosome : chromosomes) {
+			chromosome->writeSites(bytes);
+		}
+		serialDataMap.set(name + "_sites", SitesEncoding::toBase64(bytes));
+	}
+	else {
+		serialDataMap.set(name + "_sites", genomeToStr());
+	}
 	return serialDataMap;
 }
 
@@ -568,6 +602,15 @@ void MultiGenome::deserialize(std::shared_ptr<ParametersTable> PT, std::unordere
 	convertCSVListToVector(orgData[name + "_chromosomeLengths"], _chromosomeLengths);
 	std::string sitesType = AbstractGenome::genomeSitesTypePL->get(PT);
 	std::string allSites = orgData[name + "_sites"];
+	if (SitesEncoding::isBinary(allSites)) {
+		std::string bytes = SitesEncoding::fromBase64(allSites);
+		size_t position = 0;
+		for (size_t i = 0; i < _chromosomeLengths.size(); i++) {
+			chromosomes[i]->readSites(bytes, position, _chromosomeLengths[i]);
+		}
+		SitesEncoding::checkAllRead(bytes, position);
+		return;
+	}
 	std::stringstream ss(allSites);
 
 	char nextChar;
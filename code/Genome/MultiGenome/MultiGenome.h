@@ -22,6 +22,8 @@
 #include <Utilities/Data.h>
 #include <Utilities/Parameters.h>
 #include <Utilities/Random.h>
+#include <Utilities/SiteSampler.h>
+#include <Utilities/SitesEncoding.h>
 #include "Chromosome/AbstractChromosome.h"
 #include "Chromosome/TemplatedChromosome.h"
 #include <Genome/AbstractGenome.h>
@@ -45,6 +47,25 @@ public:
   static std::shared_ptr<ParameterLink<int>>
       crossCountPL; // number of crosses to make when performing crossover
 
+  // the mutation parameters, as looked up in one ParametersTable
+  struct Mutation {
+    SiteSampler point;
+    SiteSampler insertion;
+    int insertionMinSize;
+    int insertionMaxSize;
+    SiteSampler deletion;
+    int deletionMinSize;
+    int deletionMaxSize;
+    int maxChromosomeSize;
+    int minChromosomeSize;
+    int crossCount;
+  };
+  // mutation parameters for PT. These are looked up the first time a genome
+  // is made with PT and then shared by all genomes made with it.
+  static std::shared_ptr<const Mutation>
+  getMutation(std::shared_ptr<ParametersTable> PT);
+  std::shared_ptr<const Mutation> mutation; // (set up from PT)
+
   // std::shared_ptr<ParameterLink<int>> initialPloidyLPL;
   // std::shared_ptr<ParameterLink<int>> initialChromosomesLPL;
   // std::shared_ptr<ParameterLink<int>> initialChromosomeSizeLPL;
@@ -0,0 +1,151 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+// SiteHistory records where the sites of a genome came from in the genome it
+// was copied from (its parent), as the genome is mutated. The genome is kept
+// as a list of runs; each run is either sites copied unchanged from a run of
+// parent sites, or new sites (point mutated, inserted...).
+// This lets work done on the parent (see CodonIndex.h and
+// ClassicGateListBuilder) be reused for the parts of the genome that did not
+// change.
+// Sites contents are identified by a sitesID (see newSitesID), which a genome
+// changes whenever any of its sites change.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+class SiteHistory {
+public:
+	struct Run {
+		int size;
+		int parentIndex; // index of the first site of this run in the parent, -1 for new sites
+	};
+
+	// sitesID of the parent when it was copied, 0 if the sites can not be traced back to a parent
+	long long parentSitesID = 0;
+	std::vector<Run> runs; // (in site order, sizes add up to the genome size)
+
+	// a new id for the contents of a genome (never 0)
+	static long long newSitesID() {
+		static std::atomic<long long> nextID(1);
+		return nextID++;
+	}
+
+	// sites were changed in a way that is not recorded
+	void forget() {
+		parentSitesID = 0;
+		runs.clear();
+	}
+
+	// the genome is now an unchanged copy of a genome of size sites with sitesID parentID
+	void copied(long long parentID, int size) {
+		parentSitesID = parentID;
+		runs.clear();
+		if (size > 0) {
+			runs.push_back({ size, 0 });
+		}
+	}
+
+	// count sites starting at index were given new values
+	void changed(int index, int count) {
+		if (parentSitesID == 0 || count <= 0) {
+			return;
+		}
+		size_t first = split(index);
+		size_t last = split(index + count);
+		runs.erase(runs.begin() + first, runs.begin() + last);
+		runs.insert(runs.begin() + first, { count, -1 });
+		merge(first);
+	}
+
+	// count new sites were inserted before site index
+	void inserted(int index, int count) {
+		if (parentSitesID == 0 || count <= 0) {
+			return;
+		}
+		size_t at = split(index);
+		runs.insert(runs.begin() + at, { count, -1 });
+		merge(at);
+	}
+
+	// count sites starting at index were removed
+	void erased(int index, int count) {
+		if (parentSitesID == 0 || count <= 0) {
+			return;
+		}
+		size_t first = split(index);
+		size_t last = split(index + count);
+		runs.erase(runs.begin() + first, runs.begin() + last);
+		if (first > 0) {
+			merge(first - 1);
+		}
+	}
+
+	// if the count sites starting at index are all unchanged parent sites (in
+	// the same order, with nothing inserted or removed between them) the index
+	// of the first of them in the parent, else -1
+	int parentIndex(int index, int count) const {
+		if (parentSitesID == 0 || index < 0) {
+			return -1;
+		}
+		int runStart = 0;
+		for (auto &run : runs) {
+			if (index < runStart + run.size) {
+				if (run.parentIndex < 0 || index + count > runStart + run.size) {
+					return -1;
+				}
+				return run.parentIndex + (index - runStart);
+			}
+			runStart += run.size;
+		}
+		return -1;
+	}
+
+private:
+	// make sure that a run starts at site index, and return that run (or
+	// runs.size() if index is at or past the end)
+	size_t split(int index) {
+		int runStart = 0;
+		for (size_t r = 0; r < runs.size(); r++) {
+			if (index == runStart) {
+				return r;
+			}
+			if (index < runStart + runs[r].size) {
+				Run tail = { runStart + runs[r].size - index, runs[r].parentIndex < 0 ? -1 : runs[r].parentIndex + (index - runStart) };
+				runs[r].size = index - runStart;
+				runs.insert(runs.begin() + r + 1, tail);
+				return r + 1;
+			}
+			runStart += runs[r].size;
+		}
+		return runs.size();
+	}
+
+	// join run r with its neighbors where they are both new, or where they
+	// continue the same run of parent sites
+	void merge(size_t r) {
+		auto joins = [this](size_t a) {
+			return a + 1 < runs.size() &&
+				((runs[a].parentIndex < 0 && runs[a + 1].parentIndex < 0) ||
+				 (runs[a].parentIndex >= 0 && runs[a].parentIndex + runs[a].size == runs[a + 1].parentIndex));
+		};
+		if (r + 1 < runs.size() && joins(r)) {
+			runs[r].size += runs[r + 1].size;
+			runs.erase(runs.begin() + r + 1);
+		}
+		if (r > 0 && r < runs.size() && joins(r - 1)) {
+			runs[r - 1].size += runs[r].size;
+			runs.erase(runs.begin() + r);
+		}
+	}
+};
@@ -41,6 +41,34 @@ std::shared_ptr<ParameterLink<std::string>> Global::outputPrefixPL =
     Parameters::register_parameter(
         "GLOBAL-outputPrefix", std::string("./"),
         "Directory and prefix specifying where data files will be written");
+std::shared_ptr<ParameterLink<bool>> Global::asyncOutputPL =
+    Parameters::register_parameter(
+        "GLOBAL-asyncOutput", true,
+        "if true, data files are written by a background thread so that the "
+        "run does not wait on the disk (files are brought up to date after "
+        "each update is archived and at the end of the run)");
+std::shared_ptr<ParameterLink<int>> Global::outputQueueSizePL =
+    Parameters::register_parameter(
+        "GLOBAL-outputQueueSize", 64,
+        "if asyncOutput, the most data (in MB) that can be waiting to be "
+        "written before the run waits for the disk");
+std::shared_ptr<ParameterLink<bool>> Global::reportAllocationsPL =
+    Parameters::register_parameter(
+        "GLOBAL-reportAllocations", false,
+        "if true, after each update show how many times (and how many KB) "
+        "the object pools that hold organisms, genomes, brains and data maps "
+        "went to the heap in that update. once the population has reached "
+        "its working size this should be (close to) 0");
+std::shared_ptr<ParameterLink<bool>> Global::recordTimingPL =
+    Parameters::register_parameter(
+        "GLOBAL-recordTiming", false,
+        "if true, time each phase of each update (evaluate, optimize, archive "
+        "and cleanup, and within them brain building, genome mutation and "
+        "file output) and write the times, pool heap allocations and peak "
+        "memory to timing.csv. a summary is shown at the end of the run. "
+        "time spent in a phase on several threads at once is counted once, "
+        "and the allocations counted are only the object pools' (see "
+        "GLOBAL-reportAllocations)");
 
 // shared_ptr<ParameterLink<string>> Global::groupNameSpacesPL =
 // Parameters::register_parameter("GLOBAL-groups", (string) "[]", "name spaces
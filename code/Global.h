@@ -41,6 +41,14 @@ public:
 
   static std::shared_ptr<ParameterLink<std::string>>
       outputPrefixPL; // where files will be written
+  static std::shared_ptr<ParameterLink<bool>>
+      asyncOutputPL; // if true, files are written on a background thread
+  static std::shared_ptr<ParameterLink<int>>
+      outputQueueSizePL; // MB of output that can wait to be written
+  static std::shared_ptr<ParameterLink<bool>>
+      reportAllocationsPL; // if true, show heap allocations made by Pool each update
+  static std::shared_ptr<ParameterLink<bool>>
+      recordTimingPL; // if true, time each phase of each update (see Timing.h)
 
   // static shared_ptr<ParameterLink<string>> groupNameSpacesPL;
 
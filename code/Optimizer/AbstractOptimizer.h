@@ -34,6 +34,10 @@ public:
   std::unordered_set<std::shared_ptr<Organism>>
       killList; // set of organisms to be killed after archive
 
+  // where optimize prints its report (an IslandsOptimizer gives each island
+  // its own stream, so islands optimized on other threads do not share cout)
+  std::ostream *output = &std::cout;
+
   AbstractOptimizer(std::shared_ptr<ParametersTable> PT_) : PT(PT_) {}
 
   virtual ~AbstractOptimizer() = default;
@@ -11,6 +11,9 @@
 
 #include "IslandsOptimizer.h"
 
+#include <algorithm>
+#include <unordered_map>
+
 std::shared_ptr<ParameterLink<std::string>> IslandsOptimizer::IslandNameSpaceListPL =
 Parameters::register_parameter(
 	"OPTIMIZER_ISLANDS-IslandNameSpaceList", static_cast<std::string>("Tmin::,Roul::,Tmin::Ts50::,Tmax::"),
@@ -32,6 +35,21 @@ std::shared_ptr<ParameterLink<double>> IslandsOptimizer::migrationRatePL =
 Parameters::register_parameter(
 	"OPTIMIZER_ISLANDS-migrationRate", .02,
 	"% of new organisms which migrate to a random island at birth");
+std::shared_ptr<ParameterLink<int>> IslandsOptimizer::migrationIntervalPL =
+Parameters::register_parameter(
+	"OPTIMIZER_ISLANDS-migrationInterval", 1,
+	"migrants are exchanged every this many updates. organisms born since the last exchange\n"
+	"may migrate (with migrationRate)");
+std::shared_ptr<ParameterLink<int>> IslandsOptimizer::maxMigrantsPL =
+Parameters::register_parameter(
+	"OPTIMIZER_ISLANDS-maxMigrants", -1,
+	"most organisms which may leave an island in one exchange, -1 = no limit");
+std::shared_ptr<ParameterLink<int>> IslandsOptimizer::islandThreadsPL =
+Parameters::register_parameter(
+	"OPTIMIZER_ISLANDS-islandThreads", 1,
+	"number of threads used to optimize islands, 1 = run on main thread, 0 = one thread per\n"
+	"hardware thread (the results do not depend on this; island optimizers, and the genomes\n"
+	"and brains they copy, must be safe to use on a worker thread)");
 
 IslandsOptimizer::IslandsOptimizer(std::shared_ptr<ParametersTable> PT_)
     : AbstractOptimizer(PT_) {
@@ -50,6 +68,17 @@ IslandsOptimizer::IslandsOptimizer(std::shared_ptr<ParametersTable> PT_)
 	}
 
 	migrationRate = migrationRatePL->get(PT);
+	migrationInterval = std::max(1, migrationIntervalPL->get(PT));
+	maxMigrants = maxMigrantsPL->get(PT);
+	islandThreads = islandThreadsPL->get(PT);
+
+	islandPopulations.resize(islands);
+	islandOutput.resize(islands);
+	for (size_t island = 0; island < islands; island++) {
+		islandOptimizers[island]->output = &islandOutput[island];
+	}
+	islandStagings.resize(islands);
+	outboxes.resize(islands);
 
 	// leave this undefined so that max.csv is not generated
 	//optimizeFormula = optimizeValueMT;
@@ -58,85 +87,264 @@ IslandsOptimizer::IslandsOptimizer(std::shared_ptr<ParametersTable> PT_)
 	// since diffrent optimizers may generate diffrent values, we will leave this empty
 }
 
-void IslandsOptimizer::optimize(std::vector<std::shared_ptr<Organism>> &population) {
-	std::vector<std::vector<std::shared_ptr<Organism>>> islandPopulations(islands);
+void IslandsOptimizer::partition(std::vector<std::shared_ptr<Organism>> &population) {
+	size_t index = 0;
+	bool matches = true;
+	for (size_t island = 0; island < islands && matches; island++) {
+		for (auto &org : islandPopulations[island]) {
+			if (index >= population.size() || population[index] != org) {
+				matches = false;
+				break;
+			}
+			index++;
+		}
+	}
+	if (matches && index == population.size()) {
+		return; // population is still the islands, one after the other
+	}
+
+	// otherwise, put organisms back on the island they were on (if they have
+	// one) or on a random island
+	auto islandKey = DataMap::lookupKey("IsOp_island");
+	for (auto &islandPopulation : islandPopulations) {
+		islandPopulation.clear();
+	}
+	for (auto &org : population) {
+		int island = -1;
+		if (org->dataMap.fieldExists(islandKey)) {
+			island = org->dataMap.getIntVector(islandKey)[0];
+		}
+		if (island < 0 || island >= static_cast<int>(islands)) {
+			island = Random::getIndex(islands);
+			org->dataMap.set(islandKey, island);
+		}
+		islandPopulations[island].push_back(org);
+	}
+}
+
+void IslandsOptimizer::optimizeIsland(size_t island) {
+	Random::UseGenerator useGenerator(islandGenerators[island]);
+	int provisionalID = -2;
+	Organism::provisionalIDCounter() = &provisionalID;
+	Phylogeny::threadStaging() = &islandStagings[island];
+	islandOutput[island].str("");
 
-	int popSize = static_cast<int>(population.size());
-	if (Global::update == 0) {
-		for (auto org : population) {
-			org->dataMap.set("IsOp_island", Random::getIndex(islands));
+	auto &islandPopulation = islandPopulations[island];
+	islandOptimizers[island]->optimize(islandPopulation);
+
+	// pick this island's migrants (organisms born since the last exchange)
+	outboxes[island].clear();
+	if (Global::update - lastMigration >= migrationInterval) {
+		auto &islandKillList = islandOptimizers[island]->killList;
+		for (auto &org : islandPopulation) {
+			if (maxMigrants >= 0 && static_cast<int>(outboxes[island].size()) >= maxMigrants) {
+				break;
+			}
+			if (org->timeOfBirth > lastMigration && islandKillList.find(org) == islandKillList.end() &&
+				Random::P(migrationRate)) {
+				int destination = Random::getIndex(islands);
+				if (destination != static_cast<int>(island)) {
+					outboxes[island].push_back({ org, destination });
+				}
+			}
+		}
+	}
+
+	Phylogeny::threadStaging() = nullptr;
+	Organism::provisionalIDCounter() = nullptr;
+}
+
+void IslandsOptimizer::optimize(std::vector<std::shared_ptr<Organism>> &population) {
+	if (islandGenerators.empty()) {
+		// one draw from the common generator seeds every island's stream
+		auto &common = Random::getCommonGenerator();
+		uint64_t islandSeed = static_cast<uint64_t>(common());
+		islandSeed = (islandSeed << 32) ^ static_cast<uint64_t>(common());
+		islandGenerators.resize(islands);
+		for (size_t island = 0; island < islands; island++) {
+			Random::seedGenerator(islandGenerators[island], Random::getStreamSeed(islandSeed, island));
 		}
 		allKeys = population[0]->dataMap.getKeys(); // get all keys from a dataMap before optimizing
 		sort(allKeys.begin(), allKeys.end());
 	}
+	partition(population);
 
-	for (auto org : population) {
-		islandPopulations[org->dataMap.getIntVector("IsOp_island")[0]].push_back(org);
+	int threadCount = std::min(ThreadPool::resolveThreadCount(islandThreads), static_cast<int>(islands));
+	if (threadCount <= 1) {
+		for (size_t island = 0; island < islands; island++) {
+			optimizeIsland(island);
+		}
 	}
+	else {
+		if (islandPool == nullptr || islandPool->size() != threadCount) {
+			islandPool = std::make_shared<ThreadPool>(threadCount);
+		}
+		islandPool->parallelFor(islands, [this](size_t island, int) { optimizeIsland(island); });
+	}
+	Phylogeny::get().merge(islandStagings);
 
-	population.clear();
+	// in island order: print what each island printed, give new organisms
+	// their ids (in the order they were made) and collect the kill lists
 	killList.clear();
-	std::cout << "\n  optimizing...";
-	for (size_t island = 0; island < islands; island++){
-		std::cout << "\n    island " << island << " : " << islandOptimizers[island]->PT->getTableNameSpace() << "   (" << islandPopulations[island].size() << ")  ";
-		islandOptimizers[island]->optimize(islandPopulations[island]);
-		for (auto org : islandPopulations[island]) {
-			population.push_back(org);
-			if (org->timeOfBirth == Global::update) { // if an org is brand new there is a chance is will migrate
-				if (Random::P(migrationRate)) { // chance for migration
-					org->dataMap.set("IsOp_island", Random::getIndex(islands));
-				}
-				else { // stay on your island
-					org->dataMap.set("IsOp_island", static_cast<int>(island));
-				}
+	*output << "\n  optimizing...";
+	std::vector<std::shared_ptr<Organism>> newOrgs;
+	for (size_t island = 0; island < islands; island++) {
+		*output << "\n    island " << island << " : " << islandOptimizers[island]->PT->getTableNameSpace() << "   (" << islandPopulations[island].size() << ")  ";
+		*output << islandOutput[island].str();
+		newOrgs.clear();
+		for (auto &org : islandPopulations[island]) {
+			if (org->hasProvisionalID()) {
+				newOrgs.push_back(org);
 			}
 		}
-		for (auto org : islandOptimizers[island]->killList) {
+		for (auto &org : islandOptimizers[island]->killList) {
 			killList.insert(org);
+			if (org->hasProvisionalID()) {
+				newOrgs.push_back(org);
+			}
+		}
+		std::sort(newOrgs.begin(), newOrgs.end(), [](const std::shared_ptr<Organism> &a, const std::shared_ptr<Organism> &b) {
+			return a->ID > b->ID; // provisional ids count down
+		});
+		newOrgs.erase(std::unique(newOrgs.begin(), newOrgs.end()), newOrgs.end()); // (in both lists)
+		for (auto &org : newOrgs) {
+			org->assignID();
 		}
 	}
 
+	if (Global::update - lastMigration >= migrationInterval) {
+		lastMigration = Global::update;
+	}
+
 	// now, look at how dataMaps were changed by island optimizers, and figure out what will
 	// need to be added so that all orgs have the same values in their data maps
-	if (Global::update == 0) {
-		for (auto ipop : islandPopulations) {
-			// for each island, look at the 0th organisms datamap, and see if it adds any columns
-			auto thisIslandsKeys = ipop[0]->dataMap.getKeys();
-			sort(thisIslandsKeys.begin(), thisIslandsKeys.end());
-			std::vector<std::string> diff;
-			std::set_difference(thisIslandsKeys.begin(), thisIslandsKeys.end(),
-				allKeys.begin(), allKeys.end(), // allKeys was generated above and already sorted.
-				std::inserter(diff, diff.begin()));
-			for (auto s : diff) { // add each new column name to fillerLookup with information about wether this column is a number of string
-				fillerLookup[s] = ipop[0]->dataMap.lookupDataMapTypeName(ipop[0]->dataMap.findKeyInData(s)) == "string";
+	if (!fillerKeysFound) {
+		findFillerKeys();
+	}
+
+	// new organisms are given their island and any missing columns (every
+	// other organism already has them)
+	auto islandKey = DataMap::lookupKey("IsOp_island");
+	population.clear();
+	for (size_t island = 0; island < islands; island++) {
+		for (auto &org : islandPopulations[island]) {
+			if (org->timeOfBirth == Global::update) {
+				org->dataMap.set(islandKey, static_cast<int>(island));
+				fill(org, island);
 			}
 		}
-		// now we know all the new columns
-		for (size_t i = 0; i < islandPopulations.size(); i++) {
-			// for each island, again look at the 0th element, but this time, make a list for each island of the
-			// columns we will need to add
-			fillerKeys.push_back({}); // add an empty vector for this island
-			for (auto fillerPair : fillerLookup) {
-				auto thisIslandsKeys = islandPopulations[i][0]->dataMap.getKeys();
-				if (find(thisIslandsKeys.begin(), thisIslandsKeys.end(), fillerPair.first) == thisIslandsKeys.end()){ // if not found
-					fillerKeys[i].push_back(fillerPair.first); // this key is missing from this islands organisms, add it to the fillerKeys for that island
-				}
+		population.insert(population.end(), islandPopulations[island].begin(), islandPopulations[island].end());
+	}
+}
+
+void IslandsOptimizer::findFillerKeys() {
+	// fillerLookup: the type of each column ("bool", "double", "int" or "string")
+	std::map<std::string, std::string> fillerLookup;
+	for (auto &ipop : islandPopulations) {
+		if (ipop.empty()) {
+			return; // try again next update
+		}
+	}
+	for (auto &ipop : islandPopulations) {
+		// for each island, look at the 0th organisms datamap, and see if it adds any columns
+		auto thisIslandsKeys = ipop[0]->dataMap.getKeys();
+		sort(thisIslandsKeys.begin(), thisIslandsKeys.end());
+		std::vector<std::string> diff;
+		std::set_difference(thisIslandsKeys.begin(), thisIslandsKeys.end(),
+			allKeys.begin(), allKeys.end(), // allKeys was generated before the first update and already sorted.
+			std::inserter(diff, diff.begin()));
+		for (auto s : diff) { // add each new column name to fillerLookup with information about wether this column is a number of string
+			fillerLookup[s] = ipop[0]->dataMap.lookupDataMapTypeName(ipop[0]->dataMap.findKeyInData(s));
+		}
+	}
+	// now we know all the new columns
+	fillerKeys.assign(islands, {});
+	for (size_t i = 0; i < islands; i++) {
+		// for each island, again look at the 0th element, but this time, make a list for each island of the
+		// columns we will need to add
+		auto &dataMap = islandPopulations[i][0]->dataMap;
+		for (auto fillerPair : fillerLookup) {
+			auto keyID = DataMap::lookupKey(fillerPair.first);
+			if (!dataMap.fieldExists(keyID)) { // this key is missing from this islands organisms
+				fillerKeys[i].push_back({ keyID, fillerPair.second });
 			}
 		}
 	}
+	fillerKeysFound = true;
 
-	// add missing columns to dataMaps
-	// fillerKeys tells us for each island what we need to add
-	// fillerLookup tells us the type of the data that we need to add (0 = number, 1 = string)
-	for (auto org : population) {
-		for (auto key : fillerKeys[org->dataMap.getIntVector("IsOp_island")[0]]) {
-			if (fillerLookup[key] == 0) {
-				org->dataMap.set(key, 0);
+	// organisms which were here before the filler keys were known
+	for (size_t island = 0; island < islands; island++) {
+		for (auto &org : islandPopulations[island]) {
+			fill(org, island);
+		}
+	}
+}
+
+void IslandsOptimizer::fill(const std::shared_ptr<Organism> &org, size_t island) {
+	if (!fillerKeysFound) {
+		return;
+	}
+	// (numbers are written with the type the column has on the islands which
+	// add it, so an organism which migrates there can be given real values)
+	for (auto &key : fillerKeys[island]) {
+		if (key.second == "string") {
+			org->dataMap.set(key.first, (std::string)"---");
+		}
+		else if (key.second == "double") {
+			org->dataMap.set(key.first, 0.0);
+		}
+		else if (key.second == "bool") {
+			org->dataMap.set(key.first, false);
+		}
+		else {
+			org->dataMap.set(key.first, 0);
+		}
+	}
+}
+
+void IslandsOptimizer::cleanup(std::vector<std::shared_ptr<Organism>> &population) {
+	// each island's optimizer cleans up its own island (some optimizers, i.e.
+	// Lexicase, do more here than remove their killList)
+	for (size_t island = 0; island < islands; island++) {
+		islandOptimizers[island]->cleanup(islandPopulations[island]);
+	}
+
+	// exchange migrants: each island keeps the organisms which did not leave
+	// (in order) and then takes the arrivals (in order of the island they left)
+	std::vector<std::vector<std::shared_ptr<Organism>>> arrivals(islands);
+	std::unordered_map<Organism *, int> leaving;
+	for (size_t island = 0; island < islands; island++) {
+		if (outboxes[island].empty()) {
+			continue;
+		}
+		leaving.clear();
+		for (auto &migrant : outboxes[island]) {
+			leaving[migrant.org.get()] = migrant.destination;
+		}
+		outboxes[island].clear();
+		auto &islandPopulation = islandPopulations[island];
+		size_t kept = 0;
+		for (size_t i = 0; i < islandPopulation.size(); i++) {
+			auto destination = leaving.find(islandPopulation[i].get());
+			if (destination == leaving.end()) {
+				islandPopulation[kept++] = islandPopulation[i];
 			}
 			else {
-				org->dataMap.set(key, (std::string)"---");
+				arrivals[destination->second].push_back(islandPopulation[i]);
 			}
 		}
+		islandPopulation.resize(kept);
 	}
-}
 
+	auto islandKey = DataMap::lookupKey("IsOp_island");
+	population.clear();
+	for (size_t island = 0; island < islands; island++) {
+		for (auto &org : arrivals[island]) {
+			org->dataMap.set(islandKey, static_cast<int>(island));
+			fill(org, island);
+			islandPopulations[island].push_back(org);
+		}
+		population.insert(population.end(), islandPopulations[island].begin(), islandPopulations[island].end());
+	}
+	killList.clear();
+}
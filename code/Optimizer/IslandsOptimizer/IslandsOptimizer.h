@@ -13,29 +13,78 @@
 #include <module_factories.h>
 
 #include <Optimizer/AbstractOptimizer.h>
+#include <Organism/Phylogeny.h>
 #include <Utilities/MTree.h>
+#include <Utilities/ThreadPool.h>
 
 #include <iostream>
 #include <sstream>
 
-
+// the population is kept as one contiguous block per island (island 0 first).
+// each island is optimized by its own optimizer with its own random stream,
+// on a worker thread if islandThreads allows, so a run gives the same result
+// with any number of threads. migrants are exchanged between islands every
+// migrationInterval updates.
 class IslandsOptimizer : public AbstractOptimizer {
 public:
 
 	static std::shared_ptr<ParameterLink<std::string>> IslandNameSpaceListPL;
 	static std::shared_ptr<ParameterLink<double>> migrationRatePL;
+	static std::shared_ptr<ParameterLink<int>> migrationIntervalPL;
+	static std::shared_ptr<ParameterLink<int>> maxMigrantsPL;
+	static std::shared_ptr<ParameterLink<int>> islandThreadsPL;
 
 	std::vector <std::shared_ptr<AbstractOptimizer>> islandOptimizers;
 	size_t islands;
 	double migrationRate;
+	int migrationInterval;
+	int maxMigrants;
+	int islandThreads;
+
+	// islandPopulations[i] is island i's block of population (as of the end
+	// of the last optimize / cleanup)
+	std::vector<std::vector<std::shared_ptr<Organism>>> islandPopulations;
+	std::vector<Random::Generator> islandGenerators; // one stream per island
+	// each island's optimizer prints to its stream (so islands can print from
+	// worker threads), and the streams are printed in island order
+	std::vector<std::ostringstream> islandOutput;
+	// organisms made (or deleted) while an island is optimized change the
+	// island's staging rather than the phylogeny, and the stagings are merged
+	// into the phylogeny once every island is done
+	std::vector<Phylogeny::Staging> islandStagings;
+	std::shared_ptr<ThreadPool> islandPool; // created on first use
+	int lastMigration = -1; // update of the last migration
+
+	// an organism leaving its island for another island. migrants are picked
+	// when an island is optimized, and move in cleanup (if their island's
+	// optimizer did not remove them)
+	struct Migrant {
+		std::shared_ptr<Organism> org;
+		int destination;
+	};
+	std::vector<std::vector<Migrant>> outboxes; // per island, for this update
+
 	std::vector<std::string> allKeys;
-	std::vector<std::vector<std::string>> fillerKeys;
-	std::map<std::string,int> fillerLookup; // if int = 0 (int,double,bool), write 0, else  (string) write "---"
+	// per island, columns other islands add which this island does not, and
+	// the type of each (strings are filled with "---" and numbers with 0)
+	std::vector<std::vector<std::pair<DataMap::KeyID, std::string>>> fillerKeys;
+	bool fillerKeysFound = false;
 
 	std::shared_ptr<Abstract_MTree> nextPopSizeMT;
 
 	IslandsOptimizer(std::shared_ptr<ParametersTable> PT_ = nullptr);
 
 	virtual void optimize(std::vector<std::shared_ptr<Organism>> &population) override;
-};
+	virtual void cleanup(std::vector<std::shared_ptr<Organism>> &population) override;
 
+private:
+	// make islandPopulations match population (only needed if population was
+	// not left by this optimizer, i.e. on the first update)
+	void partition(std::vector<std::shared_ptr<Organism>> &population);
+	// run island's optimizer with its generator, output and organism ids
+	// kept to this island
+	void optimizeIsland(size_t island);
+	// work out fillerKeys from the columns each island's optimizer added
+	void findFillerKeys();
+	void fill(const std::shared_ptr<Organism> &org, size_t island);
+};
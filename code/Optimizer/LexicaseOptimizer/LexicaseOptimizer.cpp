@@ -9,9 +9,12 @@
 //         github.com/Hintzelab/MABE/wiki/License
 
 #include "LexicaseOptimizer.h"
+#include <Utilities/BitOps.h>
 #include <iostream>
 #include <numeric>
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <vector>
 #include <memory>
 
@@ -66,6 +69,7 @@ LexicaseOptimizer::LexicaseOptimizer(std::shared_ptr<ParametersTable> PT_)
 
 	for (auto s : optimizeFormulasStrings) {
 		optimizeFormulasMTs.push_back(stringToMTree(s));
+		optimizeFormulasPrograms.emplace_back(optimizeFormulasMTs.back());
 	}
 
 	// get names to use with scores
@@ -110,75 +114,142 @@ LexicaseOptimizer::LexicaseOptimizer(std::shared_ptr<ParametersTable> PT_)
 	}
 }
 
-// return n nonrepeating elements for [0..m)
-auto m_choose_n = [](auto const m, auto const n) {
-	std::vector<int> v(m);
-	std::iota(std::begin(v), std::end(v), 0);
-	std::shuffle(std::begin(v), std::end(v), Random::getCommonGenerator());
-	std::vector<int> r;
-	std::copy_n(std::begin(v), n, std::back_inserter(r));
-	return r;
-};
+void LexicaseOptimizer::setScores(std::vector<std::vector<double>> _scores, int _populationSize) {
+	scores = std::move(_scores);
+	scoresHaveDelta = false;
+	for (auto &formulaScores : scores) {
+		auto const minmax = std::minmax_element(std::begin(formulaScores), std::end(formulaScores));
+		scoresHaveDelta |= *minmax.first < *minmax.second;
+	}
+	prepareSelection(_populationSize);
+}
 
+void LexicaseOptimizer::prepareSelection(int _populationSize) {
+	populationSize = _populationSize;
+	wordCount = (populationSize + 63) / 64;
+	const int formulaCount = static_cast<int>(scores.size());
 
-int LexicaseOptimizer::lexiSelect(const std::vector<int> &orgIndexList) {
-	if (!scoresHaveDelta) { // if all scores are the same! pick random
-		return Random::getIndex(orgIndexList.size());
+	// the first formula applied to a pool of the whole population always
+	// keeps the same organisms
+	std::vector<uint64_t> everyone(wordCount, ~uint64_t(0));
+	if (populationSize % 64) {
+		everyone.back() = (uint64_t(1) << (populationSize % 64)) - 1;
+	}
+	formulaElites.resize(formulaCount);
+	formulaEliteCounts.resize(formulaCount);
+	for (int f = 0; f < formulaCount; f++) {
+		formulaElites[f] = everyone;
+		double cutoff = scoreCutoff(f, everyone.data(), populationSize);
+		formulaEliteCounts[f] = applyCutoff(f, cutoff, formulaElites[f].data());
 	}
 
-	// generate a vector with formulasSize and fill with values from 0 to formulasSize - 1, in a random order.
-	std::vector<int> formulasOrder(optimizeFormulasMTs.size());
-	iota(formulasOrder.begin(), formulasOrder.end(), 0);
-	std::shuffle(formulasOrder.begin(), formulasOrder.end(), Random::getCommonGenerator());
-	// now we have a random order in formulasOrder
-
-	// keepers is the current list of indexes into population for orgs which
-	// have passed all tests so far.
-	std::vector<int> keepers  = orgIndexList;
+	formulasOrder.resize(formulaCount);
+	std::iota(formulasOrder.begin(), formulasOrder.end(), 0);
+	poolOrder.resize(populationSize);
+	std::iota(poolOrder.begin(), poolOrder.end(), 0);
+	keepers.resize(wordCount);
+}
 
-	while (keepers.size() > 1 && formulasOrder.size() > 0) {
-		// while there are still atleast one keeper and there are still formulas
-		int formulaIndex = formulasOrder.back();
-		formulasOrder.pop_back();
+double LexicaseOptimizer::scoreCutoff(int formulaIndex, const uint64_t *members, int memberCount) {
+	const double *formulaScores = scores[formulaIndex].data();
+	if (epsilonRelativeTo) { // get scoreCutoff relitive to score
+		double minScore = std::numeric_limits<double>::max();
+		double maxScore = std::numeric_limits<double>::lowest();
+		for (int w = 0; w < wordCount; w++) {
+			for (uint64_t bits = members[w]; bits; bits &= bits - 1) {
+				double score = formulaScores[w * 64 + BitOps::countTrailingZeros(bits)];
+				minScore = std::min(minScore, score);
+				maxScore = std::max(maxScore, score);
+			}
+		}
+		return (maxScore - ((maxScore - minScore) * epsilon));
+	}
 
-		double scoreCutoff;
+	// get scoreCutoff relitive to rank: based on the number of keepers,
+	// calculate how many to keep. the cutoff is the score at cull_index in
+	// the members' scores sorted low to high
+	size_t cull_index = std::ceil(std::max((((1.0 - epsilon) * memberCount) - 1.0), 0.0));
+	keeperScores.clear();
+	for (int w = 0; w < wordCount; w++) {
+		for (uint64_t bits = members[w]; bits; bits &= bits - 1) {
+			keeperScores.push_back(formulaScores[w * 64 + BitOps::countTrailingZeros(bits)]);
+		}
+	}
+	std::nth_element(std::begin(keeperScores),
+		std::begin(keeperScores) + cull_index,
+		std::end(keeperScores));
+	return keeperScores[cull_index];
+}
 
-		// create a vector of remaning scores
-		std::vector<double> keeperScores;
-		for (size_t i = 0; i < keepers.size(); i++) {
-			keeperScores.push_back(scores[formulaIndex][keepers[i]]);
+int LexicaseOptimizer::applyCutoff(int formulaIndex, double cutoff, uint64_t *members) {
+	const double *formulaScores = scores[formulaIndex].data();
+	int count = 0;
+	for (int w = 0; w < wordCount; w++) {
+		uint64_t kept = 0;
+		for (uint64_t bits = members[w]; bits; bits &= bits - 1) {
+			int bit = BitOps::countTrailingZeros(bits);
+			kept |= static_cast<uint64_t>(!(formulaScores[w * 64 + bit] < cutoff)) << bit;
 		}
+		members[w] = kept;
+		count += BitOps::popCount(kept);
+	}
+	return count;
+}
 
-		if (epsilonRelativeTo) { // get scoreCutoff relitive to score
-			auto scoreRange = std::minmax_element(std::begin(keeperScores), std::end(keeperScores));
-			scoreCutoff = (*scoreRange.second - ((*scoreRange.second - *scoreRange.first) * epsilon));
+int LexicaseOptimizer::lexiSelect() {
+	const int poolCount = std::min(poolSize, populationSize);
+	if (!scoresHaveDelta) { // if all scores are the same! pick random
+		return Random::getIndex(poolCount);
+	}
+
+	// pick the pool (the first poolCount of a partial Fisher-Yates shuffle)
+	const bool wholePopulation = poolCount == populationSize;
+	if (!wholePopulation) {
+		std::fill(keepers.begin(), keepers.end(), 0);
+		for (int i = 0; i < poolCount; i++) {
+			std::swap(poolOrder[i], poolOrder[i + Random::getIndex(populationSize - i)]);
+			keepers[poolOrder[i] >> 6] |= uint64_t(1) << (poolOrder[i] & 63);
+		}
+	}
+	int keeperCount = poolCount;
+
+	// formulas are drawn one at a time, in a random order, as they are needed
+	int formulasLeft = static_cast<int>(formulasOrder.size());
+	bool first = true;
+	while (keeperCount > 1 && formulasLeft > 0) {
+		std::swap(formulasOrder[Random::getIndex(formulasLeft)], formulasOrder[formulasLeft - 1]);
+		int formulaIndex = formulasOrder[--formulasLeft];
+
+		if (first && wholePopulation) {
+			keepers = formulaElites[formulaIndex];
+			keeperCount = formulaEliteCounts[formulaIndex];
 		}
-		else { // get scoreCutoff relitive to rank
-			// based on the number of keepers, calculate how many to keep.
-			size_t cull_index = std::ceil(std::max((((1.0 - epsilon) * keeperScores.size()) - 1.0), 0.0));
-
-			// get score at the cull index position
-			std::nth_element(std::begin(keeperScores),
-				std::begin(keeperScores) + cull_index,
-				std::end(keeperScores));
-			scoreCutoff = keeperScores[cull_index];
-
-			//std::cout << "cull_index: " << cull_index << "  keeperScores.size(): " << keeperScores.size() << std::endl;
-			//std::cout << "scoreCutoff: " << scoreCutoff << std::endl;
+		else {
+			double cutoff = scoreCutoff(formulaIndex, keepers.data(), keeperCount);
+			keeperCount = applyCutoff(formulaIndex, cutoff, keepers.data());
 		}
+		first = false;
+	}
+	if (first && wholePopulation) { // (no formula was applied)
+		return Random::getIndex(keeperCount);
+	}
 
-		// for each keeper, see if there are still a keeper, i.e. they have score >= scoreCutoff. remove if not
-		keepers.erase(std::remove_if(std::begin(keepers), std::end(keepers), [&](auto k) {
-			return scores[formulaIndex][k] < scoreCutoff;
-		}), std::end(keepers));
+	// pick one of the keepers
+	int pickHere = Random::getIndex(keeperCount);
+	for (int w = 0; w < wordCount; w++) {
+		int inWord = BitOps::popCount(keepers[w]);
+		if (pickHere < inWord) {
+			uint64_t bits = keepers[w];
+			for (int i = 0; i < pickHere; i++) {
+				bits &= bits - 1;
+			}
+			return w * 64 + BitOps::countTrailingZeros(bits);
+		}
+		pickHere -= inWord;
 	}
-	int pickHere = Random::getIndex(keepers.size()); 
-	//std::cout << "    keeping: " << tournamentPopulation[keepers[pickHere]]->ID << std::endl;
-	// if there is only one keeper left, return that, otherwise select randomly from keepers.
-	return keepers[pickHere];
+	return -1; // not reached
 }
 
-
 void LexicaseOptimizer::optimize(
     std::vector<std::shared_ptr<Organism>> &population) {
 
@@ -189,18 +260,13 @@ void LexicaseOptimizer::optimize(
   std::vector<double> minScores;
   minScores.reserve(optimizeFormulasMTs.size());
 
-  scoresHaveDelta = false;
-
-  scores.clear();
-  for (auto &opt_formula : optimizeFormulasMTs) {
+  std::vector<std::vector<double>> newScores;
+  for (auto &opt_program : optimizeFormulasPrograms) {
 
     std::vector<double> pop_scores;
-    pop_scores.reserve(population.size());
-
-    for (auto &org : population)
-      pop_scores.push_back(opt_formula->eval(org->dataMap, PT)[0]);
+    opt_program.evalPopulation(population, PT, pop_scores);
 
-    scores.push_back(pop_scores);
+    newScores.push_back(pop_scores);
 
     aveScores.push_back(
         std::accumulate(std::begin(pop_scores), std::end(pop_scores), 0.0) /
@@ -209,19 +275,18 @@ void LexicaseOptimizer::optimize(
     auto const minmax =
         std::minmax_element(std::begin(pop_scores), std::end(pop_scores));
 
-    scoresHaveDelta |= *minmax.first < *minmax.second;
-
     minScores.push_back(*minmax.first);
     maxScores.push_back(*minmax.second);
   }
 
+  poolSize = poolSize == -1 ? population.size() : poolSize;
+  setScores(std::move(newScores), population.size());
+
   if (recordOptimizeValues)
     for (size_t i = 0; i < population.size(); i++)
       for (size_t fIndex = 0; fIndex < optimizeFormulasMTs.size(); fIndex++)
         population[i]->dataMap.set(scoreNames[fIndex], scores[fIndex][i]);
 
-  poolSize = poolSize == -1 ? population.size() : poolSize;
-
 
   size_t nextPopulationTargetSize = nextPopSizeFormula->eval(PT)[0];
   nextPopulationTargetSize = nextPopulationTargetSize == -1
@@ -236,13 +301,12 @@ void LexicaseOptimizer::optimize(
 
   // generate a list of 'nextPopulationTargetSize' new orgs into 'newPopulation'
   // for each, generate a 'parents' vector with 'numberParents' parent orgs
-  // parents are selected with lexiSelect( m_choose_n(population.size(), poolSize))
-  //   where the m_choose_n command selects 'poolSize' number of population indexes
+  // parents are selected with lexiSelect, from pools of 'poolSize' organisms
   std::generate_n(
       std::back_inserter(newPopulation), nextPopulationTargetSize, [&] {
         std::vector<std::shared_ptr<Organism>> parents;
         std::generate_n(std::back_inserter(parents), numberParents, [&] {
-          return population[lexiSelect(m_choose_n(population.size(), poolSize))];
+          return population[lexiSelect()];
         });
         return parents[0]->makeMutatedOffspringFromMany(parents);
       });
@@ -250,10 +314,10 @@ void LexicaseOptimizer::optimize(
   oldPopulation = population;
   population.insert(population.end(), newPopulation.begin(), newPopulation.end());
   for (size_t fIndex = 0; fIndex < optimizeFormulasMTs.size(); fIndex++) {
-    std::cout << std::endl
-              << "   " << scoreNames[fIndex]
-              << ":  max = " << std::to_string(maxScores[fIndex])
-              << "   ave = " << std::to_string(aveScores[fIndex]) << std::flush;
+    *output << std::endl
+            << "   " << scoreNames[fIndex]
+            << ":  max = " << std::to_string(maxScores[fIndex])
+            << "   ave = " << std::to_string(aveScores[fIndex]) << std::flush;
   }
 }
 
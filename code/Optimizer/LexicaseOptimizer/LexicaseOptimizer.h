@@ -12,7 +12,9 @@
 
 #include <Optimizer/AbstractOptimizer.h>
 #include <Utilities/MTree.h>
+#include <Utilities/CompiledMTree.h>
 
+#include <cstdint>
 #include <iostream>
 #include <numeric>
 #include <algorithm>
@@ -46,6 +48,7 @@ public:
 	bool recordOptimizeValues;
 
 	std::vector<std::shared_ptr<Abstract_MTree>> optimizeFormulasMTs;
+	std::vector<CompiledMTree> optimizeFormulasPrograms; // optimizeFormulasMTs, compiled
 
 	LexicaseOptimizer(std::shared_ptr<ParametersTable> PT_ = nullptr);
 
@@ -53,6 +56,40 @@ public:
 
 	virtual void cleanup(std::vector<std::shared_ptr<Organism>> &population) override;
 
+	// select one parent (an index into the population scores were made for).
+	// a pool of poolSize organisms is picked at random, then formulas are
+	// applied in a random order, each removing the pool members below its
+	// cutoff, until one organism or no formulas are left. The parent is picked
+	// at random from what is left.
+	int lexiSelect();
 
-	int lexiSelect(const std::vector<int> &tournamentIndexList);
+	// set the scores (formulas x organisms) lexiSelect selects from, and set
+	// up selection for a population of _populationSize. optimize sets its
+	// population's scores here; selecting from scores alone (as the tests and
+	// benchmarks do) needs no organisms. set poolSize and epsilon first
+	void setScores(std::vector<std::vector<double>> _scores, int _populationSize);
+
+private:
+	// organisms are held in bitsets, 64 to a word (organism i is bit i % 64 of
+	// word i / 64)
+	int populationSize = 0;
+	int wordCount = 0;
+
+	// built once per generation by prepareSelection
+	std::vector<std::vector<uint64_t>> formulaElites; // kept by each formula when applied to the whole population
+	std::vector<int> formulaEliteCounts;
+
+	// reused by lexiSelect
+	std::vector<int> formulasOrder; // formulas not yet applied are [0,formulasLeft)
+	std::vector<int> poolOrder; // population indices, for drawing pools
+	std::vector<uint64_t> keepers; // organisms still in the running
+	std::vector<double> keeperScores;
+
+	// set up lexiSelect for a population of _populationSize, once scores are
+	// set for this generation
+	void prepareSelection(int _populationSize);
+	// score organisms must have on formulaIndex to stay a keeper
+	double scoreCutoff(int formulaIndex, const uint64_t *members, int memberCount);
+	// keep members with score >= cutoff on formulaIndex, return how many
+	int applyCutoff(int formulaIndex, double cutoff, uint64_t *members);
 };
@@ -25,19 +25,6 @@ Parameters::register_parameter("OPTIMIZER_ROULETTE-remapFunction", (std::string)
 	"if NONE, no remap is preformed.");
 
 
-int RouletteOptimizer::selectParent(std::vector<double>& scores, double maxScore, double minScore, int popSize){
-
-	if (maxScore <= 0 || maxScore == minScore) {
-		return Random::getIndex(popSize);
-	}
-	int parent;
-	int countTries = 0;
-	do {
-		parent = Random::getIndex(popSize);
-	} while (!Random::P(scores[parent] / maxScore));
-	return parent;
-}
-
 void RouletteOptimizer::stringReplace(std::string& s, const std::string& search, const std::string& replace) {
 	for (size_t pos = 0; ; pos += replace.length()) {
 		// Locate the substd::string to replace
@@ -55,6 +42,7 @@ RouletteOptimizer::RouletteOptimizer(std::shared_ptr<ParametersTable> PT_)
 	numberParents = numberParentsPL->get(PT);
 
 	optimizeValueMT = stringToMTree(optimizeValuePL->get(PT));
+	optimizeValueProgram.compile(optimizeValueMT);
 
 	if (remapFunctionPL->get(PT) == "NONE") {
 		doRemap = false;
@@ -67,6 +55,7 @@ RouletteOptimizer::RouletteOptimizer(std::shared_ptr<ParametersTable> PT_)
 		stringReplace(remapString, "$maxOptVal$", "VECT[0,2]");
 		stringReplace(remapString, "$optVal$", "VECT[0,3]");
 		remapFunctionMT = stringToMTree(remapString);
+		remapFunctionProgram.compile(remapFunctionMT);
 	}
 	popFileColumns.clear();
 	popFileColumns.push_back("optimizeValue");
@@ -78,18 +67,18 @@ RouletteOptimizer::RouletteOptimizer(std::shared_ptr<ParametersTable> PT_)
 void RouletteOptimizer::optimize(std::vector<std::shared_ptr<Organism>>& population) {
 	auto popSize = population.size();
 
-	std::vector<double> scores(popSize, 0);
+	std::vector<double> scores;
+	optimizeValueProgram.evalPopulation(population, PT, scores);
 	std::vector<double> remappedScores(popSize, 0);
 	double aveScore = 0;
-	double maxScore = optimizeValueMT->eval(population[0]->dataMap, PT)[0];
+	double maxScore = scores[0];
 	double minScore = maxScore;
 
 	killList.clear();
 
 	for (size_t i = 0; i < popSize; i++) {
 		killList.insert(population[i]);
-		double opVal = optimizeValueMT->eval(population[i]->dataMap, PT)[0];
-		scores[i] = opVal;
+		double opVal = scores[i];
 		aveScore += opVal;
 		population[i]->dataMap.set("optimizeValue", opVal);
 		maxScore = std::max(maxScore, opVal);
@@ -102,7 +91,7 @@ void RouletteOptimizer::optimize(std::vector<std::shared_ptr<Organism>>& populat
 	if (doRemap) {
 		for (size_t i = 0; i < popSize; i++) {
 			remapVect[0][3] = scores[i];
-			remappedScores[i] = remapFunctionMT->eval(population[i]->dataMap, PT, remapVect)[0];
+			remappedScores[i] = remapFunctionProgram.eval(population[i]->dataMap, PT, remapVect);
 			population[i]->dataMap.set("remappedOptimizeValue", remappedScores[i]);
 		}
 	}
@@ -111,27 +100,26 @@ void RouletteOptimizer::optimize(std::vector<std::shared_ptr<Organism>>& populat
 
 	}
 
-	double remappedScoresMax = *std::max_element(remappedScores.begin(), remappedScores.end());
-	double remappedScoresMin = *std::min_element(remappedScores.begin(), remappedScores.end());
+	selectionTable.build(remappedScores);
 
 	std::vector<std::shared_ptr<Organism>> parents;
 
 	for (int i = 0; i < popSize; i++) {
 		if (numberParents == 1) {
-			auto parent = population[selectParent(remappedScores, remappedScoresMax, remappedScoresMin, popSize)];
+			auto parent = population[selectionTable.sample()];
 			population.push_back(parent->makeMutatedOffspringFrom(parent)); // add to population
 		}
 		else {
 			parents.clear();
 			do {
-				parents.push_back(population[selectParent(remappedScores, remappedScoresMax, remappedScoresMin, popSize)]); // select from culled
+				parents.push_back(population[selectionTable.sample()]); // select from culled
 			} while (static_cast<int>(parents.size()) < numberParents);
 			population.push_back(parents[0]->makeMutatedOffspringFromMany(parents)); // push to population
 		}
 
 	}
 	for (int i = 0; i < popSize; i++) {
-		population[i]->dataMap.set("roulette_numOffspring", population[i]->offspringCount);
+		population[i]->dataMap.set("roulette_numOffspring", population[i]->getOffspringCount());
 	}
-	std::cout << "max = " << std::to_string(maxScore) << "   ave = " << std::to_string(aveScore) << "   min = " << std::to_string(minScore);
+	*output << "max = " << std::to_string(maxScore) << "   ave = " << std::to_string(aveScore) << "   min = " << std::to_string(minScore);
 }
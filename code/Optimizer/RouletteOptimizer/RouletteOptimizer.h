@@ -10,6 +10,8 @@
 
 #include "../AbstractOptimizer.h"
 #include "../../Utilities/MTree.h"
+#include "../../Utilities/AliasTable.h"
+#include "../../Utilities/CompiledMTree.h"
 
 #include <iostream>
 #include <sstream>
@@ -20,13 +22,18 @@ public:
 	static std::shared_ptr<ParameterLink<std::string>> optimizeValuePL;
 	static std::shared_ptr<ParameterLink<std::string>> remapFunctionPL;
 
-	int selectParent(std::vector<double>& scores, double maxScore, double minScore, int popSize);
+	// picks parents with probability proportional to (remapped) score, scores
+	// below 0 count as 0 and if no score is above 0 all are equally likely.
+	// built once per generation
+	AliasTable selectionTable;
 
 	void stringReplace(std::string& s, const std::string& search, const std::string& replace);
 
 	int numberParents;
 	std::shared_ptr<Abstract_MTree> optimizeValueMT;
 	std::shared_ptr<Abstract_MTree> remapFunctionMT;
+	CompiledMTree optimizeValueProgram; // optimizeValueMT, compiled
+	CompiledMTree remapFunctionProgram; // remapFunctionMT, compiled
 	bool doRemap;
 
 	RouletteOptimizer(std::shared_ptr<ParametersTable> PT_ = nullptr);
@@ -10,6 +10,9 @@
 
 #include "TournamentOptimizer.h"
 
+#include <algorithm>
+#include <numeric>
+
 std::shared_ptr<ParameterLink<int>> TournamentOptimizer::tournamentSizePL =
 	Parameters::register_parameter("OPTIMIZER_TOURNAMENT-tournamentSize", 5, "number of organisims compaired in each tournament");
 
@@ -22,19 +25,61 @@ Parameters::register_parameter("OPTIMIZER_TOURNAMENT-minimizeError", false, "if
 std::shared_ptr<ParameterLink<std::string>> TournamentOptimizer::optimizeValuePL =
 	Parameters::register_parameter("OPTIMIZER_TOURNAMENT-optimizeValue", (std::string) "DM_AVE[score]", "value to optimize (MTree)");
 
+std::shared_ptr<ParameterLink<int>> TournamentOptimizer::elitismPL =
+	Parameters::register_parameter("OPTIMIZER_TOURNAMENT-elitism", 0, "number of organisms with the best optimizeValues which survive into the next generation (the rest of the population is made by tournaments)");
+
+std::shared_ptr<ParameterLink<int>> TournamentOptimizer::selectionThreadsPL =
+	Parameters::register_parameter("OPTIMIZER_TOURNAMENT-selectionThreads", 1, "number of threads used to run tournaments, 1 = run on main thread, 0 = one thread per hardware thread (the parents selected do not depend on this)");
 
-int TournamentOptimizer::selectParent(int tournamentSize, bool minimizeError, std::vector<double> scores, int popSize){
-	int winner, challanger;
-	winner = Random::getIndex(popSize);
+
+int TournamentOptimizer::selectParent(const double *scores, int popSize, int tournamentSize,
+	bool minimizeError, Random::Generator &generator) {
+	int winner = Random::getIndex(popSize, generator);
+	double winnerScore = scores[winner];
 	for (int i = 0; i < tournamentSize - 1; i++) {
-		challanger = Random::getIndex(popSize);
-		if (minimizeError?scores[challanger] < scores[winner]:scores[challanger] > scores[winner]) {
+		int challanger = Random::getIndex(popSize, generator);
+		double challangerScore = scores[challanger];
+		if (minimizeError ? challangerScore < winnerScore : challangerScore > winnerScore) {
 			winner = challanger;
+			winnerScore = challangerScore;
 		}
 	}
 	return winner;
 }
 
+void TournamentOptimizer::selectParents(const std::vector<double> &scores, int count) {
+	parentIndices.resize(count);
+	const int popSize = static_cast<int>(scores.size());
+	const int blockCount = (count + selectionBlockSize - 1) / selectionBlockSize;
+
+	// one draw from the common generator picks this generation's streams
+	auto &common = Random::getCommonGenerator();
+	uint64_t selectionSeed = static_cast<uint64_t>(common());
+	selectionSeed = (selectionSeed << 32) ^ static_cast<uint64_t>(common());
+
+	auto selectBlock = [&](size_t block) {
+		Random::Generator generator;
+		Random::seedGenerator(generator, Random::getStreamSeed(selectionSeed, block));
+		const int first = static_cast<int>(block) * selectionBlockSize;
+		const int last = std::min(count, first + selectionBlockSize);
+		for (int k = first; k < last; k++) {
+			parentIndices[k] = selectParent(scores.data(), popSize, tournamentSize, minimizeError, generator);
+		}
+	};
+
+	int threadCount = ThreadPool::resolveThreadCount(selectionThreads);
+	if (threadCount == 1 || blockCount < 2) {
+		for (int block = 0; block < blockCount; block++) {
+			selectBlock(block);
+		}
+		return;
+	}
+	if (selectionPool == nullptr || selectionPool->size() != threadCount) {
+		selectionPool = std::make_shared<ThreadPool>(threadCount);
+	}
+	selectionPool->parallelFor(blockCount, [&selectBlock](size_t block, int) { selectBlock(block); });
+}
+
 
 TournamentOptimizer::TournamentOptimizer(std::shared_ptr<ParametersTable> PT_)
 	: AbstractOptimizer(PT_) {
@@ -42,8 +87,11 @@ TournamentOptimizer::TournamentOptimizer(std::shared_ptr<ParametersTable> PT_)
 	tournamentSize = tournamentSizePL->get(PT);
 	numberParents = numberParentsPL->get(PT);
 	minimizeError = minimizeErrorPL->get(PT);
+	elitism = elitismPL->get(PT);
+	selectionThreads = selectionThreadsPL->get(PT);
 
 	optimizeValueMT = stringToMTree(optimizeValuePL->get(PT));
+	optimizeValueProgram.compile(optimizeValueMT);
 
 	if (!minimizeError) {
 		optimizeFormula = optimizeValueMT; // set this so Archivist knows which org is max
@@ -59,17 +107,16 @@ TournamentOptimizer::TournamentOptimizer(std::shared_ptr<ParametersTable> PT_)
 void TournamentOptimizer::optimize(std::vector<std::shared_ptr<Organism>> &population) {
 	auto popSize = population.size();
 
-	std::vector<double> scores(popSize, 0);
+	optimizeValueProgram.evalPopulation(population, PT, scores);
 	double aveScore = 0;
-	double maxScore = optimizeValueMT->eval(population[0]->dataMap, PT)[0];
+	double maxScore = scores[0];
 	double minScore = maxScore;
 
 	killList.clear();
 
 	for (size_t i = 0; i < popSize; i++) {
 		killList.insert(population[i]);
-		double opVal = optimizeValueMT->eval(population[i]->dataMap, PT)[0];
-		scores[i] = opVal;
+		double opVal = scores[i];
 		aveScore += opVal;
 		population[i]->dataMap.set("optimizeValue", opVal);
 		maxScore = std::max(maxScore, opVal);
@@ -78,32 +125,53 @@ void TournamentOptimizer::optimize(std::vector<std::shared_ptr<Organism>> &popul
 	
 	aveScore /= popSize;
 
+	// the best organisms are not killed (ties go to the lower index)
+	int survivors = std::min(std::max(elitism, 0), static_cast<int>(popSize));
+	if (survivors > 0) {
+		eliteIndices.resize(popSize);
+		std::iota(eliteIndices.begin(), eliteIndices.end(), 0);
+		std::partial_sort(eliteIndices.begin(), eliteIndices.begin() + survivors, eliteIndices.end(),
+			[this](int a, int b) {
+				if (scores[a] != scores[b]) {
+					return minimizeError ? scores[a] < scores[b] : scores[a] > scores[b];
+				}
+				return a < b;
+			});
+		for (int i = 0; i < survivors; i++) {
+			killList.erase(population[eliteIndices[i]]);
+		}
+	}
+
+	// run every tournament for this generation, then make the offspring
+	int offspringCount = static_cast<int>(popSize) - survivors;
+	int parentCount = std::max(numberParents, 1); // parents per offspring
+	selectParents(scores, offspringCount * parentCount);
+
 	std::vector<std::shared_ptr<Organism>> parents;
 
-	for (int i = 0; i < popSize; i++) {
+	for (int i = 0; i < offspringCount; i++) {
 		if (numberParents == 1) {
-			auto parent = population[selectParent(tournamentSize, minimizeError, scores, popSize)];
+			auto parent = population[parentIndices[i]];
 			population.push_back(parent->makeMutatedOffspringFrom(parent)); // add to population
 		}
 		else {
 			parents.clear();
-			parents.push_back(population[selectParent(tournamentSize, minimizeError, scores, popSize)]);
-			while (static_cast<int>(parents.size()) < numberParents) {
-				parents.push_back(population[selectParent(tournamentSize, minimizeError, scores, popSize)]); // select from culled
+			for (int j = 0; j < parentCount; j++) {
+				parents.push_back(population[parentIndices[i * parentCount + j]]);
 			}
 			population.push_back(parents[0]->makeMutatedOffspringFromMany(parents)); // push to population
 		}
 	}
 
 	for (int i = 0; i < popSize; i++) {
-		population[i]->dataMap.set("tournament_numOffspring", population[i]->offspringCount);
+		population[i]->dataMap.set("tournament_numOffspring", population[i]->getOffspringCount());
 	}
 
 	if (!minimizeError) {
-		std::cout << "max = " << std::to_string(maxScore) << "   ave = " << std::to_string(aveScore);
+		*output << "max = " << std::to_string(maxScore) << "   ave = " << std::to_string(aveScore);
 	}
 	else {
-		std::cout << "min = " << std::to_string(minScore) << "   ave = " << std::to_string(aveScore);
+		*output << "min = " << std::to_string(minScore) << "   ave = " << std::to_string(aveScore);
 	}
 }
 
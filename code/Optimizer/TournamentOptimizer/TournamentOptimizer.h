@@ -10,6 +10,9 @@
 
 #include "../AbstractOptimizer.h"
 #include "../../Utilities/MTree.h"
+#include "../../Utilities/CompiledMTree.h"
+#include "../../Utilities/Random.h"
+#include "../../Utilities/ThreadPool.h"
 
 #include <iostream>
 #include <sstream>
@@ -20,13 +23,31 @@ public:
 	static std::shared_ptr<ParameterLink<int>> numberParentsPL; // number of parents (default 1, asexual)
 	static std::shared_ptr<ParameterLink<std::string>> optimizeValuePL; // what value is used to generate
 	static std::shared_ptr<ParameterLink<bool>> minimizeErrorPL; // If true, lower optimizeValue will be prefered
+	static std::shared_ptr<ParameterLink<int>> elitismPL; // number of best organisms which survive
+	static std::shared_ptr<ParameterLink<int>> selectionThreadsPL; // threads used to run tournaments
 
 	int tournamentSize;
 	int numberParents;
 	bool minimizeError;
+	int elitism;
+	int selectionThreads;
 	std::shared_ptr<Abstract_MTree> optimizeValueMT;
-
-	int selectParent(int tournamentSize, bool minimizeError, std::vector<double> scores, int popSize);
+	CompiledMTree optimizeValueProgram; // optimizeValueMT, compiled
+
+	std::vector<double> scores; // optimizeValue of each organism
+	std::vector<int> parentIndices; // winner of each tournament
+	std::vector<int> eliteIndices; // organisms ordered best first (if elitism)
+	std::shared_ptr<ThreadPool> selectionPool; // created on first use
+
+	// tournaments are drawn in blocks of this many, each block from its own
+	// random stream, so the winners do not depend on the number of threads
+	static const int selectionBlockSize = 1024;
+
+	// run one tournament over scores[0,popSize) and return the winner
+	static int selectParent(const double *scores, int popSize, int tournamentSize,
+		bool minimizeError, Random::Generator &generator);
+	// run count tournaments, parentIndices[k] gets the winner of tournament k
+	void selectParents(const std::vector<double> &scores, int count);
 
 	TournamentOptimizer(std::shared_ptr<ParametersTable> PT_ = nullptr);
 
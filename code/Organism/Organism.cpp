@@ -15,6 +15,7 @@
 
 #include <Genome/AbstractGenome.h>
 #include <Utilities/Random.h>
+#include <Utilities/Timing.h>
 #include <Utilities/Utilities.h>
 
 /* Organism class (the one we expect to be used most of the time
@@ -30,9 +31,9 @@ void Organism::initOrganism(std::shared_ptr<ParametersTable> PT_) {
   PT = std::move(PT_);
   ID = registerOrganism();
   alive = true;
-  offspringCount = 0;           // because it's alive;
   timeOfBirth = Global::update; // happy birthday!
   timeOfDeath = -1;             // still alive
+  Phylogeny::get().addNode(*this); // (sets phylogenyNode)
   dataMap.set("ID", ID);
   dataMap.set("alive", alive);
   dataMap.set("timeOfBirth", timeOfBirth);
@@ -44,8 +45,6 @@ void Organism::initOrganism(std::shared_ptr<ParametersTable> PT_) {
  */
 Organism::Organism(std::shared_ptr<ParametersTable> PT_) {
   initOrganism(std::move(PT_));
-  ancestors.insert(ID); // it is it's own Ancestor for data tracking purposes
-  snapshotAncestors.insert(ID);
 }
 
 /*
@@ -77,9 +76,6 @@ Organism::Organism(
     (brain.first == "root::") ? prefix = "" : prefix = brain.first;
     dataMap.merge(brain.second->getStats(prefix));
   }
-
-  ancestors.insert(ID); // it is it's own Ancestor for data tracking purposes
-  snapshotAncestors.insert(ID);
 }
 
 /*
@@ -111,16 +107,8 @@ Organism::Organism(
     dataMap.merge(brain.second->getStats(prefix));
   }
 
-  parents.push_back(from);
-  from->offspringCount++; // this parent has an(other) offspring
-  for (auto ancestorID : from->ancestors) {
-    ancestors.insert(ancestorID); // union all parents ancestors into this
-                                  // organisms ancestor set.
-  }
-  for (auto ancestorID : from->snapshotAncestors) {
-    snapshotAncestors.insert(ancestorID); // union all parents ancestors into
-                                          // this organisms ancestor set.
-  }
+  // (this organisms ancestors are found from its parent's in Phylogeny)
+  Phylogeny::get().linkParents(phylogenyNode, {from->phylogenyNode});
 }
 
 /*
@@ -152,31 +140,44 @@ Organism::Organism(
     dataMap.merge(brain.second->getStats(prefix));
   }
 
+  std::vector<Phylogeny::Node> parentNodes;
+  parentNodes.reserve(from.size());
   for (auto const &parent : from) {
-    parents.push_back(parent); // add this parent to the parents set
-    parent->offspringCount++;  // this parent has an(other) offspring
-    for (auto ancestorID : parent->ancestors) {
-      ancestors.insert(ancestorID); // union all parents ancestors into this
-                                    // organisms ancestor set
-    }
-    for (auto ancestorID : parent->snapshotAncestors) {
-      snapshotAncestors.insert(ancestorID); // union all parents ancestors into
-                                            // this organisms ancestor set.
-    }
+    parentNodes.push_back(parent->phylogenyNode);
   }
+  // (this organisms ancestors are found from its parents' in Phylogeny)
+  Phylogeny::get().linkParents(phylogenyNode, parentNodes);
 }
 
 // this function provides a unique ID value for every org
 int Organism::registerOrganism() {
+  if (provisionalIDCounter() != nullptr) {
+    return (*provisionalIDCounter())--;
+  }
   return organismIDCounter++;
-  ;
+}
+
+int *&Organism::provisionalIDCounter() {
+  static thread_local int *counter = nullptr;
+  return counter;
+}
+
+void Organism::assignID() {
+  ID = organismIDCounter++;
+  Phylogeny::get().setID(phylogenyNode, ID);
+  dataMap.set("ID", ID);
 }
 
 Organism::~Organism() {
-  for (auto const &parent : parents) {
-    parent->offspringCount--; // this parent has one less child in memory
-  }
-  parents.clear();
+  // parents have one less child in memory (or, if this organisms node is still
+  // needed, its data and genomes are kept there)
+  Phylogeny::get().releaseOrganism(phylogenyNode, *this);
+}
+
+void Organism::clearParents() { Phylogeny::get().clearParents(phylogenyNode); }
+
+int Organism::getOffspringCount() const {
+  return Phylogeny::get().getOffspringCount(phylogenyNode);
 }
 
 /*
@@ -185,8 +186,10 @@ Organism::~Organism() {
 void Organism::kill() {
   alive = false;
   timeOfDeath = Global::update;
+  Phylogeny::get().setDeath(phylogenyNode, timeOfDeath);
   if (!trackOrganism) { // if the archivist is not tracking is organism, we can
-                        // clear it's genomes and brains.
+                        // clear it's genomes and brains (their memory goes
+                        // back to Pool, for the next generation to reuse).
     genomes.clear();
     brains.clear();
   }
@@ -198,18 +201,24 @@ Organism::makeMutatedOffspringFrom(std::shared_ptr<Organism> from) {
   std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> newGenomes;
   std::unordered_map<std::string, std::shared_ptr<AbstractBrain>> newBrains;
 
-  for (auto genome : from->genomes) {
-    newGenomes[genome.first] =
-        genome.second->makeMutatedGenomeFrom(genome.second);
+  {
+    Timing::ScopedTimer timer(Timing::GENOME_MUTATION);
+    for (auto genome : from->genomes) {
+      newGenomes[genome.first] =
+          genome.second->makeMutatedGenomeFrom(genome.second);
+    }
   }
 
-  for (auto brain : from->brains) {
-    newBrains[brain.first] =
-        brain.second->makeBrainFrom(brain.second, newGenomes);
-    newBrains[brain.first]->mutate();
+  {
+    Timing::ScopedTimer timer(Timing::BRAIN_BUILD);
+    for (auto brain : from->brains) {
+      newBrains[brain.first] =
+          brain.second->makeBrainFrom(brain.second, newGenomes);
+      newBrains[brain.first]->mutate();
+    }
   }
 
-  return std::make_shared<Organism>(from, newGenomes, newBrains, PT);
+  return Pool::make<Organism>(from, newGenomes, newBrains, PT);
 }
 
 std::shared_ptr<Organism> Organism::makeMutatedOffspringFromMany(
@@ -218,52 +227,49 @@ std::shared_ptr<Organism> Organism::makeMutatedOffspringFromMany(
   std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> newGenomes;
   std::unordered_map<std::string, std::shared_ptr<AbstractBrain>> newBrains;
 
-  for (auto genome : from[0]->genomes) {
-    std::vector<std::shared_ptr<AbstractGenome>>
-        parentGenomes; // make a list of parents genomes
-    for (auto const &p : from) {
-      parentGenomes.push_back(p->genomes[genome.first]);
+  {
+    Timing::ScopedTimer timer(Timing::GENOME_MUTATION);
+    for (auto genome : from[0]->genomes) {
+      std::vector<std::shared_ptr<AbstractGenome>>
+          parentGenomes; // make a list of parents genomes
+      for (auto const &p : from) {
+        parentGenomes.push_back(p->genomes[genome.first]);
+      }
+      newGenomes[genome.first] =
+          genome.second->makeMutatedGenomeFromMany(parentGenomes);
     }
-    newGenomes[genome.first] =
-        genome.second->makeMutatedGenomeFromMany(parentGenomes);
   }
 
-  for (auto brain : from[0]->brains) {
-    std::vector<std::shared_ptr<AbstractBrain>>
-        parentBrains; // make a list of parents genomes
-    for (auto const &p : from) {
-      parentBrains.push_back(p->brains[brain.first]);
+  {
+    Timing::ScopedTimer timer(Timing::BRAIN_BUILD);
+    for (auto brain : from[0]->brains) {
+      std::vector<std::shared_ptr<AbstractBrain>>
+          parentBrains; // make a list of parents genomes
+      for (auto const &p : from) {
+        parentBrains.push_back(p->brains[brain.first]);
+      }
+
+      newBrains[brain.first] =
+          brain.second->makeBrainFromMany(parentBrains, newGenomes);
+      newBrains[brain.first]->mutate();
     }
-
-    newBrains[brain.first] =
-        brain.second->makeBrainFromMany(parentBrains, newGenomes);
-    newBrains[brain.first]->mutate();
   }
 
-  return std::make_shared<Organism>(from, newGenomes, newBrains, PT);
+  return Pool::make<Organism>(from, newGenomes, newBrains, PT);
 }
 
 /*
- * Given a genome return a list of Organisms containing this Organism and all if
+ * Given a genome return a list of Phylogeny nodes of this Organism and all if
  * this Organisms ancestors ordered oldest first
  * it will fail if any organism in the LOD has more then one parent. (!not for
  * sexual reproduction!)
  */
-std::vector<std::shared_ptr<Organism>>
+std::vector<Phylogeny::Node>
 Organism::getLOD(std::shared_ptr<Organism> org) {
-  std::vector<std::shared_ptr<Organism>> list;
-
-  list.push_back(org); // add this organism to the front of the LOD list
-  while (org->parents.size() ==
-         1) {              // while the current org has one and only one parent
-    org = org->parents[0]; // move to the next ancestor (since there is only one
-                           // parent it is the element in the first position).
-    list.push_back(org);   // add that ancestor to the front of the LOD list
-  }
-  reverse(list.begin(), list.end());
-  for (size_t i = 0; i < list.size(); i++) {
-  }
-  if (org->parents.size() > 1) { // if more than one parent we have a problem!
+  bool hasMultipleParents;
+  auto lineage =
+      Phylogeny::get().getLineage(org->phylogenyNode, hasMultipleParents);
+  if (hasMultipleParents) { // if more than one parent we have a problem!
     std::cout
         << "In Organism::getLOD(shared_ptr<Organism> org)\n Looks like you "
            "have enabled sexual reproduction.\nLOD only works with asexual "
@@ -271,51 +277,37 @@ Organism::getLOD(std::shared_ptr<Organism> org) {
            "parent.\nExiting!\n";
     exit(1);
   }
-  return list;
+  return lineage;
 }
 
 /*
  * find the Most Recent Common Ancestor
- * uses getLOD to get a list of ancestors (oldest first). seaches the list for
- * the first ancestor with a referenceCounter > 1
- * that is the first reference counter with more then one offspring.
- * If none are found, then return "from"
- * Note: a currently active genome has a referenceCounter = 1 (it has not
- * reproduced yet, it only has 1 for it's self)
- *       a dead Organism with a referenceCounter = 0 will not be in the LOD (it
- * has no offspring and will have been pruned)
- *       a dead Organism with a referenceCounter = 1 has only one offspring.
- *       a dead Organism with a referenceCounter > 1 has more then one spring
+ * walks the line of decent (oldest first) in Phylogeny, and returns the first
+ * ancestor with offspringCount > 1, that is the first ancestor with more then
+ * one offspring in memory.
+ * If none are found, then return "from" (all as Phylogeny nodes)
+ * Note: a currently active organism has not reproduced yet (offspringCount = 0)
+ *       a dead Organism with no offspring in memory will not be in the LOD (it
+ * will have been deleted)
+ *       a dead Organism with offspringCount = 1 has only one offspring.
+ *       a dead Organism with offspringCount > 1 has more then one spring
  * with surviving lines of decent.
  */
-std::shared_ptr<Organism>
+Phylogeny::Node
 Organism::getMostRecentCommonAncestor(std::shared_ptr<Organism> org) {
-  std::vector<std::shared_ptr<Organism>> LOD =
-      getLOD(org); // get line of decent parent "parent"
-  for (auto org :
-       LOD) { // starting at the oldest parent, moving to the youngest
-    if (org->offspringCount >
-        1) // the first (oldest) ancestor with more then one surviving offspring
-      return org;
-  }
-  return org; // a currently active genome will have referenceCounter = 1 but
-              // may be the Most Recent Common Ancestor
+  bool hasMultipleParents;
+  auto lineage =
+      Phylogeny::get().getLineage(org->phylogenyNode, hasMultipleParents);
+  return Phylogeny::get().getMostRecentCommonAncestor(lineage);
 }
-std::shared_ptr<Organism> Organism::getMostRecentCommonAncestor(
-    std::vector<std::shared_ptr<Organism>> LOD) {
-  for (auto org :
-       LOD) { // starting at the oldest parent, moving to the youngest
-    if (org->offspringCount >
-        1) // the first (oldest) ancestor with more then one surviving offspring
-      return org;
-  }
-  return LOD.back(); // a currently active genome will have referenceCounter = 1
-                     // but may be the Most Recent Common Ancestor
+Phylogeny::Node
+Organism::getMostRecentCommonAncestor(std::vector<Phylogeny::Node> LOD) {
+  return Phylogeny::get().getMostRecentCommonAncestor(LOD);
 }
 
 std::shared_ptr<Organism>
 Organism::makeCopy(std::shared_ptr<ParametersTable> PT_) {
-  auto newOrg = std::make_shared<Organism>(PT_);
+  auto newOrg = Pool::make<Organism>(PT_);
   for (auto genome : genomes) {
     newOrg->genomes[genome.first] = genome.second->makeCopy(genome.second->PT);
   }
@@ -325,12 +317,10 @@ Organism::makeCopy(std::shared_ptr<ParametersTable> PT_) {
 
   newOrg->dataMap = dataMap;
   newOrg->snapShotDataMaps = snapShotDataMaps;
-  newOrg->offspringCount = offspringCount;
-  newOrg->parents = parents;
-  for (auto const &parent : parents) {
-    parent->offspringCount++;
-  }
-  newOrg->ancestors = ancestors;
+  Phylogeny::get().linkParents(newOrg->phylogenyNode,
+                               Phylogeny::get().getParents(phylogenyNode));
+  Phylogeny::get().setOffspringCount(newOrg->phylogenyNode,
+                                     getOffspringCount());
   newOrg->timeOfBirth = timeOfBirth;
   newOrg->timeOfDeath = timeOfDeath;
   newOrg->alive = alive;
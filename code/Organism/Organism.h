@@ -16,9 +16,11 @@
 
 #include <Brain/AbstractBrain.h>
 #include <Genome/AbstractGenome.h>
+#include <Organism/Phylogeny.h>
 
 #include <Utilities/Data.h>
 #include <Utilities/Parameters.h>
+#include <Utilities/Pool.h>
 
 class Organism {
 private:
@@ -26,6 +28,14 @@ private:
   int registerOrganism();       // get an Organism_id (uses organismIDCounter)
 
 public:
+  // organisms made on a thread which has a provisional id counter (i.e. an
+  // IslandsOptimizer worker) take their ID from it (counting down from -2),
+  // and are given their real ID later, on the main thread, with assignID.
+  // this keeps ids the same however the threads happen to run.
+  static int *&provisionalIDCounter();
+  bool hasProvisionalID() const { return ID < -1; }
+  void assignID(); // give this organism the next ID from organismIDCounter
+
   DataMap dataMap; // holds all data (genome size, score, world data, etc.)
   std::map<int, DataMap> snapShotDataMaps; // Used only with SnapShot with Delay
   // (SSwD) stores contents of dataMap when
@@ -38,18 +48,14 @@ public:
   std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> genomes;
   std::unordered_map<std::string, std::shared_ptr<AbstractBrain>> brains;
 
-  int offspringCount;
+  Phylogeny::Node phylogenyNode; // this organisms node in Phylogeny, which
+                                 // holds its parents, offspringCount and
+                                 // ancestors (for data and snapshot files)
 
-  std::vector<std::shared_ptr<Organism>>
-      parents; // parents are pointers to parents of
-               // this organism. In asexual populations
-               // this will have one element
-  std::unordered_set<int>
-      ancestors; // list of the IDs of organisms in the last data
-                 // files who are ancestors of this organism
-                 // (i.e. all files saved on data interval)
-  std::unordered_set<int>
-      snapshotAncestors; // like ancestors, but for snapshot files.
+  void clearParents(); // release parents (they may be deleted if no other
+                       // organism needs them)
+  int getOffspringCount() const; // number of offspring in memory which have
+                                 // not been deleted
 
   int ID;
   int timeOfBirth; // the time this organism was made
@@ -97,12 +103,11 @@ public:
 
   virtual void kill(); // sets alive = 0 (on org and in dataMap)
 
-  virtual std::vector<std::shared_ptr<Organism>>
-  getLOD(std::shared_ptr<Organism> org);
-  virtual std::shared_ptr<Organism>
+  virtual std::vector<Phylogeny::Node> getLOD(std::shared_ptr<Organism> org);
+  virtual Phylogeny::Node
   getMostRecentCommonAncestor(std::shared_ptr<Organism> org);
-  virtual std::shared_ptr<Organism>
-  getMostRecentCommonAncestor(std::vector<std::shared_ptr<Organism>> LOD);
+  virtual Phylogeny::Node
+  getMostRecentCommonAncestor(std::vector<Phylogeny::Node> LOD);
   virtual std::shared_ptr<Organism>
   makeMutatedOffspringFrom(std::shared_ptr<Organism> parent);
   virtual std::shared_ptr<Organism>
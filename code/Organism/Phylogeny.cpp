@@ -0,0 +1,665 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include <Organism/Phylogeny.h>
+
+#include <Global.h>
+#include <Organism/Organism.h>
+
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <unordered_set>
+
+Phylogeny &Phylogeny::get() {
+  // never destroyed, so that organisms which outlive static destruction
+  // (i.e. held by other statics) can still release their nodes
+  static Phylogeny *phylogeny = new Phylogeny();
+  return *phylogeny;
+}
+
+Phylogeny::Staging *&Phylogeny::threadStaging() {
+  static thread_local Staging *staging = nullptr;
+  return staging;
+}
+
+Phylogeny::Staging::StagedNode &Phylogeny::stagedNode(Node node) {
+  Staging *staging = threadStaging();
+  if (staging == nullptr) {
+    std::cout << "  In Phylogeny :: node " << node
+              << " is staged, but this thread has no staging (nodes made on "
+                 "a staging thread must be merged before other threads use "
+                 "them).\n  Exiting." << std::endl;
+    exit(1);
+  }
+  return staging->nodes[-2 - node];
+}
+
+void Phylogeny::requireMerged(Node node, const char *caller) {
+  if (isStaged(node)) {
+    std::cout << "  In Phylogeny::" << caller << " :: node " << node
+              << " is staged and must be merged before it can be used "
+                 "here.\n  Exiting." << std::endl;
+    exit(1);
+  }
+}
+
+void Phylogeny::requireUnstaged(const char *caller) {
+  if (threadStaging() != nullptr) {
+    std::cout << "  In Phylogeny::" << caller
+              << " :: this thread has a staging, and can not change nodes "
+                 "which are already merged.\n  Exiting." << std::endl;
+    exit(1);
+  }
+}
+
+Phylogeny::Node Phylogeny::allocate() {
+  if (!freeNodes.empty()) {
+    Node node = freeNodes.back();
+    freeNodes.pop_back();
+    return node;
+  }
+  Node node = static_cast<Node>(ids.size());
+  ids.push_back(0);
+  births.push_back(0);
+  deaths.push_back(-1);
+  offspringCounts.push_back(0);
+  childLinks.push_back(0);
+  childSums.push_back(0);
+  firstParents.push_back(none);
+  organisms.push_back(nullptr);
+  records.emplace_back();
+  holds.push_back(0);
+  serials.push_back(0);
+  lineageBits.push_back(0);
+  for (auto &saved : savedIn) {
+    saved.push_back(notSaved);
+  }
+  return node;
+}
+
+bool Phylogeny::inUse(Node node) const {
+  return organisms[node] != nullptr || childLinks[node] > 0 || holds[node] > 0;
+}
+
+std::unique_ptr<Phylogeny::Record> Phylogeny::makeRecord(Organism &organism) {
+  auto record = std::make_unique<Record>();
+  record->dataMap = std::move(organism.dataMap);
+  record->snapShotDataMaps = std::move(organism.snapShotDataMaps);
+  record->genomes = std::move(organism.genomes);
+  record->brains = std::move(organism.brains);
+  return record;
+}
+
+void Phylogeny::addNode(Organism &organism) {
+  Staging *staging = threadStaging();
+  if (staging != nullptr) {
+    staging->nodes.push_back({&organism, organism.ID, organism.timeOfBirth, -1,
+                              0, 0, {}, true, false, nullptr, 0, none});
+    organism.phylogenyNode = -1 - static_cast<Node>(staging->nodes.size());
+    return;
+  }
+  Node node = allocate();
+  organism.phylogenyNode = node;
+  ids[node] = organism.ID;
+  births[node] = organism.timeOfBirth;
+  deaths[node] = -1;
+  offspringCounts[node] = 0;
+  childLinks[node] = 0;
+  childSums[node] = 0;
+  firstParents[node] = none;
+  organisms[node] = &organism;
+  holds[node] = 0;
+  lineageBits[node] = 0;
+  for (auto &saved : savedIn) {
+    saved[node] = INT_MIN; // (an organism with no parents is its own ancestor)
+  }
+}
+
+void Phylogeny::linkParents(Node node, const std::vector<Node> &parents) {
+  if (isStaged(node)) {
+    Staging &staging = *threadStaging();
+    auto &staged = stagedNode(node);
+    for (Node parentNode : parents) {
+      if (isStaged(parentNode)) {
+        auto &stagedParent = stagedNode(parentNode);
+        stagedParent.offspringCount++;
+        stagedParent.childLinks++;
+      } else {
+        staging.offspringAdded[parentNode]++;
+      }
+      staged.parentNodes.push_back(parentNode);
+    }
+    return;
+  }
+  requireUnstaged("linkParents");
+  for (Node parentNode : parents) {
+    offspringCounts[parentNode]++; // this parent has an(other) offspring
+    childLinks[parentNode]++;
+    childSums[parentNode] += node;
+    if (firstParents[node] == none) {
+      firstParents[node] = parentNode;
+      lineageBits[node] = lineageBits[parentNode];
+    } else {
+      otherParents[node].push_back(parentNode);
+      lineageBits[node] &= lineageBits[parentNode];
+    }
+  }
+  if (!parents.empty()) {
+    for (auto &saved : savedIn) {
+      saved[node] = notSaved;
+    }
+  }
+}
+
+void Phylogeny::unlinkParents(Node node, bool countOffspring,
+                              std::vector<Node> &unused) {
+  if (firstParents[node] == none) {
+    return;
+  }
+  auto unlink = [&](Node parent) {
+    if (countOffspring) {
+      offspringCounts[parent]--;
+    }
+    childSums[parent] -= node;
+    childLinks[parent]--;
+    if (!inUse(parent)) {
+      unused.push_back(parent);
+    }
+  };
+  unlink(firstParents[node]);
+  firstParents[node] = none;
+  auto others = otherParents.find(node);
+  if (others != otherParents.end()) {
+    for (Node parent : others->second) {
+      unlink(parent);
+    }
+    otherParents.erase(others);
+  }
+}
+
+void Phylogeny::releaseParents(Node node, bool countOffspring) {
+  // (freed nodes are worked through here rather than recursively, as lines of
+  // descent can be very long)
+  std::vector<Node> unused;
+  unlinkParents(node, countOffspring, unused);
+  while (!unused.empty()) {
+    Node parent = unused.back();
+    unused.pop_back();
+    // the parent's organism is gone, so its own parents have one less
+    // offspring in memory
+    unlinkParents(parent, true, unused);
+    recycle(parent);
+  }
+}
+
+void Phylogeny::free(Node node) {
+  releaseParents(node, true);
+  recycle(node);
+}
+
+void Phylogeny::recycle(Node node) {
+  organisms[node] = nullptr;
+  records[node] = nullptr;
+  for (auto &kept : keptAncestors) {
+    kept.erase(node);
+  }
+  serials[node]++; // (so WeakNodes to it expire)
+  freeNodes.push_back(node);
+}
+
+void Phylogeny::clearParents(Node node) {
+  if (isStaged(node)) {
+    stagedNode(node).linked = false; // (cleared once merged)
+    return;
+  }
+  requireUnstaged("clearParents");
+  if (firstParents[node] == none) {
+    return;
+  }
+  // the ancestors node was born with can no longer be found from its parents
+  for (int set = 0; set < 2; set++) {
+    if (trackedAncestors[set] &&
+        (savedIn[set][node] == notSaved || childLinks[node] > 0) &&
+        keptAncestors[set].find(node) == keptAncestors[set].end()) {
+      keptAncestors[set][node] =
+          getBirthAncestors(static_cast<AncestorSet>(set), node);
+    }
+  }
+  releaseParents(node, false);
+}
+
+void Phylogeny::releaseStaged(Staging &staging, Node node) {
+  std::vector<Node> released{node};
+  while (!released.empty()) {
+    auto &staged = staging.nodes[-2 - released.back()];
+    released.pop_back();
+    staged.released = true;
+    staged.record = nullptr;
+    for (Node parentNode : staged.parentNodes) {
+      if (!isStaged(parentNode)) {
+        if (staged.linked) {
+          staging.offspringAdded[parentNode]--;
+        }
+        continue;
+      }
+      auto &stagedParent = staging.nodes[-2 - parentNode];
+      if (staged.linked) {
+        stagedParent.offspringCount--;
+      }
+      if (--stagedParent.childLinks == 0 && stagedParent.organism == nullptr) {
+        released.push_back(parentNode);
+      }
+    }
+  }
+}
+
+void Phylogeny::releaseOrganism(Node node, Organism &organism) {
+  Staging *staging = threadStaging();
+  if (isStaged(node)) {
+    auto &staged = stagedNode(node);
+    staged.organism = nullptr;
+    if (staged.childLinks > 0) {
+      staged.record = makeRecord(organism);
+    } else {
+      releaseStaged(*staging, node);
+    }
+    return;
+  }
+  if (staging != nullptr) {
+    // (whether node is still in use is not known until staged children are
+    // merged, so merge keeps the record or frees the node)
+    staging->releasedNodes.emplace_back(node, makeRecord(organism));
+    return;
+  }
+  organisms[node] = nullptr;
+  if (inUse(node)) {
+    records[node] = makeRecord(organism);
+  } else {
+    free(node);
+  }
+}
+
+void Phylogeny::hold(Node node) {
+  requireMerged(node, "hold");
+  requireUnstaged("hold");
+  holds[node]++;
+}
+
+void Phylogeny::release(Node node) {
+  requireMerged(node, "release");
+  requireUnstaged("release");
+  holds[node]--;
+  if (!inUse(node)) {
+    free(node);
+  }
+}
+
+void Phylogeny::merge(std::vector<Staging> &stagings) {
+  for (auto &staging : stagings) {
+    for (auto const &added : staging.offspringAdded) {
+      offspringCounts[added.first] += added.second;
+    }
+  }
+  std::vector<Node> cleared; // merged nodes whose parents were cleared
+  for (auto &staging : stagings) {
+    for (auto &staged : staging.nodes) {
+      // a node has a lineage tracker's bit if all of its parents do (staged
+      // parents were made, and so are merged, before their offspring)
+      uint32_t bits = 0;
+      for (size_t p = 0; p < staged.parentNodes.size(); p++) {
+        Node parentNode = staged.parentNodes[p];
+        uint32_t parentBits = isStaged(parentNode)
+                                  ? staging.nodes[-2 - parentNode].lineageBits
+                                  : lineageBits[parentNode];
+        bits = (p == 0) ? parentBits : (bits & parentBits);
+      }
+      staged.lineageBits = bits;
+      if (staged.released) {
+        continue;
+      }
+      Node node = allocate();
+      staged.merged = node;
+      ids[node] = staged.id;
+      births[node] = staged.birth;
+      deaths[node] = staged.death;
+      offspringCounts[node] = staged.offspringCount;
+      childLinks[node] = 0;
+      childSums[node] = 0;
+      firstParents[node] = none;
+      organisms[node] = staged.organism;
+      records[node] = std::move(staged.record);
+      holds[node] = 0;
+      lineageBits[node] = bits;
+      for (auto &saved : savedIn) {
+        saved[node] = staged.parentNodes.empty() ? INT_MIN : notSaved;
+      }
+      // (a released parent has no linked children, so staged parents here
+      // have been merged)
+      for (Node parentNode : staged.parentNodes) {
+        if (isStaged(parentNode)) {
+          parentNode = staging.nodes[-2 - parentNode].merged;
+        }
+        childLinks[parentNode]++;
+        childSums[parentNode] += node;
+        if (firstParents[node] == none) {
+          firstParents[node] = parentNode;
+        } else {
+          otherParents[node].push_back(parentNode);
+        }
+      }
+      if (!staged.linked) {
+        cleared.push_back(node);
+      }
+      if (staged.organism != nullptr) {
+        staged.organism->phylogenyNode = node;
+      }
+    }
+  }
+  for (auto &staging : stagings) {
+    for (auto &released : staging.releasedNodes) {
+      Node node = released.first;
+      organisms[node] = nullptr;
+      if (inUse(node)) {
+        records[node] = std::move(released.second);
+      } else {
+        free(node);
+      }
+    }
+  }
+  for (Node node : cleared) {
+    clearParents(node);
+  }
+  for (auto &staging : stagings) {
+    staging.nodes.clear();
+    staging.offspringAdded.clear();
+    staging.releasedNodes.clear();
+  }
+}
+
+std::vector<Phylogeny::Node> Phylogeny::getParents(Node node) {
+  if (isStaged(node)) {
+    auto &staged = stagedNode(node);
+    return staged.linked ? staged.parentNodes : std::vector<Node>();
+  }
+  std::vector<Node> parents;
+  if (firstParents[node] == none) {
+    return parents;
+  }
+  parents.push_back(firstParents[node]);
+  auto others = otherParents.find(node);
+  if (others != otherParents.end()) {
+    parents.insert(parents.end(), others->second.begin(),
+                   others->second.end());
+  }
+  return parents;
+}
+
+bool Phylogeny::hasLinkedChildren(Node node) {
+  requireMerged(node, "hasLinkedChildren");
+  return childLinks[node] > 0;
+}
+
+std::vector<Phylogeny::Node> Phylogeny::getLineage(Node node,
+                                                   bool &hasMultipleParents) {
+  requireMerged(node, "getLineage");
+  std::vector<Node> lineage;
+  lineage.push_back(node);
+  // while the current node has one and only one parent
+  while (firstParents[node] != none &&
+         otherParents.find(node) == otherParents.end()) {
+    node = firstParents[node];
+    lineage.push_back(node);
+  }
+  hasMultipleParents = firstParents[node] != none;
+  std::reverse(lineage.begin(), lineage.end());
+  return lineage;
+}
+
+Phylogeny::Node
+Phylogeny::getMostRecentCommonAncestor(const std::vector<Node> &lineage) {
+  for (Node node : lineage) { // starting at the oldest, moving to the youngest
+    if (offspringCounts[node] > 1) {
+      return node;
+    }
+  }
+  return lineage.back();
+}
+
+std::vector<Phylogeny::Node> Phylogeny::getOnlyChildChain(Node node) {
+  requireMerged(node, "getOnlyChildChain");
+  std::vector<Node> chain;
+  chain.push_back(node);
+  while (offspringCounts[node] == 1 && childLinks[node] == 1) {
+    node = static_cast<Node>(childSums[node]);
+    chain.push_back(node);
+  }
+  return chain;
+}
+
+int Phylogeny::addLineageTracker() {
+  if (lineageTrackers >= 32) {
+    std::cout << "  In Phylogeny::addLineageTracker() :: more then 32 lineage "
+                 "trackers were requested.\n  Exiting." << std::endl;
+    exit(1);
+  }
+  return lineageTrackers++;
+}
+
+void Phylogeny::setRoot(int tracker, Node root,
+                        const std::vector<Node> &living) {
+  uint32_t bit = 1u << tracker;
+  // nodes whose descent is known (each node is walked over at most once)
+  std::unordered_map<Node, bool> known;
+  known[root] = true;
+  std::vector<Node> path;
+  for (Node node : living) {
+    path.clear();
+    bool descends = false;
+    while (true) {
+      auto found = known.find(node);
+      if (found != known.end()) {
+        descends = found->second;
+        break;
+      }
+      path.push_back(node);
+      if (firstParents[node] == none ||
+          otherParents.find(node) != otherParents.end()) {
+        break; // a line of descent only follows single parents
+      }
+      node = firstParents[node];
+    }
+    for (Node pathNode : path) {
+      known[pathNode] = descends;
+    }
+  }
+  for (auto const &entry : known) {
+    if (entry.second) {
+      lineageBits[entry.first] |= bit;
+    } else {
+      lineageBits[entry.first] &= ~bit;
+    }
+  }
+}
+
+bool Phylogeny::descendsFromRoot(int tracker, Node node) {
+  requireMerged(node, "descendsFromRoot");
+  return (lineageBits[node] >> tracker) & 1u;
+}
+
+void Phylogeny::detach(int tracker, Node node) {
+  requireMerged(node, "detach");
+  lineageBits[node] &= ~(1u << tracker);
+}
+
+void Phylogeny::trackAncestors(AncestorSet set) { trackedAncestors[set] = true; }
+
+std::vector<int> Phylogeny::getAncestors(AncestorSet set, Node node) {
+  requireMerged(node, "getAncestors");
+  if (savedIn[set][node] <= Global::update) {
+    return {ids[node]};
+  }
+  return getBirthAncestors(set, node);
+}
+
+std::vector<int> Phylogeny::getBirthAncestors(AncestorSet set, Node node) {
+  auto kept = keptAncestors[set].find(node);
+  if (kept != keptAncestors[set].end()) {
+    return kept->second;
+  }
+  // a node's ancestors are its parents' ancestors when it was born, and a
+  // parent saved before then is its own ancestor
+  std::vector<int> ancestors;
+  std::unordered_set<Node> walked{node};
+  std::vector<Node> toWalk{node};
+  while (!toWalk.empty()) {
+    Node child = toWalk.back();
+    toWalk.pop_back();
+    for (Node parent : getParents(child)) {
+      if (savedIn[set][parent] < births[child]) {
+        ancestors.push_back(ids[parent]);
+        continue;
+      }
+      auto parentKept = keptAncestors[set].find(parent);
+      if (parentKept != keptAncestors[set].end()) {
+        ancestors.insert(ancestors.end(), parentKept->second.begin(),
+                         parentKept->second.end());
+      } else if (walked.insert(parent).second) {
+        toWalk.push_back(parent);
+      }
+    }
+  }
+  std::sort(ancestors.begin(), ancestors.end());
+  ancestors.erase(std::unique(ancestors.begin(), ancestors.end()),
+                  ancestors.end());
+  return ancestors;
+}
+
+void Phylogeny::setAncestors(AncestorSet set, Node node,
+                             std::vector<int> ancestors) {
+  requireMerged(node, "setAncestors");
+  std::sort(ancestors.begin(), ancestors.end());
+  ancestors.erase(std::unique(ancestors.begin(), ancestors.end()),
+                  ancestors.end());
+  keptAncestors[set][node] = std::move(ancestors);
+}
+
+void Phylogeny::setSaved(AncestorSet set, Node node) {
+  requireMerged(node, "setSaved");
+  savedIn[set][node] = std::min(savedIn[set][node], Global::update);
+  if (childLinks[node] == 0) {
+    keptAncestors[set].erase(node); // (no offspring born before now to ask)
+  }
+}
+
+bool Phylogeny::isSaved(AncestorSet set, Node node) {
+  requireMerged(node, "isSaved");
+  return savedIn[set][node] <= Global::update;
+}
+
+Phylogeny::WeakNode Phylogeny::getWeakNode(Node node) {
+  requireMerged(node, "getWeakNode");
+  return {node, serials[node]};
+}
+
+bool Phylogeny::expired(const WeakNode &weakNode) {
+  return serials[weakNode.node] != weakNode.serial;
+}
+
+DataMap &Phylogeny::getDataMap(Node node) {
+  requireMerged(node, "getDataMap");
+  return organisms[node] != nullptr ? organisms[node]->dataMap
+                                    : records[node]->dataMap;
+}
+
+std::map<int, DataMap> &Phylogeny::getSnapShotDataMaps(Node node) {
+  requireMerged(node, "getSnapShotDataMaps");
+  return organisms[node] != nullptr ? organisms[node]->snapShotDataMaps
+                                    : records[node]->snapShotDataMaps;
+}
+
+std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &
+Phylogeny::getGenomes(Node node) {
+  requireMerged(node, "getGenomes");
+  return organisms[node] != nullptr ? organisms[node]->genomes
+                                    : records[node]->genomes;
+}
+
+std::unordered_map<std::string, std::shared_ptr<AbstractBrain>> &
+Phylogeny::getBrains(Node node) {
+  requireMerged(node, "getBrains");
+  return organisms[node] != nullptr ? organisms[node]->brains
+                                    : records[node]->brains;
+}
+
+int Phylogeny::getID(Node node) {
+  if (isStaged(node)) {
+    return stagedNode(node).id;
+  }
+  return ids[node];
+}
+
+void Phylogeny::setID(Node node, int id) {
+  if (isStaged(node)) {
+    stagedNode(node).id = id;
+    return;
+  }
+  ids[node] = id;
+}
+
+int Phylogeny::getBirth(Node node) {
+  if (isStaged(node)) {
+    return stagedNode(node).birth;
+  }
+  return births[node];
+}
+
+int Phylogeny::getDeath(Node node) {
+  if (isStaged(node)) {
+    return stagedNode(node).death;
+  }
+  return deaths[node];
+}
+
+void Phylogeny::setDeath(Node node, int death) {
+  if (isStaged(node)) {
+    stagedNode(node).death = death;
+    return;
+  }
+  // (on a staging thread this is still safe, as only the thread optimizing
+  // an organism kills it, and merged nodes are not moved until merge)
+  deaths[node] = death;
+}
+
+int Phylogeny::getOffspringCount(Node node) {
+  if (isStaged(node)) {
+    return stagedNode(node).offspringCount;
+  }
+  int added = 0;
+  Staging *staging = threadStaging();
+  if (staging != nullptr) {
+    auto found = staging->offspringAdded.find(node);
+    if (found != staging->offspringAdded.end()) {
+      added = found->second;
+    }
+  }
+  return offspringCounts[node] + added;
+}
+
+void Phylogeny::setOffspringCount(Node node, int offspringCount) {
+  if (isStaged(node)) {
+    stagedNode(node).offspringCount = offspringCount;
+    return;
+  }
+  requireUnstaged("setOffspringCount");
+  offspringCounts[node] = offspringCount;
+}
+
+size_t Phylogeny::size() { return ids.size() - freeNodes.size(); }
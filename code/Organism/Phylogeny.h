@@ -0,0 +1,226 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#pragma once
+
+#include <Utilities/Data.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class AbstractBrain;
+class AbstractGenome;
+class Organism;
+
+// Phylogeny holds the ancestry of every organism in memory. Each organism has
+// a node, and nodes are kept as parallel arrays (id, parents, birth, death,
+// offspringCount) addressed by index, so lines of descent are walked without
+// touching the organisms themselves.
+//
+// A node is in use while its organism exists, while it has linked children
+// (children which have not had their parents cleared), or while it is held
+// (i.e. by LODwAP as the root of its line of descent). When an organism is
+// deleted and its node is still in use, the node keeps a Record of the
+// organism's data and genomes (so dead ancestors can still be written out),
+// and when the node is no longer in use it is freed along with its Record.
+//
+// The phylogeny is only changed on the main thread, or through a Staging (see
+// below) on other threads, so it does not take a lock.
+class Phylogeny {
+public:
+  using Node = int;
+  static constexpr Node none = -1;
+
+  // what is kept of an organism once it is deleted, while its node is in use
+  struct Record {
+    DataMap dataMap;
+    std::map<int, DataMap> snapShotDataMaps;
+    std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> genomes;
+    std::unordered_map<std::string, std::shared_ptr<AbstractBrain>> brains;
+  };
+
+  // while a thread has a staging (threadStaging), nodes made on it are kept
+  // in the staging. they are numbered down from -2, and can be used as any
+  // other node by that thread (except to walk lines of descent). offspring
+  // added to existing nodes, and existing nodes whose organisms are deleted,
+  // are also kept there. merge then adds staged nodes to the phylogeny, in the
+  // order they were made, so node numbers do not depend on thread timing.
+  class Staging {
+    friend class Phylogeny;
+    struct StagedNode {
+      Organism *organism; // nullptr once deleted
+      int id;
+      int birth;
+      int death;
+      int offspringCount;
+      int childLinks; // (from staged children)
+      std::vector<Node> parentNodes; // (staged or not)
+      bool linked;   // false once parents are cleared (they are still linked
+                     // when merged, and then cleared)
+      bool released; // deleted with no linked children (so not merged)
+      std::unique_ptr<Record> record; // once deleted, if still in use
+      uint32_t lineageBits; // (worked out by merge)
+      Node merged;          // (set by merge)
+    };
+    std::vector<StagedNode> nodes; // staged node n is nodes[-2 - n]
+    std::unordered_map<Node, int> offspringAdded; // by existing node
+    // existing nodes whose organisms were deleted (and the records made)
+    std::vector<std::pair<Node, std::unique_ptr<Record>>> releasedNodes;
+  };
+  static Staging *&threadStaging();
+  // add every staged node to the phylogeny (stagings in order) and empty the
+  // stagings. call on the main thread, once the threads staging are done
+  void merge(std::vector<Staging> &stagings);
+
+  static Phylogeny &get(); // the phylogeny all organisms are in
+
+  // make a node for an organism (with no parents), and set its phylogenyNode
+  void addNode(Organism &organism);
+  // link node to parents (in addition to any parents it already has), and
+  // count it as an offspring of each
+  void linkParents(Node node, const std::vector<Node> &parents);
+  // release the links from node to its parents, without changing their
+  // offspringCount (this is pruning - the offspring still exists). parents
+  // which are no longer in use are freed
+  void clearParents(Node node);
+  // node's organism is being deleted. if node is still in use, the organism's
+  // data and genomes are moved to its Record, otherwise node is freed
+  void releaseOrganism(Node node, Organism &organism);
+  // keep node in use (even once its organism is deleted) until release
+  void hold(Node node);
+  void release(Node node);
+
+  std::vector<Node> getParents(Node node);
+  bool hasLinkedChildren(Node node);
+
+  // nodes from the oldest ancestor reachable by single parent links to node
+  // (inclusive). if the oldest has more then one parent, hasMultipleParents is set
+  std::vector<Node> getLineage(Node node, bool &hasMultipleParents);
+  // the first (oldest) node in lineage with more then one offspring, or the last
+  Node getMostRecentCommonAncestor(const std::vector<Node> &lineage);
+  // node, and then each only child (the one offspring in memory, still linked)
+  // in turn. the last node is the first descendant of node with other then
+  // one offspring, i.e. the MRCA of any line of descent through node.
+  std::vector<Node> getOnlyChildChain(Node node);
+
+  // a lineage tracker (i.e. a LODwAPArchivist) has a root, and a bit in every
+  // node which is set if that node descends from the root. a new node has the
+  // bit if all of its parents do, so checking descent does not need a walk.
+  int addLineageTracker(); // returns the tracker (at most 32)
+  // set tracker's root, and its bit on each of living (and their ancestors)
+  // by walking up from them once
+  void setRoot(int tracker, Node root, const std::vector<Node> &living);
+  bool descendsFromRoot(int tracker, Node node);
+  // node no longer descends from tracker's root (nor will its offspring)
+  void detach(int tracker, Node node);
+
+  // an organism's ancestors are the IDs of its closest ancestors in the last
+  // data files (DATA_ANCESTORS, SSwD) or snapshot files (SNAPSHOT_ANCESTORS,
+  // Default). an organism which has been saved, or was made with no parents,
+  // is its own ancestor; otherwise its ancestors are those of its parents when
+  // it was born. they are found by walking up from the organism when asked for
+  enum AncestorSet { DATA_ANCESTORS = 0, SNAPSHOT_ANCESTORS = 1 };
+  // an archivist will ask for this set (so when a node's parents are cleared,
+  // the node keeps its ancestors in this set)
+  void trackAncestors(AncestorSet set);
+  std::vector<int> getAncestors(AncestorSet set, Node node); // in ID order
+  // set node's ancestors (i.e. once SSwD has checked them against its files)
+  void setAncestors(AncestorSet set, Node node, std::vector<int> ancestors);
+  // node has been saved in this update, so from now on it is its own ancestor
+  void setSaved(AncestorSet set, Node node);
+  bool isSaved(AncestorSet set, Node node);
+
+  // a reference to a node which does not keep it in use (like a weak_ptr)
+  struct WeakNode {
+    Node node;
+    uint32_t serial;
+  };
+  WeakNode getWeakNode(Node node);
+  bool expired(const WeakNode &weakNode);
+
+  // node's organism's data and genomes (from its Record once it is deleted)
+  DataMap &getDataMap(Node node);
+  std::map<int, DataMap> &getSnapShotDataMaps(Node node);
+  std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &
+  getGenomes(Node node);
+  std::unordered_map<std::string, std::shared_ptr<AbstractBrain>> &
+  getBrains(Node node);
+
+  int getID(Node node);
+  void setID(Node node, int id);
+  int getBirth(Node node);
+  int getDeath(Node node);
+  void setDeath(Node node, int death);
+  int getOffspringCount(Node node);
+  void setOffspringCount(Node node, int offspringCount);
+
+  size_t size(); // number of nodes in use
+
+private:
+  Phylogeny() = default;
+
+  Node allocate();
+  static bool isStaged(Node node) { return node < none; }
+  // the staged node on this thread's staging (exits if there is no staging)
+  static Staging::StagedNode &stagedNode(Node node);
+  // exits if node is staged (caller can only use nodes in the phylogeny)
+  static void requireMerged(Node node, const char *caller);
+  // exits if this thread has a staging (caller changes shared nodes)
+  static void requireUnstaged(const char *caller);
+  bool inUse(Node node) const;
+  // unlink node from its parents. parents which are then not in use are added
+  // to unused
+  void unlinkParents(Node node, bool countOffspring, std::vector<Node> &unused);
+  // unlink node from its parents, and free any parents (and their parents...)
+  // which are then not in use
+  void releaseParents(Node node, bool countOffspring);
+  void free(Node node);    // (node is not in use)
+  void recycle(Node node); // (node has no parents and is not in use)
+  // a staged node's organism is gone and it has no linked children, so it
+  // will not be merged. staged parents may be released in turn
+  static void releaseStaged(Staging &staging, Node node);
+  static std::unique_ptr<Record> makeRecord(Organism &organism);
+  // ancestors of node as they were when born (from its parents, or kept)
+  std::vector<int> getBirthAncestors(AncestorSet set, Node node);
+
+  static constexpr int notSaved = 0x7fffffff;
+
+  std::vector<int> ids;
+  std::vector<int> births;
+  std::vector<int> deaths;
+  std::vector<int> offspringCounts; // offspring in memory (see Organism)
+  std::vector<int> childLinks;      // children whose parents include this node
+  std::vector<int64_t> childSums; // sum of linked children (so, if childLinks
+                                  // is 1, the child)
+  std::vector<Node> firstParents;   // none if there are no parents
+  std::unordered_map<Node, std::vector<Node>>
+      otherParents; // parents after the first (sexual reproduction only)
+  std::vector<Organism *> organisms; // nullptr once deleted
+  std::vector<std::unique_ptr<Record>> records; // set once deleted
+  std::vector<int> holds;
+  std::vector<uint32_t> serials; // (changed when a node is reused)
+
+  std::vector<uint32_t> lineageBits; // one bit per lineage tracker
+
+  // per AncestorSet, the update each node was first saved in (notSaved if it
+  // has not been, and the lowest int if it was made with no parents)
+  std::vector<int> savedIn[2];
+  // per AncestorSet, the ancestors of nodes which can not be worked out from
+  // their parents (the parents were cleared, or they were set)
+  std::unordered_map<Node, std::vector<int>> keptAncestors[2];
+  bool trackedAncestors[2] = {false, false};
+
+  std::vector<Node> freeNodes;
+  int lineageTrackers = 0;
+};
@@ -0,0 +1,144 @@
+#ifdef MABE_MODULE_Genome_Circular
+// brain updates, and decoding genomes into Markov brain gates. Brains are
+// built from a 5000 site char genome which the brain initialized (as the
+// first population's brains are) with a fixed seed. Inputs cycle through
+// benchBrainInputRows fixed 0/1 patterns.
+
+#include <Brain/AbstractBrain.h>
+
+#include <random>
+#include <unordered_map>
+
+static const int benchBrainInputRows = 64;
+
+// a brain built from templateBrain, with the genomes it needs
+static std::shared_ptr<AbstractBrain> benchBrain(std::shared_ptr<AbstractBrain> templateBrain,
+	std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &genomes) {
+	BenchCircularGenomeParameters parameters(5000, "char");
+	Random::seed(101);
+	auto templateGenome = benchCircularGenome();
+	for (auto &name : templateBrain->requiredGenomes()) {
+		genomes[name] = templateGenome->makeLike();
+	}
+	templateBrain->initializeGenomes(genomes);
+	return templateBrain->makeBrain(genomes);
+}
+
+// range(0) = inputs (outputs are half as many)
+static void benchBrainUpdates(benchmark::State &state, std::shared_ptr<AbstractBrain> templateBrain) {
+	std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> genomes;
+	auto brain = benchBrain(templateBrain, genomes);
+	const int inputs = state.range(0);
+	std::vector<std::vector<double>> inputRows(benchBrainInputRows, std::vector<double>(inputs));
+	std::mt19937 gen(101);
+	for (auto &row : inputRows) {
+		for (auto &value : row) {
+			value = Random::getIndex(2, gen);
+		}
+	}
+	brain->resetBrain();
+	int row = 0;
+	for (auto _ : state) {
+		for (int i = 0; i < inputs; i++) {
+			brain->setInput(i, inputRows[row][i]);
+		}
+		brain->update();
+		benchmark::DoNotOptimize(brain->readOutput(0));
+		row = (row + 1) % benchBrainInputRows;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+#ifdef MABE_MODULE_Brain_Markov
+#include <Brain/MarkovBrain/MarkovBrain.h>
+
+// range(1) = hidden nodes, range(2) = deterministic gates in the genome
+static void BM_MarkovBrainUpdate(benchmark::State &state) {
+	BenchParameter<int> hiddenNodes("BRAIN_MARKOV-hiddenNodes", state.range(1));
+	BenchParameter<int> gates("BRAIN_MARKOV_GATES_DETERMINISTIC-initialCount", state.range(2));
+	benchBrainUpdates(state, MarkovBrain_brainFactory(state.range(0), state.range(0) / 2, Parameters::root));
+}
+BENCHMARK(BM_MarkovBrainUpdate)->ArgsProduct({{4, 16}, {8, 32}, {6, 50}});
+
+// decoding the genome of a mutated copy of a parent into gates (as each
+// offspring's brain is built). range(0) = sites, range(1) = method:
+// 0 = read every site, 1 = start codon index, 2 = start codon index and
+// copy the gates in sites that did not change from the parent's decoding
+// (see BRAIN_MARKOV_ADVANCED-useCodonIndex)
+static void BM_GateListDecode(benchmark::State &state) {
+	const int method = state.range(1);
+	BenchParameter<bool> useCodonIndex("BRAIN_MARKOV_ADVANCED-useCodonIndex", method > 0);
+	BenchCircularGenomeParameters parameters(state.range(0), "char");
+	auto templateBrain = std::dynamic_pointer_cast<MarkovBrain>(MarkovBrain_brainFactory(8, 4, Parameters::root));
+	Random::seed(101);
+	auto parent = benchCircularGenome();
+	std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> genomes;
+	genomes[*templateBrain->requiredGenomes().begin()] = parent;
+	templateBrain->initializeGenomes(genomes);
+
+	std::shared_ptr<const GateListDecoding> parentDecoding;
+	templateBrain->GLB->buildGateList(parent, templateBrain->nrNodes, Parameters::root, nullptr, &parentDecoding);
+	std::shared_ptr<AbstractGenome> child;
+	std::vector<std::shared_ptr<AbstractGate>> gates;
+	size_t gateCount = 0;
+	for (auto _ : state) {
+		state.PauseTiming();
+		child = parent->makeMutatedGenomeFrom(parent);
+		gates.clear();
+		state.ResumeTiming();
+		std::shared_ptr<const GateListDecoding> decoding;
+		gates = templateBrain->GLB->buildGateList(child, templateBrain->nrNodes, Parameters::root,
+			method == 2 ? parentDecoding : nullptr, &decoding);
+		gateCount += gates.size();
+	}
+	state.counters["gates"] = benchmark::Counter(gateCount, benchmark::Counter::kAvgIterations);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GateListDecode)->ArgsProduct({{5000, 20000}, {0, 1, 2}});
+#endif
+
+#ifdef MABE_MODULE_Brain_ANN
+#include <Brain/ANNBrain/ANNBrain.h>
+
+// range(1) = recurring nodes
+static void BM_ANNBrainUpdate(benchmark::State &state) {
+	BenchParameter<int> recurringNodes("BRAIN_ANN-nrOfRecurringNodes", state.range(1));
+	benchBrainUpdates(state, ANNBrain_brainFactory(state.range(0), state.range(0) / 2, Parameters::root));
+}
+BENCHMARK(BM_ANNBrainUpdate)->ArgsProduct({{4, 16}, {10, 40}});
+#endif
+
+#ifdef MABE_MODULE_Brain_LSTM
+#include <Brain/LSTMBrain/LSTMBrain.h>
+
+static void BM_LSTMBrainUpdate(benchmark::State &state) {
+	benchBrainUpdates(state, LSTMBrain_brainFactory(state.range(0), state.range(0) / 2, Parameters::root));
+}
+BENCHMARK(BM_LSTMBrainUpdate)->Arg(4)->Arg(16);
+#endif
+
+#ifdef MABE_MODULE_Brain_Wire
+#include <Brain/WireBrain/WireBrain.h>
+
+// range(1) = width, height and depth of the wire space (the default, 6, is too
+// small for 16 inputs)
+static void BM_WireBrainUpdate(benchmark::State &state) {
+	BenchParameter<int> width("BRAIN_WIRE-size_width", state.range(1));
+	BenchParameter<int> height("BRAIN_WIRE-size_height", state.range(1));
+	BenchParameter<int> depth("BRAIN_WIRE-size_depth", state.range(1));
+	benchBrainUpdates(state, WireBrain_brainFactory(state.range(0), state.range(0) / 2, Parameters::root));
+}
+BENCHMARK(BM_WireBrainUpdate)->ArgsProduct({{4, 16}, {8, 12}});
+#endif
+
+#ifdef MABE_MODULE_Brain_CGP
+#include <Brain/CGPBrain/CGPBrain.h>
+
+// range(1) = hidden nodes
+static void BM_CGPBrainUpdate(benchmark::State &state) {
+	BenchParameter<int> hiddenNodes("BRAIN_CGP-hiddenNodes", state.range(1));
+	benchBrainUpdates(state, CGPBrain_brainFactory(state.range(0), state.range(0) / 2, Parameters::root));
+}
+BENCHMARK(BM_CGPBrainUpdate)->ArgsProduct({{4, 16}, {3, 12}});
+#endif
+#endif
@@ -0,0 +1,110 @@
+#ifdef MABE_MODULE_Genome_Circular
+#include <Genome/CircularGenome/CircularGenome.h>
+
+#include <string>
+#include <unordered_map>
+
+// making, saving and loading CircularGenomes with the default mutation rates.
+// range(0) = sites (5000 is the default size, genomes much smaller than 2000
+// sites do not fit the default indel sizes), range(1) = site type (below)
+
+static const std::vector<std::string> benchSitesTypes = { "char", "int", "double" };
+
+// sets a parameter of Parameters::root for the rest of a benchmark, then puts
+// back the value it had (so a benchmark measures the same run alone or after
+// others)
+template <typename T>
+class BenchParameter {
+public:
+	BenchParameter(const std::string &name_, const T &value) : name(name_) {
+		Parameters::root->lookup(name, previous);
+		Parameters::root->setParameter(name, value);
+	}
+	~BenchParameter() { Parameters::root->setParameter(name, previous); }
+	BenchParameter(const BenchParameter &) = delete;
+	BenchParameter &operator=(const BenchParameter &) = delete;
+
+private:
+	std::string name;
+	T previous;
+};
+
+// the parameters of a genome of size sites of sitesType (genomes read the
+// size limits when they mutate, so keep these while the genome is used)
+struct BenchCircularGenomeParameters {
+	BenchParameter<std::string> sitesType;
+	BenchParameter<int> sizeInitial;
+	// (so that indels neither only grow nor only shrink the genome)
+	BenchParameter<int> sizeMin;
+	BenchParameter<int> sizeMax;
+
+	BenchCircularGenomeParameters(int size, const std::string &type)
+		: sitesType("GENOME-sitesType", type), sizeInitial("GENOME_CIRCULAR-sizeInitial", size),
+		sizeMin("GENOME_CIRCULAR-sizeMin", size / 2), sizeMax("GENOME_CIRCULAR-sizeMax", size * 2) {}
+};
+
+// a genome of random sites, made from Parameters::root
+static std::shared_ptr<AbstractGenome> benchCircularGenome() {
+	auto genome = CircularGenome_genomeFactory(Parameters::root);
+	genome->fillRandom();
+	return genome;
+}
+
+// a mutated copy of a parent (as each offspring's genome is made)
+static void BM_CircularGenomeMutatedCopy(benchmark::State &state) {
+	BenchCircularGenomeParameters parameters(state.range(0), benchSitesTypes[state.range(1)]);
+	Random::seed(101);
+	auto parent = benchCircularGenome();
+	std::shared_ptr<AbstractGenome> child;
+	for (auto _ : state) {
+		child = parent->makeMutatedGenomeFrom(parent);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CircularGenomeMutatedCopy)->ArgsProduct({{2000, 5000, 50000}, {0, 1, 2}});
+
+// mutate in place (the size drifts with indels, the same way every run)
+static void BM_CircularGenomeMutate(benchmark::State &state) {
+	BenchCircularGenomeParameters parameters(state.range(0), benchSitesTypes[state.range(1)]);
+	Random::seed(101);
+	auto genome = benchCircularGenome();
+	for (auto _ : state) {
+		genome->mutate();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CircularGenomeMutate)->ArgsProduct({{2000, 5000, 50000}, {0, 1, 2}});
+
+// range(2) = 1 to save sites as binary (GENOME-sitesEncoding)
+static void BM_CircularGenomeSerialize(benchmark::State &state) {
+	BenchCircularGenomeParameters parameters(state.range(0), benchSitesTypes[state.range(1)]);
+	Random::seed(101);
+	auto genome = benchCircularGenome();
+	BenchParameter<std::string> sitesEncoding("GENOME-sitesEncoding", state.range(2) ? "binary" : "text");
+	std::string name = "GENOME_root::";
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(genome->serialize(name));
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CircularGenomeSerialize)->ArgsProduct({{5000, 50000}, {0, 1, 2}, {0, 1}});
+
+// (char genomes are left out, their deserialize writes to std::cout)
+static void BM_CircularGenomeDeserialize(benchmark::State &state) {
+	BenchCircularGenomeParameters parameters(state.range(0), benchSitesTypes[state.range(1)]);
+	Random::seed(101);
+	auto genome = benchCircularGenome();
+	BenchParameter<std::string> sitesEncoding("GENOME-sitesEncoding", state.range(2) ? "binary" : "text");
+	std::string name = "GENOME_root::";
+	DataMap saved = genome->serialize(name);
+	std::unordered_map<std::string, std::string> orgData;
+	orgData[name + "_genomeLength"] = saved.getStringOfVector(name + "_genomeLength");
+	orgData[name + "_sites"] = saved.getStringVector(name + "_sites")[0];
+	auto loaded = genome->makeLike();
+	for (auto _ : state) {
+		loaded->deserialize(Parameters::root, orgData, name);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CircularGenomeDeserialize)->ArgsProduct({{5000, 50000}, {1, 2}, {0, 1}});
+#endif
@@ -0,0 +1,101 @@
+#include <Utilities/Data.h>
+
+#include <string>
+#include <vector>
+
+// the DataMap calls a world makes for each organism it evaluates (set and
+// append of scores) and the reads the optimizer and archivist make after
+// (getAverage, getDoubleVector). range(0) = keys, range(1) = values appended
+// to each key (evaluations per organism)
+
+static std::vector<std::string> benchDataMapKeys(int count) {
+	std::vector<std::string> keys;
+	for (int k = 0; k < count; k++) {
+		keys.push_back("score" + std::to_string(k));
+	}
+	return keys;
+}
+
+static void BM_DataMapSet(benchmark::State &state) {
+	auto keys = benchDataMapKeys(state.range(0));
+	DataMap dataMap;
+	for (auto _ : state) {
+		for (size_t k = 0; k < keys.size(); k++) {
+			dataMap.set(keys[k], (double)k);
+		}
+	}
+	benchmark::DoNotOptimize(dataMap);
+	state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_DataMapSet)->Arg(4)->Arg(32);
+
+// as BM_DataMapSet, with the keys looked up once (DataMap::lookupKey)
+static void BM_DataMapSetKeyID(benchmark::State &state) {
+	auto keys = benchDataMapKeys(state.range(0));
+	std::vector<DataMap::KeyID> keyIDs;
+	for (auto &key : keys) {
+		keyIDs.push_back(DataMap::lookupKey(key));
+	}
+	DataMap dataMap;
+	for (auto _ : state) {
+		for (size_t k = 0; k < keyIDs.size(); k++) {
+			dataMap.set(keyIDs[k], (double)k);
+		}
+	}
+	benchmark::DoNotOptimize(dataMap);
+	state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_DataMapSetKeyID)->Arg(4)->Arg(32);
+
+// a new data map filled by range(1) evaluations (as a new organism's is)
+static void BM_DataMapAppend(benchmark::State &state) {
+	auto keys = benchDataMapKeys(state.range(0));
+	const int evaluations = state.range(1);
+	for (auto _ : state) {
+		DataMap dataMap;
+		for (int e = 0; e < evaluations; e++) {
+			for (size_t k = 0; k < keys.size(); k++) {
+				dataMap.append(keys[k], e * .5 + k);
+			}
+		}
+		benchmark::DoNotOptimize(dataMap);
+	}
+	state.SetItemsProcessed(state.iterations() * keys.size() * evaluations);
+}
+BENCHMARK(BM_DataMapAppend)->ArgsProduct({{4, 32}, {1, 10}});
+
+static DataMap benchDataMapFilled(const std::vector<std::string> &keys, int evaluations) {
+	DataMap dataMap;
+	for (int e = 0; e < evaluations; e++) {
+		for (size_t k = 0; k < keys.size(); k++) {
+			dataMap.append(keys[k], e * .5 + k);
+		}
+	}
+	return dataMap;
+}
+
+static void BM_DataMapGetAverage(benchmark::State &state) {
+	auto keys = benchDataMapKeys(state.range(0));
+	DataMap dataMap = benchDataMapFilled(keys, state.range(1));
+	for (auto _ : state) {
+		double total = 0;
+		for (auto &key : keys) {
+			total += dataMap.getAverage(key);
+		}
+		benchmark::DoNotOptimize(total);
+	}
+	state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_DataMapGetAverage)->ArgsProduct({{4, 32}, {1, 10}});
+
+static void BM_DataMapGetDoubleVector(benchmark::State &state) {
+	auto keys = benchDataMapKeys(state.range(0));
+	DataMap dataMap = benchDataMapFilled(keys, state.range(1));
+	for (auto _ : state) {
+		for (auto &key : keys) {
+			benchmark::DoNotOptimize(dataMap.getDoubleVector(key));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_DataMapGetDoubleVector)->ArgsProduct({{4, 32}, {1, 10}});
@@ -0,0 +1,38 @@
+#include <Analyze/entropy.h>
+
+#include <random>
+
+// entropy of recorded brain states (as Analyze uses on node time series).
+// range(0) = samples (updates recorded), range(1) = nodes in each sample. All
+// nodes are 0 or 1, so there are at most 2^range(1) different symbols
+
+static TS::intTimeSeries benchBitTimeSeries(int samples, int nodes, int seed) {
+	TS::intTimeSeries series(samples, std::vector<int>(nodes));
+	std::mt19937 gen(seed);
+	for (auto &sample : series) {
+		for (auto &node : sample) {
+			node = Random::getIndex(2, gen);
+		}
+	}
+	return series;
+}
+
+static void BM_Entropy(benchmark::State &state) {
+	auto X = benchBitTimeSeries(state.range(0), state.range(1), 101);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(ENT::Entropy(X));
+	}
+	state.SetItemsProcessed(state.iterations() * X.size());
+}
+BENCHMARK(BM_Entropy)->ArgsProduct({{100, 1000}, {2, 4, 8, 16}});
+
+// (three entropies, one of X and Y joined)
+static void BM_MutualEntropy(benchmark::State &state) {
+	auto X = benchBitTimeSeries(state.range(0), state.range(1), 101);
+	auto Y = benchBitTimeSeries(state.range(0), state.range(1), 102);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(ENT::MutualEntropy(X, Y));
+	}
+	state.SetItemsProcessed(state.iterations() * X.size());
+}
+BENCHMARK(BM_MutualEntropy)->ArgsProduct({{100, 1000}, {2, 4, 8}});
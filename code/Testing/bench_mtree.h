@@ -0,0 +1,68 @@
+#include <Utilities/CompiledMTree.h>
+
+// compare walking an MTree with running it compiled (CompiledMTree), on
+// optimizer formulas evaluated once for each organism in a population
+
+// (stands in for Organism, which is all evalPopulation needs)
+struct BenchMTreeOrganism {
+	DataMap dataMap;
+};
+
+static const std::vector<std::string> benchMTreeFormulas = {
+	"DM_AVE[score]",
+	"(DM_AVE[score]+DM_SUM[score])/2",
+	"REMAP[DM_AVE[score],0,100,-1,1]",
+	"MAX[DM_AVE[score],DM_SUM[score]*0.1,0]^2",
+};
+
+// range(0) = population size, range(1) = formula
+static std::vector<std::shared_ptr<BenchMTreeOrganism>> benchMTreePopulation(int size) {
+	std::vector<std::shared_ptr<BenchMTreeOrganism>> population;
+	for (int i = 0; i < size; i++) {
+		population.push_back(std::make_shared<BenchMTreeOrganism>());
+		for (int j = 0; j < 4; j++) { // a few evaluations per organism
+			population.back()->dataMap.append("score", (i * 7 + j * 3) % 101 + .5);
+		}
+	}
+	return population;
+}
+
+static void BM_MTreeEval(benchmark::State &state) {
+	auto population = benchMTreePopulation(state.range(0));
+	auto tree = stringToMTree(benchMTreeFormulas[state.range(1)]);
+	std::vector<double> scores(population.size());
+	for (auto _ : state) {
+		for (size_t i = 0; i < population.size(); i++) {
+			scores[i] = tree->eval(population[i]->dataMap, nullptr)[0];
+		}
+		benchmark::DoNotOptimize(scores.data());
+	}
+	state.SetItemsProcessed(state.iterations() * population.size());
+}
+BENCHMARK(BM_MTreeEval)->ArgsProduct({{100, 1000}, {0, 1, 2, 3}});
+
+static void BM_CompiledMTreeEval(benchmark::State &state) {
+	auto population = benchMTreePopulation(state.range(0));
+	CompiledMTree program(stringToMTree(benchMTreeFormulas[state.range(1)]));
+	std::vector<double> scores(population.size());
+	for (auto _ : state) {
+		for (size_t i = 0; i < population.size(); i++) {
+			scores[i] = program.eval(population[i]->dataMap, nullptr);
+		}
+		benchmark::DoNotOptimize(scores.data());
+	}
+	state.SetItemsProcessed(state.iterations() * population.size());
+}
+BENCHMARK(BM_CompiledMTreeEval)->ArgsProduct({{100, 1000}, {0, 1, 2, 3}});
+
+static void BM_CompiledMTreeEvalPopulation(benchmark::State &state) {
+	auto population = benchMTreePopulation(state.range(0));
+	CompiledMTree program(stringToMTree(benchMTreeFormulas[state.range(1)]));
+	std::vector<double> scores;
+	for (auto _ : state) {
+		program.evalPopulation(population, nullptr, scores);
+		benchmark::DoNotOptimize(scores.data());
+	}
+	state.SetItemsProcessed(state.iterations() * population.size());
+}
+BENCHMARK(BM_CompiledMTreeEvalPopulation)->ArgsProduct({{100, 1000}, {0, 1, 2, 3}});
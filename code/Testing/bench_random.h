@@ -0,0 +1,129 @@
+#include <Utilities/Random.h>
+#include <Utilities/SiteSampler.h>
+
+// compare the generators Random:: can be built with (MABE_RANDOM_GENERATOR)
+// on the helpers MABE calls most often
+
+template <typename Engine>
+static void BM_getIndex(benchmark::State &state) {
+	Engine gen;
+	Random::seedGenerator(gen, 101);
+	const int size = state.range(0);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(Random::getIndex(size, gen));
+	}
+}
+BENCHMARK_TEMPLATE(BM_getIndex, std::mt19937)->Arg(100)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_getIndex, Random::Xoshiro256pp)->Arg(100)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_getIndex, Random::PCG32)->Arg(100)->Arg(10000);
+
+template <typename Engine>
+static void BM_P(benchmark::State &state) {
+	Engine gen;
+	Random::seedGenerator(gen, 101);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(Random::P(.005, gen));
+	}
+}
+BENCHMARK_TEMPLATE(BM_P, std::mt19937);
+BENCHMARK_TEMPLATE(BM_P, Random::Xoshiro256pp);
+BENCHMARK_TEMPLATE(BM_P, Random::PCG32);
+
+template <typename Engine>
+static void BM_getDouble(benchmark::State &state) {
+	Engine gen;
+	Random::seedGenerator(gen, 101);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(Random::getDouble(-1.0, 1.0, gen));
+	}
+}
+BENCHMARK_TEMPLATE(BM_getDouble, std::mt19937);
+BENCHMARK_TEMPLATE(BM_getDouble, Random::Xoshiro256pp);
+BENCHMARK_TEMPLATE(BM_getDouble, Random::PCG32);
+
+// range(0) = upper (getInt(0, upper), 255 is a char genome site)
+template <typename Engine>
+static void BM_getInt(benchmark::State &state) {
+	Engine gen;
+	Random::seedGenerator(gen, 101);
+	const int upper = state.range(0);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(Random::getInt(0, upper, gen));
+	}
+}
+BENCHMARK_TEMPLATE(BM_getInt, std::mt19937)->Arg(1)->Arg(255);
+BENCHMARK_TEMPLATE(BM_getInt, Random::Xoshiro256pp)->Arg(1)->Arg(255);
+BENCHMARK_TEMPLATE(BM_getInt, Random::PCG32)->Arg(1)->Arg(255);
+
+// (a new distribution each call, as Random::getNormal makes)
+template <typename Engine>
+static void BM_getNormal(benchmark::State &state) {
+	Engine gen;
+	Random::seedGenerator(gen, 101);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(Random::getNormal(0.0, 1.0, gen));
+	}
+}
+BENCHMARK_TEMPLATE(BM_getNormal, std::mt19937);
+BENCHMARK_TEMPLATE(BM_getNormal, Random::Xoshiro256pp);
+BENCHMARK_TEMPLATE(BM_getNormal, Random::PCG32);
+
+// range(0) = tests (5000 is the CircularGenome default size)
+template <typename Engine>
+static void BM_getBinomial(benchmark::State &state) {
+	Engine gen;
+	Random::seedGenerator(gen, 101);
+	const int tests = state.range(0);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(Random::getBinomial(tests, .005, gen));
+	}
+}
+BENCHMARK_TEMPLATE(BM_getBinomial, std::mt19937)->Arg(500)->Arg(5000);
+BENCHMARK_TEMPLATE(BM_getBinomial, Random::Xoshiro256pp)->Arg(500)->Arg(5000);
+BENCHMARK_TEMPLATE(BM_getBinomial, Random::PCG32)->Arg(500)->Arg(5000);
+
+// cost of setting up a stream (done once per organism per evaluation)
+template <typename Engine>
+static void BM_seedStream(benchmark::State &state) {
+	Engine gen;
+	uint64_t streamID = 0;
+	for (auto _ : state) {
+		Random::seedGenerator(gen, Random::getStreamSeed(0, streamID++));
+		benchmark::DoNotOptimize(gen());
+	}
+}
+BENCHMARK_TEMPLATE(BM_seedStream, std::mt19937);
+BENCHMARK_TEMPLATE(BM_seedStream, Random::Xoshiro256pp);
+BENCHMARK_TEMPLATE(BM_seedStream, Random::PCG32);
+
+// per site point mutation of a genome: a binomial count of uniform picks (what
+// CircularGenome::mutate did), and SiteSampler's geometric skips
+template <typename Engine>
+static void BM_pointMutationBinomial(benchmark::State &state) {
+	Engine gen;
+	Random::seedGenerator(gen, 101);
+	std::vector<int> sites(state.range(0), 0);
+	for (auto _ : state) {
+		int howMany = Random::getBinomial((int)sites.size(), .005, gen);
+		for (int i = 0; i < howMany; i++) {
+			sites[Random::getIndex((int)sites.size(), gen)] = Random::getIndex(256, gen);
+		}
+	}
+	benchmark::DoNotOptimize(sites.data());
+}
+BENCHMARK_TEMPLATE(BM_pointMutationBinomial, Random::Generator)->Arg(500)->Arg(5000);
+
+template <typename Engine>
+static void BM_pointMutationSiteSampler(benchmark::State &state) {
+	Engine gen;
+	Random::seedGenerator(gen, 101);
+	std::vector<int> sites(state.range(0), 0);
+	SiteSampler sampler(.005);
+	for (auto _ : state) {
+		sampler.forEach((int)sites.size(), [&](int site) {
+			sites[site] = Random::getIndex(256, gen);
+		}, gen);
+	}
+	benchmark::DoNotOptimize(sites.data());
+}
+BENCHMARK_TEMPLATE(BM_pointMutationSiteSampler, Random::Generator)->Arg(500)->Arg(5000);
@@ -0,0 +1,45 @@
+#include <Utilities/AliasTable.h>
+
+// roulette selection of a generation of parents, by rejection (what
+// RouletteOptimizer did before AliasTable) and with an alias table (built
+// once per generation). One organism has range(1) times the score of the
+// others, which makes rejection draw about that many times per parent
+
+static std::vector<double> benchRouletteScores(int size, double outlier) {
+	std::vector<double> scores(size, 1.0);
+	scores[size / 2] = outlier;
+	return scores;
+}
+
+static void BM_RouletteRejection(benchmark::State &state) {
+	auto scores = benchRouletteScores(state.range(0), state.range(1));
+	const int popSize = scores.size();
+	const double maxScore = *std::max_element(scores.begin(), scores.end());
+	std::mt19937 gen(101);
+	for (auto _ : state) {
+		for (int i = 0; i < popSize; i++) {
+			int parent;
+			do {
+				parent = Random::getIndex(popSize, gen);
+			} while (!Random::P(scores[parent] / maxScore, gen));
+			benchmark::DoNotOptimize(parent);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * popSize);
+}
+BENCHMARK(BM_RouletteRejection)->ArgsProduct({{1000, 10000}, {2, 100, 10000}});
+
+static void BM_RouletteAliasTable(benchmark::State &state) {
+	auto scores = benchRouletteScores(state.range(0), state.range(1));
+	const int popSize = scores.size();
+	AliasTable table;
+	std::mt19937 gen(101);
+	for (auto _ : state) {
+		table.build(scores);
+		for (int i = 0; i < popSize; i++) {
+			benchmark::DoNotOptimize(table.sample(gen));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * popSize);
+}
+BENCHMARK(BM_RouletteAliasTable)->ArgsProduct({{1000, 10000}, {2, 100, 10000}});
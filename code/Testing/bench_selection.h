@@ -0,0 +1,62 @@
+// selecting a generation of parents from the scores of a population (roulette
+// selection is in bench_roulette.h). Scores are uniform in [0, 100), drawn
+// with a fixed seed
+
+#include <random>
+#include <vector>
+
+static std::vector<double> benchSelectionScores(int size, int seed) {
+	std::vector<double> scores(size);
+	std::mt19937 gen(seed);
+	for (auto &score : scores) {
+		score = Random::getDouble(100.0, gen);
+	}
+	return scores;
+}
+
+#ifdef MABE_MODULE_Optimizer_Tournament
+#include <Optimizer/TournamentOptimizer/TournamentOptimizer.h>
+
+// range(0) = population size, range(1) = tournament size, range(2) = threads
+static void BM_TournamentSelectParents(benchmark::State &state) {
+	auto scores = benchSelectionScores(state.range(0), 101);
+	TournamentOptimizer optimizer(Parameters::root);
+	optimizer.tournamentSize = state.range(1);
+	optimizer.selectionThreads = state.range(2);
+	Random::seed(101);
+	for (auto _ : state) {
+		optimizer.selectParents(scores, (int)scores.size());
+		benchmark::DoNotOptimize(optimizer.parentIndices.data());
+	}
+	state.SetItemsProcessed(state.iterations() * scores.size());
+}
+BENCHMARK(BM_TournamentSelectParents)->ArgsProduct({{1000, 100000}, {2, 8}, {1, 4}})->UseRealTime();
+#endif
+
+#ifdef MABE_MODULE_Optimizer_Lexicase
+#include <Optimizer/LexicaseOptimizer/LexicaseOptimizer.h>
+
+// range(0) = population size, range(1) = formulas (each with its own scores),
+// range(2) = epsilon * 100 (0 is classic lexicase). Pools are the whole
+// population (the default)
+static void BM_LexicaseSelect(benchmark::State &state) {
+	const int popSize = state.range(0);
+	LexicaseOptimizer optimizer(Parameters::root);
+	std::vector<std::vector<double>> scores;
+	for (int f = 0; f < state.range(1); f++) {
+		scores.push_back(benchSelectionScores(popSize, 101 + f));
+	}
+	optimizer.epsilon = state.range(2) / 100.0;
+	optimizer.epsilonRelativeTo = false;
+	optimizer.poolSize = popSize;
+	Random::seed(101);
+	optimizer.setScores(scores, popSize);
+	for (auto _ : state) {
+		for (int i = 0; i < popSize; i++) {
+			benchmark::DoNotOptimize(optimizer.lexiSelect());
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * popSize);
+}
+BENCHMARK(BM_LexicaseSelect)->ArgsProduct({{100, 1000}, {2, 8}, {0, 10}});
+#endif
@@ -0,0 +1,101 @@
+#include <Utilities/SitesEncoding.h>
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// saving and loading the sites of one organism (range(0) unsigned char sites,
+// 5000 is the CircularGenome default size) as comma separated text (the way
+// CircularGenome::genomeToStr and deserialize do) and as base64 binary
+
+static std::vector<unsigned char> benchSites(int size) {
+	std::vector<unsigned char> sites(size);
+	std::mt19937 gen(101);
+	for (auto &site : sites) {
+		site = Random::getIndex(256, gen);
+	}
+	return sites;
+}
+
+static std::string benchSitesToText(const std::vector<unsigned char> &sites) {
+	std::stringstream ss;
+	for (size_t i = 0; i < sites.size() - 1; i++) {
+		ss << (int)sites[i] << ',';
+	}
+	ss << (int)sites[sites.size() - 1];
+	return ss.str();
+}
+
+static void BM_SitesSaveText(benchmark::State &state) {
+	auto sites = benchSites(state.range(0));
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(benchSitesToText(sites));
+	}
+	state.SetBytesProcessed(state.iterations() * sites.size());
+}
+BENCHMARK(BM_SitesSaveText)->Arg(5000);
+
+static void BM_SitesLoadText(benchmark::State &state) {
+	auto sites = benchSites(state.range(0));
+	std::string text = benchSitesToText(sites);
+	std::vector<unsigned char> loaded;
+	for (auto _ : state) {
+		std::stringstream ss(text);
+		loaded.clear();
+		char nextChar;
+		bool streamNotEmpty = static_cast<bool>(ss >> nextChar);
+		for (size_t i = 0; i < sites.size(); i++) {
+			std::string nextString;
+			while (streamNotEmpty && (nextChar != ',')) {
+				nextString += nextChar;
+				streamNotEmpty = static_cast<bool>(ss >> nextChar);
+			}
+			int value;
+			std::stringstream(nextString) >> value; // (as convertString does)
+			loaded.push_back((unsigned char)value);
+			streamNotEmpty = static_cast<bool>(ss >> nextChar);
+		}
+		benchmark::DoNotOptimize(loaded.data());
+	}
+	state.SetBytesProcessed(state.iterations() * sites.size());
+}
+BENCHMARK(BM_SitesLoadText)->Arg(5000);
+
+static void BM_SitesSaveBinary(benchmark::State &state) {
+	auto sites = benchSites(state.range(0));
+	for (auto _ : state) {
+		std::string bytes;
+		SitesEncoding::SiteWriter<unsigned char> writer(bytes);
+		for (auto site : sites) {
+			writer.add(site);
+		}
+		writer.finish();
+		benchmark::DoNotOptimize(SitesEncoding::toBase64(bytes));
+	}
+	state.SetBytesProcessed(state.iterations() * sites.size());
+}
+BENCHMARK(BM_SitesSaveBinary)->Arg(5000);
+
+static void BM_SitesLoadBinary(benchmark::State &state) {
+	auto sites = benchSites(state.range(0));
+	std::string bytes;
+	SitesEncoding::SiteWriter<unsigned char> writer(bytes);
+	for (auto site : sites) {
+		writer.add(site);
+	}
+	std::string text = SitesEncoding::toBase64(bytes);
+	std::vector<unsigned char> loaded;
+	for (auto _ : state) {
+		std::string decoded = SitesEncoding::fromBase64(text);
+		size_t position = 0;
+		SitesEncoding::SiteReader<unsigned char> reader(decoded, position);
+		loaded.clear();
+		for (size_t i = 0; i < sites.size(); i++) {
+			loaded.push_back(reader.next());
+		}
+		benchmark::DoNotOptimize(loaded.data());
+	}
+	state.SetBytesProcessed(state.iterations() * sites.size());
+}
+BENCHMARK(BM_SitesLoadBinary)->Arg(5000);
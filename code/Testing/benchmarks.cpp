@@ -0,0 +1,17 @@
+#include <benchmark/benchmark.h>
+
+#include "bench_random.h"
+#include "bench_mtree.h"
+#include "bench_roulette.h"
+#include "bench_sitesencoding.h"
+#include "bench_datamap.h"
+#include "bench_entropy.h"
+// (benchmarks of modules are only built with the module, see CMakeLists.txt)
+#include "bench_selection.h"
+#include "bench_circulargenome.h"
+#include "bench_brains.h"
+
+// normally defined by the generated Utilities/gitversion.h (see main.cpp)
+const char *gitversion = "benchmarks";
+
+BENCHMARK_MAIN();
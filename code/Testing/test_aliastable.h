@@ -0,0 +1,87 @@
+#include <Utilities/AliasTable.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// the roulette selection RouletteOptimizer used before AliasTable: draw an
+// index and keep it with probability weight / maxWeight
+static int rouletteByRejection(const std::vector<double> &weights, std::mt19937 &gen) {
+	double maxWeight = *std::max_element(weights.begin(), weights.end());
+	double minWeight = *std::min_element(weights.begin(), weights.end());
+	if (maxWeight <= 0 || maxWeight == minWeight) {
+		return Random::getIndex(weights.size(), gen);
+	}
+	int index;
+	do {
+		index = Random::getIndex(weights.size(), gen);
+	} while (!Random::P(weights[index] / maxWeight, gen));
+	return index;
+}
+
+// Pearson's chi-squared statistic of counts against probabilities (cells with
+// probability 0 must have no counts)
+static double chiSquared(const std::vector<int> &counts, const std::vector<double> &probabilities, int draws) {
+	double statistic = 0;
+	for (size_t i = 0; i < counts.size(); i++) {
+		if (probabilities[i] == 0) {
+			statistic += (counts[i] == 0) ? 0 : 1e9;
+			continue;
+		}
+		double expected = probabilities[i] * draws;
+		statistic += (counts[i] - expected) * (counts[i] - expected) / expected;
+	}
+	return statistic;
+}
+
+TEST(AliasTable, MatchesRejectionRoulette) {
+	// an outlier, a zero and a negative weight (which counts as zero)
+	std::vector<double> weights = { .5, 3, 1, 0, -2, 10, 1, 1 };
+	std::vector<double> probabilities;
+	double total = 0;
+	for (double w : weights) {
+		total += std::max(w, 0.0);
+	}
+	for (double w : weights) {
+		probabilities.push_back(std::max(w, 0.0) / total);
+	}
+
+	AliasTable table;
+	table.build(weights);
+	std::mt19937 gen(101);
+	const int draws = 200000;
+	std::vector<int> aliasCounts(weights.size(), 0);
+	std::vector<int> rejectionCounts(weights.size(), 0);
+	for (int i = 0; i < draws; i++) {
+		aliasCounts[table.sample(gen)]++;
+		rejectionCounts[rouletteByRejection(weights, gen)]++;
+	}
+	// 6 degrees of freedom, 22.46 is the .001 critical value
+	EXPECT_LT(chiSquared(aliasCounts, probabilities, draws), 22.46) << "alias table does not pick in proportion to weight";
+	EXPECT_LT(chiSquared(rejectionCounts, probabilities, draws), 22.46) << "rejection roulette does not pick in proportion to weight";
+	EXPECT_EQ(aliasCounts[3], 0) << "weight 0 should never be picked";
+	EXPECT_EQ(aliasCounts[4], 0) << "negative weight should never be picked";
+}
+
+TEST(AliasTable, UniformWhenNoWeightIsPositive) {
+	for (auto weights : { std::vector<double>{ 0, 0, 0, 0 }, std::vector<double>{ -1, -3, 0, -2 }, std::vector<double>{ 2, 2, 2, 2 } }) {
+		AliasTable table;
+		table.build(weights);
+		std::mt19937 gen(101);
+		const int draws = 100000;
+		std::vector<int> counts(weights.size(), 0);
+		for (int i = 0; i < draws; i++) {
+			counts[table.sample(gen)]++;
+		}
+		// 3 degrees of freedom, 16.27 is the .001 critical value
+		EXPECT_LT(chiSquared(counts, std::vector<double>(weights.size(), .25), draws), 16.27) << "picks should be uniform";
+	}
+}
+
+TEST(AliasTable, SingleWeight) {
+	AliasTable table;
+	table.build({ 5 });
+	std::mt19937 gen(101);
+	EXPECT_EQ(table.size(), 1);
+	EXPECT_EQ(table.sample(gen), 0);
+}
@@ -0,0 +1,28 @@
+#include <Utilities/BitOps.h>
+
+#include <random>
+
+TEST(BitOps, MatchesBitByBitCounts) {
+	std::mt19937_64 generator(3);
+	for (int i = 0; i < 10000; i++) {
+		uint64_t word = generator() >> (i % 64); // vary how many high bits are clear
+		if (i % 5 == 0) {
+			word &= generator(); // and how many bits are set
+		}
+		int count = 0;
+		int lowest = -1;
+		for (int bit = 63; bit >= 0; bit--) {
+			if ((word >> bit) & 1) {
+				count++;
+				lowest = bit;
+			}
+		}
+		ASSERT_EQ(BitOps::popCount(word), count);
+		if (word) {
+			ASSERT_EQ(BitOps::countTrailingZeros(word), lowest);
+		}
+	}
+	EXPECT_EQ(BitOps::popCount(0), 0);
+	EXPECT_EQ(BitOps::popCount(~uint64_t(0)), 64);
+	EXPECT_EQ(BitOps::countTrailingZeros(uint64_t(1) << 63), 63);
+}
@@ -0,0 +1,86 @@
+#include <Utilities/ChunkedVector.h>
+
+#include <random>
+#include <vector>
+
+// a ChunkedVector and a std::vector should always hold the same values
+static void expectSameValues(const ChunkedVector<int> &chunked, const std::vector<int> &plain) {
+	ASSERT_EQ(chunked.size(), plain.size());
+	size_t hint = 0;
+	for (size_t i = 0; i < plain.size(); i++) {
+		ASSERT_EQ(chunked.get(i, hint), plain[i]) << "at index " << i;
+		ASSERT_EQ(chunked.get(i), plain[i]) << "at index " << i;
+	}
+}
+
+TEST(ChunkedVector, MatchesVectorThroughEdits) {
+	std::mt19937 gen(101);
+	ChunkedVector<int> chunked;
+	std::vector<int> plain;
+	for (int i = 0; i < 5000; i++) {
+		chunked.push_back(i);
+		plain.push_back(i);
+	}
+	for (int step = 0; step < 2000; step++) {
+		int size = (int)plain.size();
+		int begin = std::uniform_int_distribution<int>(0, size - 1)(gen);
+		int end = std::min(size, begin + std::uniform_int_distribution<int>(0, 700)(gen));
+		switch (step % 4) {
+		case 0: { // copy a segment of itself somewhere else
+			int at = std::uniform_int_distribution<int>(0, size)(gen);
+			std::vector<int> segment(plain.begin() + begin, plain.begin() + end);
+			plain.insert(plain.begin() + at, segment.begin(), segment.end());
+			chunked.insert(at, chunked, begin, end);
+			break;
+		}
+		case 1:
+			if (size > 1000) {
+				plain.erase(plain.begin() + begin, plain.begin() + end);
+				chunked.erase(begin, end);
+			}
+			break;
+		default:
+			plain[begin] = -step;
+			chunked.set(begin, -step);
+		}
+		if (step % 100 == 0) {
+			expectSameValues(chunked, plain);
+		}
+	}
+	expectSameValues(chunked, plain);
+	// splits and merges keep blocks from fragmenting
+	EXPECT_LE(chunked.blockCount(), 2 * plain.size() / (ChunkedVector<int>::blockSize / 2) + 2);
+}
+
+TEST(ChunkedVector, CopiesShareUnchangedBlocks) {
+	ChunkedVector<int> parent;
+	for (int i = 0; i < 10 * (int)ChunkedVector<int>::blockSize; i++) {
+		parent.push_back(i);
+	}
+	ChunkedVector<int> offspring = parent;
+	EXPECT_EQ(offspring.sharedBlockCount(parent), parent.blockCount());
+
+	offspring.set(5, -1); // a point mutation copies one block
+	EXPECT_EQ(offspring.sharedBlockCount(parent), parent.blockCount() - 1);
+	EXPECT_EQ(parent.get(5), 5) << "writing to a copy changed the original";
+	EXPECT_EQ(offspring.get(5), -1);
+
+	offspring.erase(1000, 1010); // an indel only rebuilds the blocks at its ends
+	EXPECT_GE(offspring.sharedBlockCount(parent), parent.blockCount() - 3);
+	EXPECT_EQ(offspring.size(), parent.size() - 10);
+	EXPECT_EQ(offspring.get(1000), 1010);
+
+	ChunkedVector<int> segment = parent.slice(0, 3 * ChunkedVector<int>::blockSize);
+	EXPECT_EQ(segment.sharedBlockCount(parent), 3u);
+}
+
+TEST(ChunkedVector, BoolSites) {
+	ChunkedVector<bool> chunked;
+	chunked.resize(1000);
+	chunked.set(999, true);
+	EXPECT_FALSE(chunked.get(998));
+	EXPECT_TRUE(chunked.get(999));
+	int count = 0;
+	chunked.forEach([&](bool site) { count += site; });
+	EXPECT_EQ(count, 1);
+}
@@ -0,0 +1,199 @@
+#include <Global.h>
+#include <Utilities/CompiledMTree.h>
+#include <Utilities/MTree.h>
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace compiledMTreeTest {
+
+using Tree = std::shared_ptr<Abstract_MTree>;
+using Branches = std::vector<Tree>;
+
+Tree c(double value) { return std::make_shared<CONST_MTree>(value); }
+Tree ave(const std::string &key) { return std::make_shared<fromDataMapAve_MTree>(key); }
+Tree sum(const std::string &key) { return std::make_shared<fromDataMapSum_MTree>(key); }
+template <class T> Tree node(Branches branches = {}) { return std::make_shared<T>(branches); }
+
+// compare results bit for bit (so -0 and 0, and NaNs, are told apart)
+uint64_t bits(double value) {
+	uint64_t b;
+	std::memcpy(&b, &value, sizeof(b));
+	return b;
+}
+
+struct Holder {
+	DataMap dataMap;
+};
+
+// data maps to evaluate trees on. every map has x, a list l (so DM_AVE and
+// DM_SUM differ), hasY (y is only in the maps where hasY is 1) and safeN
+// (n, which is read by MOD, only fits in an int where safeN is 1)
+std::vector<std::shared_ptr<Holder>> makeHolders() {
+	const double xs[] = { 0, -0.0, 1, -1, 2.5, -3.75, 0.5, 1e-300, 123456.789,
+		std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN() };
+	const double ns[] = { 7, -7, 0, 0.9, 2147483647.0, (double)INT_MIN, 1e12, -1e300,
+		std::numeric_limits<double>::quiet_NaN() };
+	std::vector<std::shared_ptr<Holder>> holders;
+	int i = 0;
+	for (double x : xs) {
+		for (double n : ns) {
+			auto holder = std::make_shared<Holder>();
+			auto &dataMap = holder->dataMap;
+			dataMap.set("x", x);
+			dataMap.append("l", std::vector<double>({ x, 2.0, -0.5 * i }));
+			bool hasY = i % 3 != 0;
+			dataMap.set("hasY", hasY ? 1 : 0);
+			if (hasY) {
+				dataMap.set("y", (i % 5) - 2.0);
+			}
+			// (-1 with INT_MIN traps, and out of range casts are undefined)
+			bool safeN = (n == 7 || n == -7 || n == 0 || n == 0.9 || n == 2147483647.0);
+			dataMap.set("n", n);
+			dataMap.set("safeN", safeN ? 1 : 0);
+			holders.push_back(holder);
+			i++;
+		}
+	}
+	return holders;
+}
+
+// x, or 0 where x is infinite or NaN (so that it can be cast to an int)
+Tree finite(Tree x) {
+	auto notFinite = node<ABS_MTree>({ node<SUBTRACT_MTree>({ x, x }) }); // (NaN or 0)
+	return node<IF_MTree>({ node<SUBTRACT_MTree>({ c(0.5), notFinite }), x, c(0) });
+}
+
+// trees using every node type CompiledMTree compiles. y and n are only read
+// where the tree reads them if they are there (and fit)
+std::vector<Tree> makeTrees() {
+	Tree x = ave("x");
+	Tree fx = finite(x);
+	Tree y = node<IF_MTree>({ ave("hasY"), ave("y"), c(0) }); // (IF guards y)
+	Tree n = node<IF_MTree>({ ave("safeN"), ave("n"), c(3) });
+	Tree modN = node<MOD_MTree>({ ave("n"), c(-1) }); // (only if safeN)
+	return {
+		c(2.5),
+		x,
+		ave("l"),
+		sum("l"),
+		std::make_shared<UPDATE_MTree>(),
+		node<SUM_MTree>({ x, ave("l"), sum("l") }),
+		node<MULT_MTree>({ x, c(-2), sum("l") }),
+		node<SUBTRACT_MTree>({ x, sum("l") }),
+		node<DIVIDE_MTree>({ x, ave("l") }),
+		node<DIVIDE_MTree>({ c(1), x }),
+		node<DIVIDE_MTree>({ ave("y"), ave("hasY") }), // (y is only read if hasY)
+		node<DIVIDE_MTree>({ modN, ave("safeN") }),
+		node<POW_MTree>({ x, c(0.5) }),
+		node<POW_MTree>({ c(2), x }),
+		node<MOD_MTree>({ n, fx }),
+		node<MOD_MTree>({ node<SUM_MTree>({ n, c(0.5) }), c(3) }),
+		node<MIN_MTree>({ x, y, ave("l") }),
+		node<MAX_MTree>({ x, y, ave("l") }),
+		node<ABS_MTree>({ x }),
+		node<SIN_MTree>({ x }),
+		node<COS_MTree>({ sum("l") }),
+		y,
+		// (x * 0 is NaN for infinite x, and NaN > 0 is false)
+		node<IF_MTree>({ node<MULT_MTree>({ x, ave("safeN") }), modN, c(0) }),
+		node<IF_MTree>({ ave("safeN"), modN, node<MOD_MTree>({ fx, c(2) }) }),
+		node<IF_MTree>({ node<SUBTRACT_MTree>({ c(1), ave("safeN") }), c(1), modN }),
+		// nested: the inner IF only runs where the outer one takes it
+		node<IF_MTree>({ ave("hasY"),
+			node<IF_MTree>({ ave("y"), node<DIVIDE_MTree>({ x, ave("y") }), node<MOD_MTree>({ ave("y"), c(2) }) }),
+			node<IF_MTree>({ ave("safeN"), modN, x }) }),
+		node<SUM_MTree>({ y, node<IF_MTree>({ ave("safeN"), modN, y }), n }),
+		node<REMAP_MTree>({ x }),
+		node<REMAP_MTree>({ x, c(-1), c(3) }),
+		node<REMAP_MTree>({ x, c(2), c(2) }),
+		node<REMAP_MTree>({ x, y, c(3), c(10), c(20) }),
+		node<SIGMOID_MTree>({ x, c(2) }),
+		node<SIGMOID_MTree>({ x, sum("l"), c(-4), c(4) }),
+		// VECT with no values to pick from, where it is not evaluated
+		node<IF_MTree>({ c(0), node<VECT_MTree>({ c(0), c(0) }), x }),
+	};
+}
+
+void expectSame(CompiledMTree &compiled, const Tree &tree,
+		const std::vector<std::shared_ptr<Holder>> &holders,
+		const std::vector<std::vector<double>> &vectorData = {}) {
+	for (size_t i = 0; i < holders.size(); i++) {
+		double expected = tree->eval(holders[i]->dataMap, Parameters::root, vectorData)[0];
+		double actual = compiled.eval(holders[i]->dataMap, Parameters::root, vectorData);
+		EXPECT_EQ(bits(actual), bits(expected)) << tree->getFormula() << " on data map " << i
+			<< ": " << actual << " != " << expected;
+	}
+}
+
+} // namespace compiledMTreeTest
+
+TEST(CompiledMTree, MatchesTreeForEveryNodeType) {
+	using namespace compiledMTreeTest;
+	int update = Global::update;
+	Global::update = 17;
+	auto holders = makeHolders();
+	for (auto &tree : makeTrees()) {
+		CompiledMTree compiled(tree);
+		ASSERT_TRUE(compiled.isCompiled()) << tree->getFormula();
+		expectSame(compiled, tree, holders);
+
+		std::vector<double> scores;
+		compiled.evalPopulation(holders, Parameters::root, scores);
+		ASSERT_EQ(scores.size(), holders.size());
+		for (size_t i = 0; i < holders.size(); i++) {
+			double expected = tree->eval(holders[i]->dataMap, Parameters::root)[0];
+			EXPECT_EQ(bits(scores[i]), bits(expected)) << tree->getFormula()
+				<< " (evalPopulation) on data map " << i << ": " << scores[i] << " != " << expected;
+		}
+	}
+	Global::update = update;
+}
+
+TEST(CompiledMTree, MatchesTreeForVect) {
+	using namespace compiledMTreeTest;
+	auto holders = makeHolders();
+	std::vector<std::vector<double>> vectorData = { { 1.5, -2, 3 }, { 4 }, {} };
+	Tree whichVect = node<MOD_MTree>({ finite(ave("x")), c(1000) });
+	std::vector<Tree> trees = {
+		node<VECT_MTree>({ c(0), c(2) }),
+		node<VECT_MTree>({ c(-1), c(1) }),
+		node<VECT_MTree>({ c(1), whichVect }),
+		node<VECT_MTree>({ whichVect, c(0) }), // (picks the empty vector for some x)
+		// the empty vector, where it is not evaluated
+		node<IF_MTree>({ c(1), node<VECT_MTree>({ c(0), whichVect }), node<VECT_MTree>({ c(2), c(0) }) }),
+	};
+	for (auto &tree : trees) {
+		CompiledMTree compiled(tree);
+		ASSERT_TRUE(compiled.isCompiled()) << tree->getFormula();
+		for (size_t i = 0; i < holders.size(); i++) {
+			auto &dataMap = holders[i]->dataMap;
+			if (tree == trees[3] &&
+					std::max(0, (int)whichVect->eval(dataMap, Parameters::root)[0] % 3) == 2) {
+				continue; // (the tree would fail, and so then does eval)
+			}
+			double expected = tree->eval(dataMap, Parameters::root, vectorData)[0];
+			double actual = compiled.eval(dataMap, Parameters::root, vectorData);
+			EXPECT_EQ(bits(actual), bits(expected)) << tree->getFormula() << " on data map " << i;
+		}
+	}
+}
+
+TEST(CompiledMTree, MissingKeyWhereEvaluatedIsLeftToTheTree) {
+	using namespace compiledMTreeTest;
+	Holder holder;
+	holder.dataMap.set("x", 1.0);
+	// the IF takes the branch with the missing key, which the tree can not read
+	Tree tree = node<IF_MTree>({ ave("x"), ave("notInThisMap"), c(0) });
+	CompiledMTree compiled(tree);
+	ASSERT_TRUE(compiled.isCompiled());
+	// (DataMap says why on std::cout, so only the exit code is checked)
+	EXPECT_EXIT(compiled.eval(holder.dataMap, Parameters::root), ::testing::ExitedWithCode(1), "");
+	holder.dataMap.set("x", -1.0);
+	EXPECT_EQ(compiled.eval(holder.dataMap, Parameters::root), 0);
+}
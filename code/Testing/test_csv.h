@@ -0,0 +1,34 @@
+#include <Utilities/CSV.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// write contents to fileName, read it as a csv file, and remove the file
+static CSV readTestCSV(const std::string &fileName, const std::string &contents) {
+	{
+		std::ofstream file(fileName, std::ios::out | std::ios::binary);
+		file << contents;
+	}
+	CSV csv(fileName);
+	std::remove(fileName.c_str());
+	return csv;
+}
+
+TEST(CSV, ReadsLinesEndingInCRLF) {
+	// a file saved on Windows: the \r before each \n is not part of the last
+	// field (the last line has no line end at all)
+	CSV crlf = readTestCSV("test_csv_crlf.csv", "ID,name,score\r\n1,a,0.5\r\n2,b,7\r\n3,c,-1");
+	CSV lf = readTestCSV("test_csv_lf.csv", "ID,name,score\n1,a,0.5\n2,b,7\n3,c,-1\n");
+	EXPECT_EQ(crlf.column_names(), std::vector<std::string>({ "ID", "name", "score" }));
+	ASSERT_EQ(crlf.row_count(), 3u);
+	EXPECT_EQ(crlf.row(0), std::vector<std::string>({ "1", "a", "0.5" }));
+	EXPECT_EQ(crlf.row(2), std::vector<std::string>({ "3", "c", "-1" }));
+	EXPECT_EQ(crlf.lookUp("ID", "2", "score"), "7");
+	EXPECT_EQ(crlf.lookUp("score", "7", "name"), "b");
+	EXPECT_EQ(crlf.column_names(), lf.column_names());
+	for (size_t r = 0; r < lf.row_count(); r++) {
+		EXPECT_EQ(crlf.row(r), lf.row(r)) << "row " << r;
+	}
+}
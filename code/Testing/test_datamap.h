@@ -0,0 +1,53 @@
+#include <Utilities/Data.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(DataMap, WritesFromManyThreads) {
+	// evaluateSolo writes each organism's own data map from a worker thread.
+	// data maps share only the key registry, which new keys are added to, so
+	// writing different maps (with keys no map has seen before) must be safe
+	const int mapCount = 64;
+	std::vector<DataMap> maps(mapCount);
+	std::vector<std::thread> threads;
+	for (int thread = 0; thread < 8; thread++) {
+		threads.emplace_back([&, thread]() {
+			for (int m = thread; m < mapCount; m += 8) {
+				for (int k = 0; k < 50; k++) {
+					maps[m].append("threadedKey" + std::to_string(k), m * 100 + k);
+					maps[m].set("threadedSolo" + std::to_string((m + k) % 50), k);
+				}
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	for (int m = 0; m < mapCount; m++) {
+		for (int k = 0; k < 50; k++) {
+			ASSERT_EQ(maps[m].getIntVector("threadedKey" + std::to_string(k)), std::vector<int>({m * 100 + k}));
+		}
+		EXPECT_EQ(maps[m].getIntVector("threadedSolo" + std::to_string(m % 50)), std::vector<int>({0}));
+	}
+}
+
+TEST(DataMap, VectorAppendToSingleValue) {
+	// as a single value is a different type from a list, only a bool vector
+	// may be appended to a single value
+	DataMap map;
+	map.set("single", true);
+	map.append("single", std::vector<bool>({ false }));
+	EXPECT_EQ(map.getBoolVector("single"), std::vector<bool>({ true, false }));
+	map.set("singleInt", 1);
+	EXPECT_EXIT(map.append("singleInt", std::vector<int>({ 2 })), ::testing::ExitedWithCode(1), "");
+	map.set("singleDouble", 1.0);
+	EXPECT_EXIT(map.append("singleDouble", std::vector<double>({ 2.0 })), ::testing::ExitedWithCode(1), "");
+	map.set("singleString", std::string("a"));
+	EXPECT_EXIT(map.append("singleString", std::vector<std::string>({ "b" })), ::testing::ExitedWithCode(1), "");
+	// single values (and vectors) may still be appended to lists
+	map.append("list", 1);
+	map.append("list", std::vector<int>({ 2, 3 }));
+	map.append("list", 4);
+	EXPECT_EQ(map.getIntVector("list"), std::vector<int>({ 1, 2, 3, 4 }));
+}
@@ -0,0 +1,120 @@
+#include <Brain/MarkovBrain/GateListBuilder/GateListBuilder.h>
+#include <Genome/CircularGenome/CircularGenome.h>
+
+#include "test_parameter.h"
+
+#include <string>
+#include <vector>
+
+// what a gate list builder gave, in a form that can be compared
+struct BuiltGates {
+	std::vector<int> headValues;
+	std::vector<std::vector<int>> perGateValues;
+	std::vector<std::string> descriptions;
+	std::vector<std::vector<double>> updates; // next states of each gate for each test state
+};
+
+static const int testGateNodes = 8;
+static const int testGateStates = 16;
+
+static BuiltGates buildTestGates(ClassicGateListBuilder &builder, std::shared_ptr<AbstractGenome> genome, bool useCodonIndex,
+	std::shared_ptr<const GateListDecoding> parentDecoding = nullptr, std::shared_ptr<const GateListDecoding> *decoding = nullptr) {
+	TestParameter<bool> codonIndex("BRAIN_MARKOV_ADVANCED-useCodonIndex", useCodonIndex);
+	BuiltGates built;
+	auto gates = builder.buildGateListAndGetAllValues(genome, testGateNodes, 15, built.headValues, 3, built.perGateValues, 2, Parameters::root,
+		parentDecoding, decoding);
+
+	// map gate inputs and outputs to nodes (as a brain does), and update each
+	// gate from the same states
+	std::vector<int> nodeMap(1 << Gate_Builder::bitsPerBrainAddressPL->get());
+	for (size_t i = 0; i < nodeMap.size(); i++) {
+		nodeMap[i] = (int)i;
+	}
+	for (auto &gate : gates) {
+		gate->applyNodeMap(nodeMap, testGateNodes);
+		built.descriptions.push_back(gate->description());
+		for (int state = 0; state < testGateStates; state++) {
+			std::vector<double> states(testGateNodes), nextStates(testGateNodes, 0.0);
+			for (int node = 0; node < testGateNodes; node++) {
+				states[node] = (state >> (node % 4)) & 1;
+			}
+			gate->resetGate();
+			Random::seed(state); // (probabilistic gates)
+			gate->update(states, nextStates);
+			built.updates.push_back(nextStates);
+		}
+	}
+	return built;
+}
+
+// gates found from the start codon index (and copied from the parent's
+// decoding) must be the ones found by reading every site, over lineages of
+// mutated genomes with insertions and deletions. alphabetSize sets whether
+// a codon fits in one site (256) or not (16 and 2, which read every site
+// with mustReadAll when the index is not used)
+static void checkGateListsOverLineage(const std::string &sitesType, double alphabetSize) {
+	TestParameter<std::string> type("GENOME-sitesType", sitesType);
+	TestParameter<double> alphabet("GENOME-alphabetSize", alphabetSize);
+	TestParameter<int> size("GENOME_CIRCULAR-sizeInitial", 3000);
+	TestParameter<int> sizeMin("GENOME_CIRCULAR-sizeMin", 1500);
+	TestParameter<int> sizeMax("GENOME_CIRCULAR-sizeMax", 6000);
+	TestParameter<double> copyRate("GENOME_CIRCULAR-mutationCopyRate", 0.0002);
+	TestParameter<double> deleteRate("GENOME_CIRCULAR-mutationDeleteRate", 0.0002);
+	TestParameter<bool> probabilistic("BRAIN_MARKOV_GATES_PROBABILISTIC-allow", true);
+	ClassicGateListBuilder builder(Parameters::root);
+	int codonMax = (1 << Gate_Builder::bitsPerCodonPL->get()) - 1;
+	ASSERT_EQ(codonMax > alphabetSize, alphabetSize < 256);
+
+	Random::seed(101);
+	auto genome = CircularGenome_genomeFactory(Parameters::root);
+	genome->fillRandom();
+	// write start codons at random sites (as MarkovBrain::initializeGenomes does)
+	auto handler = genome->newHandler(genome);
+	for (auto gateType : builder.gateBuilder.inUseGateTypes) {
+		for (int i = 0; i < 20; i++) {
+			handler->randomize();
+			for (auto value : builder.gateBuilder.gateStartCodes[gateType]) {
+				handler->writeInt(value, 0, codonMax);
+			}
+		}
+	}
+
+	std::shared_ptr<const GateListDecoding> parentDecoding;
+	buildTestGates(builder, genome, true, nullptr, &parentDecoding);
+	size_t gateCount = 0;
+	for (int generation = 0; generation < 40; generation++) {
+		Random::seed(1000 + generation);
+		auto child = genome->makeMutatedGenomeFrom(genome);
+		auto scanned = buildTestGates(builder, child, false);
+		auto indexed = buildTestGates(builder, child, true);
+		std::shared_ptr<const GateListDecoding> decoding;
+		auto copied = buildTestGates(builder, child, true, parentDecoding, &decoding);
+		ASSERT_NE(decoding, nullptr); // (the genome kept an index)
+
+		EXPECT_EQ(indexed.headValues, scanned.headValues) << "generation " << generation;
+		EXPECT_EQ(indexed.perGateValues, scanned.perGateValues) << "generation " << generation;
+		EXPECT_EQ(indexed.descriptions, scanned.descriptions) << "generation " << generation;
+		EXPECT_EQ(indexed.updates, scanned.updates) << "generation " << generation;
+		EXPECT_EQ(copied.headValues, scanned.headValues) << "generation " << generation;
+		EXPECT_EQ(copied.perGateValues, scanned.perGateValues) << "generation " << generation;
+		EXPECT_EQ(copied.descriptions, scanned.descriptions) << "generation " << generation;
+		EXPECT_EQ(copied.updates, scanned.updates) << "generation " << generation;
+		gateCount += scanned.descriptions.size();
+
+		genome = child;
+		parentDecoding = decoding;
+	}
+	EXPECT_GT(gateCount, 40u); // (the lineage kept some gates)
+}
+
+TEST(GateListBuilder, CodonIndexMatchesScanCharSites) {
+	checkGateListsOverLineage("char", 256);
+}
+
+TEST(GateListBuilder, CodonIndexMatchesScanMustReadAll) {
+	checkGateListsOverLineage("char", 16);
+}
+
+TEST(GateListBuilder, CodonIndexMatchesScanBoolSites) {
+	checkGateListsOverLineage("bool", 2);
+}
@@ -0,0 +1,144 @@
+#include <Optimizer/LexicaseOptimizer/LexicaseOptimizer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// the old lexiSelect, which LexicaseOptimizer used before selection used
+// bitsets (pools were drawn with a full shuffle and kept as vectors of
+// population indices)
+static int oldLexiSelect(LexicaseOptimizer &optimizer) {
+	std::vector<int> orgIndexList(optimizer.scores[0].size());
+	std::iota(std::begin(orgIndexList), std::end(orgIndexList), 0);
+	std::shuffle(std::begin(orgIndexList), std::end(orgIndexList), Random::getCommonGenerator());
+	orgIndexList.resize(std::min(optimizer.poolSize, (int)orgIndexList.size()));
+
+	if (!optimizer.scoresHaveDelta) { // if all scores are the same! pick random
+		return Random::getIndex(orgIndexList.size());
+	}
+
+	std::vector<int> formulasOrder(optimizer.scores.size());
+	std::iota(formulasOrder.begin(), formulasOrder.end(), 0);
+	std::shuffle(formulasOrder.begin(), formulasOrder.end(), Random::getCommonGenerator());
+
+	std::vector<int> keepers = orgIndexList;
+	while (keepers.size() > 1 && formulasOrder.size() > 0) {
+		int formulaIndex = formulasOrder.back();
+		formulasOrder.pop_back();
+		auto &scores = optimizer.scores[formulaIndex];
+
+		double scoreCutoff;
+		std::vector<double> keeperScores;
+		for (size_t i = 0; i < keepers.size(); i++) {
+			keeperScores.push_back(scores[keepers[i]]);
+		}
+		if (optimizer.epsilonRelativeTo) {
+			auto scoreRange = std::minmax_element(std::begin(keeperScores), std::end(keeperScores));
+			scoreCutoff = (*scoreRange.second - ((*scoreRange.second - *scoreRange.first) * optimizer.epsilon));
+		}
+		else {
+			size_t cull_index = std::ceil(std::max((((1.0 - optimizer.epsilon) * keeperScores.size()) - 1.0), 0.0));
+			std::nth_element(std::begin(keeperScores), std::begin(keeperScores) + cull_index, std::end(keeperScores));
+			scoreCutoff = keeperScores[cull_index];
+		}
+		keepers.erase(std::remove_if(std::begin(keepers), std::end(keepers), [&](int k) {
+			return scores[k] < scoreCutoff;
+		}), std::end(keepers));
+	}
+	return keepers[Random::getIndex(keepers.size())];
+}
+
+// how often each organism is selected by lexiSelect, and by the old
+// lexiSelect, from scores (formulas x organisms) made by makeScore. the two
+// sets of counts must pass a two sample chi-squared test (that they come from
+// the same distribution) at p = 0.001
+template <class MakeScore>
+static void checkLexicaseFrequencies(int popSize, int formulas, int poolSize, double epsilon, bool epsilonRelativeTo, MakeScore makeScore) {
+	LexicaseOptimizer optimizer(Parameters::root);
+	std::mt19937 gen(101);
+	std::vector<std::vector<double>> scores(formulas, std::vector<double>(popSize));
+	for (auto &formulaScores : scores) {
+		for (auto &score : formulaScores) {
+			score = makeScore(gen);
+		}
+	}
+	optimizer.epsilon = epsilon;
+	optimizer.epsilonRelativeTo = epsilonRelativeTo;
+	optimizer.poolSize = poolSize;
+	optimizer.setScores(scores, popSize);
+
+	const int selections = 100000;
+	std::vector<int> newCounts(popSize, 0), oldCounts(popSize, 0);
+	Random::seed(101);
+	for (int i = 0; i < selections; i++) {
+		int selected = optimizer.lexiSelect();
+		ASSERT_GE(selected, 0);
+		ASSERT_LT(selected, popSize);
+		newCounts[selected]++;
+	}
+	Random::seed(202);
+	for (int i = 0; i < selections; i++) {
+		oldCounts[oldLexiSelect(optimizer)]++;
+	}
+
+	// (with the same number of selections in each, the statistic is the sum
+	// of (a - b)^2 / (a + b) over organisms either selected)
+	double chiSquared = 0;
+	int selectedOrganisms = 0;
+	for (int org = 0; org < popSize; org++) {
+		double a = newCounts[org], b = oldCounts[org];
+		if (a + b > 0) {
+			chiSquared += (a - b) * (a - b) / (a + b);
+			selectedOrganisms++;
+		}
+	}
+	if (selectedOrganisms < 2) {
+		EXPECT_EQ(newCounts, oldCounts);
+		return;
+	}
+	// critical value for p = 0.001 (Wilson-Hilferty, within 1% for these
+	// degrees of freedom)
+	double df = selectedOrganisms - 1;
+	double z = 3.0902;
+	double critical = df * std::pow(1 - 2 / (9 * df) + z * std::sqrt(2 / (9 * df)), 3);
+	EXPECT_LT(chiSquared, critical) << "selection counts differ (" << selectedOrganisms << " organisms selected)";
+}
+
+// (70 organisms, so bitsets have a partly used word)
+TEST(LexicaseSelect, MatchesOldSelectionWithTies) {
+	auto fewScores = [](std::mt19937 &gen) { return (double)std::uniform_int_distribution<int>(0, 3)(gen); };
+	checkLexicaseFrequencies(70, 4, 70, 0.0, false, fewScores);
+	checkLexicaseFrequencies(70, 4, 9, 0.0, false, fewScores);
+	checkLexicaseFrequencies(70, 4, 70, 0.2, false, fewScores);
+	checkLexicaseFrequencies(70, 4, 70, 0.2, true, fewScores);
+	checkLexicaseFrequencies(70, 4, 9, 0.2, true, fewScores);
+}
+
+TEST(LexicaseSelect, MatchesOldSelectionWithDistinctScores) {
+	auto manyScores = [](std::mt19937 &gen) { return std::uniform_real_distribution<double>(0.0, 1.0)(gen); };
+	checkLexicaseFrequencies(70, 3, 70, 0.0, false, manyScores);
+	checkLexicaseFrequencies(70, 3, 20, 0.1, false, manyScores);
+	checkLexicaseFrequencies(70, 3, 70, 0.1, true, manyScores);
+}
+
+// some formulas have all scores the same (and so keep every organism)
+TEST(LexicaseSelect, MatchesOldSelectionWithEqualFormulas) {
+	int formula = 0;
+	auto someEqual = [&formula](std::mt19937 &gen) {
+		formula++;
+		return ((formula - 1) / 70) % 2 ? 1.0 : (double)std::uniform_int_distribution<int>(0, 5)(gen);
+	};
+	checkLexicaseFrequencies(70, 4, 70, 0.0, false, someEqual);
+	formula = 0;
+	checkLexicaseFrequencies(70, 4, 12, 0.1, true, someEqual);
+}
+
+// all scores are the same, so scoresHaveDelta is false and organisms are
+// picked at random
+TEST(LexicaseSelect, MatchesOldSelectionWithAllScoresEqual) {
+	auto sameScore = [](std::mt19937 &) { return 0.5; };
+	checkLexicaseFrequencies(70, 3, 70, 0.0, false, sameScore);
+	checkLexicaseFrequencies(70, 3, 9, 0.1, true, sameScore);
+}
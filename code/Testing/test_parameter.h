@@ -0,0 +1,22 @@
+#pragma once
+
+#include <Utilities/Parameters.h>
+
+#include <string>
+
+// sets a parameter in Parameters::root, and puts it back when done
+template <class T>
+class TestParameter {
+public:
+	TestParameter(const std::string &name_, const T &value) : name(name_) {
+		Parameters::root->lookup(name, previous);
+		Parameters::root->setParameter(name, value);
+	}
+	~TestParameter() { Parameters::root->setParameter(name, previous); }
+	TestParameter(const TestParameter &) = delete;
+	TestParameter &operator=(const TestParameter &) = delete;
+
+private:
+	std::string name;
+	T previous;
+};
@@ -0,0 +1,84 @@
+#include <Utilities/Parameters.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(ParameterLink, GetFromManyThreads) {
+	// worlds and optimizers call PL->get(PT) from worker threads, and the first
+	// get for a table fills the link's cache (and adds a following entry to the
+	// table), so many threads must be able to do this at the same time
+	auto valuePL = Parameters::register_parameter("TEST-threadedValue", 7, "used by ParameterLink.GetFromManyThreads");
+	const int tableCount = 64;
+	std::vector<std::shared_ptr<ParametersTable>> tables;
+	for (int t = 0; t < tableCount; t++) {
+		auto table = Parameters::root->getTable("threadedTest" + std::to_string(t) + "::");
+		if (t % 2 == 0) {
+			table->setParameter("TEST-threadedValue", 100 + t);
+		}
+		tables.push_back(table);
+	}
+	std::atomic<int> wrong(0);
+	std::vector<std::thread> threads;
+	for (int thread = 0; thread < 8; thread++) {
+		threads.emplace_back([&, thread]() {
+			for (int i = 0; i < tableCount * 20; i++) {
+				int t = (i * 7 + thread * 13) % tableCount;
+				int expected = (t % 2 == 0) ? 100 + t : 7;
+				if (valuePL->get(tables[t]) != expected) {
+					wrong++;
+				}
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	EXPECT_EQ(wrong.load(), 0);
+}
+
+TEST(ParameterLink, GetWhileCacheIsReplaced) {
+	// get reads the link's cache with no lock, so it must stay correct while
+	// other threads add tables to the cache or clear it
+	auto valuePL = Parameters::register_parameter("TEST-republishedValue", 3, "used by ParameterLink.GetWhileCacheIsReplaced");
+	const int tableCount = 16;
+	std::vector<std::shared_ptr<ParametersTable>> tables;
+	for (int t = 0; t < tableCount; t++) {
+		auto table = Parameters::root->getTable("republishedTest" + std::to_string(t) + "::");
+		table->setParameter("TEST-republishedValue", 200 + t);
+		tables.push_back(table);
+	}
+	std::atomic<int> wrong(0);
+	std::atomic<int> reads(0);
+	std::atomic<bool> done(false);
+	std::vector<std::thread> threads;
+	for (int thread = 0; thread < 4; thread++) {
+		threads.emplace_back([&, thread]() {
+			for (int i = 0; !done; i++) {
+				int t = (i + thread * 5) % tableCount;
+				if (valuePL->get(tables[t]) != 200 + t) {
+					wrong++;
+				}
+				reads++;
+			}
+		});
+	}
+	while (reads < 1000) {
+		std::this_thread::yield();
+	}
+	for (int i = 0; i < 2000; i++) {
+		if (i % 100 == 0) {
+			valuePL->clearCache();
+		}
+		else {
+			valuePL->clearCache(tables[i % tableCount]);
+		}
+	}
+	done = true;
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	EXPECT_EQ(wrong.load(), 0);
+	EXPECT_EQ(valuePL->get(tables[5]), 205);
+}
@@ -0,0 +1,272 @@
+#include <Global.h>
+#include <Organism/Organism.h>
+#include <Organism/Phylogeny.h>
+
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// organisms for phylogeny tests have no genomes or brains
+static std::shared_ptr<Organism> makeTestOrganism() {
+	return std::make_shared<Organism>(Parameters::root);
+}
+
+static std::shared_ptr<Organism> makeTestOffspring(std::vector<std::shared_ptr<Organism>> parents) {
+	std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> genomes;
+	std::unordered_map<std::string, std::shared_ptr<AbstractBrain>> brains;
+	if (parents.size() == 1) {
+		return std::make_shared<Organism>(parents[0], genomes, brains, Parameters::root);
+	}
+	return std::make_shared<Organism>(parents, genomes, brains, Parameters::root);
+}
+
+static std::vector<int> lineageIDs(const std::vector<Phylogeny::Node> &lineage) {
+	std::vector<int> ids;
+	for (auto node : lineage) {
+		ids.push_back(Phylogeny::get().getID(node));
+	}
+	return ids;
+}
+
+// sets Global::update, and puts it back when done
+class TestUpdate {
+public:
+	TestUpdate(int update) : previous(Global::update) { Global::update = update; }
+	~TestUpdate() { Global::update = previous; }
+
+private:
+	int previous;
+};
+
+TEST(Phylogeny, LineageAndMostRecentCommonAncestor) {
+	auto &phylogeny = Phylogeny::get();
+	auto root = makeTestOrganism();
+	auto a = makeTestOffspring({root});
+	auto b = makeTestOffspring({a});
+	auto c = makeTestOffspring({a});
+	auto d = makeTestOffspring({b});
+	int rootID = root->ID;
+	root.reset(); // (kept as a record, a is still linked to it)
+
+	bool hasMultipleParents;
+	auto lineage = phylogeny.getLineage(d->phylogenyNode, hasMultipleParents);
+	EXPECT_FALSE(hasMultipleParents);
+	EXPECT_EQ(lineageIDs(lineage), std::vector<int>({rootID, a->ID, b->ID, d->ID}));
+	EXPECT_EQ(d->getLOD(d), lineage);
+	// a is the oldest with more then one offspring
+	EXPECT_EQ(phylogeny.getMostRecentCommonAncestor(lineage), a->phylogenyNode);
+	EXPECT_EQ(d->getMostRecentCommonAncestor(d), a->phylogenyNode);
+
+	// once c is gone, no one on the lineage has more then one offspring
+	c.reset();
+	EXPECT_EQ(phylogeny.getOffspringCount(a->phylogenyNode), 1);
+	EXPECT_EQ(phylogeny.getMostRecentCommonAncestor(lineage), d->phylogenyNode);
+}
+
+TEST(Phylogeny, LineageStopsAtMultipleParents) {
+	auto &phylogeny = Phylogeny::get();
+	auto p1 = makeTestOrganism();
+	auto p2 = makeTestOrganism();
+	auto x = makeTestOffspring({p1, p2});
+	auto y = makeTestOffspring({x});
+	auto z = makeTestOffspring({y});
+	auto w = makeTestOffspring({y});
+
+	EXPECT_EQ(phylogeny.getParents(x->phylogenyNode), std::vector<Phylogeny::Node>({p1->phylogenyNode, p2->phylogenyNode}));
+	EXPECT_EQ(p1->getOffspringCount(), 1);
+	EXPECT_EQ(p2->getOffspringCount(), 1);
+
+	bool hasMultipleParents;
+	auto lineage = phylogeny.getLineage(z->phylogenyNode, hasMultipleParents);
+	EXPECT_TRUE(hasMultipleParents);
+	EXPECT_EQ(lineageIDs(lineage), std::vector<int>({x->ID, y->ID, z->ID}));
+	EXPECT_EQ(phylogeny.getMostRecentCommonAncestor(lineage), y->phylogenyNode);
+
+	// a dead parent's data is kept while it has linked children
+	auto p1Node = p1->phylogenyNode;
+	p1->dataMap.set("score", 3.5);
+	p1.reset();
+	EXPECT_EQ(phylogeny.getDataMap(p1Node).getAverage("score"), 3.5);
+	EXPECT_EQ(phylogeny.getParents(x->phylogenyNode).size(), 2u);
+}
+
+TEST(Phylogeny, FreedNodesAreReused) {
+	auto &phylogeny = Phylogeny::get();
+	size_t startSize = phylogeny.size();
+
+	auto org = makeTestOrganism();
+	auto node = org->phylogenyNode;
+	auto weakNode = phylogeny.getWeakNode(node);
+	org.reset();
+	EXPECT_TRUE(phylogeny.expired(weakNode));
+	EXPECT_EQ(phylogeny.size(), startSize);
+	org = makeTestOrganism();
+	EXPECT_EQ(org->phylogenyNode, node);
+	EXPECT_FALSE(phylogeny.expired(phylogeny.getWeakNode(node)));
+
+	// a long line of descent (only its youngest organism is alive) is freed
+	// all at once, without recursion
+	std::set<Phylogeny::Node> chainNodes;
+	auto youngest = makeTestOrganism();
+	chainNodes.insert(youngest->phylogenyNode);
+	for (int i = 0; i < 100000; i++) {
+		youngest = makeTestOffspring({youngest});
+		chainNodes.insert(youngest->phylogenyNode);
+	}
+	EXPECT_EQ(phylogeny.size(), startSize + 1 + chainNodes.size());
+	youngest.reset();
+	EXPECT_EQ(phylogeny.size(), startSize + 1);
+	std::vector<std::shared_ptr<Organism>> reusing;
+	for (int i = 0; i < 10; i++) {
+		reusing.push_back(makeTestOrganism());
+		EXPECT_EQ(chainNodes.count(reusing.back()->phylogenyNode), 1u);
+	}
+
+	// clearing parents frees the ones no one else needs, but the parent still
+	// counts the offspring
+	auto parent = makeTestOrganism();
+	auto parentWeak = phylogeny.getWeakNode(parent->phylogenyNode);
+	auto child = makeTestOffspring({parent});
+	auto grandchild = makeTestOffspring({child});
+	parent.reset();
+	EXPECT_FALSE(phylogeny.expired(parentWeak));
+	grandchild->clearParents();
+	EXPECT_TRUE(phylogeny.getParents(grandchild->phylogenyNode).empty());
+	EXPECT_EQ(child->getOffspringCount(), 1);
+	child->clearParents();
+	EXPECT_TRUE(phylogeny.expired(parentWeak));
+}
+
+TEST(Phylogeny, MergesStagingsInIslandOrder) {
+	auto &phylogeny = Phylogeny::get();
+	auto parent = makeTestOrganism();
+	auto doomed = makeTestOrganism();
+	auto doomedWeak = phylogeny.getWeakNode(doomed->phylogenyNode);
+
+	// free four nodes, so that the next four allocated are known
+	std::vector<std::shared_ptr<Organism>> placeholders;
+	for (int i = 0; i < 4; i++) {
+		placeholders.push_back(makeTestOrganism());
+	}
+	std::vector<Phylogeny::Node> nextNodes;
+	for (auto &placeholder : placeholders) {
+		nextNodes.push_back(placeholder->phylogenyNode);
+	}
+	while (!placeholders.empty()) {
+		placeholders.pop_back(); // (the first node is freed last)
+	}
+	size_t startSize = phylogeny.size();
+
+	std::vector<Phylogeny::Staging> stagings(2);
+	std::vector<std::vector<std::shared_ptr<Organism>>> made(2);
+	for (size_t island = 0; island < stagings.size(); island++) {
+		int provisionalID = -2;
+		Organism::provisionalIDCounter() = &provisionalID;
+		Phylogeny::threadStaging() = &stagings[island];
+
+		auto child = makeTestOffspring({parent});
+		auto grandchild = makeTestOffspring({child});
+		auto released = makeTestOffspring({parent});
+		released.reset(); // (made and deleted on the staging, so never merged)
+		if (island == 1) {
+			doomed.reset(); // (a merged node, released at the merge)
+		}
+		EXPECT_LT(child->phylogenyNode, Phylogeny::none);
+		EXPECT_EQ(child->ID, -2);
+		EXPECT_EQ(grandchild->ID, -3);
+		EXPECT_EQ(phylogeny.getID(grandchild->phylogenyNode), -3);
+		EXPECT_EQ(phylogeny.getParents(grandchild->phylogenyNode), std::vector<Phylogeny::Node>({child->phylogenyNode}));
+		// each staging only sees its own offspring
+		EXPECT_EQ(parent->getOffspringCount(), 1);
+		made[island] = {child, grandchild};
+
+		Phylogeny::threadStaging() = nullptr;
+		Organism::provisionalIDCounter() = nullptr;
+	}
+	EXPECT_EQ(phylogeny.size(), startSize);
+	EXPECT_FALSE(phylogeny.expired(doomedWeak));
+
+	phylogeny.merge(stagings);
+	EXPECT_EQ(phylogeny.size(), startSize + 4 - 1);
+	EXPECT_TRUE(phylogeny.expired(doomedWeak));
+	EXPECT_EQ(parent->getOffspringCount(), 2);
+	// islands are merged in order, and each island's nodes in the order made
+	EXPECT_EQ(made[0][0]->phylogenyNode, nextNodes[0]);
+	EXPECT_EQ(made[0][1]->phylogenyNode, nextNodes[1]);
+	EXPECT_EQ(made[1][0]->phylogenyNode, nextNodes[2]);
+	EXPECT_EQ(made[1][1]->phylogenyNode, nextNodes[3]);
+	for (auto &islandMade : made) {
+		EXPECT_EQ(phylogeny.getParents(islandMade[0]->phylogenyNode), std::vector<Phylogeny::Node>({parent->phylogenyNode}));
+		EXPECT_EQ(phylogeny.getParents(islandMade[1]->phylogenyNode), std::vector<Phylogeny::Node>({islandMade[0]->phylogenyNode}));
+		EXPECT_EQ(phylogeny.getID(islandMade[1]->phylogenyNode), -3);
+	}
+
+	// IDs are then given in island order (as IslandsOptimizer does)
+	for (auto &islandMade : made) {
+		for (auto &org : islandMade) {
+			org->assignID();
+		}
+	}
+	EXPECT_EQ(made[0][1]->ID, made[0][0]->ID + 1);
+	EXPECT_EQ(made[1][0]->ID, made[0][1]->ID + 1);
+	for (auto &islandMade : made) {
+		for (auto &org : islandMade) {
+			EXPECT_EQ(phylogeny.getID(org->phylogenyNode), org->ID);
+		}
+	}
+}
+
+TEST(Phylogeny, AncestorsAcrossSavedAndUnsavedNodes) {
+	auto &phylogeny = Phylogeny::get();
+	const auto set = Phylogeny::SNAPSHOT_ANCESTORS;
+	phylogeny.trackAncestors(set);
+	TestUpdate update(10);
+
+	// an organism made with no parents is its own ancestor
+	auto root = makeTestOrganism();
+	EXPECT_TRUE(phylogeny.isSaved(set, root->phylogenyNode));
+	EXPECT_EQ(phylogeny.getAncestors(set, root->phylogenyNode), std::vector<int>({root->ID}));
+
+	Global::update = 11;
+	auto a = makeTestOffspring({root});
+	auto b = makeTestOffspring({root});
+	EXPECT_FALSE(phylogeny.isSaved(set, a->phylogenyNode));
+	EXPECT_EQ(phylogeny.getAncestors(set, a->phylogenyNode), std::vector<int>({root->ID}));
+	phylogeny.setSaved(set, a->phylogenyNode);
+	EXPECT_EQ(phylogeny.getAncestors(set, a->phylogenyNode), std::vector<int>({a->ID}));
+
+	Global::update = 12;
+	auto c = makeTestOffspring({a}); // (a was saved before c was born)
+	auto d = makeTestOffspring({b}); // (b has not been saved)
+	auto e = makeTestOffspring({c, d});
+	EXPECT_EQ(phylogeny.getAncestors(set, c->phylogenyNode), std::vector<int>({a->ID}));
+	EXPECT_EQ(phylogeny.getAncestors(set, d->phylogenyNode), std::vector<int>({root->ID}));
+	EXPECT_EQ(phylogeny.getAncestors(set, e->phylogenyNode), std::vector<int>({root->ID, a->ID}));
+
+	// b is saved after d was born, so d's ancestors do not change
+	Global::update = 13;
+	phylogeny.setSaved(set, b->phylogenyNode);
+	EXPECT_EQ(phylogeny.getAncestors(set, b->phylogenyNode), std::vector<int>({b->ID}));
+	EXPECT_EQ(phylogeny.getAncestors(set, d->phylogenyNode), std::vector<int>({root->ID}));
+	auto f = makeTestOffspring({b});
+	Global::update = 14;
+	auto g = makeTestOffspring({f});
+	EXPECT_EQ(phylogeny.getAncestors(set, g->phylogenyNode), std::vector<int>({root->ID}));
+
+	// ancestors are kept when parents are cleared, after the parents are gone
+	int rootID = root->ID;
+	root.reset();
+	a.reset();
+	b.reset();
+	c.reset();
+	e->clearParents();
+	d->clearParents();
+	EXPECT_EQ(phylogeny.getAncestors(set, e->phylogenyNode), std::vector<int>({rootID, e->ID - 4}));
+	EXPECT_EQ(phylogeny.getAncestors(set, d->phylogenyNode), std::vector<int>({rootID}));
+
+	// and can be set (as SSwD does once it has checked them)
+	phylogeny.setAncestors(set, g->phylogenyNode, {f->ID, d->ID, f->ID});
+	EXPECT_EQ(phylogeny.getAncestors(set, g->phylogenyNode), std::vector<int>({d->ID, f->ID}));
+}
@@ -0,0 +1,105 @@
+#include <Utilities/Pool.h>
+
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+TEST(Pool, SizeClasses) {
+	size_t lastChunk = 0;
+	int lastClass = -1;
+	for (size_t bytes = 1; bytes <= Pool::maxChunkSize; bytes++) {
+		size_t chunkSize;
+		int c = Pool::sizeClass(bytes, chunkSize);
+		ASSERT_GE(chunkSize, bytes);
+		ASSERT_EQ(chunkSize % 16, 0u);
+		ASSERT_LT(c, Pool::classCount);
+		ASSERT_GE(c, lastClass) << "classes should grow with size";
+		if (c == lastClass) {
+			ASSERT_EQ(chunkSize, lastChunk) << "all sizes in a class share a chunk size";
+		}
+		if (bytes > 256) {
+			ASSERT_LT(chunkSize - bytes, bytes / 4 + 1) << "a chunk should not waste more than a quarter of a request";
+		}
+		lastClass = c;
+		lastChunk = chunkSize;
+	}
+	EXPECT_EQ(lastClass, Pool::classCount - 1);
+}
+
+TEST(Pool, FreedMemoryIsReused) {
+	// warm up, then make and free the same objects again: no new heap allocations
+	for (int round = 0; round < 3; round++) {
+		long long before = Pool::heapAllocations();
+		std::vector<std::shared_ptr<std::vector<int, Pool::Allocator<int>>>> objects;
+		for (int i = 0; i < 2000; i++) {
+			objects.push_back(Pool::make<std::vector<int, Pool::Allocator<int>>>(i % 300, i));
+		}
+		for (int i = 0; i < 2000; i++) {
+			ASSERT_EQ((int)objects[i]->size(), i % 300);
+			for (int value : *objects[i]) {
+				ASSERT_EQ(value, i);
+			}
+		}
+		objects.clear();
+		if (round > 0) {
+			EXPECT_EQ(Pool::heapAllocations(), before);
+		}
+	}
+	void *p = Pool::allocate(100);
+	Pool::deallocate(p, 100);
+	EXPECT_EQ(Pool::allocate(112), p) << "the last chunk freed should be the next handed out";
+	Pool::deallocate(p, 112);
+}
+
+TEST(Pool, ThreadsShareFreedMemory) {
+	// objects made on worker threads and freed on this thread (as migrants
+	// and offspring of islands are) should be reused by later workers, not
+	// pile up on this thread
+	long long warm = 0;
+	for (int round = 0; round < 20; round++) {
+		std::vector<std::thread> workers;
+		std::vector<std::vector<std::shared_ptr<double>>> results(4);
+		for (int w = 0; w < 4; w++) {
+			workers.emplace_back([&results, w, round]() {
+				for (int i = 0; i < 5000; i++) {
+					results[w].push_back(Pool::make<double>(w * 10000.0 + i + round));
+				}
+			});
+		}
+		for (auto &worker : workers) {
+			worker.join();
+		}
+		for (int w = 0; w < 4; w++) {
+			for (int i = 0; i < 5000; i++) {
+				ASSERT_EQ(*results[w][i], w * 10000.0 + i + round);
+			}
+		}
+		results.clear(); // (freed on this thread)
+		if (round == 1) {
+			warm = Pool::heapAllocations();
+		}
+	}
+	EXPECT_LT(Pool::heapAllocations() - warm, 20) << "workers should reuse memory freed by earlier workers";
+}
+
+TEST(Pool, FreeingThreadsGiveBackMemory) {
+	// a thread which only frees objects (made on another thread) should give
+	// its free lists back when it ends, rather than strand them
+	long long warm = 0;
+	for (int round = 0; round < 20; round++) {
+		std::vector<std::shared_ptr<double>> objects;
+		std::thread maker([&objects, round]() {
+			for (int i = 0; i < 3000; i++) { // (fewer than a thread keeps)
+				objects.push_back(Pool::make<double>(i + round));
+			}
+		});
+		maker.join();
+		std::thread freer([&objects]() { objects.clear(); });
+		freer.join();
+		if (round == 1) {
+			warm = Pool::heapAllocations();
+		}
+	}
+	EXPECT_LT(Pool::heapAllocations() - warm, 10) << "makers should reuse memory freed by earlier freeing threads";
+}
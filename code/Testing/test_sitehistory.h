@@ -0,0 +1,76 @@
+#include <Genome/SiteHistory.h>
+
+#include <random>
+#include <vector>
+
+// the parent index of each site (-1 for new sites), kept the slow way
+static int expectedParentIndex(const std::vector<int> &origins, int index, int count) {
+	if (index < 0 || index + count > (int)origins.size() || origins[index] < 0) {
+		return -1;
+	}
+	for (int i = 1; i < count; i++) {
+		if (origins[index + i] != origins[index] + i) {
+			return -1;
+		}
+	}
+	return origins[index];
+}
+
+TEST(SiteHistory, MatchesSiteOrigins) {
+	std::mt19937 gen(101);
+	for (int trial = 0; trial < 50; trial++) {
+		int parentSize = std::uniform_int_distribution<int>(1, 400)(gen);
+		SiteHistory history;
+		history.copied(7, parentSize);
+		std::vector<int> origins(parentSize);
+		for (int i = 0; i < parentSize; i++) {
+			origins[i] = i;
+		}
+		for (int edit = 0; edit < 30; edit++) {
+			int size = (int)origins.size();
+			int index = std::uniform_int_distribution<int>(0, size)(gen);
+			int count = std::uniform_int_distribution<int>(0, 20)(gen);
+			switch (std::uniform_int_distribution<int>(0, 2)(gen)) {
+			case 0: // changed
+				count = std::min(count, size - index);
+				history.changed(index, count);
+				for (int i = index; i < index + count; i++) {
+					origins[i] = -1;
+				}
+				break;
+			case 1: // inserted
+				history.inserted(index, count);
+				origins.insert(origins.begin() + index, count, -1);
+				break;
+			case 2: // erased
+				count = std::min(count, size - index);
+				history.erased(index, count);
+				origins.erase(origins.begin() + index, origins.begin() + index + count);
+				break;
+			}
+			int total = 0;
+			for (auto &run : history.runs) {
+				ASSERT_GT(run.size, 0);
+				total += run.size;
+			}
+			ASSERT_EQ(total, (int)origins.size());
+			for (int i = 0; i < (int)origins.size(); i++) {
+				for (int count : { 1, 2, 5 }) {
+					ASSERT_EQ(history.parentIndex(i, count), expectedParentIndex(origins, i, count)) << "site " << i << " count " << count;
+				}
+			}
+		}
+	}
+}
+
+TEST(SiteHistory, ForgetStopsTracking) {
+	SiteHistory history;
+	history.copied(3, 10);
+	EXPECT_EQ(history.parentIndex(4, 2), 4);
+	history.forget();
+	EXPECT_EQ(history.parentSitesID, 0);
+	EXPECT_EQ(history.parentIndex(4, 2), -1);
+	history.changed(0, 1); // (not recorded)
+	EXPECT_TRUE(history.runs.empty());
+	EXPECT_NE(SiteHistory::newSitesID(), SiteHistory::newSitesID());
+}
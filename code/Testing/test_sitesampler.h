@@ -0,0 +1,59 @@
+#include <Utilities/SiteSampler.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+// SiteSampler should hit each site independently with probability rate, the
+// same model as trying every site (EmpGetFullRandBinomial)
+TEST(SiteSampler, HitCountsAreBinomial) {
+	std::mt19937 gen(101);
+	const int sites = 5000;
+	const int trials = 20000;
+	for (double rate : { .005, .05, .5 }) {
+		SiteSampler sampler(rate);
+		double sum = 0, sumSquares = 0;
+		for (int i = 0; i < trials; i++) {
+			double hits = sampler.count(sites, gen);
+			sum += hits;
+			sumSquares += hits * hits;
+		}
+		double mean = sum / trials;
+		double variance = sumSquares / trials - mean * mean;
+		double expectedMean = sites * rate;
+		double expectedVariance = sites * rate * (1 - rate);
+		// mean is within 5 standard errors, variance within 5%
+		EXPECT_NEAR(mean, expectedMean, 5 * std::sqrt(expectedVariance / trials)) << "rate " << rate;
+		EXPECT_NEAR(variance, expectedVariance, .05 * expectedVariance) << "rate " << rate;
+	}
+}
+
+TEST(SiteSampler, HitsAreUniformAndDistinct) {
+	std::mt19937 gen(101);
+	const int sites = 100;
+	const int trials = 100000;
+	SiteSampler sampler(.02);
+	std::vector<int> counts(sites, 0);
+	for (int i = 0; i < trials; i++) {
+		int last = -1;
+		sampler.forEach(sites, [&](int site) {
+			EXPECT_GT(site, last) << "hits should be in order, and each site hit at most once";
+			last = site;
+			counts[site]++;
+		}, gen);
+	}
+	double expected = trials * .02;
+	double statistic = 0;
+	for (int count : counts) {
+		statistic += (count - expected) * (count - expected) / expected;
+	}
+	// 99 degrees of freedom, 148.23 is the .001 critical value
+	EXPECT_LT(statistic, 148.23) << "hits should be uniform over sites";
+}
+
+TEST(SiteSampler, EdgeRates) {
+	std::mt19937 gen(101);
+	EXPECT_EQ(SiteSampler(0).count(1000, gen), 0);
+	EXPECT_EQ(SiteSampler(1).count(1000, gen), 1000);
+	EXPECT_EQ(SiteSampler(.5).count(0, gen), 0);
+}
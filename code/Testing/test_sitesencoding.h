@@ -0,0 +1,180 @@
+#include <Genome/CircularGenome/CircularGenome.h>
+#include <Genome/MultiGenome/MultiGenome.h>
+#include <Utilities/SitesEncoding.h>
+
+#include "test_parameter.h"
+
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// the text format genomes save sites in (comma separated), as written by
+// CircularGenome::genomeToStr (unsigned char sites are written as ints)
+template <class T>
+static std::string sitesToText(const std::vector<T> &sites) {
+	std::stringstream ss;
+	for (size_t i = 0; i < sites.size(); i++) {
+		if (std::is_same<T, unsigned char>::value) {
+			ss << (int)sites[i];
+		}
+		else {
+			ss << sites[i];
+		}
+		if (i + 1 < sites.size()) {
+			ss << ',';
+		}
+	}
+	return ss.str();
+}
+
+// encode sites, decode them and check that the text of what comes back
+// matches the text of what went in
+template <class T>
+static void expectRoundTrip(const std::vector<T> &sites) {
+	std::string bytes;
+	SitesEncoding::SiteWriter<T> writer(bytes);
+	for (auto site : sites) {
+		writer.add(site);
+	}
+	writer.finish();
+	std::string text = SitesEncoding::toBase64(bytes);
+	ASSERT_TRUE(SitesEncoding::isBinary(text));
+	EXPECT_EQ(text.find(','), std::string::npos) << "base64 sites must fit in one csv column";
+
+	std::string decoded = SitesEncoding::fromBase64(text);
+	ASSERT_EQ(decoded, bytes);
+	size_t position = 0;
+	SitesEncoding::SiteReader<T> reader(decoded, position);
+	std::vector<T> loaded;
+	for (size_t i = 0; i < sites.size(); i++) {
+		loaded.push_back(reader.next());
+	}
+	EXPECT_EQ(position, decoded.size()) << "all bytes should be read";
+	EXPECT_EQ(sitesToText(loaded), sitesToText(sites));
+	if (!std::is_same<T, double>::value) { // (doubles are saved exactly, so may not be smaller)
+		EXPECT_LT(text.size(), sitesToText(sites).size() + 16) << "binary sites should not be larger than text";
+	}
+}
+
+TEST(SitesEncoding, RoundTripMatchesText) {
+	std::mt19937 gen(101);
+	for (size_t size : { 0, 1, 2, 3, 7, 8, 9, 5000 }) {
+		std::vector<unsigned char> chars;
+		std::vector<int> ints;
+		std::vector<bool> bools;
+		std::vector<double> doubles;
+		for (size_t i = 0; i < size; i++) {
+			chars.push_back(std::uniform_int_distribution<int>(0, 255)(gen));
+			ints.push_back(std::uniform_int_distribution<int>(-1000, 1000)(gen));
+			bools.push_back(std::uniform_int_distribution<int>(0, 1)(gen));
+			doubles.push_back(std::uniform_real_distribution<double>(0, 256)(gen));
+		}
+		expectRoundTrip(chars);
+		expectRoundTrip(ints);
+		expectRoundTrip(bools);
+		expectRoundTrip(doubles);
+	}
+}
+
+TEST(SitesEncoding, ExactValues) {
+	// ints at the ends of the range, and doubles text can not hold exactly
+	std::vector<int> ints = { 0, -1, 1, 63, -64, 64, std::numeric_limits<int>::max(), std::numeric_limits<int>::min() };
+	std::vector<double> doubles = { 0.1, 1.0 / 3.0, 255.99999999999997, -0.0 };
+	std::string bytes;
+	SitesEncoding::SiteWriter<int> intWriter(bytes);
+	for (int site : ints) {
+		intWriter.add(site);
+	}
+	SitesEncoding::SiteWriter<double> doubleWriter(bytes);
+	for (double site : doubles) {
+		doubleWriter.add(site);
+	}
+	size_t position = 0;
+	SitesEncoding::SiteReader<int> intReader(bytes, position);
+	for (int site : ints) {
+		EXPECT_EQ(intReader.next(), site);
+	}
+	SitesEncoding::SiteReader<double> doubleReader(bytes, position);
+	for (double site : doubles) {
+		EXPECT_EQ(doubleReader.next(), site);
+	}
+}
+
+// what a genome's serialize saves, as the columns of an organisms file
+static std::unordered_map<std::string, std::string> serializeGenome(std::shared_ptr<AbstractGenome> genome, std::string name) {
+	DataMap serialData = genome->serialize(name);
+	std::unordered_map<std::string, std::string> orgData;
+	for (auto &key : serialData.getKeys()) {
+		orgData[key] = serialData.getStringOfVector(key);
+	}
+	return orgData;
+}
+
+// make a genome (as configured) for each sites type, save it with each sites
+// encoding and load it into another genome. the sites must come back the same
+// (and binary sites are only loaded if every byte is read)
+static void expectGenomesRoundTrip(std::shared_ptr<AbstractGenome> (*genomeFactory)(std::shared_ptr<ParametersTable>)) {
+	std::string name = "GENOME_root";
+	for (std::string sitesType : { "char", "int", "double", "bool" }) {
+		TestParameter<std::string> type("GENOME-sitesType", sitesType);
+		TestParameter<double> alphabetSize("GENOME-alphabetSize", sitesType == "bool" ? 2.0 : 256.0);
+		for (std::string encoding : { "text", "binary" }) {
+			TestParameter<std::string> sitesEncoding("GENOME-sitesEncoding", encoding);
+			auto genome = genomeFactory(Parameters::root);
+			genome->fillRandom();
+			auto orgData = serializeGenome(genome, name);
+			ASSERT_EQ(SitesEncoding::isBinary(orgData[name + "_sites"]), encoding == "binary") << sitesType;
+
+			auto loaded = genome->makeLike();
+			ASSERT_NE(loaded->genomeToStr(), genome->genomeToStr()) << sitesType; // (so loading must change it)
+			loaded->deserialize(Parameters::root, orgData, name);
+			EXPECT_EQ(loaded->genomeToStr(), genome->genomeToStr()) << sitesType << " sites saved as " << encoding;
+		}
+	}
+}
+
+TEST(SitesEncoding, CircularGenomeRoundTrip) {
+	// (an odd size, so bool sites do not fill their last byte)
+	TestParameter<int> size("GENOME_CIRCULAR-sizeInitial", 333);
+	expectGenomesRoundTrip(CircularGenome_genomeFactory);
+}
+
+TEST(SitesEncoding, MultiGenomeRoundTrip) {
+	TestParameter<int> size("GENOME_MULTI-chromosomeSizeInitial", 333);
+	{
+		expectGenomesRoundTrip(MultiGenome_genomeFactory);
+	}
+	{
+		// each chromosome starts on a new byte, so the last partly filled byte
+		// of a chromosome of bools must not shift the sites of the next
+		TestParameter<int> sets("GENOME_MULTI-chromosome_sets", 3);
+		TestParameter<int> ploidy("GENOME_MULTI-chromosome_ploidy", 2);
+		expectGenomesRoundTrip(MultiGenome_genomeFactory);
+	}
+}
+
+TEST(SitesEncoding, BinarySitesMustAllBeRead) {
+	std::string name = "GENOME_root";
+	TestParameter<std::string> type("GENOME-sitesType", std::string("char"));
+	TestParameter<std::string> sitesEncoding("GENOME-sitesEncoding", std::string("binary"));
+	{
+		TestParameter<int> size("GENOME_CIRCULAR-sizeInitial", 100);
+		auto genome = CircularGenome_genomeFactory(Parameters::root);
+		auto orgData = serializeGenome(genome, name);
+		orgData[name + "_genomeLength"] = "99";
+		EXPECT_EXIT(genome->makeLike()->deserialize(Parameters::root, orgData, name), ::testing::ExitedWithCode(1), "");
+	}
+	{
+		TestParameter<int> size("GENOME_MULTI-chromosomeSizeInitial", 100);
+		TestParameter<int> sets("GENOME_MULTI-chromosome_sets", 2);
+		auto genome = MultiGenome_genomeFactory(Parameters::root);
+		auto orgData = serializeGenome(genome, name);
+		ASSERT_EQ(orgData[name + "_chromosomeLengths"], "100,100");
+		orgData[name + "_chromosomeLengths"] = "100,99";
+		EXPECT_EXIT(genome->makeLike()->deserialize(Parameters::root, orgData, name), ::testing::ExitedWithCode(1), "");
+	}
+}
@@ -2,6 +2,23 @@
 #include <iostream>
 
 #include "test_graycode.h"
+#include "test_aliastable.h"
+#include "test_bitops.h"
+#include "test_chunkedvector.h"
+#include "test_sitesampler.h"
+#include "test_sitesencoding.h"
+#include "test_sitehistory.h"
+#include "test_pool.h"
+#include "test_parameters.h"
+#include "test_datamap.h"
+#include "test_gatelistbuilder.h"
+#include "test_lexicase.h"
+#include "test_phylogeny.h"
+#include "test_compiledmtree.h"
+#include "test_csv.h"
+
+// normally defined by the generated Utilities/gitversion.h (see main.cpp)
+const char *gitversion = "tests";
 
 int main(int argc, char* argv[]) {
 	testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,97 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+// AliasTable picks indices with probability proportional to a list of
+// weights (roulette wheel selection) in constant time per pick, using
+// Vose's alias method. build is O(n) and is done once per set of weights;
+// sample then costs one index and one double from the generator, however
+// uneven the weights are.
+// Weights below 0 are taken as 0. If no weight is above 0 every index is
+// equally likely.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Random.h"
+
+class AliasTable {
+public:
+  void build(const std::vector<double> &weights) {
+    const int n = static_cast<int>(weights.size());
+    probability.assign(n, 1.0);
+    alias.resize(n);
+    for (int i = 0; i < n; i++) {
+      alias[i] = i;
+    }
+
+    double total = 0;
+    for (double weight : weights) {
+      total += (weight > 0) ? weight : 0;
+    }
+    if (!(total > 0)) {
+      return; // uniform
+    }
+
+    // scale the weights so that the average is 1, then pair each column
+    // below 1 with a column above 1 which fills the rest of it
+    scaled.resize(n);
+    small.clear();
+    large.clear();
+    for (int i = 0; i < n; i++) {
+      scaled[i] = ((weights[i] > 0) ? weights[i] : 0) * n / total;
+      if (scaled[i] < 1.0) {
+        small.push_back(i);
+      } else {
+        large.push_back(i);
+      }
+    }
+    while (!small.empty() && !large.empty()) {
+      int less = small.back();
+      small.pop_back();
+      int more = large.back();
+      probability[less] = scaled[less];
+      alias[less] = more;
+      scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+      if (scaled[more] < 1.0) {
+        large.pop_back();
+        small.push_back(more);
+      }
+    }
+    // what is left is 1 (up to rounding), so these columns always pick
+    // themselves
+    for (int i : large) {
+      probability[i] = 1.0;
+    }
+    for (int i : small) {
+      probability[i] = 1.0;
+    }
+  }
+
+  int size() const { return static_cast<int>(probability.size()); }
+
+  // an index in [0,size()), picked with probability weight / total weight
+  template <typename Engine = Random::Generator>
+  int sample(Engine &gen = Random::getCommonGenerator()) const {
+    int column = Random::getIndex(size(), gen);
+    return (Random::getDouble(1.0, gen) < probability[column]) ? column
+                                                              : alias[column];
+  }
+
+private:
+  std::vector<double> probability; // chance that a column picks itself
+  std::vector<int> alias;          // what a column picks otherwise
+
+  // used by build (kept so rebuilding does not allocate)
+  std::vector<double> scaled;
+  std::vector<int> small;
+  std::vector<int> large;
+};
@@ -0,0 +1,150 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include "AsyncFileWriter.h"
+
+AsyncFileWriter::~AsyncFileWriter() { stop(); }
+
+void AsyncFileWriter::start(size_t _maxQueuedBytes) {
+  std::lock_guard<std::mutex> lock(queueMutex);
+  maxQueuedBytes = _maxQueuedBytes;
+  if (!running) {
+    stopping = false;
+    running = true;
+    writerThread = std::thread(&AsyncFileWriter::writerLoop, this);
+  }
+}
+
+void AsyncFileWriter::write(const std::string &path, std::string text,
+                            bool truncate, bool binary) {
+  enqueue({WRITE, path, std::move(text), truncate, binary});
+}
+
+void AsyncFileWriter::close(const std::string &path) {
+  enqueue({CLOSE, path, "", false, false});
+}
+
+void AsyncFileWriter::flush(bool wait) {
+  std::unique_lock<std::mutex> lock(queueMutex);
+  if (!running) {
+    Command command{FLUSH, "", "", false, false};
+    run(command);
+    return;
+  }
+  queue.push_back({FLUSH, "", "", false, false});
+  auto ticket = ++commandsQueued;
+  workCondition.notify_one();
+  if (wait) {
+    doneCondition.wait(lock, [this, ticket] { return commandsDone >= ticket; });
+  }
+}
+
+void AsyncFileWriter::stop() {
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    if (running) {
+      stopping = true;
+    }
+  }
+  workCondition.notify_one();
+  if (writerThread.joinable()) {
+    writerThread.join();
+  }
+  std::lock_guard<std::mutex> lock(queueMutex);
+  running = false;
+  for (auto &file : files) { // the queue is empty, close everything
+    writeBuffer(file.second);
+    file.second.stream.close();
+  }
+  files.clear();
+}
+
+void AsyncFileWriter::enqueue(Command command) {
+  std::unique_lock<std::mutex> lock(queueMutex);
+  if (!running) {
+    run(command);
+    return;
+  }
+  // wait for space, unless the queue is empty (so that text larger than
+  // maxQueuedBytes can still be written)
+  spaceCondition.wait(lock, [this, &command] {
+    return queue.empty() ||
+           queuedBytes + command.text.size() <= maxQueuedBytes;
+  });
+  queuedBytes += command.text.size();
+  queue.push_back(std::move(command));
+  commandsQueued++;
+  workCondition.notify_one();
+}
+
+void AsyncFileWriter::run(Command &command) {
+  if (command.type == FLUSH) {
+    for (auto &file : files) {
+      writeBuffer(file.second);
+      file.second.stream.flush();
+    }
+    return;
+  }
+  if (command.type == CLOSE) {
+    auto found = files.find(command.path);
+    if (found != files.end()) {
+      writeBuffer(found->second);
+      files.erase(found); // closes stream
+    }
+    return;
+  }
+  // WRITE
+  auto &file = files[command.path];
+  auto mode = command.binary ? std::ios::out | std::ios::binary : std::ios::out;
+  if (command.truncate) {
+    file.buffer.clear();
+    if (file.stream.is_open()) {
+      file.stream.close();
+    }
+    file.stream.open(command.path, mode); // clear file contents and open in write mode
+  } else if (!file.stream.is_open()) {
+    file.stream.open(command.path, mode | std::ios::app);
+  }
+  file.buffer += command.text;
+  if (!running) { // no writer thread, write through as soon as asked
+    writeBuffer(file);
+    file.stream.flush();
+  } else if (file.buffer.size() >= bufferBytes) {
+    writeBuffer(file);
+  }
+}
+
+void AsyncFileWriter::writeBuffer(OutputFile &file) {
+  if (!file.buffer.empty()) {
+    file.stream.write(file.buffer.data(), file.buffer.size());
+    file.buffer.clear();
+  }
+}
+
+void AsyncFileWriter::writerLoop() {
+  std::unique_lock<std::mutex> lock(queueMutex);
+  while (true) {
+    workCondition.wait(lock, [this] { return stopping || !queue.empty(); });
+    if (queue.empty()) { // stopping and nothing left to do
+      return;
+    }
+    Command command = std::move(queue.front());
+    queue.pop_front();
+    queuedBytes -= command.text.size();
+    spaceCondition.notify_all();
+
+    lock.unlock(); // the disk is only touched while the queue is unlocked
+    run(command);
+    lock.lock();
+
+    commandsDone++;
+    doneCondition.notify_all();
+  }
+}
@@ -0,0 +1,97 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+// AsyncFileWriter owns a set of output files and writes to them on a
+// background thread. Writes are put on a queue (bounded by the number of bytes
+// waiting) and the writer thread collects the text for each file in a large
+// buffer, so the disk sees a few big writes rather than one write (and flush)
+// per line. Until start() is called (or after stop()) every command is run
+// right away on the calling thread.
+// Commands are run in the order they are given, so a file which is closed and
+// then written to again is reopened in append mode, as FileManager expects.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+class AsyncFileWriter {
+public:
+  AsyncFileWriter() = default;
+  ~AsyncFileWriter();
+
+  AsyncFileWriter(const AsyncFileWriter &) = delete;
+  AsyncFileWriter &operator=(const AsyncFileWriter &) = delete;
+
+  // start the writer thread. write will wait if more than maxQueuedBytes of
+  // text is waiting to be written
+  void start(size_t maxQueuedBytes);
+
+  // add text to the file at path. if truncate, the file is (re)created first,
+  // otherwise text is added to the end of the file. binary only matters when
+  // the file is opened (no line ending conversion)
+  void write(const std::string &path, std::string text, bool truncate,
+             bool binary = false);
+
+  // write any buffered text for path and close it
+  void close(const std::string &path);
+
+  // pass all buffered text to the OS. if wait, do not return until this
+  // (and everything before it) is done
+  void flush(bool wait = false);
+
+  // flush and close every file and stop the writer thread
+  void stop();
+
+  bool isRunning() const { return running; }
+
+private:
+  enum CommandType { WRITE, CLOSE, FLUSH };
+  struct Command {
+    CommandType type;
+    std::string path;
+    std::string text;
+    bool truncate;
+    bool binary;
+  };
+  struct OutputFile {
+    std::ofstream stream;
+    std::string buffer; // text waiting to be written to stream
+  };
+
+  // text for a file is buffered until there is at least this much
+  static const size_t bufferBytes = 1 << 20;
+
+  void enqueue(Command command);
+  void run(Command &command); // run command (on the writer thread if running)
+  void writeBuffer(OutputFile &file);
+  void writerLoop();
+
+  std::unordered_map<std::string, OutputFile> files;
+
+  std::mutex queueMutex;
+  std::condition_variable workCondition;  // writer waits for commands
+  std::condition_variable spaceCondition; // callers wait for queue space
+  std::condition_variable doneCondition;  // flush(true) waits for writer
+  std::deque<Command> queue;
+  size_t queuedBytes = 0;
+  size_t maxQueuedBytes = 0;
+  unsigned long long commandsQueued = 0;
+  unsigned long long commandsDone = 0;
+  bool running = false;
+  bool stopping = false;
+  std::thread writerThread;
+};
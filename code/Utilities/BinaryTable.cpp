@@ -0,0 +1,401 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include "BinaryTable.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#ifdef MABE_ZLIB
+#include <zlib.h>
+#endif
+
+const std::string BinaryTable::extension = ".mbt";
+
+static const std::string chunkMagic = "MBT1";
+
+enum Encoding { TEXT = 0, INTEGERS = 1, INTEGER_LISTS = 2, BYTE_LISTS = 3 };
+enum Compression { NO_COMPRESSION = 0, ZLIB = 1 };
+
+static void putVarint(std::string &out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+static uint64_t zigzag(long long value) {
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+static long long unzigzag(uint64_t value) {
+  return static_cast<long long>(value >> 1) ^ -static_cast<long long>(value & 1);
+}
+
+// parse [begin,end) as an integer. returns false unless the text is exactly
+// what std::to_string would give for the value (no '+', no leading zeros...)
+static bool parseInteger(const char *begin, const char *end, long long &value) {
+  bool negative = false;
+  if (begin != end && *begin == '-') {
+    negative = true;
+    begin++;
+  }
+  size_t digits = end - begin;
+  if (digits == 0 || digits > 18 || (*begin == '0' && (digits > 1 || negative))) {
+    return false;
+  }
+  long long result = 0;
+  for (const char *c = begin; c != end; c++) {
+    if (*c < '0' || *c > '9') {
+      return false;
+    }
+    result = result * 10 + (*c - '0');
+  }
+  value = negative ? -result : result;
+  return true;
+}
+
+// call f(value) for each value in a comma separated list of integers. returns
+// false (part way through) if cell is not such a list. "" is an empty list
+template <typename F>
+static bool forEachListValue(const std::string &cell, F f) {
+  if (cell.empty()) {
+    return true;
+  }
+  const char *begin = cell.data();
+  const char *end = begin + cell.size();
+  while (true) {
+    const char *comma = begin;
+    while (comma != end && *comma != ',') {
+      comma++;
+    }
+    long long value;
+    if (!parseInteger(begin, comma, value)) {
+      return false;
+    }
+    f(value);
+    if (comma == end) {
+      return true;
+    }
+    begin = comma + 1;
+  }
+}
+
+static bool encodeIntegers(const std::vector<std::string> &cells,
+                           std::string &out) {
+  for (auto &cell : cells) {
+    long long value;
+    if (!parseInteger(cell.data(), cell.data() + cell.size(), value)) {
+      return false;
+    }
+    putVarint(out, zigzag(value));
+  }
+  return true;
+}
+
+static bool encodeLists(const std::vector<std::string> &cells, std::string &out,
+                        Encoding &encoding) {
+  // check that every cell is a list, and if all values fit in a byte
+  bool bytes = true;
+  for (auto &cell : cells) {
+    bool isList = forEachListValue(cell, [&bytes](long long value) {
+      bytes = bytes && value >= 0 && value <= 255;
+    });
+    if (!isList) {
+      return false;
+    }
+  }
+  encoding = bytes ? BYTE_LISTS : INTEGER_LISTS;
+  for (auto &cell : cells) {
+    uint64_t count = cell.empty() ? 0 : 1;
+    for (auto c : cell) {
+      count += c == ',';
+    }
+    putVarint(out, count);
+    forEachListValue(cell, [&out, bytes](long long value) {
+      if (bytes) {
+        out.push_back(static_cast<char>(value));
+      } else {
+        putVarint(out, zigzag(value));
+      }
+    });
+  }
+  return true;
+}
+
+static void encodeColumn(const std::string &name,
+                         const std::vector<std::string> &cells,
+                         std::string &chunk) {
+  std::string raw;
+  Encoding encoding = INTEGERS;
+  if (!encodeIntegers(cells, raw)) {
+    raw.clear();
+    if (!encodeLists(cells, raw, encoding)) {
+      raw.clear();
+      encoding = TEXT;
+      for (auto &cell : cells) {
+        putVarint(raw, cell.size());
+        raw += cell;
+      }
+    }
+  }
+
+  Compression compression = NO_COMPRESSION;
+  std::string stored;
+#ifdef MABE_ZLIB
+  uLongf compressedSize = compressBound(raw.size());
+  stored.resize(compressedSize);
+  if (compress2(reinterpret_cast<Bytef *>(&stored[0]), &compressedSize,
+                reinterpret_cast<const Bytef *>(raw.data()), raw.size(),
+                Z_BEST_SPEED) == Z_OK &&
+      compressedSize < raw.size()) {
+    stored.resize(compressedSize);
+    compression = ZLIB;
+  }
+#endif
+  if (compression == NO_COMPRESSION) {
+    stored = std::move(raw);
+  }
+
+  putVarint(chunk, name.size());
+  chunk += name;
+  chunk.push_back(static_cast<char>(encoding));
+  chunk.push_back(static_cast<char>(compression));
+  putVarint(chunk, compression == NO_COMPRESSION ? stored.size() : raw.size());
+  putVarint(chunk, stored.size());
+  chunk += stored;
+}
+
+bool BinaryTable::isBinaryTableFile(const std::string &fileName) {
+  return fileName.size() >= extension.size() &&
+         fileName.compare(fileName.size() - extension.size(), extension.size(),
+                          extension) == 0;
+}
+
+bool BinaryTable::Writer::matches(
+    const std::vector<std::string> &_columnNames) const {
+  return rows == 0 || columnNames == _columnNames;
+}
+
+void BinaryTable::Writer::addRow(const std::vector<std::string> &_columnNames,
+                                 std::vector<std::string> cells) {
+  if (rows == 0) {
+    columnNames = _columnNames;
+    columns.resize(columnNames.size());
+  }
+  for (size_t c = 0; c < cells.size(); c++) {
+    bytes += cells[c].size();
+    columns[c].push_back(std::move(cells[c]));
+  }
+  rows++;
+}
+
+std::string BinaryTable::Writer::takeChunk() {
+  std::string chunk = encodeChunk(columnNames, columns, rows);
+  for (auto &column : columns) {
+    column.clear();
+  }
+  rows = 0;
+  bytes = 0;
+  return chunk;
+}
+
+std::string
+BinaryTable::encodeChunk(const std::vector<std::string> &columnNames,
+                         const std::vector<std::vector<std::string>> &columns,
+                         size_t rowCount) {
+  std::string chunk = chunkMagic;
+  putVarint(chunk, rowCount);
+  putVarint(chunk, columnNames.size());
+  for (size_t c = 0; c < columnNames.size(); c++) {
+    encodeColumn(columnNames[c], columns[c], chunk);
+  }
+  return chunk;
+}
+
+// reads values from a block of bytes, exiting if the block ends too soon
+class ByteReader {
+public:
+  ByteReader(const std::string &_fileName, const char *_position,
+             const char *_end)
+      : fileName(_fileName), position(_position), end(_end) {}
+
+  bool atEnd() const { return position == end; }
+
+  uint64_t varint() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      auto byte = static_cast<unsigned char>(next());
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if (!(byte & 0x80)) {
+        return value;
+      }
+    }
+    damaged("bad number");
+    return 0;
+  }
+
+  char next() {
+    if (position == end) {
+      damaged("unexpected end of data");
+    }
+    return *position++;
+  }
+
+  const char *take(uint64_t size) {
+    if (static_cast<uint64_t>(end - position) < size) {
+      damaged("unexpected end of data");
+    }
+    const char *start = position;
+    position += size;
+    return start;
+  }
+
+  void damaged(const std::string &problem) const {
+    std::cout << "  In BinaryTable::read :: file '" << fileName
+              << "' is not a complete MABE binary table (" << problem
+              << "). Exiting." << std::endl;
+    exit(1);
+  }
+
+private:
+  const std::string &fileName;
+  const char *position;
+  const char *end;
+};
+
+static void decodeColumn(ByteReader &data, Encoding encoding, size_t rowCount,
+                         std::vector<std::string> &cells) {
+  cells.resize(rowCount);
+  for (auto &cell : cells) {
+    if (encoding == TEXT) {
+      auto size = data.varint();
+      cell.assign(data.take(size), size);
+    } else if (encoding == INTEGERS) {
+      cell = std::to_string(unzigzag(data.varint()));
+    } else if (encoding == INTEGER_LISTS) {
+      auto count = data.varint();
+      cell.clear();
+      for (uint64_t i = 0; i < count; i++) {
+        if (i > 0) {
+          cell.push_back(',');
+        }
+        cell += std::to_string(unzigzag(data.varint()));
+      }
+    } else { // BYTE_LISTS, written digit by digit as these can be very long
+      auto count = data.varint();
+      auto bytes = reinterpret_cast<const unsigned char *>(data.take(count));
+      cell.resize(count * 4); // at most 3 digits and a comma per value
+      char *out = &cell[0];
+      for (uint64_t i = 0; i < count; i++) {
+        unsigned int value = bytes[i];
+        if (value >= 100) {
+          *out++ = static_cast<char>('0' + value / 100);
+        }
+        if (value >= 10) {
+          *out++ = static_cast<char>('0' + value / 10 % 10);
+        }
+        *out++ = static_cast<char>('0' + value % 10);
+        *out++ = ',';
+      }
+      cell.resize(count == 0 ? 0 : out - &cell[0] - 1); // drop the last ','
+    }
+  }
+  if (!data.atEnd()) {
+    data.damaged("column has extra data");
+  }
+}
+
+void BinaryTable::read(const std::string &fileName,
+                       std::vector<std::string> &columnNames,
+                       std::vector<std::vector<std::string>> &rows) {
+  std::ifstream file(fileName, std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    std::cout << "  In BinaryTable::read :: unable to open file '" << fileName
+              << "'. Exiting." << std::endl;
+    exit(1);
+  }
+  std::string contents((std::istreambuf_iterator<char>(file)),
+                       std::istreambuf_iterator<char>());
+  ByteReader reader(fileName, contents.data(),
+                    contents.data() + contents.size());
+
+  columnNames.clear();
+  rows.clear();
+  bool firstChunk = true;
+  std::vector<std::string> chunkColumnNames;
+  std::vector<std::string> cells;
+  while (!reader.atEnd()) {
+    if (std::string(reader.take(chunkMagic.size()), chunkMagic.size()) !=
+        chunkMagic) {
+      reader.damaged("chunk does not start with " + chunkMagic);
+    }
+    auto rowCount = reader.varint();
+    auto columnCount = reader.varint();
+    auto firstRow = rows.size();
+    rows.resize(firstRow + rowCount, std::vector<std::string>(columnCount));
+    chunkColumnNames.clear();
+    for (uint64_t c = 0; c < columnCount; c++) {
+      auto nameSize = reader.varint();
+      chunkColumnNames.emplace_back(reader.take(nameSize), nameSize);
+      auto encoding = static_cast<Encoding>(reader.next());
+      auto compression = static_cast<Compression>(reader.next());
+      auto rawSize = reader.varint();
+      auto storedSize = reader.varint();
+      const char *stored = reader.take(storedSize);
+      if (encoding > BYTE_LISTS) {
+        reader.damaged("unknown column encoding");
+      }
+
+      std::string raw;
+      if (compression == NO_COMPRESSION) {
+        raw.assign(stored, storedSize);
+      } else if (compression == ZLIB) {
+#ifdef MABE_ZLIB
+        raw.resize(rawSize);
+        uLongf size = rawSize;
+        if (uncompress(reinterpret_cast<Bytef *>(&raw[0]), &size,
+                       reinterpret_cast<const Bytef *>(stored),
+                       storedSize) != Z_OK ||
+            size != rawSize) {
+          reader.damaged("can not uncompress column");
+        }
+#else
+        std::cout << "  In BinaryTable::read :: file '" << fileName
+                  << "' is compressed with zlib, but MABE was built without "
+                     "zlib. Exiting."
+                  << std::endl;
+        exit(1);
+#endif
+      } else {
+        reader.damaged("unknown column compression");
+      }
+
+      ByteReader columnReader(fileName, raw.data(), raw.data() + raw.size());
+      decodeColumn(columnReader, encoding, rowCount, cells);
+      for (uint64_t r = 0; r < rowCount; r++) {
+        rows[firstRow + r][c] = std::move(cells[r]);
+      }
+    }
+    if (firstChunk) {
+      columnNames = chunkColumnNames;
+      firstChunk = false;
+    } else if (chunkColumnNames != columnNames) {
+      std::cout << "  In BinaryTable::read :: file '" << fileName
+                << "' has chunks with different columns. Exiting."
+                << std::endl;
+      exit(1);
+    }
+  }
+}
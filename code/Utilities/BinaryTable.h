@@ -0,0 +1,84 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+// BinaryTable reads and writes MABE binary table (.mbt) files, a compact
+// alternative to csv for the large archivist files (snapshot and LOD files).
+// A table holds the same cells as the csv file would (after the csv quotes are
+// removed), so anything which reads a csv file through the CSV class can read
+// a .mbt file.
+//
+// A file is a sequence of chunks. Each chunk holds a block of rows stored by
+// column and can be read on its own (so rows can be added to a file at any
+// time by adding another chunk):
+//
+//   "MBT1" rowCount columnCount
+//   for each column:
+//     nameSize name encoding compression rawSize storedSize data
+//
+// all counts and sizes are unsigned LEB128 varints. Each column is encoded as
+//   TEXT          - for each row: size, bytes
+//   INTEGERS      - for each row: zigzag varint
+//   INTEGER_LISTS - for each row: count, zigzag varints
+//   BYTE_LISTS    - for each row: count, one byte per value
+// the writer picks the smallest encoding which gives back exactly the same
+// cells (i.e. a genome's sites, "3,200,17,...", is stored one byte per site).
+// If MABE is built with zlib (MABE_ZLIB) the encoded data of each column is
+// also compressed when that makes it smaller.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+class BinaryTable {
+public:
+  static const std::string extension; // ".mbt"
+
+  // true if fileName should be written (and read) as a binary table
+  static bool isBinaryTableFile(const std::string &fileName);
+
+  // Writer collects rows for one file until there are enough to make a chunk
+  class Writer {
+  public:
+    // true if no rows are waiting
+    bool empty() const { return rows == 0; }
+    // true if rows with columnNames can go in the same chunk as the rows
+    // already waiting
+    bool matches(const std::vector<std::string> &_columnNames) const;
+    // add a row (cells must be the same size as columnNames). call matches
+    // (and takeChunk if it is false) first
+    void addRow(const std::vector<std::string> &_columnNames,
+                std::vector<std::string> cells);
+    // true if enough rows are waiting that they should be written
+    bool full() const { return rows >= maxChunkRows || bytes >= maxChunkBytes; }
+    // encode the waiting rows as a chunk and remove them
+    std::string takeChunk();
+
+  private:
+    static const size_t maxChunkRows = 4096;
+    static const size_t maxChunkBytes = 16 << 20;
+
+    std::vector<std::string> columnNames;
+    std::vector<std::vector<std::string>> columns; // cells by column
+    size_t rows = 0;
+    size_t bytes = 0;
+  };
+
+  // encode one chunk. columns[c][r] is the cell for column c in row r
+  static std::string encodeChunk(const std::vector<std::string> &columnNames,
+                                 const std::vector<std::vector<std::string>> &columns,
+                                 size_t rowCount);
+
+  // read every row in fileName. exits with an error if the file is not a
+  // binary table or if its chunks do not all have the same columns
+  static void read(const std::string &fileName,
+                   std::vector<std::string> &columnNames,
+                   std::vector<std::vector<std::string>> &rows);
+};
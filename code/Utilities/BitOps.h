@@ -0,0 +1,59 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+// bit counting on 64 bit words (i.e. for walking the bits of a bitset).
+// these use the compiler's instructions where there are some (gcc/clang
+// builtins, or intrinsics with visual studio) and plain loops otherwise.
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace BitOps {
+
+// number of bits set in word
+inline int popCount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+  return static_cast<int>(__popcnt64(word));
+#else
+  int count = 0;
+  while (word) {
+    word &= word - 1; // clear the lowest set bit
+    count++;
+  }
+  return count;
+#endif
+}
+
+// index of the lowest set bit in word (word must not be 0)
+inline int countTrailingZeros(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+  unsigned long index;
+  _BitScanForward64(&index, word);
+  return static_cast<int>(index);
+#else
+  int index = 0;
+  while (!(word & 1)) {
+    word >>= 1;
+    index++;
+  }
+  return index;
+#endif
+}
+
+} // namespace BitOps
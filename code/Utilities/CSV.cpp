@@ -2,10 +2,12 @@
 
 
 #include "CSV.h"
+#include "BinaryTable.h"
 #include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <numeric>
 #include <regex>
@@ -67,6 +69,46 @@ void CSVReader::doStateAction(state s, char c, const std::string& line, const in
   }
 }
 
+bool CSVReader::parseSimpleLine(const char *begin, const char *end,
+                                std::vector<std::string> &fields) const {
+  const char *c = begin;
+  while (true) {
+    if (c != end && *c == quotation_) { // quoted field, up to the next quote
+      const char *close = std::find(c + 1, end, quotation_);
+      if (close == end) {
+        return false;
+      }
+      fields.emplace_back(c + 1, close);
+      c = close + 1;
+    } else { // plain field, up to the next delimiter
+      const char *start = c;
+      while (c != end && *c != delimiter_) {
+        if (*c == ' ' || *c == quotation_) {
+          return false;
+        }
+        c++;
+      }
+      fields.emplace_back(start, c);
+    }
+    if (c == end) {
+      return true;
+    }
+    if (*c != delimiter_) {
+      return false;
+    }
+    c++;
+  }
+}
+
+void CSVReader::parseLine(const char *begin, const char *end,
+                          std::vector<std::string> &fields) {
+  fields.clear();
+  if (parseSimpleLine(begin, end, fields)) {
+    return;
+  }
+  fields = parseLine(std::string(begin, end));
+}
+
 std::vector<std::string> CSVReader::parseLine(const std::string &s) {
   fields_.clear();
    	state curr = state::precw;
@@ -91,92 +133,124 @@ std::vector<std::string> CSVReader::parseLine(const std::string &s) {
   return fields_;
 }
 
-std::vector<std::string> CSV::singleColumn(std::string column) {
+size_t CSV::columnIndex(const std::string &column) const {
+  auto found = std::find(std::begin(column_names_), std::end(column_names_), column);
+  if (found == std::end(column_names_)) {
+    std::cout << " Error : could not find column " << column
+              << " in file " << file_name_ << std::endl;
+    exit(1);
+  }
+  return found - std::begin(column_names_);
+}
+
+const std::unordered_map<std::string, size_t> &
+CSV::index(size_t column_index) const {
+  auto found = indexes_.find(column_index);
+  if (found != indexes_.end()) {
+    return found->second;
+  }
+  auto &column_index_map = indexes_[column_index];
+  column_index_map.reserve(rows_.size());
+  for (size_t r = 0; r < rows_.size(); r++) {
+    auto inserted = column_index_map.emplace(rows_[r][column_index], r);
+    if (!inserted.second) {
+      inserted.first->second = multipleRows;
+    }
+  }
+  return column_index_map;
+}
+
+std::vector<std::string> CSV::singleColumn(const std::string &column) const {
   if (!hasColumn(column)) {
     std::cout << " Error : could not find column " << column
               << " to merge from file " << file_name_ << std::endl;
     exit(1);
   }
 
-  auto const column_index =
-      std::find(std::begin(column_names_), std::end(column_names_), column) -
-      std::begin(column_names_);
+  auto const column_index = columnIndex(column);
 
   std::vector<std::string> values;
+  values.reserve(rows_.size());
   std::transform(std::begin(rows_), std::end(rows_), std::back_inserter(values),
                  [column_index](auto const &row) { return row[column_index]; }); // row type: vec<vecv<string>>
 
   return values;
 }
 
-std::string CSV::lookUp(std::string lookup_column, std::string value,
-                        std::string return_column) const {
-
-  if (!hasColumn(lookup_column)) {
-    std::cout << " Error : could not find column " << lookup_column
-              << " in file " << file_name_ << std::endl;
-    exit(1);
-  }
-
-  if (!hasColumn(return_column)) {
-    std::cout << " Error : could not find column " << return_column
-              << " in file " << file_name_ << std::endl;
-    exit(1);
-  }
+size_t CSV::lookUpRow(const std::string &lookup_column,
+                      const std::string &value) const {
+  auto &value_rows = index(columnIndex(lookup_column));
+  auto found = value_rows.find(value);
 
-  // find position of lookup column
-  auto const column_index =
-      std::find(std::begin(column_names_), std::end(column_names_), lookup_column) -
-      std::begin(column_names_);
-
-  // find number of values in lookup column
-  auto const value_count = std::count_if(
-      std::begin(rows_), std::end(rows_),
-      [value, column_index](auto &row) { return row[column_index] == value; }); // row type: vec<vecv<string>>
-
-  if (!value_count) {
+  if (found == value_rows.end()) {
     std::cout << "Error : could not find requested lookup value" << value
               << " from column " << lookup_column << " from file " << file_name_
               << std::endl;
     exit(1);
   }
 
-  if (value_count > 1) {
+  if (found->second == multipleRows) {
     std::cout << "Error : multiple entries found for requested lookup value"
               << value << " from column " << lookup_column << " from file "
               << file_name_ << std::endl;
     exit(1);
   }
 
-  // find row where lookup column has value
-  auto const value_index = std::find_if(std::begin(rows_), std::end(rows_),
-                                      [value, column_index](auto &row) { // row type: vec<vecv<string>>
-                                        return row[column_index] == value;
-                                 }) -
-                         std::begin(rows_);
+  return found->second;
+}
 
-  // find position of return column
-  auto const return_index =
-      std::find(std::begin(column_names_), std::end(column_names_), return_column) -
-      std::begin(column_names_);
+std::string CSV::lookUp(const std::string &lookup_column, const std::string &value,
+                        const std::string &return_column) const {
+  // check both columns before looking for the value
+  columnIndex(lookup_column);
+  auto const return_index = columnIndex(return_column);
 
-  return rows_[value_index][return_index];
+  return rows_[lookUpRow(lookup_column, value)][return_index];
 }
 
 CSV::CSV(std::string fn, char s, char se) : file_name_(fn), reader_(s, se) {
 
-  std::ifstream file(file_name_);
-  if (!file.is_open()) {
-    std::cout << " Error: cannot open csv file "
-              << file_name_ << std::endl;
-    exit(1);
-  }
-
-  std::string raw_line;
+  if (BinaryTable::isBinaryTableFile(file_name_)) {
+    // a binary table holds the same cells as the csv file would
+    BinaryTable::read(file_name_, column_names_, rows_);
+  } else {
+    std::ifstream file(file_name_, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+      std::cout << " Error: cannot open csv file "
+                << file_name_ << std::endl;
+      exit(1);
+    }
 
-  // read header line
-  getline(file, raw_line);
-  column_names_ = reader_.parseLine(raw_line);
+    // read the whole file at once and split it into lines in memory
+    std::string contents((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+    const char *line = contents.data();
+    const char *end = line + contents.size();
+    const char *line_end = std::find(line, end, '\n');
+    // the file is read as binary, so a line ending in \r\n (as written on
+    // Windows) still has its \r, which is not part of the last field
+    auto withoutCR = [](const char *line, const char *line_end) {
+      return (line_end > line && line_end[-1] == '\r') ? line_end - 1 : line_end;
+    };
+
+    // read header line
+    reader_.parseLine(line, withoutCR(line, line_end), column_names_);
+
+    // read remaining rows
+    rows_.reserve(std::count(line, end, '\n'));
+    while (line_end != end && line_end + 1 != end) {
+      line = line_end + 1;
+      line_end = std::find(line, end, '\n');
+      rows_.emplace_back();
+      reader_.parseLine(line, withoutCR(line, line_end), rows_.back());
+      // ensure all rows have correct number of columns
+      if (column_names_.size() != rows_.back().size()) {
+        std::cout << " Error: incorrect number of columns in CSV file "
+                  << file_name_ << std::endl;
+        exit(1);
+      }
+    }
+  }
 
   // ensure column names are unique
   std::set<std::string> uniq_headers(std::begin(column_names_), std::end(column_names_));
@@ -185,21 +259,9 @@ CSV::CSV(std::string fn, char s, char se) : file_name_(fn), reader_(s, se) {
               << " does not have unique Header names" << std::endl;
     exit(1);
   }
-
-  // read remaining rows
-  while (getline(file, raw_line)) {
-    auto data_line = reader_.parseLine(raw_line);
-    // ensure all rows have correct number of columns
-    if (column_names_.size() != data_line.size()) {
-      std::cout << " Error: incorrect number of columns in CSV file "
-                << file_name_ << std::endl;
-      exit(1);
-    }
-    rows_.push_back(data_line);
-  }
 }
 
-void CSV::merge(CSV merge_csv, std::string column) {
+void CSV::merge(const CSV &merge_csv, const std::string &column) {
 
   if (!hasColumn(column)) {
     std::cout << " Error : could not find column " << column << " in file "
@@ -213,10 +275,11 @@ void CSV::merge(CSV merge_csv, std::string column) {
     exit(1);
   }
 
+  // find position of lookup column
+  auto const column_index = columnIndex(column);
+
   // ensure lookup column has distinct values
-  auto lookop_column = singleColumn(column);
-  std::set<std::string> lookup_values(std::begin(lookop_column),
-                                      std::end(lookop_column));
+  auto &lookup_values = index(column_index);
   if (lookup_values.size() != rows_.size()) {
     std::cout << "Error: CSV file " << file_name_
               << " does not have unique values in column " << column
@@ -225,33 +288,37 @@ void CSV::merge(CSV merge_csv, std::string column) {
   }
 
   // ensure column in second file has matching values for all values in this
-  // file
-  auto merge_column = merge_csv.singleColumn(column);
-  std::set<std::string> merge_values(std::begin(merge_column),
-                                     std::end(merge_column));
-  if (!std::includes(std::begin(merge_values), std::end(merge_values),
-                     std::begin(lookup_values), std::end(lookup_values))) {
-    std::cout << "Error: CSV file " << merge_csv.fileName()
-              << " does not have some matching values for column " << column
-              << std::endl;
-    exit(1);
+  // file, and find the row in the second file for each row in this file
+  auto &merge_values = merge_csv.index(merge_csv.columnIndex(column));
+  std::vector<size_t> merge_rows(rows_.size());
+  for (size_t r = 0; r < rows_.size(); r++) {
+    auto found = merge_values.find(rows_[r][column_index]);
+    if (found == merge_values.end()) {
+      std::cout << "Error: CSV file " << merge_csv.fileName()
+                << " does not have some matching values for column " << column
+                << std::endl;
+      exit(1);
+    }
+    if (found->second == multipleRows) {
+      std::cout << "Error : multiple entries found for requested lookup value"
+                << rows_[r][column_index] << " from column " << column
+                << " from file " << merge_csv.fileName() << std::endl;
+      exit(1);
+    }
+    merge_rows[r] = found->second;
   }
 
-  // find position of lookup column
-  auto const column_index =
-      std::find(std::begin(column_names_), std::end(column_names_), column) -
-      std::begin(column_names_);
-
   // merge columns from second file
-  for (auto const &merge_column : merge_csv.column_names()) {
+  for (size_t c = 0; c < merge_csv.column_names_.size(); c++) {
+    auto const &merge_column = merge_csv.column_names_[c];
     // only add additional columns
     if (std::find(std::begin(column_names_), std::end(column_names_), merge_column) ==
         std::end(column_names_)) {
       column_names_.push_back(merge_column);
       // for each column add value to every row
-      for (auto &row : rows_) // row type: vec<vec<string>>
-        row.push_back(merge_csv.lookUp(column, row[column_index], merge_column));
+      for (size_t r = 0; r < rows_.size(); r++) {
+        rows_[r].push_back(merge_csv.rows_[merge_rows[r]][c]);
+      }
     }
   }
 }
-
@@ -10,6 +10,7 @@
 #include <regex>
 #include <set>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 #include <array>
 
@@ -53,17 +54,29 @@ class CSVReader {
   void doStateAction(state, char, const std::string&, const int&);
   void showLineAndErrorChar(const std::string&, const int&);
 
+  // split lines where every field is either plain (no spaces or quotes) or
+  // completely quoted (no quotes inside) without going through the state
+  // machine. returns false (and fields is incomplete) for any other line
+  bool parseSimpleLine(const char *begin, const char *end,
+                       std::vector<std::string> &fields) const;
+
 public:
   CSVReader() = default ;
   CSVReader(char d) : delimiter_(d) {}
   CSVReader(char d, char oq) : delimiter_(d), quotation_(oq) {}
   std::vector<std::string> parseLine(const std::string &);
+  // parse the line [begin,end) into fields
+  void parseLine(const char *begin, const char *end,
+                 std::vector<std::string> &fields);
 };
 
 // parses a csv file and stores in memory.
 // the first line of the file is treated as the column headers
 // The delimiter and quotation character can be specified:
 // by default  , and "
+// The file is read with one read and split into lines in memory. lookUp
+// builds a hash index (value -> row) for the lookup column the first time that
+// column is used, so looking up every row of a file is linear, not quadratic.
 class CSV {
 
   // to do the reading
@@ -75,6 +88,16 @@ class CSV {
 
   std::string file_name_;
 
+  // value -> row for each column that has been used with lookUp (a row of
+  // multipleRows means the value is in more than one row)
+  static const size_t multipleRows = static_cast<size_t>(-1);
+  mutable std::map<size_t, std::unordered_map<std::string, size_t>> indexes_;
+
+  // position of column in column_names_ (exits if it is not there)
+  size_t columnIndex(const std::string &column) const;
+  // the index for a column, built the first time it is asked for
+  const std::unordered_map<std::string, size_t> &index(size_t column_index) const;
+
 public:
   CSV(std::string fn, char s, char se);
   CSV(std::string fn) : CSV(fn, ',', '"') {}
@@ -94,19 +117,29 @@ public:
   // return all rows in the file
   std::vector<std::vector<std::string>> rows() const { return rows_; }
 
+  // return one row (values in the same order as column_names())
+  const std::vector<std::string> &row(size_t row_index) const {
+    return rows_[row_index];
+  }
+
   // return all values corresponding to a single column
-  std::vector<std::string> singleColumn(std::string column);
+  std::vector<std::string> singleColumn(const std::string &column) const;
 
   // look up a value in a column and return the value in the corresponding row
   // of the other column
-  std::string lookUp(std::string lookup_column, std::string value,
-                     std::string return_column) const;
+  std::string lookUp(const std::string &lookup_column, const std::string &value,
+                     const std::string &return_column) const;
+
+  // return the row where lookup_column has value (exits if there is not
+  // exactly one such row)
+  size_t lookUpRow(const std::string &lookup_column,
+                   const std::string &value) const;
 
   // merges another csv file. Only extra columns are added. All values in the
   // specified column must also exist in the same column in the other file.
   // only rows in the other file that have matching values in this
   // file are merged
-  void merge(CSV csv, std::string column);
+  void merge(const CSV &csv, const std::string &column);
 
   // check existence of a column
   bool hasColumn(std::string name) const {
@@ -0,0 +1,256 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+// ChunkedVector is a list of values stored as a row of ref-counted blocks
+// (about blockSize values each). Copying a ChunkedVector only copies the
+// block pointers, so a copy shares all of its blocks with the original until
+// one of them writes to a block, which then gets its own copy of that block
+// (copy on write). An offspring genome made by copying its parent and then
+// mutating a few sites therefore costs a few blocks, not a whole genome.
+// insert and erase split and rebuild only the blocks at their ends; the
+// blocks in between are moved (or shared from the source) as pointers.
+// get and set find the block with a binary search over block starts. Callers
+// which walk through the values in order can pass a hint (the block used by
+// their last call) so that most lookups skip the search.
+// Blocks are allocated from Pool (see Pool.h), so the blocks of genomes that
+// die are reused by the genomes of the next generation.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <Utilities/Pool.h>
+
+template <class T> class ChunkedVector {
+public:
+  static const size_t blockSize = 256;
+
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+
+  T get(size_t index) const {
+    size_t block = findBlock(index);
+    return static_cast<T>((*blocks[block])[index - starts[block]]);
+  }
+
+  T get(size_t index, size_t &hint) const {
+    if (!inBlock(index, hint)) {
+      hint = findBlock(index);
+    }
+    return static_cast<T>((*blocks[hint])[index - starts[hint]]);
+  }
+
+  void set(size_t index, T value) {
+    size_t block = findBlock(index);
+    writable(block)[index - starts[block]] = value;
+  }
+
+  void set(size_t index, T value, size_t &hint) {
+    if (!inBlock(index, hint)) {
+      hint = findBlock(index);
+    }
+    writable(hint)[index - starts[hint]] = value;
+  }
+
+  void push_back(T value) {
+    if (blocks.empty() || blocks.back()->size() >= blockSize) {
+      starts.push_back(count);
+      blocks.push_back(Pool::make<Block>());
+      blocks.back()->reserve(blockSize);
+    }
+    writable(blocks.size() - 1).push_back(value);
+    count++;
+  }
+
+  void clear() {
+    blocks.clear();
+    starts.clear();
+    count = 0;
+  }
+
+  // new values (if any) are T()
+  void resize(size_t newSize) {
+    if (newSize < count) {
+      erase(newSize, count);
+    }
+    while (count < newSize) {
+      push_back(T());
+    }
+  }
+
+  // insert values [begin, end) of from in front of position. from may be
+  // this ChunkedVector. Blocks of from which are wholly inside the range are
+  // shared, not copied.
+  void insert(size_t position, const ChunkedVector &from, size_t begin,
+              size_t end) {
+    if (begin >= end) {
+      return;
+    }
+    BlockList pieces;
+    size_t block = from.findBlock(begin);
+    while (begin < end) {
+      const auto &source = from.blocks[block];
+      size_t first = begin - from.starts[block];
+      size_t last = std::min(source->size(), end - from.starts[block]);
+      if (first == 0 && last == source->size()) {
+        pieces.push_back(source);
+      } else {
+        pieces.push_back(Pool::make<Block>(source->begin() + first,
+                                                 source->begin() + last));
+      }
+      begin += last - first;
+      block++;
+    }
+    size_t at = splitAt(position);
+    blocks.insert(blocks.begin() + at, pieces.begin(), pieces.end());
+    recount();
+    mergeSmallBlocks(at == 0 ? 0 : at - 1, at + pieces.size());
+  }
+
+  // remove values [begin, end)
+  void erase(size_t begin, size_t end) {
+    if (begin >= end) {
+      return;
+    }
+    size_t first = splitAt(begin);
+    size_t last = splitAt(end);
+    blocks.erase(blocks.begin() + first, blocks.begin() + last);
+    recount();
+    mergeSmallBlocks(first == 0 ? 0 : first - 1, first);
+  }
+
+  // values [begin, end) as a new ChunkedVector (sharing whole blocks)
+  ChunkedVector slice(size_t begin, size_t end) const {
+    ChunkedVector segment;
+    segment.insert(0, *this, begin, end);
+    return segment;
+  }
+
+  // call f(value) for each value, in order
+  template <class F> void forEach(F f) const {
+    for (auto const &block : blocks) {
+      for (auto value : *block) {
+        f(static_cast<T>(value));
+      }
+    }
+  }
+
+  size_t blockCount() const { return blocks.size(); }
+
+  // number of blocks held by both this and other
+  size_t sharedBlockCount(const ChunkedVector &other) const {
+    size_t shared = 0;
+    for (auto const &block : blocks) {
+      for (auto const &otherBlock : other.blocks) {
+        if (block == otherBlock) {
+          shared++;
+          break;
+        }
+      }
+    }
+    return shared;
+  }
+
+private:
+  // (std::vector<bool> packs bits and can not hand out plain values)
+  using Value = typename std::conditional<std::is_same<T, bool>::value,
+                                          unsigned char, T>::type;
+  using Block = std::vector<Value, Pool::Allocator<Value>>;
+  using BlockList =
+      std::vector<std::shared_ptr<Block>, Pool::Allocator<std::shared_ptr<Block>>>;
+
+  BlockList blocks;
+  std::vector<size_t, Pool::Allocator<size_t>> starts; // index of the first value in each block
+  size_t count = 0;
+
+  bool inBlock(size_t index, size_t block) const {
+    return block < blocks.size() && index >= starts[block] &&
+           index - starts[block] < blocks[block]->size();
+  }
+
+  size_t findBlock(size_t index) const {
+    return static_cast<size_t>(
+               std::upper_bound(starts.begin(), starts.end(), index) -
+               starts.begin()) -
+           1;
+  }
+
+  // the block, copied first if it is shared with another ChunkedVector
+  Block &writable(size_t block) {
+    if (blocks[block].use_count() > 1) {
+      blocks[block] = Pool::make<Block>(*blocks[block]);
+    }
+    return *blocks[block];
+  }
+
+  void recount() {
+    starts.resize(blocks.size());
+    count = 0;
+    for (size_t block = 0; block < blocks.size(); block++) {
+      starts[block] = count;
+      count += blocks[block]->size();
+    }
+  }
+
+  // make position the start of a block (splitting the block holding it),
+  // and return that block (blockCount() if position is the end)
+  size_t splitAt(size_t position) {
+    if (position >= count) {
+      return blocks.size();
+    }
+    size_t block = findBlock(position);
+    size_t offset = position - starts[block];
+    if (offset == 0) {
+      return block;
+    }
+    const Block &source = *blocks[block];
+    auto head = Pool::make<Block>(source.begin(), source.begin() + offset);
+    auto tail = Pool::make<Block>(source.begin() + offset, source.end());
+    blocks[block] = head;
+    blocks.insert(blocks.begin() + block + 1, tail);
+    recount();
+    return block + 1;
+  }
+
+  // merge neighbouring blocks in [first, last] where one is under half of
+  // blockSize, so that repeated inserts and erases do not leave the row
+  // fragmented into tiny blocks
+  void mergeSmallBlocks(size_t first, size_t last) {
+    last = std::min(last, blocks.size());
+    bool merged = false;
+    size_t block = first;
+    while (block + 1 < blocks.size() && block < last) {
+      size_t here = blocks[block]->size();
+      size_t next = blocks[block + 1]->size();
+      if ((here < blockSize / 2 || next < blockSize / 2) &&
+          here + next <= 2 * blockSize) {
+        auto joined = Pool::make<Block>();
+        joined->reserve(here + next);
+        joined->insert(joined->end(), blocks[block]->begin(),
+                       blocks[block]->end());
+        joined->insert(joined->end(), blocks[block + 1]->begin(),
+                       blocks[block + 1]->end());
+        blocks[block] = joined;
+        blocks.erase(blocks.begin() + block + 1);
+        last--;
+        merged = true;
+      } else {
+        block++;
+      }
+    }
+    if (merged) {
+      recount();
+    }
+  }
+};
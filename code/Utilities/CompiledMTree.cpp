@@ -0,0 +1,433 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include "CompiledMTree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <typeinfo>
+
+#include "../Global.h"
+
+bool CompiledMTree::compile(std::shared_ptr<Abstract_MTree> _tree) {
+  tree = _tree;
+  program.clear();
+  stackSize = 0;
+  maskCount = 1;
+  int depth = 0;
+  int maskDepth = 0;
+  if (tree == nullptr || !compileNode(tree, depth, maskDepth)) {
+    program.clear();
+    return false;
+  }
+  return true;
+}
+
+bool CompiledMTree::compileNode(const std::shared_ptr<Abstract_MTree> &node,
+                                int &depth, int &maskDepth) {
+  Instruction instruction;
+  instruction.branchCount = static_cast<int>(node->branches.size());
+  instruction.keyID = -1;
+  instruction.value = 0;
+
+  // (typeid rather than dynamic_cast, so that nodes derived from these are
+  // not compiled with the wrong function)
+  auto &nodeType = typeid(*node);
+  auto branchesAre = [&](std::initializer_list<int> counts) {
+    return std::find(counts.begin(), counts.end(), instruction.branchCount) !=
+           counts.end();
+  };
+  bool known = true;
+  if (nodeType == typeid(CONST_MTree)) {
+    instruction.op = CONST;
+    instruction.value = std::static_pointer_cast<CONST_MTree>(node)->value;
+  } else if (nodeType == typeid(fromDataMapAve_MTree)) {
+    instruction.op = DM_AVE;
+    instruction.keyID = std::static_pointer_cast<fromDataMapAve_MTree>(node)->keyID;
+  } else if (nodeType == typeid(fromDataMapSum_MTree)) {
+    instruction.op = DM_SUM;
+    instruction.keyID = std::static_pointer_cast<fromDataMapSum_MTree>(node)->keyID;
+  } else if (nodeType == typeid(UPDATE_MTree)) {
+    instruction.op = UPDATE;
+  } else if (nodeType == typeid(SUM_MTree)) {
+    instruction.op = SUM;
+  } else if (nodeType == typeid(MULT_MTree)) {
+    instruction.op = MULT;
+  } else if (nodeType == typeid(SUBTRACT_MTree)) {
+    instruction.op = SUBTRACT;
+    known = branchesAre({2});
+  } else if (nodeType == typeid(DIVIDE_MTree)) {
+    instruction.op = DIVIDE;
+    known = branchesAre({2});
+  } else if (nodeType == typeid(POW_MTree)) {
+    instruction.op = POW;
+    known = branchesAre({2});
+  } else if (nodeType == typeid(MOD_MTree)) {
+    instruction.op = MOD;
+    known = branchesAre({2});
+  } else if (nodeType == typeid(MIN_MTree)) {
+    instruction.op = MIN;
+    known = instruction.branchCount > 0;
+  } else if (nodeType == typeid(MAX_MTree)) {
+    instruction.op = MAX;
+    known = instruction.branchCount > 0;
+  } else if (nodeType == typeid(ABS_MTree)) {
+    instruction.op = ABS;
+    known = branchesAre({1});
+  } else if (nodeType == typeid(SIN_MTree)) {
+    instruction.op = SIN;
+    known = branchesAre({1});
+  } else if (nodeType == typeid(COS_MTree)) {
+    instruction.op = COS;
+    known = branchesAre({1});
+  } else if (nodeType == typeid(IF_MTree)) {
+    instruction.op = IF;
+    known = branchesAre({3});
+  } else if (nodeType == typeid(REMAP_MTree)) {
+    instruction.op = REMAP;
+    known = branchesAre({1, 3, 5});
+  } else if (nodeType == typeid(SIGMOID_MTree)) {
+    instruction.op = SIGMOID;
+    known = branchesAre({2, 4});
+  } else if (nodeType == typeid(VECT_MTree)) {
+    instruction.op = VECT;
+    known = branchesAre({2});
+  } else { // RANDOM, MANY, ...
+    known = false;
+  }
+  if (!known || (instruction.op <= UPDATE && instruction.branchCount != 0)) {
+    return false;
+  }
+
+  auto &branches = node->branches;
+  if (instruction.op == IF) {
+    if (!compileNode(branches[0], depth, maskDepth)) {
+      return false;
+    }
+    push(THEN, maskDepth);
+    if (!compileNode(branches[1], depth, maskDepth)) {
+      return false;
+    }
+    push(ELSE, maskDepth);
+    if (!compileNode(branches[2], depth, maskDepth)) {
+      return false;
+    }
+    maskDepth--;
+  } else if (instruction.op == DIVIDE) { // (denominator first)
+    if (!compileNode(branches[1], depth, maskDepth)) {
+      return false;
+    }
+    push(NONZERO, maskDepth);
+    if (!compileNode(branches[0], depth, maskDepth)) {
+      return false;
+    }
+    maskDepth--;
+  } else {
+    for (auto &branch : branches) {
+      if (!compileNode(branch, depth, maskDepth)) {
+        return false;
+      }
+    }
+  }
+  // the branches' values are replaced by this node's value
+  depth += 1 - instruction.branchCount;
+  stackSize = std::max(stackSize, depth);
+  program.push_back(instruction);
+  return true;
+}
+
+void CompiledMTree::push(Op op, int &maskDepth) {
+  if (op != ELSE) { // (ELSE replaces the mask THEN made)
+    maskDepth++;
+    maskCount = std::max(maskCount, maskDepth + 1);
+  }
+  program.push_back({op, 0, -1, 0});
+}
+
+double CompiledMTree::eval(DataMap &dataMap,
+                           const std::shared_ptr<ParametersTable> &PT,
+                           const std::vector<std::vector<double>> &vectorData) {
+  if (program.empty()) {
+    return tree->eval(dataMap, PT, vectorData)[0];
+  }
+  DataMap *dataMaps[1] = {&dataMap};
+  double score;
+  run(dataMaps, 1, vectorData, &score);
+  if (missing[0]) {
+    return tree->eval(dataMap, PT, vectorData)[0];
+  }
+  return score;
+}
+
+void CompiledMTree::evalBatch(DataMap *const *dataMaps, int count,
+                              const std::shared_ptr<ParametersTable> &PT,
+                              double *scores) {
+  if (program.empty()) {
+    for (int i = 0; i < count; i++) {
+      scores[i] = tree->eval(*dataMaps[i], PT)[0];
+    }
+    return;
+  }
+  run(dataMaps, count, {}, scores);
+  for (int i = 0; i < count; i++) {
+    if (missing[i]) {
+      scores[i] = tree->eval(*dataMaps[i], PT)[0];
+    }
+  }
+}
+
+void CompiledMTree::run(DataMap *const *dataMaps, int count,
+                        const std::vector<std::vector<double>> &vectorData,
+                        double *scores) {
+  stack.resize(static_cast<size_t>(stackSize) * count);
+  missing.assign(count, 0);
+  masks.resize(static_cast<size_t>(maskCount) * count);
+  std::fill(masks.begin(), masks.begin() + count, 1);
+  // the values below top are slots 0 .. top-1, and the active mask is level
+  int top = 0;
+  int level = 0;
+  auto slot = [&](int s) { return stack.data() + static_cast<size_t>(s) * count; };
+  auto mask = [&](int m) { return masks.data() + static_cast<size_t>(m) * count; };
+
+  // every case does what the matching MTree node's eval does, with the same
+  // operations in the same order
+  for (const Instruction &instruction : program) {
+    const int first = top - instruction.branchCount; // slot of branches[0]
+    double *result = slot(first);
+    const char *active = mask(level);
+    switch (instruction.op) {
+    case CONST:
+      std::fill(result, result + count, instruction.value);
+      break;
+    case DM_AVE:
+      for (int i = 0; i < count; i++) {
+        if (!active[i]) {
+          result[i] = 0;
+        } else if (!dataMaps[i]->tryGetAverage(instruction.keyID, result[i])) {
+          missing[i] = 1;
+          result[i] = 0;
+        }
+      }
+      break;
+    case DM_SUM:
+      for (int i = 0; i < count; i++) {
+        if (!active[i]) {
+          result[i] = 0;
+        } else if (!dataMaps[i]->tryGetSum(instruction.keyID, result[i])) {
+          missing[i] = 1;
+          result[i] = 0;
+        }
+      }
+      break;
+    case UPDATE:
+      std::fill(result, result + count, (double)Global::update);
+      break;
+    case SUM:
+      if (instruction.branchCount == 0) {
+        std::fill(result, result + count, 0.0);
+        break;
+      }
+      for (int i = 0; i < count; i++) {
+        result[i] = 0.0 + result[i];
+      }
+      for (int b = 1; b < instruction.branchCount; b++) {
+        const double *branch = slot(first + b);
+        for (int i = 0; i < count; i++) {
+          result[i] += branch[i];
+        }
+      }
+      break;
+    case MULT:
+      if (instruction.branchCount == 0) {
+        std::fill(result, result + count, 1.0);
+        break;
+      }
+      for (int i = 0; i < count; i++) {
+        result[i] = 1.0 * result[i];
+      }
+      for (int b = 1; b < instruction.branchCount; b++) {
+        const double *branch = slot(first + b);
+        for (int i = 0; i < count; i++) {
+          result[i] *= branch[i];
+        }
+      }
+      break;
+    case SUBTRACT: {
+      const double *b1 = slot(first + 1);
+      for (int i = 0; i < count; i++) {
+        result[i] = result[i] - b1[i];
+      }
+      break;
+    }
+    case DIVIDE: { // (the denominator is in branches[0]'s slot, see compile)
+      const double *numerator = slot(first + 1);
+      for (int i = 0; i < count; i++) {
+        const double denominator = result[i];
+        result[i] = (denominator == 0) ? 0 : numerator[i] / denominator;
+      }
+      level--;
+      break;
+    }
+    case POW: {
+      const double *b1 = slot(first + 1);
+      for (int i = 0; i < count; i++) {
+        result[i] = pow(result[i], b1[i]);
+      }
+      break;
+    }
+    case MOD: {
+      const double *b1 = slot(first + 1);
+      for (int i = 0; i < count; i++) {
+        if (!active[i]) { // (the values may not fit in an int)
+          result[i] = 0;
+          continue;
+        }
+        int temp = ((int)b1[i] == 0) ? (int)1 : (int)b1[i];
+        result[i] = (int)result[i] % temp;
+      }
+      break;
+    }
+    case MIN:
+      for (int b = 1; b < instruction.branchCount; b++) {
+        const double *branch = slot(first + b);
+        for (int i = 0; i < count; i++) {
+          result[i] = std::min(result[i], branch[i]);
+        }
+      }
+      break;
+    case MAX:
+      for (int b = 1; b < instruction.branchCount; b++) {
+        const double *branch = slot(first + b);
+        for (int i = 0; i < count; i++) {
+          result[i] = std::max(result[i], branch[i]);
+        }
+      }
+      break;
+    case ABS:
+      for (int i = 0; i < count; i++) {
+        result[i] = std::abs(result[i]);
+      }
+      break;
+    case SIN:
+      for (int i = 0; i < count; i++) {
+        result[i] = sin(result[i]);
+      }
+      break;
+    case COS:
+      for (int i = 0; i < count; i++) {
+        result[i] = cos(result[i]);
+      }
+      break;
+    case IF: {
+      const double *b1 = slot(first + 1);
+      const double *b2 = slot(first + 2);
+      for (int i = 0; i < count; i++) {
+        result[i] = (result[i] > 0) ? b1[i] : b2[i];
+      }
+      level--;
+      break;
+    }
+    case REMAP: {
+      const bool oldRange = instruction.branchCount > 2;
+      const bool newRange = instruction.branchCount > 4;
+      for (int i = 0; i < count; i++) {
+        double v = result[i];
+        double oldMin = oldRange ? slot(first + 1)[i] : 0;
+        double oldMax = oldRange ? slot(first + 2)[i] : 1;
+        double newMin = newRange ? slot(first + 3)[i] : 0;
+        double newMax = newRange ? slot(first + 4)[i] : 1;
+        // if min and max are the same, return middle of new range
+        if (oldMax == oldMin) {
+          result[i] = ((newMax + newMin) / 2);
+        } else {
+          result[i] = ((std::max(std::min(v, oldMax), oldMin) - oldMin) *
+                       (1 / (oldMax - oldMin)) * (newMax - newMin)) +
+                      newMin;
+        }
+      }
+      break;
+    }
+    case SIGMOID: {
+      const double *exponent = slot(first + 1);
+      for (int i = 0; i < count; i++) {
+        double v = result[i];
+        double e = exponent[i];
+        if (instruction.branchCount > 2) { // if oldMin/oldMax are provided, use them
+          double oldMin = slot(first + 2)[i];
+          double oldMax = slot(first + 3)[i];
+          v = ((std::max(std::min(v, oldMax), oldMin)) - oldMin) * (1 / (oldMax - oldMin));
+        } else { // if not, clamp to [0,1]
+          v = std::max(std::min(v, 1.0), 0.0);
+        }
+        if (v <= .5) {
+          result[i] = pow(v * 2, e) / 2;
+        } else {
+          result[i] = 1 - pow((1 - v) * 2, e) / 2;
+        }
+      }
+      break;
+    }
+    case VECT: {
+      const double *b1 = slot(first + 1);
+      for (int i = 0; i < count; i++) {
+        if (!active[i]) {
+          result[i] = 0;
+          continue;
+        }
+        // (with no values to pick from the tree would fail, let it)
+        if (vectorData.empty()) {
+          missing[i] = 1;
+          result[i] = 0;
+          continue;
+        }
+        int whichVect = std::max(0, (int)result[i] % (int)vectorData.size());
+        if (vectorData[whichVect].empty()) {
+          missing[i] = 1;
+          result[i] = 0;
+          continue;
+        }
+        int whichVal =
+            std::max(0, (int)b1[i] % (int)vectorData[whichVect].size());
+        result[i] = vectorData[whichVect][whichVal];
+      }
+      break;
+    }
+    case THEN: { // the condition is on top
+      const double *condition = slot(top - 1);
+      char *branchActive = mask(level + 1);
+      for (int i = 0; i < count; i++) {
+        branchActive[i] = active[i] && condition[i] > 0;
+      }
+      level++;
+      continue; // (the stack is unchanged)
+    }
+    case ELSE: { // the condition is under the value of branches[1]
+      const double *condition = slot(top - 2);
+      const char *parentActive = mask(level - 1);
+      char *branchActive = mask(level);
+      for (int i = 0; i < count; i++) {
+        branchActive[i] = parentActive[i] && !(condition[i] > 0);
+      }
+      continue;
+    }
+    case NONZERO: { // the denominator is on top
+      const double *denominator = slot(top - 1);
+      char *branchActive = mask(level + 1);
+      for (int i = 0; i < count; i++) {
+        branchActive[i] = active[i] && denominator[i] != 0;
+      }
+      level++;
+      continue;
+    }
+    }
+    top = first + 1;
+  }
+  std::copy(stack.begin(), stack.begin() + count, scores);
+}
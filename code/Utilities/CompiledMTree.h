@@ -0,0 +1,109 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+// CompiledMTree evaluates an MTree without walking the tree. compile lowers
+// the tree to a postfix program (constants, data map reads with the key ids
+// already resolved, and one instruction per function node) which is run on a
+// small value stack, so an evaluation makes no virtual calls and allocates no
+// vectors. evalPopulation runs each instruction over every organism before
+// moving to the next one, and writes one score per organism into a
+// contiguous array.
+// Results are exactly those of tree->eval(...)[0]. Like the tree, the program
+// only evaluates the branch IF takes, and skips the numerator of a DIVIDE by
+// 0: each evaluation has a lane in an active mask, the condition (or
+// denominator) narrows the mask for the branch that follows, and a data map
+// read, MOD or VECT does nothing for a lane that is not active (other
+// instructions work out values for every lane, which the lanes not active
+// never use). An evaluation that reads a key which is missing, or a VECT with
+// no values (the tree would fail), is given to the tree instead, which then
+// does whatever it does.
+// Trees with RANDOM or MANY (or any other node type this does not know) are
+// not compiled, and eval and evalPopulation just use the tree.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Data.h"
+#include "MTree.h"
+#include "Parameters.h"
+
+class CompiledMTree {
+public:
+  CompiledMTree() = default;
+  CompiledMTree(std::shared_ptr<Abstract_MTree> _tree) { compile(_tree); }
+
+  // build the program for tree. returns false (and evaluation will use the
+  // tree) if tree has a node that can not be compiled
+  bool compile(std::shared_ptr<Abstract_MTree> _tree);
+  bool isCompiled() const { return !program.empty(); }
+
+  // the same as tree->eval(dataMap, PT, vectorData)[0]
+  double eval(DataMap &dataMap, const std::shared_ptr<ParametersTable> &PT,
+              const std::vector<std::vector<double>> &vectorData = {});
+
+  // scores[i] = eval(*dataMaps[i], PT) for i in [0,count)
+  void evalBatch(DataMap *const *dataMaps, int count,
+                 const std::shared_ptr<ParametersTable> &PT, double *scores);
+
+  // scores gets eval(population[i]->dataMap, PT) for each organism
+  template <class OrganismPtr>
+  void evalPopulation(const std::vector<OrganismPtr> &population,
+                      const std::shared_ptr<ParametersTable> &PT,
+                      std::vector<double> &scores) {
+    batchDataMaps.resize(population.size());
+    for (size_t i = 0; i < population.size(); i++) {
+      batchDataMaps[i] = &population[i]->dataMap;
+    }
+    scores.resize(population.size());
+    evalBatch(batchDataMaps.data(), static_cast<int>(population.size()), PT,
+              scores.data());
+  }
+
+private:
+  enum Op : unsigned char {
+    CONST, DM_AVE, DM_SUM, UPDATE, // push a value
+    SUM, MULT, SUBTRACT, DIVIDE, POW, MOD, MIN, MAX, // branches -> 1 value
+    ABS, SIN, COS, IF, REMAP, SIGMOID, VECT,
+    // these change the active mask and leave the stack as it is. IF is
+    // compiled to condition THEN branches[1] ELSE branches[2] IF, and DIVIDE
+    // to branches[1] NONZERO branches[0] DIVIDE (IF and DIVIDE drop the mask)
+    THEN, ELSE, NONZERO
+  };
+
+  struct Instruction {
+    Op op;
+    int branchCount;        // values taken from the stack
+    DataMap::KeyID keyID;   // DM_AVE, DM_SUM
+    double value;           // CONST
+  };
+
+  bool compileNode(const std::shared_ptr<Abstract_MTree> &node, int &depth,
+                   int &maskDepth);
+  void push(Op op, int &maskDepth); // THEN, ELSE or NONZERO
+
+  // run the program for count data maps. stack slot s of evaluation i is
+  // stack[s * count + i], and mask m (0 has every evaluation) is
+  // masks[m * count + i]. missing[i] is set if evaluation i read a key that
+  // is not in its data map (or VECT had no values to pick from)
+  void run(DataMap *const *dataMaps, int count,
+           const std::vector<std::vector<double>> &vectorData, double *scores);
+
+  std::shared_ptr<Abstract_MTree> tree;
+  std::vector<Instruction> program;
+  int stackSize = 0;
+  int maskCount = 1;
+
+  std::vector<double> stack;
+  std::vector<char> masks;
+  std::vector<char> missing;
+  std::vector<DataMap *> batchDataMaps;
+};
@@ -9,12 +9,15 @@
 //         github.com/Hintzelab/MABE/wiki/License
 
 #include "Data.h"
+#include "Timing.h"
 
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 
 
 // global variables that should be accessible to all
@@ -22,61 +25,221 @@
 
 std::string FileManager::outputPrefix;
 std::map<std::string, std::vector<std::string>> FileManager::fileColumns;
-std::map<std::string, std::ofstream>
-    FileManager::files; // list of files (NAME,ofstream)
 std::map<std::string, bool>
     FileManager::fileStates; // list of files states (NAME,open?)
+AsyncFileWriter FileManager::writer;
+std::mutex FileManager::fileManagerMutex;
+std::map<std::string, BinaryTable::Writer> FileManager::binaryTables;
 std::map<std::string, int> DataMap::knownOutputBehaviors = {
     {"LIST", LIST},     {"AVE", AVE},     {"SUM", SUM}, {"PROD", PROD},
     {"STDERR", STDERR}, {"FIRST", FIRST}, {"VAR", VAR}};
 
 void FileManager::openAndWriteToFile(const std::string &fileName, const std::string &data, const std::string &header) {
-  openFile( fileName, header); // make sure that the file is open and ready to be written to
-  if (!data.empty()) {files[fileName] << data << "\n" << std::flush;}
+  Timing::ScopedTimer timer(Timing::FILE_OUTPUT);
+  std::lock_guard<std::mutex> lock(fileManagerMutex);
+  auto state = fileStates.find(fileName);
+  bool newFile = state == fileStates.end(); // if file has not be initialized yet
+  std::string text;
+  if (newFile && !header.empty()) { // if there is a header string, write this to the new file
+    text = header + "\n";
+  }
+  if (!data.empty()) {
+    text += data + "\n";
+  }
+  if (newFile || !text.empty()) {
+    // a new file is created (cleared) even if there is nothing to write to it,
+    // a closed file is reopened in append mode
+    writer.write(outputPrefix + fileName, std::move(text), newFile);
+  }
+  fileStates[fileName] = true; // this file is now open
 }
 
 [[deprecated("Use openAndWriteToFile() instead.")]]
 void FileManager::writeToFile(const std::string &fileName, const std::string &data, const std::string &header) {
-  openFile( fileName, header); // make sure that the file is open and ready to be written to
-  if (!data.empty()) {files[fileName] << data << "\n" << std::flush;}
-}
-
-void FileManager::openFile(const std::string &fileName, const std::string &header) {
-  if (files.find(fileName) == files.end()) { // if file has not be initialized yet
-    files.emplace(make_pair(fileName, std::ofstream())); // make an ofstream for the new file and place in FileManager::files
-    files[fileName].open(std::string(outputPrefix) + fileName); // clear file contents and open in write mode
-    fileStates[fileName] = true; // this file is now open
-    if (!header.empty()) { // if there is a header string, write this to the new file
-      files[fileName] << header << "\n";
-    }
-  }
-  if (fileStates[fileName] == false) { // if file is closed ...
-    files[fileName].open(std::string(outputPrefix) + fileName, std::ios::out | std::ios::app); // open file in append mode
-  }
+  openAndWriteToFile(fileName, data, header);
 }
 
 void FileManager::closeFile(const std::string &fileName) {
-  if (files.find(fileName) == files.end()) {
+  Timing::ScopedTimer timer(Timing::FILE_OUTPUT);
+  std::lock_guard<std::mutex> lock(fileManagerMutex);
+  if (fileStates.find(fileName) == fileStates.end()) {
     std::cout << "  In FileManager::closeFile :: ERROR, attempt to close file '" << fileName << "' but this file has not been opened or created! Exiting." << std::endl;
     exit(1);
   }
-  files[fileName].close();
+  writeBinaryRows(fileName);
+  writer.close(outputPrefix + fileName);
   fileStates[fileName] = false; // make a note that this file is closed
 }
 
+void FileManager::openAndWriteToBinaryFile(const std::string &fileName,
+                                           const std::vector<std::string> &columnNames,
+                                           std::vector<std::string> cells) {
+  Timing::ScopedTimer timer(Timing::FILE_OUTPUT);
+  std::lock_guard<std::mutex> lock(fileManagerMutex);
+  if (fileStates.find(fileName) == fileStates.end()) { // create (clear) the file
+    writer.write(outputPrefix + fileName, "", true, true);
+  }
+  fileStates[fileName] = true;
+  auto &table = binaryTables[fileName];
+  if (!table.matches(columnNames)) { // the columns changed, start a new chunk
+    writeBinaryRows(fileName);
+  }
+  table.addRow(columnNames, std::move(cells));
+  if (table.full()) {
+    writeBinaryRows(fileName);
+  }
+}
+
+void FileManager::writeBinaryRows(const std::string &fileName) {
+  auto table = binaryTables.find(fileName);
+  if (table != binaryTables.end() && !table->second.empty()) {
+    writer.write(outputPrefix + fileName, table->second.takeChunk(), false, true);
+  }
+}
+
+void FileManager::startAsyncOutput(size_t maxQueuedBytes) {
+  writer.start(maxQueuedBytes);
+}
+
+void FileManager::flush(bool wait) {
+  Timing::ScopedTimer timer(Timing::FILE_OUTPUT);
+  writer.flush(wait);
+}
+
+void FileManager::closeAll() {
+  std::lock_guard<std::mutex> lock(fileManagerMutex);
+  for (auto &table : binaryTables) {
+    writeBinaryRows(table.first);
+  }
+  writer.stop();
+  for (auto &state : fileStates) {
+    state.second = false;
+  }
+}
+
+std::shared_mutex DataMap::keyRegistryMutex;
+std::unordered_map<std::string, DataMap::KeyID> DataMap::keyIDs;
+std::deque<std::string> DataMap::keyNames;
+
+DataMap::KeyID DataMap::lookupKey(const std::string &key) {
+  {
+    std::shared_lock<std::shared_mutex> lock(keyRegistryMutex);
+    auto found = keyIDs.find(key);
+    if (found != keyIDs.end()) {
+      return found->second;
+    }
+  }
+  // key is new (unless another thread added it since we looked)
+  std::unique_lock<std::shared_mutex> lock(keyRegistryMutex);
+  auto inserted = keyIDs.emplace(key, static_cast<KeyID>(keyNames.size()));
+  if (inserted.second) {
+    keyNames.push_back(key);
+  }
+  return inserted.first->second;
+}
+
+const std::string &DataMap::keyName(KeyID keyID) {
+  std::shared_lock<std::shared_mutex> lock(keyRegistryMutex);
+  return keyNames[keyID];
+}
+
 // copy constructor
 DataMap::DataMap(std::shared_ptr<DataMap> source) {
-  boolData = source->boolData;
-  doubleData = source->doubleData;
-  intData = source->intData;
-  stringData = source->stringData;
-  for (auto entry : source->inUse) {
-    inUse[entry.first] = entry.second;
+  entryKeys = source->entryKeys;
+  entries = source->entries;
+}
+
+
+std::string DataMap::listString(dataMapType t, const double *numbers,
+                                size_t numbersCount, const std::string *strings,
+                                size_t stringsCount) {
+  std::string returnString = "";
+  if (listType(t) == STRING) {
+    for (size_t i = 0; i < stringsCount; i++) {
+      returnString += strings[i] + ",";
+    }
+  } else {
+    for (size_t i = 0; i < numbersCount; i++) {
+      returnString += numberToString(t, numbers[i]) + ",";
+    }
   }
-  // inUse = source->inUse; // replaced with for loop.
-  outputBehavior = source->outputBehavior;
+  if (returnString.size() > 2) { // if vector was not empty
+    returnString.pop_back();     // remove trailing ","
+  }
+  return returnString;
 }
 
+void DataMap::checkStringOutputBehavior(const std::string &key, unsigned int OB) {
+  if (!(OB == LIST || OB == FIRST || OB == NO_OUTPUT)) {
+    std::cout << std::endl << OB << std::endl;
+    std::cout << "  in constructHeaderAndDataStrings :: attempt to write "
+            "string not in either LIST or FIRST formatte. This is not "
+            "allowed! Key was '" << key << "'. Exiting..."
+         << std::endl;
+    exit(1);
+  }
+}
+
+void DataMap::appendHeaderAndDataStrings(std::string &headerStr, std::string &dataStr,
+                                         const std::string &key, dataMapType t,
+                                         unsigned int OB, const double *numbers,
+                                         size_t numbersCount,
+                                         const std::string *strings,
+                                         size_t stringsCount) {
+  forEachOutputColumn(key, t, OB, numbers, numbersCount, strings, stringsCount,
+                      [&headerStr, &dataStr](const std::string &columnName,
+                                             const std::string &value, bool quoted) {
+                        headerStr += FileManager::separator + columnName;
+                        dataStr += FileManager::separator;
+                        if (quoted) {
+                          dataStr += "\"" + value + "\"";
+                        } else {
+                          dataStr += value;
+                        }
+                      });
+}
+
+void DataMap::appendHeaderAndDataCells(std::vector<std::string> &columnNames,
+                                       std::vector<std::string> &cells,
+                                       const std::string &key, dataMapType t,
+                                       unsigned int OB, const double *numbers,
+                                       size_t numbersCount,
+                                       const std::string *strings,
+                                       size_t stringsCount) {
+  forEachOutputColumn(key, t, OB, numbers, numbersCount, strings, stringsCount,
+                      [&columnNames, &cells](const std::string &columnName,
+                                             const std::string &value, bool) {
+                        columnNames.push_back(columnName);
+                        cells.push_back(value);
+                      });
+}
+
+DataMap::Entry &DataMap::getOutputEntry(const std::string &key, bool aveOnly,
+                                        unsigned int &OB) {
+  Entry *entry = findEntry(lookupKey(key));
+  if (entry == nullptr || entry->type == NONE) {
+    std::cout << "  in DataMap::writeToFile() - key \"" << key
+         << "\" can not be found in data map!\n  exiting." << std::endl;
+    exit(1);
+  }
+  bool isString = listType(entry->type) == STRING;
+
+  OB = entry->outputBehavior;
+  if (isString) {
+    checkStringOutputBehavior(key, OB);
+  }
+
+  if (aveOnly) {
+    if (isString) {
+      OB = NO_OUTPUT;
+    }
+    else {
+      OB &= (AVE | FIRST); // if aveOnly, only output AVE on the entries
+                           // that have been set for AVE
+    }
+  }
+  return *entry;
+}
 
 // take two strings (header and data), and a list of keys, and whether or not to
 // save "{LIST}"s. convert data from data map to header and data strings
@@ -85,120 +248,33 @@ void DataMap::constructHeaderAndDataStrings(std::string &headerStr, std::string
                                             bool aveOnly) {
   headerStr = ""; // make sure the strings are clean
   dataStr = "";
-  dataMapType typeOfKey;
   unsigned int OB; // holds output behavior so it can be over ridden for ave file output!
   if (!keys.empty()) { // if keys is not empty
     for (auto const &i : keys) {
-      typeOfKey = findKeyInData(i);
-      if (typeOfKey == NONE) {
-        std::cout << "  in DataMap::writeToFile() - key \"" << i
-             << "\" can not be found in data map!\n  exiting." << std::endl;
-        exit(1);
-      }
-
-      // the following code makes use of bit masks! in short, AVE,SUM,LIST,etc
-      // each use only one bit of an int.
-      // therefore if we apply that mask the the outputBehavior, we can see if
-      // that type of output is needed.
-
-      OB = outputBehavior[i];
-
-      if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-        if (!(OB == LIST || OB == FIRST || OB == NO_OUTPUT)) {
-			std::cout << std::endl << OB << std::endl;
-          std::cout << "  in constructHeaderAndDataStrings :: attempt to write "
-                  "string not in either LIST or FIRST formatte. This is not "
-                  "allowed! Key was '" << i << "'. Exiting..."
-               << std::endl;
-          exit(1);
-        }
-      } 
-
-      if (aveOnly) {
-		  if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-			  OB = NO_OUTPUT;
-		  }
-		  else {
-			  OB &= (AVE | FIRST); // if aveOnly, only output AVE on the entries
-								 // that have been set for AVE
-		  }
-      }
-
-      if (OB & FIRST) { // save first (only?) element in vector with key as
-                        // column name
-        headerStr += FileManager::separator + i;
-        if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-          if (!getBoolVector(i).empty()) {
-            dataStr += FileManager::separator + to_string(getBoolVector(i)[0]);
-          } else {
-            dataStr += '0';
-            std::cout << "  WARNING!! In DataMap::constructHeaderAndDataStrings :: "
-                    "while getting value for FIRST with key \""
-                 << i << "\" vector is empty!" << std::endl;
-          }
-        }
-        if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-          if (!getDoubleVector(i).empty()) {
-            dataStr +=
-                FileManager::separator + std::to_string(getDoubleVector(i)[0]);
-          } else {
-            dataStr += '0';
-            std::cout << "  WARNING!! In DataMap::constructHeaderAndDataStrings :: "
-                    "while getting value for FIRST with key \""
-                 << i << "\" vector is empty!" << std::endl;
-          }
-        }
-        if (typeOfKey == INT || typeOfKey == INTSOLO) {
-          if (!getIntVector(i).empty()) {
-            dataStr +=
-                FileManager::separator + std::to_string(getIntVector(i)[0]);
-          } else {
-            dataStr += '0';
-            std::cout << "  WARNING!! In DataMap::constructHeaderAndDataStrings :: "
-                    "while getting value for FIRST with key \""
-                 << i << "\" vector is empty!" << std::endl;
-          }
-        }
-        if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-          if (!getStringVector(i).empty()) {
-            dataStr += FileManager::separator + (std::string)"\"" + getStringVector(i)[0] + (std::string)"\"";
-          } else {
-            dataStr += (std::string)"\"0\"";
-            std::cout << "  WARNING!! In DataMap::constructHeaderAndDataStrings :: "
-                    "while getting value for FIRST with key \""
-                 << i << "\" vector is empty!" << std::endl;
-          }
-        }
-      }
-      if (OB & AVE) { // key_AVE = ave of vector (will error if of type string!)
-        headerStr += FileManager::separator + i + "_AVE";
-        dataStr += FileManager::separator + std::to_string(getAverage(i));
-      }
-      if (OB & VAR) { // key_VAR = variance of vector (will error if of type string!)
-        headerStr += FileManager::separator + i + "_VAR";
-        dataStr += FileManager::separator + std::to_string(getVariance(i));
-      }
-      if (OB & SUM) { // key_SUM = sum of vector
-        headerStr += FileManager::separator + i + "_SUM";
-        dataStr += FileManager::separator + std::to_string(getSum(i));
-      }
-      if (OB & PROD) { // key_PROD = product of vector
-        std::cout << "  WARNING OUTPUT METHOD PROD IS HAS YET TO BE WRITTEN!"
-             << std::endl;
-      }
-      if (OB & STDERR) { // key_STDERR = standard error of vector
-        std::cout << "  WARNING OUTPUT METHOD STDERR IS HAS YET TO BE WRITTEN!"
-             << std::endl;
-      }
-      if (OB & LIST) { // key_LIST = save all elements in vector in csv list format
-        headerStr += FileManager::separator + i + "_LIST";
-        dataStr += FileManager::separator + (std::string)"\"" + getStringOfVector(i) + (std::string)"\"";
-      }
+      Entry &entry = getOutputEntry(i, aveOnly, OB);
+      appendHeaderAndDataStrings(headerStr, dataStr, i, entry.type, OB,
+                                 entry.numbers.data(), entry.numbers.size(),
+                                 entry.strings.data(), entry.strings.size());
     }
     headerStr.erase(headerStr.begin()); // clip off the leading separator
     dataStr.erase(dataStr.begin());     // clip off the leading separator
   }
 }
+
+void DataMap::constructHeaderAndDataCells(std::vector<std::string> &columnNames,
+                                          std::vector<std::string> &cells,
+                                          const std::vector<std::string> &keys,
+                                          bool aveOnly) {
+  columnNames.clear();
+  cells.clear();
+  unsigned int OB;
+  for (auto const &i : keys) {
+    Entry &entry = getOutputEntry(i, aveOnly, OB);
+    appendHeaderAndDataCells(columnNames, cells, i, entry.type, OB,
+                             entry.numbers.data(), entry.numbers.size(),
+                             entry.strings.data(), entry.strings.size());
+  }
+}
 ///////////////////////////////////////
 // need to add support for output prefix directory
 // need to add support for population file name prefixes
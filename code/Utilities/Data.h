@@ -10,25 +10,43 @@
 
 #pragma once
 
+#include <algorithm>
+#include <deque>
 #include <fstream>
 #include <iostream>
 #include <set>
+#include <shared_mutex>
 #include <string>
 #include <sstream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
+#include "AsyncFileWriter.h"
+#include "BinaryTable.h"
+#include "Pool.h"
 #include "Utilities.h"
 
+// FileManager writes through an AsyncFileWriter. once startAsyncOutput has
+// been called, writes are queued and written to disk by a background thread,
+// so callers never wait on the disk (unless the queue is full). flush() should
+// be called at points where the files on disk should catch up (i.e. after
+// archiving each update) and closeAll() at the end of the run.
+// files with the BinaryTable extension (.mbt) are written as binary tables,
+// a row at a time, with openAndWriteToBinaryFile.
 class FileManager {
 private:
-  static void openFile(const std::string &fileName, const std::string &header = ""); // open file and write header to file if file is new and header is provided
+  static AsyncFileWriter writer;
+  static std::mutex fileManagerMutex; // guards fileStates and binaryTables
+  // rows waiting to be written to each binary table file
+  static std::map<std::string, BinaryTable::Writer> binaryTables;
+  // write any rows waiting for fileName (fileManagerMutex must be held)
+  static void writeBinaryRows(const std::string &fileName);
 public:
   static std::map<std::string, std::vector<std::string>>
       fileColumns;                     // list of files (NAME,LIST OF COLUMNS)
-  static std::map<std::string, std::ofstream> files;  // list of files (NAME,ofstream)
   static std::map<std::string, bool> fileStates; // list of files states (NAME,open?)
 
   static std::string outputPrefix;
@@ -39,6 +57,19 @@ public:
   static void openAndWriteToFile(const std::string &fileName, const std::string &data, const std::string &header = ""); // fileName, data, header - used when you want to output formatted data (i.e. genomes)
   static void writeToFile(const std::string &fileName, const std::string &data, const std::string &header = ""); // fileName, data, header - used when you want to output formatted data (i.e. genomes)
   static void closeFile(const std::string &fileName);   // close file
+  // add a row to a binary table file (see BinaryTable.h). rows are collected
+  // and written a chunk at a time, and when the file is closed
+  static void openAndWriteToBinaryFile(const std::string &fileName,
+                                       const std::vector<std::string> &columnNames,
+                                       std::vector<std::string> cells);
+
+  // write files on a background thread from now on. at most maxQueuedBytes
+  // of data can be waiting to be written before writes have to wait
+  static void startAsyncOutput(size_t maxQueuedBytes);
+  // pass all data written so far to the OS. if wait, block until this is done
+  static void flush(bool wait = false);
+  // write all waiting data, close all files and stop the background thread
+  static void closeAll();
 };
 
 class DataMap {
@@ -53,11 +84,20 @@ public:
     VAR = 64,
 	 NO_OUTPUT = 128
   };                               // 0 = do not save or default..?
-  std::map<std::string, int> outputBehavior; // Defines how each element should be written
-                                   // to file - if element not found, LIST
-                                   // (write out list) is used.
   static std::map<std::string, int> knownOutputBehaviors;
 
+  // keys are interned. the first time any DataMap sees a key it is given a
+  // small integer id, and every DataMap stores its entries against these ids.
+  // all of the functions which take a key string look up the id and then call
+  // the id version, so code which uses the same key very often (i.e. "score")
+  // can call lookupKey once and keep the id.
+  using KeyID = int;
+
+  // return the id for key, adding key to the registry if it is new (thread safe)
+  static KeyID lookupKey(const std::string &key);
+  // return the key string for an id returned by lookupKey
+  static const std::string &keyName(KeyID keyID);
+
 private:
   enum dataMapType {
     NONE = 0,
@@ -71,13 +111,266 @@ private:
     STRINGSOLO = 14
   }; // NONE = not found in this data map
 
-  std::unordered_map<std::string, std::vector<bool>> boolData;
-  std::unordered_map<std::string, std::vector<double>> doubleData;
-  std::unordered_map<std::string, std::vector<int>> intData;
-  std::unordered_map<std::string, std::vector<std::string>> stringData;
+  // BOOLSOLO -> BOOL, DOUBLESOLO -> DOUBLE, etc.
+  static inline dataMapType listType(dataMapType t) {
+    return (t > STRING) ? static_cast<dataMapType>(t - 10) : t;
+  }
+
+  // all the data for one key. bool, int and double values are all held in
+  // numbers (a double holds every bool and int exactly) so that setting a
+  // single value reuses the entry's storage rather than making a new vector.
+  // (entries and their numbers are allocated from Pool, as every organism's
+  // data map is remade each generation)
+  struct Entry {
+    dataMapType type = NONE; // NONE = this entry has been cleared
+    int outputBehavior = 0;  // how this entry should be written to file
+    std::vector<double, Pool::Allocator<double>> numbers;
+    std::vector<std::string> strings;
+  };
+
+  // entryKeys[i] is the key of entries[i]. entries are kept in the order
+  // keys were first used (data maps only hold a handful of keys, so a linear
+  // search of the ids is faster than any map)
+  std::vector<KeyID, Pool::Allocator<KeyID>> entryKeys;
+  std::vector<Entry, Pool::Allocator<Entry>> entries;
+
+  // registry of interned keys shared by all data maps
+  static std::shared_mutex keyRegistryMutex;
+  static std::unordered_map<std::string, KeyID> keyIDs;
+  static std::deque<std::string> keyNames; // deque so names never move
+
+  // return entry for keyID or nullptr if this data map has never seen keyID
+  inline Entry *findEntry(KeyID keyID) {
+    for (size_t i = 0; i < entryKeys.size(); i++) {
+      if (entryKeys[i] == keyID) {
+        return &entries[i];
+      }
+    }
+    return nullptr;
+  }
+
+  // return entry for keyID (new entries have type NONE) and check that it
+  // can hold values with type (i.e. a key may switch between solo and list
+  // but not from int to double). caller is used in the error message
+  inline Entry &getEntry(KeyID keyID, dataMapType type, const std::string &caller) {
+    Entry *entry = findEntry(keyID);
+    if (entry == nullptr) {
+      entryKeys.push_back(keyID);
+      entries.emplace_back();
+      entry = &entries.back();
+    }
+    if (entry->type != NONE && listType(entry->type) != type) {
+      std::cout << "  ERROR :: in DataMap::" << caller << " attempt to use key \""
+                << keyName(keyID) << "\" with type " << lookupDataMapTypeName(type)
+                << " but this key is already associated with type "
+                << lookupDataMapTypeName(entry->type) << ". Exiting." << std::endl;
+      exit(1);
+    }
+    return *entry;
+  }
+
+  // return entry for keyID, or exit with an error if keyID is not in use
+  inline Entry &getEntryInUse(KeyID keyID, const std::string &caller) {
+    Entry *entry = findEntry(keyID);
+    if (entry == nullptr || entry->type == NONE) {
+      std::cout << "  in DataMap::" << caller << " :: key \"" << keyName(keyID)
+                << "\" can not be found in data map!\n  Exiting." << std::endl;
+      exit(1);
+    }
+    return *entry;
+  }
+
+  // return entry for keyID, or exit if keyID is not in use or is not type
+  inline Entry &getEntryOfType(KeyID keyID, dataMapType type, const std::string &caller) {
+    Entry &entry = getEntryInUse(keyID, caller);
+    if (listType(entry.type) != type) {
+      std::cout << "  in DataMap::" << caller << " :: attempt to use "
+                << caller << " with key \"" << keyName(keyID)
+                << "\" but this key is associated with type "
+                << lookupDataMapTypeName(entry.type) << "\n  exiting." << std::endl;
+      exit(1);
+    }
+    return entry;
+  }
+
+  // exit with an error if entry is not bool, double or int
+  inline void checkNumeric(const Entry &entry, KeyID keyID, const std::string &caller) {
+    if (listType(entry.type) == STRING) {
+      std::cout << "  in DataMap::" << caller << " attempt to use with vector of type "
+              "string associated key \""
+           << keyName(keyID) << "\".\n  Cannot average strings!\n  Exiting." << std::endl;
+      exit(1);
+    }
+  }
+
+  // convert a value from numbers to a string for output
+  static inline std::string numberToString(dataMapType t, double value) {
+    if (listType(t) == DOUBLE) {
+      return std::to_string(value);
+    }
+    return std::to_string(static_cast<int>(value)); // bool or int
+  }
+
+  // the values held by an entry (or a PopulationTable cell) are passed to the
+  // following functions as a pointer and count so they can be used on any
+  // contiguous block of values
+
+  // sum, average and variance of count values
+  static inline double sum(const double *values, size_t count) {
+    double returnValue = 0;
+    for (size_t i = 0; i < count; i++) {
+      returnValue += values[i];
+    }
+    return returnValue;
+  }
+  static inline double average(const double *values, size_t count) {
+    double returnValue = sum(values, count);
+    if (count > 1) {
+      returnValue /= count;
+    } // else vector is  size 1, no div needed or vector is empty, returnValue
+      // will be 0
+    return returnValue;
+  }
+  static inline double variance(const double *values, size_t count) {
+    double averageValue = sum(values, count) / count;
+    double varianceValue(0);
+    for (size_t i = 0; i < count; i++) {
+      varianceValue += (values[i] - averageValue) * (values[i] - averageValue);
+    }
+    if (count > 0)
+      varianceValue /= count - 1;
+    else
+      varianceValue = 0;
+    return varianceValue;
+  }
+
+  // values as a comma separated list (strings are used if t is string)
+  static std::string listString(dataMapType t, const double *numbers,
+                                size_t numbersCount, const std::string *strings,
+                                size_t stringsCount);
+
+  // exit with an error if a string key has an output behavior other than
+  // LIST, FIRST or NO_OUTPUT
+  static void checkStringOutputBehavior(const std::string &key, unsigned int OB);
+
+  // call output(columnName, value, quoted) for each column written for one
+  // key, as directed by output behavior OB. quoted is true for values which
+  // are put in quotes in csv files (strings and lists)
+  template <typename Output>
+  static void forEachOutputColumn(const std::string &key, dataMapType t,
+                                  unsigned int OB, const double *numbers,
+                                  size_t numbersCount, const std::string *strings,
+                                  size_t stringsCount, Output output) {
+    bool isString = listType(t) == STRING;
+
+    // the following code makes use of bit masks! in short, AVE,SUM,LIST,etc
+    // each use only one bit of an int.
+    // therefore if we apply that mask the the outputBehavior, we can see if
+    // that type of output is needed.
+
+    if (OB & FIRST) { // save first (only?) element in vector with key as
+                      // column name
+      if (isString ? stringsCount == 0 : numbersCount == 0) {
+        output(key, "0", isString);
+        std::cout << "  WARNING!! In DataMap::constructHeaderAndDataStrings :: "
+                "while getting value for FIRST with key \""
+             << key << "\" vector is empty!" << std::endl;
+      } else if (isString) {
+        output(key, strings[0], true);
+      } else {
+        output(key, numberToString(t, numbers[0]), false);
+      }
+    }
+    if (OB & AVE) { // key_AVE = ave of vector (will error if of type string!)
+      output(key + "_AVE", std::to_string(average(numbers, numbersCount)), false);
+    }
+    if (OB & VAR) { // key_VAR = variance of vector (will error if of type string!)
+      output(key + "_VAR", std::to_string(variance(numbers, numbersCount)), false);
+    }
+    if (OB & SUM) { // key_SUM = sum of vector
+      output(key + "_SUM", std::to_string(sum(numbers, numbersCount)), false);
+    }
+    if (OB & PROD) { // key_PROD = product of vector
+      std::cout << "  WARNING OUTPUT METHOD PROD IS HAS YET TO BE WRITTEN!"
+           << std::endl;
+    }
+    if (OB & STDERR) { // key_STDERR = standard error of vector
+      std::cout << "  WARNING OUTPUT METHOD STDERR IS HAS YET TO BE WRITTEN!"
+           << std::endl;
+    }
+    if (OB & LIST) { // key_LIST = save all elements in vector in csv list format
+      output(key + "_LIST",
+             listString(t, numbers, numbersCount, strings, stringsCount), true);
+    }
+  }
+
+  // add the column names and values for one key to headerStr and dataStr
+  // (each preceded by a separator), as directed by output behavior OB
+  static void appendHeaderAndDataStrings(std::string &headerStr, std::string &dataStr,
+                                         const std::string &key, dataMapType t,
+                                         unsigned int OB, const double *numbers,
+                                         size_t numbersCount,
+                                         const std::string *strings,
+                                         size_t stringsCount);
+
+  // add the column names and values (without csv quotes) for one key to
+  // columnNames and cells, as directed by output behavior OB
+  static void appendHeaderAndDataCells(std::vector<std::string> &columnNames,
+                                       std::vector<std::string> &cells,
+                                       const std::string &key, dataMapType t,
+                                       unsigned int OB, const double *numbers,
+                                       size_t numbersCount,
+                                       const std::string *strings,
+                                       size_t stringsCount);
+
+  // find the entry for key to be written to a file and set OB to the output
+  // behavior to use (exits if key is not in this map)
+  Entry &getOutputEntry(const std::string &key, bool aveOnly, unsigned int &OB);
+
+  friend class PopulationTable;
+
+  inline void setNumber(KeyID keyID, dataMapType type, double value) {
+    Entry &entry = getEntry(keyID, type, "set");
+    entry.numbers.assign(1, value);
+    entry.type = static_cast<dataMapType>(type + 10); // set with a single value, so solo
+    entry.outputBehavior = FIRST;
+  }
+
+  template <typename T>
+  inline void setNumbers(KeyID keyID, dataMapType type, const std::vector<T> &values) {
+    Entry &entry = getEntry(keyID, type, "set");
+    entry.numbers.assign(values.begin(), values.end());
+    entry.type = type;
+    entry.outputBehavior = LIST | AVE;
+  }
+
+  inline void appendNumber(KeyID keyID, dataMapType type, double value) {
+    Entry &entry = getEntry(keyID, type, "append");
+    entry.numbers.push_back(value);
+    entry.type = type; // may have been solo (or new) - make sure it's list
+    entry.outputBehavior = LIST | AVE;
+  }
+
+  // vectors may only be appended to lists (or to new keys), except that a
+  // bool vector may be appended to a single bool
+  inline void checkVectorAppend(const Entry &entry, KeyID keyID, dataMapType type) {
+    if (entry.type > STRING && type != BOOL) {
+      std::cout << "  In DataMap::append :: attempt to append a vector of type "
+                << lookupDataMapTypeName(type) << " to \"" << keyName(keyID)
+                << "\" but this key is already associated with "
+                << lookupDataMapTypeName(entry.type) << ".\n  exiting." << std::endl;
+      exit(1);
+    }
+  }
 
-  std::map<std::string, dataMapType>
-      inUse; // holds list of keys with type 1=bool, 2=double, 3=int, 4=string
+  template <typename T>
+  inline void appendNumbers(KeyID keyID, dataMapType type, const std::vector<T> &values) {
+    Entry &entry = getEntry(keyID, type, "append");
+    checkVectorAppend(entry, keyID, type);
+    entry.numbers.insert(entry.numbers.end(), values.begin(), values.end());
+    entry.type = type; // may have been solo bool (or new) - make sure it's list
+    entry.outputBehavior = LIST | AVE;
+  }
 
 public:
   DataMap() = default;
@@ -85,29 +378,46 @@ public:
   // copy constructor
   DataMap(std::shared_ptr<DataMap> source);
 
+  inline void setOutputBehavior(KeyID keyID, int _outputBehavior) {
+    Entry *entry = findEntry(keyID);
+    if (entry == nullptr) {
+      entryKeys.push_back(keyID);
+      entries.emplace_back();
+      entry = &entries.back();
+    }
+    entry->outputBehavior = _outputBehavior;
+  }
   inline void setOutputBehavior(const std::string &key, int _outputBehavior) {
-    outputBehavior[key] = _outputBehavior;
+    setOutputBehavior(lookupKey(key), _outputBehavior);
+  }
+
+  // return the output behavior for key (0 if key has none)
+  inline int getOutputBehavior(KeyID keyID) {
+    Entry *entry = findEntry(keyID);
+    return (entry == nullptr) ? 0 : entry->outputBehavior;
+  }
+  inline int getOutputBehavior(const std::string &key) {
+    return getOutputBehavior(lookupKey(key));
   }
 
   // find key in this data map and return type (NONE = not found)
+  inline dataMapType findKeyInData(KeyID keyID) {
+    Entry *entry = findEntry(keyID);
+    return (entry == nullptr) ? NONE : entry->type;
+  }
   inline dataMapType findKeyInData(const std::string &key, bool printType = false) {
+    auto typeOfKey = findKeyInData(lookupKey(key));
     if (printType) {
-      std::cout << key << "is of type " << inUse[key] << std::endl;
-    }
-    if (inUse.find(key) != inUse.end()) {
-      return inUse[key];
-    } else {
-      return NONE;
+      std::cout << key << "is of type " << typeOfKey << std::endl;
     }
+    return typeOfKey;
   }
 
   // find key in this data map and return type (NONE = not found)
   inline bool isKeySolo(const std::string &key) {
-    if (inUse.find(key) != inUse.end()) {
-      return ((findKeyInData(key) == BOOLSOLO) ||
-              (findKeyInData(key) == DOUBLESOLO) ||
-              (findKeyInData(key) == INTSOLO) ||
-              (findKeyInData(key) == STRINGSOLO));
+    auto typeOfKey = findKeyInData(key);
+    if (typeOfKey != NONE) {
+      return typeOfKey > STRING;
     } else {
       std::cout << "  ERROR :: in DataMap::isKeySolo, key name " << key
            << " is not defined in DataMap. Exiting!" << std::endl;
@@ -116,7 +426,7 @@ public:
   }
 
   // return a string of the type of key in this data map
-  inline std::string lookupDataMapTypeName(dataMapType t) {
+  static inline std::string lookupDataMapTypeName(dataMapType t) {
     if (t == NONE) {
       return "none";
     } else if (t == BOOL || t == BOOLSOLO) {
@@ -134,324 +444,95 @@ public:
     }
   }
 
-  // return vector of strings will all keys in this data map
+  // return vector of strings will all keys in this data map (sorted, and
+  // not including keys with output behavior NO_OUTPUT)
   inline std::vector<std::string> getKeys() {
     std::vector<std::string> keys;
-    for (auto e : inUse) {
-		 if (outputBehavior[e.first] != NO_OUTPUT) keys.push_back(e.first); // just push back the whole key
+    for (size_t i = 0; i < entries.size(); i++) {
+      if (entries[i].type != NONE && entries[i].outputBehavior != NO_OUTPUT) {
+        keys.push_back(keyName(entryKeys[i]));
+      }
     }
+    std::sort(keys.begin(), keys.end());
     return (keys);
   }
 
   // set functions (bool,double,int,string) that take a **single** value -
   // either make new map entry or replace existing
-  inline void set(const std::string &key, const bool &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == BOOL ||
-        typeOfKey ==
-            BOOLSOLO) { // if key is unused or associates with correct type
-      boolData[key] = std::vector<bool>({value});
-      inUse[key] = BOOLSOLO; // since this is set with SET, it is a single value
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key << "\" value = \""
-           << value << "\" where value is bool." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	 setOutputBehavior(key, FIRST);
-  }
-  inline void set(const std::string &key, const double &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == DOUBLE ||
-        typeOfKey ==
-            DOUBLESOLO) { // if key is unused or associates with correct type
-      doubleData[key] = std::vector<double>({value});
-      inUse[key] =
-          DOUBLESOLO; // since this is set with SET, it is a single value
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key << "\" value = \""
-           << value << "\" where value is double." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	 setOutputBehavior(key, FIRST);
-  }
-  inline void set(const std::string &key, const int &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == INT ||
-        typeOfKey ==
-            INTSOLO) { // if key is unused or associates with correct type
-      intData[key] = std::vector<int>({value});
-      inUse[key] = INTSOLO; // since this is set with SET, it is a single value
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key << "\" value = \""
-           << value << "\" where value is int." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	 setOutputBehavior(key, FIRST);
-  }
+  inline void set(KeyID keyID, const bool &value) { setNumber(keyID, BOOL, value); }
+  inline void set(KeyID keyID, const double &value) { setNumber(keyID, DOUBLE, value); }
+  inline void set(KeyID keyID, const int &value) { setNumber(keyID, INT, value); }
+  inline void set(KeyID keyID, const std::string &value) {
+    Entry &entry = getEntry(keyID, STRING, "set");
+    entry.strings.assign(1, value);
+    entry.type = STRINGSOLO;
+    entry.outputBehavior = FIRST;
+  }
+  inline void set(const std::string &key, const bool &value) { set(lookupKey(key), value); }
+  inline void set(const std::string &key, const double &value) { set(lookupKey(key), value); }
+  inline void set(const std::string &key, const int &value) { set(lookupKey(key), value); }
   inline void set(const std::string &key, const std::string &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == STRING ||
-        typeOfKey ==
-            STRINGSOLO) { // if key is unused or associates with correct type
-      stringData[key] = std::vector<std::string>({value});
-      inUse[key] = STRINGSOLO;
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key << "\" value = \""
-           << value << "\" where value is string." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	 setOutputBehavior(key, FIRST);
+    set(lookupKey(key), value);
   }
 
   // set functions (bool,double,int,string) that take a **vector** of value -
   // either make new map entry or replace existing
   // outputBehavior is set as though there was an append (i.e. list)
-  inline void set(const std::string &key, const std::vector<bool> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == BOOL ||
-        typeOfKey ==
-            BOOLSOLO) { // if key is unused or associates with correct type
-      boolData[key] = value;
-      inUse[key] = BOOL;
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key
-           << "\" value is a vector of bool." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
-  }
-  inline void set(const std::string &key, const std::vector<double> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == DOUBLE ||
-        typeOfKey ==
-            DOUBLESOLO) { // if key is unused or associates with correct type
-      doubleData[key] = value;
-      inUse[key] = DOUBLE;
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key
-           << "\" value is a vector of double." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
-  }
-  inline void set(const std::string &key, const std::vector<int> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == INT ||
-        typeOfKey ==
-            INTSOLO) { // if key is unused or associates with correct type
-      intData[key] = value;
-      inUse[key] = INT;
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key
-           << "\" value is a vector of int." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
-  }
+  inline void set(KeyID keyID, const std::vector<bool> &value) { setNumbers(keyID, BOOL, value); }
+  inline void set(KeyID keyID, const std::vector<double> &value) { setNumbers(keyID, DOUBLE, value); }
+  inline void set(KeyID keyID, const std::vector<int> &value) { setNumbers(keyID, INT, value); }
+  inline void set(KeyID keyID, const std::vector<std::string> &value) {
+    Entry &entry = getEntry(keyID, STRING, "set");
+    entry.strings = value;
+    entry.type = STRING;
+    entry.outputBehavior = LIST;
+  }
+  inline void set(const std::string &key, const std::vector<bool> &value) { set(lookupKey(key), value); }
+  inline void set(const std::string &key, const std::vector<double> &value) { set(lookupKey(key), value); }
+  inline void set(const std::string &key, const std::vector<int> &value) { set(lookupKey(key), value); }
   inline void set(const std::string &key, const std::vector<std::string> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == STRING ||
-        typeOfKey ==
-            STRINGSOLO) { // if key is unused or associates with correct type
-      stringData[key] = value;
-      inUse[key] = STRING;
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key
-           << "\" value is a vector of string." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST);
+    set(lookupKey(key), value);
   }
 
   // append a value to the end of vector associated with key. If key is not
   // found, start a new vector for key
-  inline void append(const std::string &key, const bool &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
-      inUse[key] = BOOL; // set the in use to be a list rather then a solo
-    } else if (typeOfKey == BOOL ||
-               typeOfKey == BOOLSOLO) { // if this key is in data map as a
-                                        // string, append to vector
-      boolData[key].push_back(value);
-      inUse[key] = BOOL;
-    } else {
-      std::cout << "  In DataMap::append :: attempt to append value \"" << value
-           << "\" of type bool to \"" << key
-           << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
-  }
-  inline void append(const std::string &key, const double &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
-      inUse[key] = DOUBLE; // set the in use to be a list rather then a solo
-    } else if (typeOfKey == DOUBLE ||
-               typeOfKey == DOUBLESOLO) { // if this key is in data map as a
-                                          // string, append to vector
-      doubleData[key].push_back(value);
-      inUse[key] = DOUBLE;
-    } else {
-      std::cout << "  In DataMap::append :: attempt to append value \"" << value
-           << "\" of type double to \"" << key
-           << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
-  }
-  inline void append(const std::string &key, const int &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
-      inUse[key] = INT; // set the in use to be a list rather then a solo
-    } else if (typeOfKey == INT ||
-               typeOfKey == INTSOLO) { // if this key is in data map as a
-                                       // string, append to vector
-      intData[key].push_back(value);
-      inUse[key] = INT; // set the in use to be a list rather then a solo
-    } else {
-      std::cout << "  In DataMap::append :: attempt to append value \"" << value
-           << "\" of type int to \"" << key
-           << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
-  }
+  inline void append(KeyID keyID, const bool &value) { appendNumber(keyID, BOOL, value); }
+  inline void append(KeyID keyID, const double &value) { appendNumber(keyID, DOUBLE, value); }
+  inline void append(KeyID keyID, const int &value) { appendNumber(keyID, INT, value); }
+  inline void append(KeyID keyID, const std::string &value) {
+    Entry &entry = getEntry(keyID, STRING, "append");
+    entry.strings.push_back(value);
+    entry.type = STRING; // may have been solo (or new) - make sure it's list
+    entry.outputBehavior = LIST;
+  }
+  inline void append(const std::string &key, const bool &value) { append(lookupKey(key), value); }
+  inline void append(const std::string &key, const double &value) { append(lookupKey(key), value); }
+  inline void append(const std::string &key, const int &value) { append(lookupKey(key), value); }
   inline void append(const std::string &key, const std::string &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
-      inUse[key] = STRING; // set the in use to be a list rather then a solo
-    } else if (typeOfKey == STRING ||
-               typeOfKey == STRINGSOLO) { // if this key is in data map as a
-                                          // string, append to vector
-      stringData[key].push_back(value);
-      inUse[key] = STRING; // set the in use to be a list rather then a solo
-    } else {
-      std::cout << "  In DataMap::append :: attempt to append value \"" << value
-           << "\" of type string to \"" << key
-           << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST);
+    append(lookupKey(key), value);
   }
 
   // append a vector of values to the end of vector associated with key. If key
   // is not found, start a new vector for key
-  inline void append(const std::string &key, const std::vector<bool> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
-    } else if (typeOfKey == BOOL ||
-               typeOfKey == BOOLSOLO) { // if this key is in data map as a
-                                        // string, append to vector
-      boolData[key].insert(boolData[key].end(), value.begin(), value.end());
-      inUse[key] = BOOL; // may have been solo - make sure it's list
-    } else {
-      std::cout << "  In DataMap::append :: attempt to append a vector of type bool "
-              "to \""
-           << key << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
-  }
-  inline void append(const std::string &key, const std::vector<double> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
-    } else if (typeOfKey == DOUBLE) { // if this key is in data map as a string,
-                                      // append to vector
-      doubleData[key].insert(doubleData[key].end(), value.begin(), value.end());
-      inUse[key] = DOUBLE; // may have been solo - make sure it's list
-    } else {
-      std::cout << "  In DataMap::append :: attempt to append a vector of type "
-              "double to \""
-           << key << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
-  }
-  inline void append(const std::string &key, const std::vector<int> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
-    } else if (typeOfKey == INT) { // if this key is in data map as a string,
-                                   // append to vector
-      intData[key].insert(intData[key].end(), value.begin(), value.end());
-      inUse[key] = INT; // may have been solo - make sure it's list
-    } else {
-      std::cout << "  In DataMap::append :: attempt to append a vector of type int "
-              "to \""
-           << key << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
-  }
+  inline void append(KeyID keyID, const std::vector<bool> &value) { appendNumbers(keyID, BOOL, value); }
+  inline void append(KeyID keyID, const std::vector<double> &value) { appendNumbers(keyID, DOUBLE, value); }
+  inline void append(KeyID keyID, const std::vector<int> &value) { appendNumbers(keyID, INT, value); }
+  inline void append(KeyID keyID, const std::vector<std::string> &value) {
+    Entry &entry = getEntry(keyID, STRING, "append");
+    checkVectorAppend(entry, keyID, STRING);
+    if (entry.type == NONE || entry.strings.empty()) {
+      entry.strings = value;
+    } else if (!value.empty()) { // concat new string with existing value
+      entry.strings = {entry.strings[0] + value[0]};
+    }
+    entry.type = STRING; // may have been new - make sure it's list
+    entry.outputBehavior = LIST;
+  }
+  inline void append(const std::string &key, const std::vector<bool> &value) { append(lookupKey(key), value); }
+  inline void append(const std::string &key, const std::vector<double> &value) { append(lookupKey(key), value); }
+  inline void append(const std::string &key, const std::vector<int> &value) { append(lookupKey(key), value); }
   inline void append(const std::string &key, const std::vector<std::string> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
-    } else if (typeOfKey == STRING) { // if this key is in data map as a string,
-                                      // concat new string with existing value
-		stringData[key] = { stringData[key][0] + value[0] };
-      inUse[key] = STRING; // may have been solo - make sure it's list
-    } else {
-      std::cout << "  In DataMap::append :: attempt to append a vector of type "
-              "string to \""
-           << key << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST);
+    append(lookupKey(key), value);
   }
 
   // merge contents of two data maps - if common keys are found behavior is determined by 'replace'
@@ -459,13 +540,17 @@ public:
   // replace 1 = keep current value - if the same key exists in both maps, keep the current value
   // replace 3 = keep the other value - if the same key exists in both maps, keep the other value
   // merge will attempt to merge outputBehavior
-  inline void merge(DataMap otherDataMap, int replace = 0) {
-	  for (std::string key : otherDataMap.getKeys()) {
-		  dataMapType typeOfKey = findKeyInData(key);
-		  dataMapType typeOfOtherKey = otherDataMap.findKeyInData(key);
+  inline void merge(const DataMap &otherDataMap, int replace = 0) {
+	  for (size_t i = 0; i < otherDataMap.entries.size(); i++) {
+		  const Entry &otherEntry = otherDataMap.entries[i];
+		  if (otherEntry.type == NONE || otherEntry.outputBehavior == NO_OUTPUT) {
+			  continue; // only keys which would be returned by getKeys() are merged
+		  }
+		  KeyID keyID = otherDataMap.entryKeys[i];
+		  dataMapType typeOfKey = findKeyInData(keyID);
 		  if (replace == 0) { // no replacement allowed!
 			  if (typeOfKey != NONE) { // make sure key is not in both data maps
-				  std::cout << "  In DataMap::merge() - attempt to merge key: \"" << key
+				  std::cout << "  In DataMap::merge() - attempt to merge key: \"" << keyName(keyID)
 					  << "\" but key exists in both data maps and replace = 0!\n  Exiting." << std::endl;
 			  }
 		  }
@@ -476,298 +561,121 @@ public:
 		  //  or
 		  //   rule is keep current, and this key is not already in this data map (replace = 1)
 		  if (replace == 2 || replace == 0 || (replace == 1 && typeOfKey == NONE)) {
-			  if (typeOfOtherKey == BOOL || typeOfOtherKey == BOOLSOLO) {
-				  set(key, otherDataMap.getBoolVector(key));
-				  outputBehavior[key] = otherDataMap.outputBehavior[key];
-			  }
-			  if (typeOfOtherKey == DOUBLE || typeOfOtherKey == DOUBLESOLO) {
-				  set(key, otherDataMap.getDoubleVector(key));
-				  outputBehavior[key] = otherDataMap.outputBehavior[key];
-			  }
-			  if (typeOfOtherKey == INT || typeOfOtherKey == INTSOLO) {
-				  set(key, otherDataMap.getIntVector(key));
-				  outputBehavior[key] = otherDataMap.outputBehavior[key];
-			  }
-			  if (typeOfOtherKey == STRING || typeOfOtherKey == STRINGSOLO) {
-				  set(key, otherDataMap.getStringVector(key));
-				  outputBehavior[key] = otherDataMap.outputBehavior[key];
-			  }
+			  Entry &entry = getEntry(keyID, listType(otherEntry.type), "merge");
+			  entry.numbers = otherEntry.numbers;
+			  entry.strings = otherEntry.strings;
+			  entry.type = listType(otherEntry.type);
+			  entry.outputBehavior = otherEntry.outputBehavior;
 		  }
 	  }
   }
 
-  inline std::vector<bool> getBoolVector(
-      const std::string &key) { // retrieve a double from a dataMap with "key"
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-      return boolData[key];
-    } else {
-      std::cout << "  in DataMap::getBoolVector :: attempt to use getBoolVector "
-              "with key \""
-           << key << "\" but this key is associated with type " << typeOfKey
-           << "\n  exiting." << std::endl;
-      std::cout << "  (if type is NONE, then the key was not found in dataMap)"
-           << std::endl;
-      exit(1);
+  inline std::vector<bool> getBoolVector(KeyID keyID) {
+    auto &numbers = getEntryOfType(keyID, BOOL, "getBoolVector").numbers;
+    std::vector<bool> values(numbers.size());
+    for (size_t i = 0; i < numbers.size(); i++) {
+      values[i] = numbers[i] != 0;
     }
+    return values;
   }
-  inline std::vector<double> getDoubleVector(
-      const std::string &key) { // retrieve a double from a dataMap with "key"
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-      return doubleData[key];
-    } else {
-      std::cout << "  in DataMap::getDoubleVector :: attempt to use getDoubleVector "
-              "with key \""
-           << key << "\" but this key is associated with type " << typeOfKey
-           << "\n  exiting." << std::endl;
-      std::cout << "  (if type is NONE, then the key was not found in dataMap)"
-           << std::endl;
-      exit(1);
-    }
+  inline std::vector<double> getDoubleVector(KeyID keyID) {
+    auto &numbers = getEntryOfType(keyID, DOUBLE, "getDoubleVector").numbers;
+    return std::vector<double>(numbers.begin(), numbers.end());
   }
-  inline std::vector<int> getIntVector(
-      const std::string &key) { // retrieve a double from a dataMap with "key"
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == INT || typeOfKey == INTSOLO) {
-      return intData[key];
-    } else {
-      std::cout << "  in DataMap::getIntVector :: attempt to use getIntVector with "
-              "key \""
-           << key << "\" but this key is associated with type " << typeOfKey
-           << "\n  exiting." << std::endl;
-      std::cout << "  (if type is NONE, then the key was not found in dataMap)"
-           << std::endl;
-      exit(1);
+  inline std::vector<int> getIntVector(KeyID keyID) {
+    auto &numbers = getEntryOfType(keyID, INT, "getIntVector").numbers;
+    std::vector<int> values(numbers.size());
+    for (size_t i = 0; i < numbers.size(); i++) {
+      values[i] = static_cast<int>(numbers[i]);
     }
+    return values;
   }
-  inline std::vector<std::string> getStringVector(
-      const std::string &key) { // retrieve a double from a dataMap with "key"
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-      return stringData[key];
-    } else {
-      std::cout << "  in DataMap::getStringVector :: attempt to use getStringVector "
-              "with key \""
-           << key << "\" but this key is associated with type " << typeOfKey
-           << "\n  exiting." << std::endl;
-      std::cout << "  (if type is NONE, then the key was not found in dataMap)"
-           << std::endl;
-      exit(1);
-    }
+  inline std::vector<std::string> getStringVector(KeyID keyID) {
+    return getEntryOfType(keyID, STRING, "getStringVector").strings;
+  }
+  inline std::vector<bool> getBoolVector(const std::string &key) { return getBoolVector(lookupKey(key)); }
+  inline std::vector<double> getDoubleVector(const std::string &key) { return getDoubleVector(lookupKey(key)); }
+  inline std::vector<int> getIntVector(const std::string &key) { return getIntVector(lookupKey(key)); }
+  inline std::vector<std::string> getStringVector(const std::string &key) {
+    return getStringVector(lookupKey(key));
   }
 
-  inline std::string getStringOfVector(const std::string &key) { // retrieve a string from
-                                                       // a dataMap with "key" -
-                                                       // if not already string,
-                                                       // will be converted
-    std::string returnString = "";
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) {
-      std::cout << "  In DataMap::GetString() :: key \"" << key
-           << "\" is not in data map!\n  exiting." << std::endl;
-      exit(1);
-    } else {
-      if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-        for (auto e : boolData[key]) {
-          returnString += to_string(e) + ",";
-        }
-      } else if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-        for (auto e : doubleData[key]) {
-          returnString += std::to_string(e) + ",";
-        }
-      } else if (typeOfKey == INT || typeOfKey == INTSOLO) {
-        for (auto e : intData[key]) {
-          returnString += std::to_string(e) + ",";
-        }
-      } else if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-        for (auto e : stringData[key]) {
-          returnString += e + ",";
-        }
-      }
-    }
-    if (returnString.size() > 2) { // if vector was not empty
-      returnString.pop_back();     // remove trailing ","
-    }
-    returnString += "";
-    return returnString;
+  // retrieve a string from a dataMap with "key" - if not already string,
+  // will be converted
+  inline std::string getStringOfVector(KeyID keyID) {
+    Entry &entry = getEntryInUse(keyID, "getStringOfVector");
+    return listString(entry.type, entry.numbers.data(), entry.numbers.size(),
+                      entry.strings.data(), entry.strings.size());
+  }
+  inline std::string getStringOfVector(const std::string &key) {
+    return getStringOfVector(lookupKey(key));
   }
 
   // get ave of values in a vector - must be bool, double or, int
-  inline double
-  getAverage(std::string key) { // not ref, we may need to change to a "{LIST}" key
-    dataMapType typeOfKey = findKeyInData(key);
-    double returnValue = 0;
-    if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-      for (auto e : boolData[key]) {
-        returnValue += (double)e;
-      }
-      if (boolData[key].size() > 1) {
-        returnValue /= boolData[key].size();
-      } // else vector is  size 1, no div needed or vector is empty, returnValue
-        // will be 0
-    } else if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-      for (auto e : doubleData[key]) {
-        returnValue += (double)e;
-      }
-      if (doubleData[key].size() > 1) {
-        returnValue /= doubleData[key].size();
-      } // else vector is  size 1, no div needed or vector is empty, returnValue
-        // will be 0
-    } else if (typeOfKey == INT || typeOfKey == INTSOLO) {
-      for (auto e : intData[key]) {
-        returnValue += (double)e;
-      }
-      if (intData[key].size() > 1) {
-        returnValue /= intData[key].size();
-      } // else vector is  size 1, no div needed or vector is empty, returnValue
-        // will be 0
-    } else if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-      std::cout << "  in DataMap::getAverage attempt to use with vector of type "
-              "string associated key \""
-           << key << "\".\n  Cannot average strings!\n  Exiting." << std::endl;
-      exit(1);
-    } else if (typeOfKey == NONE) {
-      std::cout << "  in DataMap::getAverage attempt to get average from "
-              "nonexistent key \""
-           << key << "\".\n  Exiting." << std::endl;
-      exit(1);
-    }
-    return returnValue;
+  inline double getAverage(KeyID keyID) {
+    Entry &entry = getEntryInUse(keyID, "getAverage");
+    checkNumeric(entry, keyID, "getAverage");
+    return average(entry.numbers.data(), entry.numbers.size());
   }
+  inline double getAverage(const std::string &key) { return getAverage(lookupKey(key)); }
 
-  inline double
-  getVariance(std::string key) { // not ref, we may need to change to a "{LIST}" key
-    dataMapType typeOfKey = findKeyInData(key);
-    double averageValue(0);
-    double varianceValue(0);
-    if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-      for (auto e : boolData[key]) {
-        averageValue += (double)e;
-      }
-      averageValue /= boolData[key].size();
-      for (auto e : boolData[key]) {
-        varianceValue +=
-            ((double)e - averageValue) * ((double)e - averageValue);
-      }
-      if (boolData[key].size() > 0)
-        varianceValue /= boolData[key].size() - 1;
-      else
-        varianceValue = 0;
-    } else if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-      for (auto e : doubleData[key]) {
-        averageValue += (double)e;
-      }
-      averageValue /= doubleData[key].size();
-      for (auto e : doubleData[key]) {
-        varianceValue +=
-            ((double)e - averageValue) * ((double)e - averageValue);
-      }
-      if (doubleData[key].size() > 0)
-        varianceValue /= doubleData[key].size() - 1;
-      else
-        varianceValue = 0;
-    } else if (typeOfKey == INT || typeOfKey == INTSOLO) {
-      for (auto e : intData[key]) {
-        averageValue += (double)e;
-      }
-      averageValue /= intData[key].size();
-      for (auto e : intData[key]) {
-        varianceValue +=
-            ((double)e - averageValue) * ((double)e - averageValue);
-      }
-      if (intData[key].size() > 0)
-        varianceValue /= intData[key].size() - 1;
-      else
-        varianceValue = 0;
-    } else if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-      std::cout << "  in DataMap::getVariance attempt to use with vector of type "
-              "string associated key \""
-           << key << "\".\n  Cannot average strings!\n  Exiting." << std::endl;
-      exit(1);
-    } else if (typeOfKey == NONE) {
-      std::cout << "  in DataMap::getVariance attempt to get value from nonexistent "
-              "key \""
-           << key << "\".\n  Exiting." << std::endl;
-      exit(1);
-    }
-    return varianceValue;
+  inline double getVariance(KeyID keyID) {
+    Entry &entry = getEntryInUse(keyID, "getVariance");
+    checkNumeric(entry, keyID, "getVariance");
+    return variance(entry.numbers.data(), entry.numbers.size());
   }
+  inline double getVariance(const std::string &key) { return getVariance(lookupKey(key)); }
 
-  // get ave of values in a vector - must be bool, double or, int
-  inline double
-  getSum(std::string key) { // not ref, we may need to change to a "{LIST}" key
-    dataMapType typeOfKey = findKeyInData(key);
-    double returnValue = 0;
-    if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-      for (auto e : boolData[key]) {
-        returnValue += (double)e;
-      }
-      // if (boolData[key].size() > 1) {
-      //	returnValue /= boolData[key].size();
-      //} // else vector is  size 1, no div needed or vector is empty,
-      //returnValue will be 0
-    } else if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-      for (auto e : doubleData[key]) {
-        returnValue += (double)e;
-      }
-      // if (doubleData[key].size() > 1) {
-      //	returnValue /= doubleData[key].size();
-      //} // else vector is  size 1, no div needed or vector is empty,
-      //returnValue will be 0
-    } else if (typeOfKey == INT || typeOfKey == INTSOLO) {
-      for (auto e : intData[key]) {
-        returnValue += (double)e;
-      }
-      // if (intData[key].size() > 1) {
-      //	returnValue /= intData[key].size();
-      //} // else vector is  size 1, no div needed or vector is empty,
-      //returnValue will be 0
-    } else if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-      std::cout << "  in DataMap::getAverage attempt to use with vector of type "
-              "string associated key \""
-           << key << "\".\n  Cannot average strings!\n  Exiting." << std::endl;
-      exit(1);
-    } else if (typeOfKey == NONE) {
-      std::cout << "  in DataMap::getAverage attempt to get average from "
-              "nonexistent key \""
-           << key << "\".\n  Exiting." << std::endl;
-      exit(1);
+  // get sum of values in a vector - must be bool, double or, int
+  inline double getSum(KeyID keyID) {
+    Entry &entry = getEntryInUse(keyID, "getSum");
+    checkNumeric(entry, keyID, "getSum");
+    return sum(entry.numbers.data(), entry.numbers.size());
+  }
+  inline double getSum(const std::string &key) { return getSum(lookupKey(key)); }
+
+  // getAverage and getSum which return false (rather than exiting) if keyID is
+  // not in use or holds strings
+  inline bool tryGetAverage(KeyID keyID, double &value) {
+    Entry *entry = findEntry(keyID);
+    if (entry == nullptr || entry->type == NONE || listType(entry->type) == STRING) {
+      return false;
     }
-    return returnValue;
+    value = average(entry->numbers.data(), entry->numbers.size());
+    return true;
+  }
+  inline bool tryGetSum(KeyID keyID, double &value) {
+    Entry *entry = findEntry(keyID);
+    if (entry == nullptr || entry->type == NONE || listType(entry->type) == STRING) {
+      return false;
+    }
+    value = sum(entry->numbers.data(), entry->numbers.size());
+    return true;
   }
 
-  // Clear a field in a DataMap
-  inline void clear(const std::string &key) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey != NONE) {
-      if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) { // data is bool
-        boolData.erase(key);
-      } else if (typeOfKey == DOUBLE ||
-                 typeOfKey == DOUBLESOLO) { // data is double
-        doubleData.erase(key);
-      } else if (typeOfKey == INT || typeOfKey == INTSOLO) { // data is int
-        intData.erase(key);
-      } else if (typeOfKey == STRING ||
-                 typeOfKey == STRINGSOLO) { // data is string
-        stringData.erase(key);
-      }
-      inUse.erase(key);
+  // Clear a field in a DataMap (the entry is kept so its storage can be reused)
+  inline void clear(KeyID keyID) {
+    Entry *entry = findEntry(keyID);
+    if (entry != nullptr) {
+      entry->type = NONE;
+      entry->numbers.clear();
+      entry->strings.clear();
     }
   }
+  inline void clear(const std::string &key) { clear(lookupKey(key)); }
 
   // Clear all data in a DataMap
   inline void clearMap() {
-    boolData.clear();
-    doubleData.clear();
-    intData.clear();
-    stringData.clear();
-    inUse.clear();
+    entryKeys.clear();
+    entries.clear();
   }
 
+  inline bool fieldExists(KeyID keyID) { // return true if a data map contains keyID
+    return (findKeyInData(keyID) > 0);
+  }
   inline bool
   fieldExists(const std::string &key) { // return true if a data map contains "key"
-    return (findKeyInData(key) > 0);
+    return fieldExists(lookupKey(key));
   }
 
   // take two strings (header and data), and a list of keys, and whether or not
@@ -776,37 +684,26 @@ public:
                                      const std::vector<std::string> &keys,
                                      bool aveOnly = false);
 
+  // as constructHeaderAndDataStrings, but with one string per column (values
+  // do not have csv quotes) for binary table files
+  void constructHeaderAndDataCells(std::vector<std::string> &columnNames,
+                                   std::vector<std::string> &cells,
+                                   const std::vector<std::string> &keys,
+                                   bool aveOnly = false);
+
   [[deprecated("Use openAndWriteToFile() instead.")]]
   inline void writeToFile(const std::string &fileName,
                           const std::vector<std::string> &keys = {},
                           bool aveOnly = false) {
-    // Set("score{LIST}",10.0);
-
-    if (FileManager::files.find(fileName) ==
-        FileManager::files
-            .end()) { // first make sure that the dataFile has been set up.
-      if (keys.size() == 0) { // if no keys are given
-        FileManager::fileColumns[fileName] = getKeys();
-      } else {
-        FileManager::fileColumns[fileName] = keys;
-      }
-    }
-    std::string headerStr = "";
-    std::string dataStr = "";
-
-    constructHeaderAndDataStrings(headerStr, dataStr,
-                                  FileManager::fileColumns[fileName],
-                                  aveOnly); // if a list is given, use that.
-
-    FileManager::openAndWriteToFile(fileName, dataStr, headerStr); // write the data to file!
+    openAndWriteToFile(fileName, keys, aveOnly);
   }
   inline void openAndWriteToFile(const std::string &fileName,
                           const std::vector<std::string> &keys = {},
                           bool aveOnly = false) {
     // Set("score{LIST}",10.0);
 
-    if (FileManager::files.find(fileName) ==
-        FileManager::files
+    if (FileManager::fileStates.find(fileName) ==
+        FileManager::fileStates
             .end()) { // first make sure that the dataFile has been set up.
       if (keys.size() == 0) { // if no keys are given
         FileManager::fileColumns[fileName] = getKeys();
@@ -814,6 +711,15 @@ public:
         FileManager::fileColumns[fileName] = keys;
       }
     }
+    if (BinaryTable::isBinaryTableFile(fileName)) {
+      std::vector<std::string> columnNames;
+      std::vector<std::string> cells;
+      constructHeaderAndDataCells(columnNames, cells,
+                                  FileManager::fileColumns[fileName], aveOnly);
+      FileManager::openAndWriteToBinaryFile(fileName, columnNames,
+                                            std::move(cells));
+      return;
+    }
     std::string headerStr = "";
     std::string dataStr = "";
 
@@ -826,88 +732,59 @@ public:
   }
 
   inline std::vector<std::string> getColumnNames() {
-    std::vector<std::string> columnNames;
+    std::vector<std::pair<std::string, int>> namesAndBehaviors;
+    for (size_t i = 0; i < entries.size(); i++) {
+      if (entries[i].type != NONE) {
+        namesAndBehaviors.push_back({keyName(entryKeys[i]), entries[i].outputBehavior});
+      }
+    }
+    std::sort(namesAndBehaviors.begin(), namesAndBehaviors.end());
 
-    for (auto element : inUse) {
-      //if (outputBehavior.find(element.first) == outputBehavior.end()) {
-      //  // this element has no defined output behavior, so it will be LIST
-      //  // (default) or FIRST (if it's a solo value)
-      //  if (element.second == BOOLSOLO || element.second == DOUBLESOLO ||
-      //      element.second == INTSOLO || element.second == STRINGSOLO) {
-      //    columnNames.push_back(element.first);
-      //  } else {
-      //    columnNames.push_back(element.first + "_LIST");
-      //  }
-      //} else { // there is an output behavior defined
-		 {
-        auto OB = outputBehavior[element.first];
-        if (OB & AVE) {
-          columnNames.push_back(element.first + "_AVE");
-        }
-        if (OB & FIRST) {
-          columnNames.push_back(element.first);
-        }
-        if (OB & SUM) {
-          std::cout << "  WARNING OUTPUT METHOD SUM IS HAS YET TO BE WRITTEN!"
-               << std::endl;
-        }
-        if (OB & PROD) {
-          std::cout << "  WARNING OUTPUT METHOD PROD IS HAS YET TO BE WRITTEN!"
-               << std::endl;
-        }
-        if (OB & STDERR) {
-          std::cout << "  WARNING OUTPUT METHOD STDERR IS HAS YET TO BE WRITTEN!"
-               << std::endl;
-        }
-        if (OB & LIST) {
-          columnNames.push_back(element.first + "_LIST");
-        }
-		  // if (OB & NO_OUTPUT) do nothing...
+    std::vector<std::string> columnNames;
+    for (auto &element : namesAndBehaviors) {
+      auto OB = element.second;
+      if (OB & AVE) {
+        columnNames.push_back(element.first + "_AVE");
+      }
+      if (OB & FIRST) {
+        columnNames.push_back(element.first);
+      }
+      if (OB & SUM) {
+        std::cout << "  WARNING OUTPUT METHOD SUM IS HAS YET TO BE WRITTEN!"
+             << std::endl;
+      }
+      if (OB & PROD) {
+        std::cout << "  WARNING OUTPUT METHOD PROD IS HAS YET TO BE WRITTEN!"
+             << std::endl;
       }
+      if (OB & STDERR) {
+        std::cout << "  WARNING OUTPUT METHOD STDERR IS HAS YET TO BE WRITTEN!"
+             << std::endl;
+      }
+      if (OB & LIST) {
+        columnNames.push_back(element.first + "_LIST");
+      }
+      // if (OB & NO_OUTPUT) do nothing...
     }
     return columnNames;
   }
-  //	/*
-  //	 * takes a vector of string with key value pairs. Calls set for each
-  //pair.
-  //	 */
-  //	void SetMany(vector<string> dataPairs);
 
+  // return a copy of this data map where every key has been renamed
+  // prefix_key. if stringify, output behaviors are not copied (new keys get
+  // the default list behavior)
   inline DataMap remakeDataMapWithPrefix(std::string prefix, bool stringify = 0) {
     DataMap copyDataMap;
-    dataMapType entryType;
-    if (!stringify) {
-      for (auto key : getKeys()) {
-        entryType = findKeyInData(key);
-        if (entryType == BOOL || entryType == BOOLSOLO) {
-          copyDataMap.set(prefix + "_" + key, getBoolVector(key));
-        }
-        if (entryType == STRING || entryType == STRINGSOLO) {
-          copyDataMap.set(prefix + "_" + key, getStringVector(key));
-        }
-        if (entryType == INT || entryType == INTSOLO) {
-          copyDataMap.set(prefix + "_" + key, getIntVector(key));
-        }
-        if (entryType == DOUBLE || entryType == DOUBLESOLO) {
-          copyDataMap.set(prefix + "_" + key, getDoubleVector(key));
-        }
-        copyDataMap.setOutputBehavior(prefix + "_" + key, outputBehavior[key]);
+    for (size_t i = 0; i < entries.size(); i++) {
+      const Entry &entry = entries[i];
+      if (entry.type == NONE || entry.outputBehavior == NO_OUTPUT) {
+        continue;
       }
-    } else {
-      for (auto key : getKeys()) {
-        entryType = findKeyInData(key);
-        if (entryType == BOOL || entryType == BOOLSOLO) {
-          copyDataMap.set(prefix + "_" + key, getBoolVector(key));
-        }
-        if (entryType == STRING || entryType == STRINGSOLO) {
-          copyDataMap.set(prefix + "_" + key, getStringVector(key));
-        }
-        if (entryType == INT || entryType == INTSOLO) {
-          copyDataMap.set(prefix + "_" + key, getIntVector(key));
-        }
-        if (entryType == DOUBLE || entryType == DOUBLESOLO) {
-          copyDataMap.set(prefix + "_" + key, getDoubleVector(key));
-        }
+      copyDataMap.entryKeys.push_back(lookupKey(prefix + "_" + keyName(entryKeys[i])));
+      copyDataMap.entries.push_back(entry);
+      Entry &copyEntry = copyDataMap.entries.back();
+      copyEntry.type = listType(entry.type);
+      if (stringify) {
+        copyEntry.outputBehavior = (copyEntry.type == STRING) ? LIST : (LIST | AVE);
       }
     }
     return copyDataMap;
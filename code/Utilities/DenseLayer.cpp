@@ -0,0 +1,218 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include "DenseLayer.h"
+
+#include <algorithm>
+#include <cmath>
+
+// the vector kernels are built with gcc/clang target attributes, so the rest
+// of the program does not need to be compiled for avx
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define DENSE_LAYER_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// sums[b][o] += in[b][i] * weights[i][o], for each input i in order
+template <class W>
+void accumulateScalar(const W *weights, int stride, const double *in,
+                      int inputCount, double *sums, int outputCount,
+                      int batchSize) {
+  for (int i = 0; i < inputCount; i++) {
+    const W *w = weights + i * stride;
+    for (int b = 0; b < batchSize; b++) {
+      const double value = in[b * inputCount + i];
+      double *s = sums + b * stride;
+      for (int o = 0; o < outputCount; o++) {
+        s[o] += static_cast<double>(w[o]) * value;
+      }
+    }
+  }
+}
+
+#ifdef DENSE_LAYER_X86
+// the vector kernels multiply and then add, so that the sums match
+// accumulateScalar. the empty asm statements hold the product in a register,
+// which keeps the compiler from fusing the two into an fma (avx512f implies
+// fma, and gcc fuses intrinsics too)
+
+__attribute__((target("avx2"))) inline __m256d loadAVX2(const double *w) {
+  return _mm256_load_pd(w);
+}
+__attribute__((target("avx2"))) inline __m256d loadAVX2(const float *w) {
+  return _mm256_cvtps_pd(_mm_load_ps(w));
+}
+
+template <class W>
+__attribute__((target("avx2"))) void
+accumulateAVX2(const W *weights, int stride, const double *in, int inputCount,
+               double *sums, int batchSize) {
+  for (int i = 0; i < inputCount; i++) {
+    const W *w = weights + i * stride;
+    for (int b = 0; b < batchSize; b++) {
+      const __m256d value = _mm256_set1_pd(in[b * inputCount + i]);
+      double *s = sums + b * stride;
+      for (int o = 0; o < stride; o += 4) {
+        __m256d product = _mm256_mul_pd(loadAVX2(w + o), value);
+        __asm__("" : "+x"(product));
+        _mm256_store_pd(s + o, _mm256_add_pd(_mm256_load_pd(s + o), product));
+      }
+    }
+  }
+}
+
+__attribute__((target("avx512f"))) inline __m512d loadAVX512(const double *w) {
+  return _mm512_load_pd(w);
+}
+__attribute__((target("avx512f"))) inline __m512d loadAVX512(const float *w) {
+  // (_mm512_cvtps_pd merges into an undefined register, which gcc warns may be
+  // uninitialized; zero masking with every lane set converts the same way)
+  return _mm512_maskz_cvtps_pd(0xFF, _mm256_load_ps(w));
+}
+
+template <class W>
+__attribute__((target("avx512f"))) void
+accumulateAVX512(const W *weights, int stride, const double *in,
+                 int inputCount, double *sums, int batchSize) {
+  for (int i = 0; i < inputCount; i++) {
+    const W *w = weights + i * stride;
+    for (int b = 0; b < batchSize; b++) {
+      const __m512d value = _mm512_set1_pd(in[b * inputCount + i]);
+      double *s = sums + b * stride;
+      for (int o = 0; o < stride; o += 8) {
+        __m512d product = _mm512_mul_pd(loadAVX512(w + o), value);
+        __asm__("" : "+v"(product));
+        _mm512_store_pd(s + o, _mm512_add_pd(_mm512_load_pd(s + o), product));
+      }
+    }
+  }
+}
+#endif
+
+template <class W>
+void accumulate(DenseLayer::InstructionSet instructionSet, const W *weights,
+                int stride, const double *in, int inputCount, double *sums,
+                int outputCount, int batchSize) {
+  switch (instructionSet) {
+#ifdef DENSE_LAYER_X86
+  case DenseLayer::AVX512:
+    accumulateAVX512(weights, stride, in, inputCount, sums, batchSize);
+    break;
+  case DenseLayer::AVX2:
+    accumulateAVX2(weights, stride, in, inputCount, sums, batchSize);
+    break;
+#endif
+  default:
+    accumulateScalar(weights, stride, in, inputCount, sums, outputCount,
+                     batchSize);
+    break;
+  }
+}
+
+} // namespace
+
+DenseLayer::InstructionSet DenseLayer::currentInstructionSet =
+    DenseLayer::bestInstructionSet();
+
+DenseLayer::DenseLayer(int _inputCount, int _outputCount, bool _singlePrecision)
+    : inputCount(_inputCount), outputCount(_outputCount),
+      stride((_outputCount + 7) / 8 * 8), singlePrecision(_singlePrecision) {
+  if (singlePrecision) {
+    singleWeights.assign(static_cast<size_t>(inputCount) * stride, 0.0f);
+  } else {
+    weights.assign(static_cast<size_t>(inputCount) * stride, 0.0);
+  }
+  biases.assign(stride, 0.0);
+}
+
+double DenseLayer::weight(int input, int output) const {
+  if (singlePrecision) {
+    return singleWeights[input * stride + output];
+  }
+  return weights[input * stride + output];
+}
+
+void DenseLayer::setWeight(int input, int output, double value) {
+  if (singlePrecision) {
+    singleWeights[input * stride + output] = static_cast<float>(value);
+  } else {
+    weights[input * stride + output] = value;
+  }
+}
+
+void DenseLayer::update(const double *in, double *out, Activation activation) {
+  updateBatch(in, out, 1, activation);
+}
+
+void DenseLayer::updateBatch(const double *in, double *out, int batchSize,
+                             Activation activation) {
+  sums.resize(static_cast<size_t>(batchSize) * stride);
+  for (int b = 0; b < batchSize; b++) {
+    std::copy(biases.begin(), biases.end(), sums.begin() + b * stride);
+  }
+  if (singlePrecision) {
+    accumulate(currentInstructionSet, singleWeights.data(), stride, in,
+               inputCount, sums.data(), outputCount, batchSize);
+  } else {
+    accumulate(currentInstructionSet, weights.data(), stride, in, inputCount,
+               sums.data(), outputCount, batchSize);
+  }
+  for (int b = 0; b < batchSize; b++) {
+    double *row = out + b * outputCount;
+    std::copy(sums.begin() + b * stride,
+              sums.begin() + b * stride + outputCount, row);
+    applyActivation(activation, row, outputCount);
+  }
+}
+
+void DenseLayer::applyActivation(Activation activation, double *V, int size) {
+  switch (activation) {
+  case NONE:
+    break;
+  case SIGMOID:
+    for (int i = 0; i < size; i++) {
+      V[i] = 2.0 * ((1.0 / (1.0 + std::exp(-1.0 * V[i]))) - .5); // Logistic function
+    }
+    break;
+  case TANH:
+    for (int i = 0; i < size; i++) {
+      V[i] = std::tanh(V[i]);
+    }
+    break;
+  case RELU:
+    for (int i = 0; i < size; i++) {
+      V[i] = std::max(0.0, V[i]);
+    }
+    break;
+  }
+}
+
+DenseLayer::InstructionSet DenseLayer::instructionSet() {
+  return currentInstructionSet;
+}
+
+void DenseLayer::setInstructionSet(InstructionSet requested) {
+  currentInstructionSet = std::min(requested, bestInstructionSet());
+}
+
+DenseLayer::InstructionSet DenseLayer::bestInstructionSet() {
+#ifdef DENSE_LAYER_X86
+  __builtin_cpu_init(); // (this may be called before static constructors)
+  if (__builtin_cpu_supports("avx512f")) {
+    return AVX512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return AVX2;
+  }
+#endif
+  return SCALAR;
+}
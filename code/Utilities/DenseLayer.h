@@ -0,0 +1,106 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+// DenseLayer is one fully connected layer of a neural network:
+//     out[o] = activation(bias[o] + in[0] * weight(0,o) + in[1] * weight(1,o) + ...)
+// The weights are kept in one row-major buffer (a row of output weights for
+// each input), with each row padded to a multiple of 64 bytes and the buffer
+// aligned to 64 bytes. update adds the rows in input order, so every output
+// is summed in exactly the same order (and gets exactly the same value) as
+// the nested loops in the brains did before, whichever kernel is used.
+// The kernel (AVX-512, AVX2 or plain C++) is picked at run time from what the
+// cpu supports. Weights can be stored as 32 bit floats (singlePrecision) to
+// halve the memory they use; sums are always made with doubles.
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+// std::allocator that aligns every allocation to a 64 byte cache line
+template <class T> class CacheLineAllocator {
+public:
+  using value_type = T;
+  static constexpr std::size_t alignment = 64;
+
+  CacheLineAllocator() = default;
+  template <class U> CacheLineAllocator(const CacheLineAllocator<U> &) {}
+
+  T *allocate(std::size_t n) {
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t(alignment)));
+  }
+  void deallocate(T *p, std::size_t) {
+    ::operator delete(p, std::align_val_t(alignment));
+  }
+};
+
+template <class T, class U>
+bool operator==(const CacheLineAllocator<T> &, const CacheLineAllocator<U> &) {
+  return true;
+}
+template <class T, class U>
+bool operator!=(const CacheLineAllocator<T> &, const CacheLineAllocator<U> &) {
+  return false;
+}
+
+class DenseLayer {
+public:
+  // activations applied to each output after the sums
+  //   SIGMOID is 2 * (logistic(x) - .5), i.e. in (-1,1), as in ANNBrain
+  enum Activation { NONE, SIGMOID, TANH, RELU };
+
+  // kernels, in order of preference
+  enum InstructionSet { SCALAR, AVX2, AVX512 };
+
+  DenseLayer() = default;
+  DenseLayer(int _inputCount, int _outputCount, bool _singlePrecision = false);
+
+  int inputs() const { return inputCount; }
+  int outputs() const { return outputCount; }
+  bool isSinglePrecision() const { return singlePrecision; }
+
+  // the weight from input to output (all weights start as 0.0)
+  double weight(int input, int output) const;
+  void setWeight(int input, int output, double value);
+  // the value each sum for output starts from (all biases start as 0.0)
+  double bias(int output) const { return biases[output]; }
+  void setBias(int output, double value) { biases[output] = value; }
+
+  // in has inputs() values, out gets outputs() values
+  void update(const double *in, double *out, Activation activation = NONE);
+  // update for batchSize independent sets of values. in holds batchSize rows
+  // of inputs() values and out gets batchSize rows of outputs() values. each
+  // weight row is used for every set before moving to the next row
+  void updateBatch(const double *in, double *out, int batchSize,
+                   Activation activation = NONE);
+
+  static void applyActivation(Activation activation, double *V, int size);
+
+  // the kernel used by every layer. setInstructionSet will not pick a kernel
+  // the cpu can not run (it uses the best one that is supported)
+  static InstructionSet instructionSet();
+  static void setInstructionSet(InstructionSet requested);
+  static InstructionSet bestInstructionSet();
+
+private:
+  int inputCount = 0;
+  int outputCount = 0;
+  int stride = 0; // padded row length (a multiple of 8 values)
+  bool singlePrecision = false;
+
+  std::vector<double, CacheLineAllocator<double>> weights;       // if !singlePrecision
+  std::vector<float, CacheLineAllocator<float>> singleWeights;   // if singlePrecision
+  std::vector<double, CacheLineAllocator<double>> biases;        // stride values
+  std::vector<double, CacheLineAllocator<double>> sums;          // stride values per set
+
+  static InstructionSet currentInstructionSet;
+};
@@ -535,25 +535,29 @@ std::pair<long, long> Loader::generatePopulation(const std::string &file_name) {
   }
 
   // for each ID in the organism+_data data (in future, we will be able to assume it's in the org file)
+  auto const column_names = org_file_data.column_names();
+  all_organism_infos.reserve(all_organism_infos.size() + org_file_data.row_count());
   for (const std::string &id : org_file_data.singleColumn("ID")) {
     // create an internal organism
     OrganismInfo org_info;
     org_info.orig_ID = std::stoi(id);
     org_info.from_file = file_name;
-    // stick all the attributes_map into the organism
-    for (const std::string &attribute : org_file_data.column_names()) {
-      // making sure to use the per-file-unique-ID
-      org_info.attributes_map.insert(std::make_pair(attribute, org_file_data.lookUp("ID", id, attribute)));
+    // stick all the attributes_map into the organism (the row is found through
+    // the csv's ID index, making sure to use the per-file-unique-ID)
+    auto const &row = org_file_data.row(org_file_data.lookUpRow("ID", id));
+    for (size_t c = 0; c < column_names.size(); c++) {
+      org_info.attributes_map.insert(std::make_pair(column_names[c], row[c]));
     }
     // Make sure the original ID,File,Update show up in the first generation's datamap store the original id
     org_info.attributes_map.insert(std::make_pair("loadedFrom.ID",id));
     // store the orginal file from which it was pulled
     org_info.attributes_map.insert(std::make_pair("loadedFrom.File",file_name));
     // store the orginal update
-    if (org_info.attributes_map.find("update") != org_info.attributes_map.end()) { 
-      org_info.attributes_map.insert(std::make_pair("loadedFrom.Update",org_file_data.lookUp("ID", id, "update")));
+    auto update = org_info.attributes_map.find("update");
+    if (update != org_info.attributes_map.end()) { 
+      org_info.attributes_map.insert(std::make_pair("loadedFrom.Update",update->second));
     }
-    all_organism_infos.push_back(org_info);
+    all_organism_infos.push_back(std::move(org_info));
   }
 
   return file_contents_pair;
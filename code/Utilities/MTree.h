@@ -638,10 +638,11 @@ public:
 class fromDataMapAve_MTree : public Abstract_MTree {
 public:
 	std::string key;
+	DataMap::KeyID keyID = -1; // interned key, so eval does not look up key
 
 	fromDataMapAve_MTree() {
 	}
-	fromDataMapAve_MTree(std::string _key) : key(_key) {}
+	fromDataMapAve_MTree(std::string _key) : key(_key), keyID(DataMap::lookupKey(_key)) {}
 	virtual ~fromDataMapAve_MTree() = default;
 	virtual std::shared_ptr<Abstract_MTree>
 		makeCopy(std::vector<std::shared_ptr<Abstract_MTree>> _branches = {}) override {
@@ -653,7 +654,7 @@ public:
 		eval(DataMap &dataMap, std::shared_ptr<ParametersTable> PT,
 			const std::vector<std::vector<double>> &vectorData) override {
 		std::vector<double> output;
-		output.push_back(dataMap.getAverage(key));
+		output.push_back(dataMap.getAverage(keyID));
 		return output;
 	}
 	virtual void show(int indent = 0) override {
@@ -668,10 +669,11 @@ public:
 class fromDataMapSum_MTree : public Abstract_MTree {
 public:
 	std::string key;
+	DataMap::KeyID keyID = -1; // interned key, so eval does not look up key
 
 	fromDataMapSum_MTree() {
 	}
-	fromDataMapSum_MTree(std::string _key) : key(_key) {}
+	fromDataMapSum_MTree(std::string _key) : key(_key), keyID(DataMap::lookupKey(_key)) {}
 	virtual ~fromDataMapSum_MTree() = default;
 	virtual std::shared_ptr<Abstract_MTree>
 		makeCopy(std::vector<std::shared_ptr<Abstract_MTree>> _branches = {}) override {
@@ -683,7 +685,7 @@ public:
 		eval(DataMap &dataMap, std::shared_ptr<ParametersTable> PT,
 			const std::vector<std::vector<double>> &vectorData) override {
 		std::vector<double> output;
-		output.push_back(dataMap.getSum(key));
+		output.push_back(dataMap.getSum(keyID));
 		return output;
 	}
 	virtual void show(int indent = 0) override {
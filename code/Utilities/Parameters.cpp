@@ -21,6 +21,7 @@ bool Parameters::save_files_stdout;
 std::string Parameters::save_file_prefix = "./";
 
 long long ParametersTable::nextTableID = 0;
+std::recursive_mutex ParametersTable::lookupMutex;
 
 template <> inline const bool ParametersEntry<bool>::getBool() { return get(); }
 
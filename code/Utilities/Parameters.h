@@ -17,6 +17,7 @@
 
 #include <type_traits>
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <map>
@@ -25,6 +26,7 @@
 #include <unordered_map>
 #include <set>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 const std::string MABE_pretty_logo =
@@ -511,6 +513,9 @@ public:
 class ParametersTable {
 private:
   static long long nextTableID;
+  // lookups add following entries to tables, and may be reached from worker
+  // threads (through ParameterLink::get), so they are serialized on this
+  static std::recursive_mutex lookupMutex;
   long long ID;
   std::string tableNameSpace;
   std::shared_ptr<ParametersTable> rootTable;
@@ -555,6 +560,8 @@ public:
 
   long long getID() { return ID; }
 
+  static std::recursive_mutex &getLookupMutex() { return lookupMutex; }
+
   std::shared_ptr<AbstractParametersEntry> getEntry(const std::string &name) {
     if (table.find(name) != table.end()) {
       return table[name];
@@ -740,6 +747,7 @@ public:
   }
 
   template <typename T> void lookup(const std::string &name, T &value) {
+    std::lock_guard<std::recursive_mutex> lock(lookupMutex);
     // check for the name in this table
     if (table.find(name) !=
         table.end()) { // if this table has entry called name
@@ -1275,12 +1283,12 @@ public:
   std::string name;
   std::shared_ptr<ParametersEntry<T>> entry; // points to a parameters entry
   std::shared_ptr<ParametersTable> table;    // the table that owns this entry
-  std::map<long long, std::shared_ptr<ParametersEntry<T>>>
-      entriesCache; // used to track entries in other name spaces
 
   ParameterLink(std::string _name, std::shared_ptr<ParametersEntry<T>> _entry,
                 std::shared_ptr<ParametersTable> _table)
-      : name(_name), entry(_entry), table(_table) {}
+      : name(_name), entry(_entry), table(_table) {
+    publish(EntriesCache());
+  }
 
   ~ParameterLink() = default;
 
@@ -1296,17 +1304,19 @@ public:
                 << std::endl;
       exit(1);
     }
-    auto mapRecord = entriesCache.find(lookupTable->getID());
-    if (mapRecord ==
-        entriesCache.end()) { // if the cache does not contain this table
-      T lookupValue;
-      lookupTable->lookup(name, lookupValue);
-      entriesCache[lookupTable->getID()] =
-          std::dynamic_pointer_cast<ParametersEntry<T>>(
-              lookupTable->getEntry(name));
-      return lookupValue;
+    const EntriesCache *entries = entriesCache.load(std::memory_order_acquire);
+    auto mapRecord = entries->find(lookupTable->getID());
+    if (mapRecord != entries->end()) {
+      return mapRecord->second->get();
     }
-    return entriesCache[lookupTable->getID()]->get();
+    // the cache does not contain this table
+    std::lock_guard<std::recursive_mutex> tableLock(
+        ParametersTable::getLookupMutex());
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    T lookupValue;
+    lookupTable->lookup(name, lookupValue);
+    cacheEntry(lookupTable);
+    return lookupValue;
   }
 
   // T lookup() {
@@ -1319,25 +1329,28 @@ public:
 
   void set(T value) {
     table->setParameter(name, value);
-    entriesCache[table->getID()] =
-        std::dynamic_pointer_cast<ParametersEntry<T>>(table->getEntry(name));
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    cacheEntry(table);
   }
 
   void set(T value, std::shared_ptr<ParametersTable> lookupTable) {
     lookupTable->setParameter(name, value);
-    entriesCache[lookupTable->getID()] =
-        std::dynamic_pointer_cast<ParametersEntry<T>>(
-            lookupTable->getEntry(name));
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    cacheEntry(lookupTable);
   }
 
-  void clearCache() { entriesCache.clear(); }
+  void clearCache() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    publish(EntriesCache());
+  }
 
   void clearCache(std::shared_ptr<ParametersTable> _table) {
-    auto mapRecord = entriesCache.find(_table->getID());
-    if (mapRecord !=
-        entriesCache
-            .end()) { // if the cache contain this _table(parameterstable)
-      entriesCache.erase(mapRecord); // remove the entry from the entiresCache
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    const EntriesCache *entries = entriesCache.load(std::memory_order_relaxed);
+    if (entries->count(_table->getID())) { // if the cache contain this _table
+      EntriesCache newEntries = *entries;
+      newEntries.erase(_table->getID()); // remove the entry from the cache
+      publish(std::move(newEntries));
     }
     // else do nothing, there is not entry for _table in this PL
   }
@@ -1348,6 +1361,35 @@ public:
       clearCache(table);
     }
   }
+
+private:
+  using EntriesCache = std::map<long long, std::shared_ptr<ParametersEntry<T>>>;
+
+  // entries for the tables this link has been used with (by table ID), so
+  // other name spaces are only looked up once. get(lookupTable) is called
+  // from worker threads (while evaluating or optimizing in parallel), so a
+  // map is never changed once it is published: get reads entriesCache with
+  // no lock, and a table which is not in it is looked up under cacheMutex and
+  // published in a new map. the maps replaced are kept (in publishedCaches)
+  // until the link is deleted, as a thread may still be reading one; a link
+  // sees few tables, so there are few of them
+  std::atomic<const EntriesCache *> entriesCache{nullptr};
+  std::vector<std::unique_ptr<const EntriesCache>> publishedCaches;
+  std::mutex cacheMutex; // held while publishing
+
+  void publish(EntriesCache entries) {
+    publishedCaches.push_back(
+        std::make_unique<const EntriesCache>(std::move(entries)));
+    entriesCache.store(publishedCaches.back().get(), std::memory_order_release);
+  }
+
+  // publish the cache with _table's entry for name added (or replaced)
+  void cacheEntry(const std::shared_ptr<ParametersTable> &_table) {
+    EntriesCache entries = *entriesCache.load(std::memory_order_relaxed);
+    entries[_table->getID()] =
+        std::dynamic_pointer_cast<ParametersEntry<T>>(_table->getEntry(name));
+    publish(std::move(entries));
+  }
 };
 
 class Parameters {
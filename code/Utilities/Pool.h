@@ -0,0 +1,242 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+// Pool recycles the memory of the objects that are made and destroyed every
+// generation (organisms, genomes and their blocks of sites, brains, gates and
+// data map storage). Memory is handed out in fixed size chunks, carved from
+// large slabs. When an object is destroyed (i.e. when an organism is killed
+// and its genomes and brains are released) its chunk goes onto a free list,
+// and the next object of about the same size reuses it. Once a run has grown
+// to its working size, a generation makes (almost) no heap allocations.
+//
+// Each thread has its own free lists, so threads do not have to lock to
+// allocate. A chunk freed on another thread than the one which made it (i.e.
+// organisms made by IslandsOptimizer workers and killed on the main thread)
+// simply joins the freeing thread's lists; when a thread's list gets long, it
+// is handed back to a shared list that any thread can take from.
+// Slabs are never given back to the system (they are reused for the rest of
+// the run). Requests larger than the largest chunk go straight to the heap.
+//
+// use Pool::make<T>(args...) in place of std::make_shared<T>(args...), and
+// Pool::Allocator<T> as the allocator of containers.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace Pool {
+
+// sizes up to 256 bytes are rounded up to a multiple of 16, larger sizes to
+// one of four steps per doubling (320, 384, 448, 512, 640, ... 8192)
+const size_t maxChunkSize = 8192;
+const int classCount = 36;
+const size_t slabSize = 64 * 1024;
+
+// the size class for bytes (bytes <= maxChunkSize), and its chunk size
+inline int sizeClass(size_t bytes, size_t &chunkSize) {
+  if (bytes <= 256) {
+    size_t sixteens = bytes == 0 ? 1 : (bytes + 15) / 16;
+    chunkSize = sixteens * 16;
+    return static_cast<int>(sixteens) - 1;
+  }
+  int shift = 8; // highest bit of (bytes - 1)
+  while (((bytes - 1) >> (shift + 1)) != 0) {
+    shift++;
+  }
+  size_t step = size_t(1) << (shift - 2);
+  chunkSize = (bytes + step - 1) & ~(step - 1);
+  return 16 + (shift - 8) * 4 + static_cast<int>(chunkSize / step) - 5;
+}
+
+namespace detail {
+
+struct FreeChunk {
+  FreeChunk *next;
+};
+
+// a free list handed from one thread to the others
+struct Batch {
+  FreeChunk *head;
+  size_t count;
+};
+
+// shared by all threads (made on first use and never destroyed, so that
+// objects destroyed at exit can still return their memory)
+struct Shared {
+  std::mutex mutex;
+  std::vector<Batch> batches[classCount];
+  std::vector<void *> slabs; // (kept so the slabs are still reachable)
+  std::atomic<long long> heapAllocations{0};
+  std::atomic<long long> heapBytes{0};
+};
+
+inline Shared &shared() {
+  static Shared *pool = new Shared();
+  return *pool;
+}
+
+// a thread's free lists. This has no destructor, so it can be used by
+// objects which are destroyed after the thread's other thread_locals.
+struct Cache {
+  FreeChunk *free[classCount];
+  size_t count[classCount];
+};
+
+// most chunks of a class a thread keeps before giving some back
+inline size_t keepLimit(size_t chunkSize) {
+  return 2 * (slabSize / chunkSize);
+}
+
+inline void giveBack(Cache &lists, int c) {
+  if (lists.count[c] == 0) {
+    return;
+  }
+  Shared &pool = shared();
+  std::lock_guard<std::mutex> lock(pool.mutex);
+  pool.batches[c].push_back({lists.free[c], lists.count[c]});
+  lists.free[c] = nullptr;
+  lists.count[c] = 0;
+}
+
+// gives a thread's free lists back when the thread ends
+struct CacheReturner {
+  Cache *lists;
+  ~CacheReturner() {
+    for (int c = 0; c < classCount; c++) {
+      giveBack(*lists, c);
+    }
+  }
+};
+
+inline Cache &cache() {
+  static thread_local Cache threadCache;
+  // made with the cache (not on the first refill) so that a thread which
+  // only frees objects made on other threads also gives its lists back
+  static thread_local CacheReturner returner{&threadCache};
+  (void)returner;
+  return threadCache;
+}
+
+// fill an empty free list, from another thread's batch or a new slab
+inline void refill(Cache &lists, int c, size_t chunkSize) {
+  Shared &pool = shared();
+  {
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    if (!pool.batches[c].empty()) {
+      lists.free[c] = pool.batches[c].back().head;
+      lists.count[c] = pool.batches[c].back().count;
+      pool.batches[c].pop_back();
+      return;
+    }
+  }
+  size_t chunks = std::max(size_t(8), slabSize / chunkSize);
+  char *slab = static_cast<char *>(::operator new(chunks * chunkSize));
+  {
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    pool.slabs.push_back(slab);
+  }
+  pool.heapAllocations.fetch_add(1, std::memory_order_relaxed);
+  pool.heapBytes.fetch_add(chunks * chunkSize, std::memory_order_relaxed);
+  for (size_t i = chunks; i-- > 0;) {
+    FreeChunk *chunk = reinterpret_cast<FreeChunk *>(slab + i * chunkSize);
+    chunk->next = lists.free[c];
+    lists.free[c] = chunk;
+  }
+  lists.count[c] = chunks;
+}
+
+} // namespace detail
+
+inline void *allocate(size_t bytes) {
+  if (bytes > maxChunkSize) {
+    detail::Shared &pool = detail::shared();
+    pool.heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    pool.heapBytes.fetch_add(bytes, std::memory_order_relaxed);
+    return ::operator new(bytes);
+  }
+  size_t chunkSize;
+  int c = sizeClass(bytes, chunkSize);
+  detail::Cache &lists = detail::cache();
+  if (lists.free[c] == nullptr) {
+    detail::refill(lists, c, chunkSize);
+  }
+  detail::FreeChunk *chunk = lists.free[c];
+  lists.free[c] = chunk->next;
+  lists.count[c]--;
+  return chunk;
+}
+
+// bytes must be the size given to allocate
+inline void deallocate(void *p, size_t bytes) {
+  if (p == nullptr) {
+    return;
+  }
+  if (bytes > maxChunkSize) {
+    ::operator delete(p);
+    return;
+  }
+  size_t chunkSize;
+  int c = sizeClass(bytes, chunkSize);
+  detail::Cache &lists = detail::cache();
+  detail::FreeChunk *chunk = static_cast<detail::FreeChunk *>(p);
+  chunk->next = lists.free[c];
+  lists.free[c] = chunk;
+  if (++lists.count[c] > detail::keepLimit(chunkSize)) {
+    detail::giveBack(lists, c);
+  }
+}
+
+// number of times the pools have gone to the heap (for a new slab or for a
+// request larger than maxChunkSize), and the bytes taken, since the start of
+// the run. Compare between generations to see how much a generation allocates.
+inline long long heapAllocations() {
+  return detail::shared().heapAllocations.load(std::memory_order_relaxed);
+}
+inline long long heapBytes() {
+  return detail::shared().heapBytes.load(std::memory_order_relaxed);
+}
+
+// an allocator for std containers (and std::allocate_shared) using the pools
+template <class T> class Allocator {
+public:
+  using value_type = T;
+
+  Allocator() = default;
+  template <class U> Allocator(const Allocator<U> &) {}
+
+  T *allocate(size_t n) {
+    static_assert(alignof(T) <= 16, "pool chunks are only 16 byte aligned");
+    return static_cast<T *>(Pool::allocate(n * sizeof(T)));
+  }
+  void deallocate(T *p, size_t n) { Pool::deallocate(p, n * sizeof(T)); }
+};
+
+template <class T, class U>
+bool operator==(const Allocator<T> &, const Allocator<U> &) {
+  return true;
+}
+template <class T, class U>
+bool operator!=(const Allocator<T> &, const Allocator<U> &) {
+  return false;
+}
+
+// std::make_shared, with the object (and its reference counts) in a pool
+template <class T, class... Args> std::shared_ptr<T> make(Args &&... args) {
+  return std::allocate_shared<T>(Allocator<T>(), std::forward<Args>(args)...);
+}
+
+} // namespace Pool
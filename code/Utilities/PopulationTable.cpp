@@ -0,0 +1,163 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include "PopulationTable.h"
+
+#include <iostream>
+
+void PopulationTable::setKeys(const std::vector<std::string> &_keys) {
+  keys = _keys;
+  columns.clear();
+  columns.resize(keys.size());
+  for (size_t c = 0; c < keys.size(); c++) {
+    columns[c].key = DataMap::lookupKey(keys[c]);
+  }
+  clearRows();
+}
+
+void PopulationTable::clearRows() {
+  for (auto &column : columns) {
+    column.numbers.clear();
+    column.strings.clear();
+    column.numberOffsets.assign(1, 0);
+    column.stringOffsets.assign(1, 0);
+    column.types.clear();
+    column.outputBehaviors.clear();
+  }
+  rows = 0;
+}
+
+void PopulationTable::addRow(DataMap &dataMap) {
+  for (size_t c = 0; c < columns.size(); c++) {
+    auto &column = columns[c];
+    auto entry = dataMap.findEntry(column.key);
+    if (entry == nullptr || entry->type == DataMap::NONE) {
+      std::cout << "  in PopulationTable::addRow - key \"" << keys[c]
+                << "\" can not be found in data map!\n  exiting." << std::endl;
+      exit(1);
+    }
+    column.numbers.insert(column.numbers.end(), entry->numbers.begin(),
+                          entry->numbers.end());
+    column.strings.insert(column.strings.end(), entry->strings.begin(),
+                          entry->strings.end());
+    column.numberOffsets.push_back(column.numbers.size());
+    column.stringOffsets.push_back(column.strings.size());
+    column.types.push_back(entry->type);
+    column.outputBehaviors.push_back(entry->outputBehavior);
+  }
+  rows++;
+}
+
+std::vector<double> PopulationTable::getRowAverages(size_t column) const {
+  auto &col = columns[column];
+  std::vector<double> averages(rows);
+  for (size_t r = 0; r < rows; r++) {
+    if (DataMap::listType(col.types[r]) == DataMap::STRING) {
+      std::cout << "  in PopulationTable::getRowAverages attempt to use with "
+                   "vector of type string associated key \""
+                << keys[column] << "\".\n  Cannot average strings!\n  Exiting."
+                << std::endl;
+      exit(1);
+    }
+    averages[r] = DataMap::average(col.numbers.data() + col.numberOffsets[r],
+                                   col.numberOffsets[r + 1] - col.numberOffsets[r]);
+  }
+  return averages;
+}
+
+DataMap PopulationTable::summarize(const std::vector<int> &outputBehaviors) const {
+  DataMap summary;
+  for (size_t c = 0; c < columns.size(); c++) {
+    summary.setOutputBehavior(columns[c].key, outputBehaviors[c]);
+    if (rows > 0) { // with no rows, the key is not added (only its behavior)
+      auto &entry = *summary.findEntry(columns[c].key);
+      auto averages = getRowAverages(c);
+      entry.numbers.assign(averages.begin(), averages.end());
+      entry.type = DataMap::DOUBLE;
+    }
+  }
+  return summary;
+}
+
+unsigned int PopulationTable::outputBehavior(size_t row, size_t column) const {
+  unsigned int OB = columns[column].outputBehaviors[row];
+  if (DataMap::listType(columns[column].types[row]) == DataMap::STRING) {
+    DataMap::checkStringOutputBehavior(keys[column], OB);
+  }
+  return OB;
+}
+
+void PopulationTable::constructHeaderAndDataStrings(size_t row,
+                                                    std::string &headerStr,
+                                                    std::string &dataStr) const {
+  headerStr = ""; // make sure the strings are clean
+  dataStr = "";
+  if (!columns.empty()) {
+    for (size_t c = 0; c < columns.size(); c++) {
+      auto &column = columns[c];
+      DataMap::appendHeaderAndDataStrings(
+          headerStr, dataStr, keys[c], column.types[row], outputBehavior(row, c),
+          column.numbers.data() + column.numberOffsets[row],
+          column.numberOffsets[row + 1] - column.numberOffsets[row],
+          column.strings.data() + column.stringOffsets[row],
+          column.stringOffsets[row + 1] - column.stringOffsets[row]);
+    }
+    headerStr.erase(headerStr.begin()); // clip off the leading separator
+    dataStr.erase(dataStr.begin());     // clip off the leading separator
+  }
+}
+
+void PopulationTable::constructHeaderAndDataCells(
+    size_t row, std::vector<std::string> &columnNames,
+    std::vector<std::string> &cells) const {
+  columnNames.clear();
+  cells.clear();
+  for (size_t c = 0; c < columns.size(); c++) {
+    auto &column = columns[c];
+    DataMap::appendHeaderAndDataCells(
+        columnNames, cells, keys[c], column.types[row], outputBehavior(row, c),
+        column.numbers.data() + column.numberOffsets[row],
+        column.numberOffsets[row + 1] - column.numberOffsets[row],
+        column.strings.data() + column.stringOffsets[row],
+        column.stringOffsets[row + 1] - column.stringOffsets[row]);
+  }
+}
+
+void PopulationTable::openAndWriteToFile(const std::string &fileName) const {
+  if (rows == 0) {
+    return;
+  }
+  if (BinaryTable::isBinaryTableFile(fileName)) {
+    std::vector<std::string> columnNames;
+    std::vector<std::string> cells;
+    for (size_t r = 0; r < rows; r++) {
+      constructHeaderAndDataCells(r, columnNames, cells);
+      FileManager::openAndWriteToBinaryFile(fileName, columnNames,
+                                            std::move(cells));
+    }
+    return;
+  }
+  // the header comes from the first row, all rows are collected and then
+  // written to the file at once
+  std::string headerStr;
+  std::string allData;
+  std::string rowHeaderStr;
+  std::string rowDataStr;
+  for (size_t r = 0; r < rows; r++) {
+    constructHeaderAndDataStrings(r, rowHeaderStr, rowDataStr);
+    if (r == 0) {
+      headerStr = rowHeaderStr;
+    } else {
+      allData += "\n";
+    }
+    allData += rowDataStr;
+  }
+  FileManager::openAndWriteToFile(fileName, allData, headerStr);
+}
@@ -0,0 +1,85 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+// PopulationTable holds the data for a set of keys from every organism in a
+// population, stored by column. Each column keeps the values from all rows
+// (organisms) in one contiguous vector, with offsets marking where each row's
+// values start, so summaries of the population and file output are made with
+// a few linear passes over each column rather than a DataMap lookup for every
+// key of every organism.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Data.h"
+
+class PopulationTable {
+private:
+  struct Column {
+    DataMap::KeyID key;
+    std::vector<double> numbers;      // values of all rows (bool, int, double)
+    std::vector<std::string> strings; // values of all rows (string)
+    // the values for row r are numbers[numberOffsets[r], numberOffsets[r+1])
+    // (and the same for strings)
+    std::vector<size_t> numberOffsets;
+    std::vector<size_t> stringOffsets;
+    std::vector<DataMap::dataMapType> types; // type of each row
+    std::vector<int> outputBehaviors;        // output behavior of each row
+  };
+
+  std::vector<std::string> keys;
+  std::vector<Column> columns;
+  size_t rows = 0;
+
+  // output behavior of column in row (exits if it can not be used for strings)
+  unsigned int outputBehavior(size_t row, size_t column) const;
+
+public:
+  PopulationTable() = default;
+  PopulationTable(const std::vector<std::string> &_keys) { setKeys(_keys); }
+
+  // set the keys (columns) in this table. this also removes all rows
+  void setKeys(const std::vector<std::string> &_keys);
+  const std::vector<std::string> &getKeys() const { return keys; }
+
+  // remove all rows (the storage is kept for the next time the table is filled)
+  void clearRows();
+
+  // add a row holding the values for each key in dataMap (every key must be
+  // in dataMap)
+  void addRow(DataMap &dataMap);
+
+  size_t rowCount() const { return rows; }
+
+  // return the average of each row's values for column (one value per row)
+  std::vector<double> getRowAverages(size_t column) const;
+
+  // make a DataMap with one list per column holding the average of each row
+  // (i.e. the average value of each key for each organism). outputBehaviors
+  // holds the output behavior for each column
+  DataMap summarize(const std::vector<int> &outputBehaviors) const;
+
+  // build header and data strings for one row in the same format as
+  // DataMap::constructHeaderAndDataStrings
+  void constructHeaderAndDataStrings(size_t row, std::string &headerStr,
+                                     std::string &dataStr) const;
+
+  // column names and values (without csv quotes) for one row, for binary
+  // table files
+  void constructHeaderAndDataCells(size_t row,
+                                   std::vector<std::string> &columnNames,
+                                   std::vector<std::string> &cells) const;
+
+  // write every row to fileName (with header if the file is new). files with
+  // the BinaryTable extension are written as binary tables
+  void openAndWriteToFile(const std::string &fileName) const;
+};
@@ -12,20 +12,149 @@
 // numbers. We provide a "common" number generator so the entire code
 // base can work with a global seed if they want, as well as some
 // utility functions for getting common number types easily.
+//
+// Independent "streams" can be made from the global seed with
+// getStreamSeed(a, b). A stream depends only on the global seed and (a, b),
+// so work that is split over threads can be given the same random numbers
+// no matter which thread does the work (see AbstractWorld::evaluateParallel).
+//
+// The generator type is std::mt19937 unless MABE_RANDOM_XOSHIRO256PP or
+// MABE_RANDOM_PCG32 is defined (cmake option MABE_RANDOM_GENERATOR). All of
+// the functions below also accept any of the generators explicitly.
 
 #pragma once
 
 #include <random>
 #include <climits> // UINT_MAX
+#include <cstdint>
+#include <limits>
+#include <type_traits>
 
 namespace Random {
 
+// SplitMix64 finalizer, used to turn seeds into well mixed generator states
+inline uint64_t mixBits(uint64_t z) {
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+// xoshiro256++ (Blackman and Vigna), 64 bit output, period 2^256 - 1.
+// jump() advances the generator 2^128 steps.
+class Xoshiro256pp {
+  uint64_t s[4];
+
+  static inline uint64_t rotl(const uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+public:
+  using result_type = uint64_t;
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  Xoshiro256pp(uint64_t value = 5489u) { seed(value); }
+
+  void seed(uint64_t value) {
+    uint64_t state = value;
+    for (auto &word : s) {
+      state += 0x9e3779b97f4a7c15ULL;
+      word = mixBits(state);
+    }
+  }
+
+  result_type operator()() {
+    const uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+    const uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+  }
+
+  void jump() {
+    static const uint64_t JUMP[] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                    0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+    uint64_t t[4] = {0, 0, 0, 0};
+    for (auto jumpWord : JUMP) {
+      for (int b = 0; b < 64; b++) {
+        if (jumpWord & (uint64_t(1) << b)) {
+          for (int i = 0; i < 4; i++) {
+            t[i] ^= s[i];
+          }
+        }
+        (*this)();
+      }
+    }
+    for (int i = 0; i < 4; i++) {
+      s[i] = t[i];
+    }
+  }
+};
+
+// PCG32 (O'Neill, pcg32_random_r / XSH RR), 32 bit output, period 2^64.
+// Different seeds give different increments and so unrelated sequences.
+class PCG32 {
+  uint64_t state;
+  uint64_t increment;
+
+public:
+  using result_type = uint32_t;
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  PCG32(uint64_t value = 5489u) { seed(value); }
+
+  void seed(uint64_t value) {
+    increment = (mixBits(value ^ 0xda3e39cb94b95bdbULL) << 1u) | 1u;
+    state = 0;
+    (*this)();
+    state += mixBits(value);
+    (*this)();
+  }
+
+  result_type operator()() {
+    const uint64_t oldState = state;
+    state = oldState * 6364136223846793005ULL + increment;
+    const uint32_t xorShifted =
+        static_cast<uint32_t>(((oldState >> 18u) ^ oldState) >> 27u);
+    const uint32_t rot = static_cast<uint32_t>(oldState >> 59u);
+    return (xorShifted >> rot) | (xorShifted << ((32 - rot) & 31));
+  }
+};
+
+#if defined(MABE_RANDOM_XOSHIRO256PP)
+using Generator = Xoshiro256pp;
+#elif defined(MABE_RANDOM_PCG32)
+using Generator = PCG32;
+#else
 using Generator = std::mt19937;
+#endif
+
+// used to keep numbers from being taken as generators in the functions below
+template <typename T>
+using EnableIfGenerator =
+    typename std::enable_if<!std::is_arithmetic<T>::value, int>::type;
 
 // for borrowed EMPIRICAL code support
 static const int32_t _BINOMIAL_TO_NORMAL = 50;     // if < n*p*(1-p)
 static const int32_t _BINOMIAL_TO_POISSON = 1000;  // if < n && !Normal approx Engine
 
+// Generator used by the calling thread in place of "common" (nullptr = use
+// "common"). Worker threads (see AbstractWorld::evaluateParallel) point this
+// at their own generator so that they never share state with other threads.
+inline Generator *&getThreadGenerator() {
+  static thread_local Generator *threadGenerator = nullptr;
+  return threadGenerator;
+}
+
 // Gives you access to the random number generator in general use
 inline Generator &getCommonGenerator() {
   // to seed, do get_common_generator().seed(value);
@@ -35,45 +164,97 @@ inline Generator &getCommonGenerator() {
   // called
   // after this, each time the function is called, a reference to the same
   // "common" is returned
+  if (getThreadGenerator() != nullptr) {
+    return *getThreadGenerator();
+  }
   return common;
 }
 
+// seed all streams are derived from (set by seed())
+inline uint64_t &getMasterSeed() {
+  static uint64_t masterSeed = 0;
+  return masterSeed;
+}
+
+// seed the common generator and the streams
+inline void seed(int value) {
+  getCommonGenerator().seed(value);
+  getMasterSeed() = static_cast<uint32_t>(value);
+}
+
+// seed for the stream identified by a and b (i.e. an evaluation and an
+// organism). The result depends only on the master seed, a and b.
+inline uint64_t getStreamSeed(uint64_t a, uint64_t b = 0) {
+  uint64_t z = mixBits(getMasterSeed() + 0x9e3779b97f4a7c15ULL);
+  z = mixBits(z ^ (a + 0x3c6ef372fe94f82aULL));
+  return mixBits(z ^ (b + 0xdaa66d2c7ddf743fULL));
+}
+
+// seed any generator from a 64 bit value
+inline void seedGenerator(std::mt19937 &gen, uint64_t value) {
+  std::seed_seq sequence{static_cast<uint32_t>(value),
+                         static_cast<uint32_t>(value >> 32)};
+  gen.seed(sequence);
+}
+inline void seedGenerator(Xoshiro256pp &gen, uint64_t value) { gen.seed(value); }
+inline void seedGenerator(PCG32 &gen, uint64_t value) { gen.seed(value); }
+
+// while one of these exists, Random:: calls on this thread use "gen" in
+// place of the common generator
+class UseGenerator {
+  Generator *previous;
+
+public:
+  UseGenerator(Generator &gen) : previous(getThreadGenerator()) {
+    getThreadGenerator() = &gen;
+  }
+  ~UseGenerator() { getThreadGenerator() = previous; }
+  UseGenerator(const UseGenerator &) = delete;
+  UseGenerator &operator=(const UseGenerator &) = delete;
+};
+
 // result = Random::getDouble(7.2, 9.5);
 // result is in [7.2, 9.5)
+template <typename Engine = Generator, EnableIfGenerator<Engine> = 0>
 inline double getDouble(const double lower, const double upper,
-                        Generator &gen = getCommonGenerator()) {
+                        Engine &gen = getCommonGenerator()) {
   return std::uniform_real_distribution<double>(lower, upper)(gen);
 }
 
 // result = Random::getDouble(9.5);
 // result is in [0, 9.5)
+template <typename Engine = Generator, EnableIfGenerator<Engine> = 0>
 inline double getDouble(const double upper,
-                        Generator &gen = getCommonGenerator()) {
+                        Engine &gen = getCommonGenerator()) {
   return getDouble(0, upper, gen);
 }
 
 // result = Random::getInt(7, 9);
 // result is in [7, 9]
+template <typename Engine = Generator, EnableIfGenerator<Engine> = 0>
 inline int getInt(const int lower, const int upper,
-                  Generator &gen = getCommonGenerator()) {
+                  Engine &gen = getCommonGenerator()) {
   return std::uniform_int_distribution<int>(lower, upper)(gen);
 }
 
 // result = Random::getInt(9);
 // result is in [0, 9]
-inline int getInt(const int upper, Generator &gen = getCommonGenerator()) {
+template <typename Engine = Generator, EnableIfGenerator<Engine> = 0>
+inline int getInt(const int upper, Engine &gen = getCommonGenerator()) {
   return getInt(0, upper, gen);
 }
 
 // Returns a random valid index of a container which has "container_size"
 // elements.
+template <typename Engine = Generator, EnableIfGenerator<Engine> = 0>
 inline int getIndex(const int container_size,
-                    Generator &gen = getCommonGenerator()) {
+                    Engine &gen = getCommonGenerator()) {
   return getInt(0, container_size - 1, gen);
 }
 
 // Returns true with "probability" probability
-inline bool P(const double probability, Generator &gen = getCommonGenerator()) {
+template <typename Engine = Generator, EnableIfGenerator<Engine> = 0>
+inline bool P(const double probability, Engine &gen = getCommonGenerator()) {
   return std::bernoulli_distribution(probability)(gen);
 }
 
@@ -83,7 +264,8 @@ inline bool P(const double probability, Generator &gen = getCommonGenerator()) {
  *
  * @param mean The mean of the distribution.
  **/
-inline uint32_t EmpGetRandPoisson(const double mean, Generator &gen = getCommonGenerator()) {
+template <typename Engine = Generator, EnableIfGenerator<Engine> = 0>
+inline uint32_t EmpGetRandPoisson(const double mean, Engine &gen = getCommonGenerator()) {
 	// Draw from a Poisson Dist with mean; if cannot calculate, return UINT_MAX.
 	// Uses Rejection Method
 	const double a = exp(-mean);
@@ -101,7 +283,8 @@ inline uint32_t EmpGetRandPoisson(const double mean, Generator &gen = getCommonG
  * (FROM EMPIRICAL)
  * Generate a random variable drawn from a Poisson distribution.
  **/
-inline uint32_t EmpGetRandPoisson(const double n, double p, Generator &gen = getCommonGenerator()) {
+template <typename Engine = Generator, EnableIfGenerator<Engine> = 0>
+inline uint32_t EmpGetRandPoisson(const double n, double p, Engine &gen = getCommonGenerator()) {
   //emp_assert(p >= 0.0 && p <= 1.0, p);
   // Optimizes for speed and calculability using symetry of the distribution
   if (p > .5) return (uint32_t)n - EmpGetRandPoisson(n * (1 - p), gen);
@@ -116,12 +299,13 @@ inline uint32_t EmpGetRandPoisson(const double n, double p, Generator &gen = get
  * @see Random::GetApproxRandBinomial
  * @see emp::Binomial in source/tools/Distribution.h
  **/
-inline uint32_t EmpGetFullRandBinomial(const double n, const double p, Generator &gen = getCommonGenerator()) {
+template <typename Engine = Generator, EnableIfGenerator<Engine> = 0>
+inline uint32_t EmpGetFullRandBinomial(const double n, const double p, Engine &gen = getCommonGenerator()) {
   //emp_assert(p >= 0.0 && p <= 1.0, p);
   //emp_assert(n >= 0.0, n);
   // Actually try n Bernoulli events, each with probability p
   uint32_t k = 0;
-  for (uint32_t i = 0; i < n; ++i) if (P(p)) k++;
+  for (uint32_t i = 0; i < n; ++i) if (P(p, gen)) k++;
   return k;
 }
 
@@ -137,7 +321,8 @@ inline uint32_t EmpGetFullRandBinomial(const double n, const double p, Generator
  * @see Random::GetFullRandBinomial
  * @see emp::Binomial in source/tools/Distribution.h
  **/
-inline uint32_t EmpGetRandBinomial(const int n, const double p, Generator &gen = getCommonGenerator()) {
+template <typename Engine = Generator, EnableIfGenerator<Engine> = 0>
+inline uint32_t EmpGetRandBinomial(const int n, const double p, Engine &gen = getCommonGenerator()) {
   //emp_assert(p >= 0.0 && p <= 1.0, p);
   //emp_assert(n >= 0.0, n);
   // Approximate Binomial if appropriate
@@ -159,8 +344,9 @@ inline uint32_t EmpGetRandBinomial(const int n, const double p, Generator &gen =
 
 // Returns how many successes you get by doing "tests" number of trials
 // with "probability" of success
+template <typename Engine = Generator, EnableIfGenerator<Engine> = 0>
 inline int getBinomial(const int tests, const double probability,
-                       Generator &gen = getCommonGenerator()) {
+                       Engine &gen = getCommonGenerator()) {
   return EmpGetRandBinomial(tests, probability, gen);
   //return std::binomial_distribution<>(tests, probability)(gen);
 }
@@ -168,8 +354,9 @@ inline int getBinomial(const int tests, const double probability,
 // Returns a double drawn from a normal (Gaussian) distribution with mean "mu"
 // and
 // standard deviation "sigma".
+template <typename Engine = Generator, EnableIfGenerator<Engine> = 0>
 inline double getNormal(const double mu, const double sigma,
-                        Generator &gen = getCommonGenerator()) {
+                        Engine &gen = getCommonGenerator()) {
   return std::normal_distribution<>(mu, sigma)(gen);
 }
 }
@@ -0,0 +1,69 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+// SiteSampler picks the sites hit by a per site mutation rate, i.e. each of
+// n sites is hit independently with probability rate. Rather than trying n
+// Bernoulli events it draws the gap to the next hit from a geometric
+// distribution, so walking over a genome costs one draw per hit (plus one),
+// and the number of hits is exactly Binomial(n, rate). (Random::getBinomial
+// tries every site when n < 1000, and uses a Poisson approximation above.)
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+
+#include "Random.h"
+
+class SiteSampler {
+public:
+  SiteSampler(double rate_ = 0)
+      : rate(rate_), logMiss((rate_ > 0 && rate_ < 1) ? std::log1p(-rate_) : 0) {}
+
+  double getRate() const { return rate; }
+
+  // the first hit site at or after site (max int if there are no more hits)
+  template <typename Engine = Random::Generator>
+  int next(int site, Engine &gen = Random::getCommonGenerator()) const {
+    if (rate <= 0) {
+      return std::numeric_limits<int>::max();
+    }
+    if (rate >= 1) {
+      return site;
+    }
+    // sites missed before the next hit, from u in (0,1]
+    double skip =
+        std::floor(std::log(1.0 - Random::getDouble(1.0, gen)) / logMiss);
+    if (skip >= static_cast<double>(std::numeric_limits<int>::max() - site)) {
+      return std::numeric_limits<int>::max();
+    }
+    return site + static_cast<int>(skip);
+  }
+
+  // call f(site) for each hit site in [0,sites), in order
+  template <typename F, typename Engine = Random::Generator>
+  void forEach(int sites, F f, Engine &gen = Random::getCommonGenerator()) const {
+    for (int site = next(0, gen); site < sites; site = next(site + 1, gen)) {
+      f(site);
+    }
+  }
+
+  // how many of sites are hit (drawn from Binomial(sites, rate))
+  template <typename Engine = Random::Generator>
+  int count(int sites, Engine &gen = Random::getCommonGenerator()) const {
+    int hits = 0;
+    forEach(sites, [&hits](int) { hits++; }, gen);
+    return hits;
+  }
+
+private:
+  double rate;
+  double logMiss; // log(1 - rate)
+};
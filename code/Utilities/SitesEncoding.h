@@ -0,0 +1,261 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+// SitesEncoding packs genome sites into bytes, and wraps the bytes in base64
+// so that they can be saved in a csv column in place of the usual comma
+// separated list of sites (see GENOME-sitesEncoding).
+//   unsigned char sites are one byte each
+//   int sites are zigzag varints (one byte for values in [-64,63])
+//   double sites are their 8 bytes (so, unlike text, they load back exactly)
+//   bool sites are packed 8 to a byte
+// A SiteWriter appends sites to a string of bytes, and a SiteReader reads them
+// back; the number of sites is not saved, so the reader must know it.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace SitesEncoding {
+
+// sites strings which start with binaryPrefix are base64 encoded bytes
+const std::string binaryPrefix = "base64:";
+
+inline bool isBinary(const std::string &sites) {
+  return sites.compare(0, binaryPrefix.size(), binaryPrefix) == 0;
+}
+
+inline std::string toBase64(const std::string &bytes) {
+  static const char *digits =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string text = binaryPrefix;
+  text.reserve(binaryPrefix.size() + ((bytes.size() + 2) / 3) * 4);
+  size_t i = 0;
+  for (; i + 2 < bytes.size(); i += 3) {
+    uint32_t group = ((uint8_t)bytes[i] << 16) | ((uint8_t)bytes[i + 1] << 8) |
+                     (uint8_t)bytes[i + 2];
+    text += digits[(group >> 18) & 63];
+    text += digits[(group >> 12) & 63];
+    text += digits[(group >> 6) & 63];
+    text += digits[group & 63];
+  }
+  if (i < bytes.size()) { // 1 or 2 bytes left, padded with '='
+    uint32_t group = (uint8_t)bytes[i] << 16;
+    if (i + 1 < bytes.size()) {
+      group |= (uint8_t)bytes[i + 1] << 8;
+    }
+    text += digits[(group >> 18) & 63];
+    text += digits[(group >> 12) & 63];
+    text += (i + 1 < bytes.size()) ? digits[(group >> 6) & 63] : '=';
+    text += '=';
+  }
+  return text;
+}
+
+// the bytes in text (which must start with binaryPrefix)
+inline std::string fromBase64(const std::string &text) {
+  static const struct Table {
+    int8_t values[256];
+    Table() {
+      memset(values, -1, sizeof(values));
+      const char *digits =
+          "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+      for (int i = 0; i < 64; i++) {
+        values[(uint8_t)digits[i]] = i;
+      }
+    }
+  } table;
+  std::string bytes;
+  bytes.reserve(((text.size() - binaryPrefix.size()) / 4) * 3);
+  uint32_t group = 0;
+  int bits = 0;
+  for (size_t i = binaryPrefix.size(); i < text.size(); i++) {
+    int value = table.values[(uint8_t)text[i]];
+    if (value < 0) {
+      if (text[i] == '=') {
+        break;
+      }
+      std::cout << "  In SitesEncoding::fromBase64 :: found '" << text[i]
+                << "' in base64 sites.\n  exiting" << std::endl;
+      exit(1);
+    }
+    group = (group << 6) | value;
+    bits += 6;
+    if (bits >= 8) {
+      bits -= 8;
+      bytes += (char)((group >> bits) & 0xFF);
+    }
+  }
+  return bytes;
+}
+
+template <class T> class SiteWriter;
+template <class T> class SiteReader;
+
+template <> class SiteWriter<unsigned char> {
+public:
+  explicit SiteWriter(std::string &bytes_) : bytes(bytes_) {}
+  void add(unsigned char value) { bytes += (char)value; }
+  void finish() {}
+
+private:
+  std::string &bytes;
+};
+
+template <> class SiteWriter<int> {
+public:
+  explicit SiteWriter(std::string &bytes_) : bytes(bytes_) {}
+  void add(int value) {
+    // zigzag, so that small negative values are small too
+    uint32_t zigzag = ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+    while (zigzag >= 0x80) {
+      bytes += (char)((zigzag & 0x7F) | 0x80);
+      zigzag >>= 7;
+    }
+    bytes += (char)zigzag;
+  }
+  void finish() {}
+
+private:
+  std::string &bytes;
+};
+
+template <> class SiteWriter<double> {
+public:
+  explicit SiteWriter(std::string &bytes_) : bytes(bytes_) {}
+  void add(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; i++) { // (little endian on every platform)
+      bytes += (char)((bits >> (8 * i)) & 0xFF);
+    }
+  }
+  void finish() {}
+
+private:
+  std::string &bytes;
+};
+
+template <> class SiteWriter<bool> {
+public:
+  explicit SiteWriter(std::string &bytes_) : bytes(bytes_) {}
+  void add(bool value) {
+    pending |= (uint8_t)value << pendingCount;
+    if (++pendingCount == 8) {
+      finish();
+    }
+  }
+  // write out a partly filled last byte
+  void finish() {
+    if (pendingCount > 0) {
+      bytes += (char)pending;
+      pending = 0;
+      pendingCount = 0;
+    }
+  }
+
+private:
+  std::string &bytes;
+  uint8_t pending = 0;
+  int pendingCount = 0;
+};
+
+// reads sites from bytes, starting at position (which is moved on)
+class ByteSource {
+public:
+  ByteSource(const std::string &bytes_, size_t &position_)
+      : bytes(bytes_), position(position_) {}
+
+protected:
+  uint8_t nextByte() {
+    if (position >= bytes.size()) {
+      std::cout << "  In SitesEncoding::SiteReader :: ran out of bytes while "
+                   "reading binary sites.\n  exiting"
+                << std::endl;
+      exit(1);
+    }
+    return (uint8_t)bytes[position++];
+  }
+
+  const std::string &bytes;
+  size_t &position;
+};
+
+// exit if reading sites stopped short of the end of bytes (the lengths they
+// were read with are not the lengths they were saved with)
+inline void checkAllRead(const std::string &bytes, size_t position) {
+  if (position != bytes.size()) {
+    std::cout << "  In SitesEncoding::checkAllRead :: " << bytes.size() - position
+              << " bytes of binary sites were not read (the saved length does "
+                 "not match the sites).\n  exiting"
+              << std::endl;
+    exit(1);
+  }
+}
+
+template <> class SiteReader<unsigned char> : public ByteSource {
+public:
+  using ByteSource::ByteSource;
+  unsigned char next() { return nextByte(); }
+};
+
+template <> class SiteReader<int> : public ByteSource {
+public:
+  using ByteSource::ByteSource;
+  int next() {
+    uint32_t zigzag = 0;
+    int shift = 0;
+    uint8_t byte;
+    do {
+      byte = nextByte();
+      zigzag |= (uint32_t)(byte & 0x7F) << shift;
+      shift += 7;
+    } while ((byte & 0x80) && shift < 35);
+    return (int)(zigzag >> 1) ^ -(int)(zigzag & 1);
+  }
+};
+
+template <> class SiteReader<double> : public ByteSource {
+public:
+  using ByteSource::ByteSource;
+  double next() {
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; i++) {
+      bits |= (uint64_t)nextByte() << (8 * i);
+    }
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+};
+
+template <> class SiteReader<bool> : public ByteSource {
+public:
+  using ByteSource::ByteSource;
+  bool next() {
+    if (bitCount == 0) {
+      current = nextByte();
+      bitCount = 8;
+    }
+    bool value = current & 1;
+    current >>= 1;
+    bitCount--;
+    return value;
+  }
+
+private:
+  uint8_t current = 0;
+  int bitCount = 0;
+};
+
+} // namespace SitesEncoding
@@ -68,7 +68,7 @@ void {{MODULE_NAME}}Optimizer::optimize(std::vector<std::shared_ptr<Organism>> &
 
 	for (int i = 0; i < popSize; i++) {
         // record number of offspring each org produced
-		population[i]->dataMap.set("tournament_numOffspring", population[i]->offspringCount);
+		population[i]->dataMap.set("tournament_numOffspring", population[i]->getOffspringCount());
 	}
 
 	std::cout << "max = " << std::to_string(maxScore) << "   ave = " << std::to_string(aveScore);
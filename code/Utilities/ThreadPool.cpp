@@ -0,0 +1,93 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(int threadCount) {
+  threadCount = resolveThreadCount(threadCount);
+  for (int threadID = 1; threadID < threadCount; threadID++) {
+    workers.emplace_back(&ThreadPool::workerLoop, this, threadID);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    stopping = true;
+  }
+  startCondition.notify_all();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+
+int ThreadPool::resolveThreadCount(int requested) {
+  if (requested > 0) {
+    return requested;
+  }
+  int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+  return hardwareThreads > 0 ? hardwareThreads : 1;
+}
+
+void ThreadPool::parallelFor(size_t count,
+                             const std::function<void(size_t, int)> &task) {
+  if (count == 0) {
+    return;
+  }
+  if (workers.empty() || count == 1) { // nothing to gain from the workers
+    for (size_t index = 0; index < count; index++) {
+      task(index, 0);
+    }
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    currentTask = &task;
+    taskCount = count;
+    nextIndex = 0;
+    busyWorkers = static_cast<int>(workers.size());
+    generation++;
+  }
+  startCondition.notify_all();
+  runTasks(0); // the calling thread also does work
+  std::unique_lock<std::mutex> lock(poolMutex);
+  doneCondition.wait(lock, [this] { return busyWorkers == 0; });
+  currentTask = nullptr;
+}
+
+void ThreadPool::workerLoop(int threadID) {
+  long long lastGeneration = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(poolMutex);
+      startCondition.wait(lock, [this, lastGeneration] {
+        return stopping || generation != lastGeneration;
+      });
+      if (stopping) {
+        return;
+      }
+      lastGeneration = generation;
+    }
+    runTasks(threadID);
+    {
+      std::lock_guard<std::mutex> lock(poolMutex);
+      busyWorkers--;
+      if (busyWorkers == 0) {
+        doneCondition.notify_one();
+      }
+    }
+  }
+}
+
+void ThreadPool::runTasks(int threadID) {
+  for (size_t index = nextIndex++; index < taskCount; index = nextIndex++) {
+    (*currentTask)(index, threadID);
+  }
+}
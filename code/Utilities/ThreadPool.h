@@ -0,0 +1,64 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+// A small fixed size pool of worker threads. The only operation is
+// parallelFor, which hands out the indices [0,count) to the workers (and to
+// the calling thread) and returns once every index has been processed.
+// The pool is not reentrant: a task must not call parallelFor on the same pool.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+  // threadCount is the total number of threads working on a parallelFor,
+  // including the calling thread (so 1 = no worker threads are created)
+  ThreadPool(int threadCount);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // number of threads that work on a parallelFor (including the caller)
+  int size() const { return static_cast<int>(workers.size()) + 1; }
+
+  // call task(index, threadID) for every index in [0,count). threadID is in
+  // [0,size()) and is 0 for the calling thread. blocks until all are done.
+  void parallelFor(size_t count,
+                   const std::function<void(size_t, int)> &task);
+
+  // convert a thread count parameter to an actual count (0 or less = one
+  // thread per hardware thread)
+  static int resolveThreadCount(int requested);
+
+private:
+  void workerLoop(int threadID);
+  void runTasks(int threadID);
+
+  std::vector<std::thread> workers;
+
+  std::mutex poolMutex;
+  std::condition_variable startCondition;
+  std::condition_variable doneCondition;
+
+  const std::function<void(size_t, int)> *currentTask = nullptr;
+  size_t taskCount = 0;
+  std::atomic<size_t> nextIndex{0};
+  int busyWorkers = 0;
+  long long generation = 0; // incremented for each parallelFor
+  bool stopping = false;
+};
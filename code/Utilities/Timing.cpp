@@ -0,0 +1,191 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include "Timing.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+#if defined(__unix__) || defined(__unix) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include "Data.h"
+#include "Pool.h"
+
+namespace Timing {
+
+namespace {
+
+const char *phaseNames[PHASE_COUNT] = {
+    "evaluate",    "optimize",       "archive",   "cleanup",
+    "brainBuild",  "genomeMutation", "fileOutput"};
+
+std::chrono::steady_clock::time_point runStart;
+std::chrono::steady_clock::time_point updateStart;
+long long runStartTotals[PHASE_COUNT];
+long long lastTotals[PHASE_COUNT];
+long long lastHeapAllocations = 0;
+long long lastHeapBytes = 0;
+int updatesRecorded = 0;
+
+double seconds(long long nanoseconds) { return nanoseconds / 1e9; }
+
+// how many timers are timing a phase, and since when its clock has run
+struct Clock {
+  std::mutex mutex;
+  std::atomic<int> timers{0};
+  std::chrono::steady_clock::time_point since;
+};
+Clock clocks[PHASE_COUNT];
+
+} // namespace
+
+bool running(Phase phase) {
+  return clocks[phase].timers.load(std::memory_order_relaxed) > 0;
+}
+
+void startTimer(Phase phase) {
+  Clock &clock = clocks[phase];
+  std::lock_guard<std::mutex> lock(clock.mutex);
+  if (clock.timers.fetch_add(1, std::memory_order_relaxed) == 0) {
+    clock.since = std::chrono::steady_clock::now();
+  }
+}
+
+void stopTimer(Phase phase) {
+  Clock &clock = clocks[phase];
+  std::lock_guard<std::mutex> lock(clock.mutex);
+  if (clock.timers.fetch_sub(1, std::memory_order_relaxed) == 1) {
+    total(phase).fetch_add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - clock.since)
+            .count(),
+        std::memory_order_relaxed);
+  }
+}
+
+long long peakMemoryKB() {
+#if defined(__unix__) || defined(__unix) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#if defined(__APPLE__)
+  return usage.ru_maxrss / 1024; // (bytes on macOS)
+#else
+  return usage.ru_maxrss;
+#endif
+#else
+  return 0;
+#endif
+}
+
+void startRun() {
+  runStart = updateStart = std::chrono::steady_clock::now();
+  for (int p = 0; p < PHASE_COUNT; p++) {
+    runStartTotals[p] = lastTotals[p] = total(static_cast<Phase>(p)).load();
+  }
+  lastHeapAllocations = Pool::heapAllocations();
+  lastHeapBytes = Pool::heapBytes();
+  updatesRecorded = 0;
+}
+
+PoolUsage finishUpdate(int update) {
+  long long heapAllocations = Pool::heapAllocations();
+  long long heapBytes = Pool::heapBytes();
+  PoolUsage usage = {heapAllocations - lastHeapAllocations,
+                     heapBytes - lastHeapBytes};
+  lastHeapAllocations = heapAllocations;
+  lastHeapBytes = heapBytes;
+  if (!enabled()) {
+    return usage;
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  std::stringstream row;
+  row << std::fixed << std::setprecision(6) << update;
+  for (int p = 0; p < PHASE_COUNT; p++) {
+    long long phaseTotal = total(static_cast<Phase>(p)).load();
+    row << FileManager::separator << seconds(phaseTotal - lastTotals[p]);
+    lastTotals[p] = phaseTotal;
+  }
+  row << FileManager::separator
+      << seconds(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     now - updateStart)
+                     .count());
+  row << FileManager::separator << usage.allocations
+      << FileManager::separator << usage.bytes / 1024
+      << FileManager::separator << peakMemoryKB();
+
+  std::string header = "update";
+  for (int p = 0; p < PHASE_COUNT; p++) {
+    header += FileManager::separator + std::string(phaseNames[p]);
+  }
+  for (auto column : {"updateTotal", "poolHeapAllocations", "poolHeapKB",
+                      "peakMemoryKB"}) {
+    header += FileManager::separator + std::string(column);
+  }
+  FileManager::openAndWriteToFile("timing.csv", row.str(), header);
+  updatesRecorded++;
+  // (the time taken to write this row is counted in the next update)
+  updateStart = now;
+  return usage;
+}
+
+void printSummary() {
+  long long runTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - runStart)
+                          .count();
+  int updates = updatesRecorded > 0 ? updatesRecorded : 1;
+  std::cout << "\nTiming (" << updatesRecorded << " updates, "
+            << std::fixed << std::setprecision(3) << seconds(runTime)
+            << " seconds):\n";
+  std::cout << "  " << std::left << std::setw(18) << "phase" << std::right
+            << std::setw(12) << "seconds" << std::setw(16) << "ms/update"
+            << std::setw(10) << "% run" << std::setw(12) << "% parent"
+            << "\n";
+  auto runTotal = [](Phase phase) {
+    return total(phase).load() - runStartTotals[phase];
+  };
+  for (int p = 0; p < PHASE_COUNT; p++) {
+    Phase phase = static_cast<Phase>(p);
+    long long phaseTotal = runTotal(phase);
+    // brain build and genome mutation are parts of optimize, so they are
+    // indented and shown as a share of it (and not of the run)
+    bool part = parent(phase) != phase;
+    std::string name = (part ? "  " : "") + std::string(phaseNames[p]);
+    long long whole = part ? runTotal(parent(phase)) : runTime;
+    std::string share = "-";
+    if (whole > 0) {
+      std::stringstream percent;
+      percent << std::fixed << std::setprecision(1)
+              << 100.0 * phaseTotal / whole;
+      share = percent.str();
+    }
+    std::cout << "  " << std::left << std::setw(18) << name << std::right
+              << std::setw(12) << std::setprecision(3) << seconds(phaseTotal)
+              << std::setw(16) << std::setprecision(3)
+              << seconds(phaseTotal) * 1000.0 / updates << std::setw(10)
+              << (part ? "" : share) << std::setw(12) << (part ? share : "")
+              << "\n";
+  }
+  std::cout << "  pool heap allocations (only the object pools', not all heap "
+               "allocations): "
+            << Pool::heapAllocations() << " (" << Pool::heapBytes() / 1024
+            << " KB)\n  peak memory: " << peakMemoryKB() << " KB\n";
+  std::cout << std::defaultfloat << std::setprecision(6) << std::flush;
+}
+
+} // namespace Timing
@@ -0,0 +1,116 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+// Timing measures how long each phase of an update takes, so that a change
+// in parameters (or code) which slows a run down can be traced to a phase.
+// The main loop times evaluate, optimize, archive and cleanup; inside them
+// brain building, genome mutation and file output are timed where they
+// happen. Put a ScopedTimer at the top of a block to add the time spent in
+// the block to a phase.
+// Timing is off unless GLOBAL-recordTiming is set. Timers are not compiled
+// out when it is off: each one still checks enabled() at runtime, but never
+// reads the clock or touches the totals.
+// A phase's clock runs while at least one timer (on any thread) is timing
+// it, so a phase timed on several threads at once (brain building and genome
+// mutation, which IslandsOptimizer workers do in parallel) counts wall time,
+// not the sum over threads. Brain building and genome mutation are only
+// timed while optimize is running (NBackWorld, for one, also makes offspring
+// while it evaluates), so they are never more than optimize.
+// The per update report and end of run summary are in Timing.cpp.
+
+#pragma once
+
+#include <atomic>
+
+namespace Timing {
+
+enum Phase {
+  EVALUATE,
+  OPTIMIZE,
+  ARCHIVE,
+  CLEANUP,
+  BRAIN_BUILD,     // (part of optimize)
+  GENOME_MUTATION, // (part of optimize)
+  FILE_OUTPUT,     // (wherever files are written: archive, the end of each
+                   // update, and timing.csv itself)
+  PHASE_COUNT
+};
+
+// set from GLOBAL-recordTiming before the run starts
+inline bool &enabled() {
+  static bool recordTiming = false;
+  return recordTiming;
+}
+
+// nanoseconds spent in phase since the start of the run
+inline std::atomic<long long> &total(Phase phase) {
+  static std::atomic<long long> totals[PHASE_COUNT];
+  return totals[phase];
+}
+
+// the phase that phase is a part of (or phase, if it is not part of another)
+inline Phase parent(Phase phase) {
+  return (phase == BRAIN_BUILD || phase == GENOME_MUTATION) ? OPTIMIZE : phase;
+}
+
+// true while at least one timer is timing phase
+bool running(Phase phase);
+
+// start and stop phase's clock for one timer (see ScopedTimer)
+void startTimer(Phase phase);
+void stopTimer(Phase phase);
+
+class ScopedTimer {
+public:
+  explicit ScopedTimer(Phase phase_)
+      : phase(phase_), running(enabled() && (parent(phase) == phase ||
+                                             Timing::running(parent(phase)))) {
+    if (running) {
+      startTimer(phase);
+    }
+  }
+  ~ScopedTimer() {
+    if (running) {
+      stopTimer(phase);
+    }
+  }
+
+  ScopedTimer(const ScopedTimer &) = delete;
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+  Phase phase;
+  bool running;
+};
+
+// the most memory this process has used so far (in KB), 0 if this is not
+// known on this system
+long long peakMemoryKB();
+
+// heap allocations made by the object pools (see Pool.h) during one update.
+// Other heap allocations are not counted
+struct PoolUsage {
+  long long allocations;
+  long long bytes;
+};
+
+// start timing the run (call before the first update)
+void startRun();
+
+// call at the end of each update. Returns the pool heap allocations made since
+// the last call (or startRun), and if timing is enabled adds a row for this
+// update to timing.csv: the time spent in each phase, the same pool heap
+// allocations (poolHeapAllocations and poolHeapKB), and peak memory
+PoolUsage finishUpdate(int update);
+
+// show the time spent in each phase over the whole run
+void printSummary();
+
+} // namespace Timing
@@ -0,0 +1 @@
+const char *gitversion = "b1a00b53525959cf17b96bc486d86dee3439ca07";
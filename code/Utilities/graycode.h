@@ -59,7 +59,7 @@ namespace Graycode {
     static unsigned int ungraycode(const unsigned int& x) {
         unsigned short highPosition = priv::getHighestBitPosition(x);
         if (highPosition < 0) return 0;
-        unsigned int r;
+        unsigned int r = 0;
         r |= x & (1<<highPosition);
         for (int i=highPosition-1; i>=0; --i) {
             r |= ((r>>1) ^ x) & (1<<i);
@@ -70,7 +70,8 @@ namespace Graycode {
     template<class T>
     static unsigned int graycode(const T& x) {
         bool neg=(x<0);
-        unsigned int n = std::abs(x);
+        unsigned int n = neg ? static_cast<unsigned int>(-x)
+                             : static_cast<unsigned int>(x);
         if (neg)
             return priv::graycode_int(n)*-1;
         else
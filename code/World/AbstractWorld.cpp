@@ -10,6 +10,8 @@
 
 #include "AbstractWorld.h"
 
+#include <Utilities/Random.h>
+
 /*
 #include <math.h>
 
@@ -27,3 +29,53 @@ std::shared_ptr<ParameterLink<std::string>> AbstractWorld::worldTypePL =
         "WORLD-worldType", std::string("This_string_is_set_by_modules.h"),
         "This_string_is_set_by_modules.h");
 ////// WORLD-worldType is actually set by Modules.h //////
+
+std::shared_ptr<ParameterLink<int>> AbstractWorld::evaluationThreadsPL =
+    Parameters::register_parameter(
+        "WORLD-evaluationThreads", 1,
+        "number of threads used to evaluate organisms (only used by worlds "
+        "which support parallel evaluation), 1 = evaluate on main thread, "
+        "0 = one thread per hardware thread");
+
+void AbstractWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze,
+                                 int visualize, int debug) {
+  std::cout << "  ERROR! In AbstractWorld::evaluateSolo :: this world "
+               "does not provide evaluateSolo and so can not use "
+               "evaluateParallel.\n  Exiting."
+            << std::endl;
+  exit(1);
+}
+
+void AbstractWorld::evaluateParallel(
+    std::vector<std::shared_ptr<Organism>> &population, int analyze,
+    int visualize, int debug) {
+  // each organism is given its own random stream, identified by this call
+  // and its index in population, so it sees the same random numbers no
+  // matter which thread evaluates it (or how many threads there are)
+  auto evaluation = evaluationCount++;
+  auto evaluateOne = [&](size_t index) {
+    Random::Generator generator;
+    Random::seedGenerator(generator, Random::getStreamSeed(evaluation, index));
+    Random::UseGenerator useGenerator(generator);
+    evaluateSolo(population[index], analyze, visualize, debug);
+  };
+
+  int threadCount =
+      ThreadPool::resolveThreadCount(evaluationThreadsPL->get(PT));
+  if (threadCount == 1 || analyze || visualize || debug ||
+      population.size() < 2) {
+    // serial evaluation (output from organisms will be in order)
+    for (size_t index = 0; index < population.size(); index++) {
+      evaluateOne(index);
+    }
+    return;
+  }
+
+  if (evaluationPool == nullptr || evaluationPool->size() != threadCount) {
+    evaluationPool = std::make_shared<ThreadPool>(threadCount);
+  }
+
+  evaluationPool->parallelFor(
+      population.size(),
+      [&evaluateOne](size_t index, int) { evaluateOne(index); });
+}
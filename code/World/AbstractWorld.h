@@ -18,11 +18,13 @@
 #include <Utilities/Utilities.h>
 #include <Utilities/Data.h>
 #include <Utilities/Parameters.h>
+#include <Utilities/ThreadPool.h>
 
 class AbstractWorld {
 public:
   static std::shared_ptr<ParameterLink<bool>> debugPL;
   static std::shared_ptr<ParameterLink<std::string>> worldTypePL;
+  static std::shared_ptr<ParameterLink<int>> evaluationThreadsPL;
 
   const std::shared_ptr<ParametersTable> PT;
 
@@ -43,4 +45,27 @@ public:
 
   virtual void evaluate(std::map<std::string, std::shared_ptr<Group>> &groups,
 	  int analyze = 0, int visualize = 0, int debug = 0) = 0;
+
+  // evaluate a single organism. Worlds where organisms do not interact
+  // should provide this and call evaluateParallel from evaluate.
+  // evaluateSolo may be called on several organisms at the same time, so it
+  // may only change the organism it was given (i.e. write to org->dataMap)
+  // and must not change the world. Random:: calls and parameter lookups
+  // (PL->get(PT)) are safe, as are writes to different data maps (the only
+  // thing data maps share is the key registry, which is locked).
+  virtual void evaluateSolo(std::shared_ptr<Organism> org, int analyze,
+                            int visualize, int debug);
+
+  // call evaluateSolo on every organism in population using
+  // WORLD-evaluationThreads threads. If evaluationThreads is 1 (or analyze,
+  // visualize or debug are set) organisms are evaluated in order on this
+  // thread. Each organism is given its own random stream (see
+  // Random::getStreamSeed), so results do not depend on the number of
+  // threads.
+  void evaluateParallel(std::vector<std::shared_ptr<Organism>> &population,
+                        int analyze, int visualize, int debug);
+
+private:
+  std::shared_ptr<ThreadPool> evaluationPool; // created on first use
+  uint64_t evaluationCount = 0; // number of calls to evaluateParallel
 };
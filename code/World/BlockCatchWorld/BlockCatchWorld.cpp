@@ -433,6 +433,8 @@ void BlockCatchWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze, i
 		visualize = 1;
 	}
 
+	size_t orgRepeats = repeats; // local copy, evaluateSolo may be running on several threads
+
 	int correct = 0; // total number of correct catches/misses
 	int incorrect = 0; // total number of incorrect catches/misses
 	std::vector<int> correctPer(patternsCount, 0); // total number of correct catches/misses per pattern
@@ -465,11 +467,11 @@ void BlockCatchWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze, i
 		}
 		// determine number of tests for this pattern if patternStartPosiont is ALL_CLEAR
 		if (patternStartPositions == 1) {
-			repeats = (worldXMax - (patternSizes[patternIndex] + paddleWidth)) + 1;
+			orgRepeats = (worldXMax - (patternSizes[patternIndex] + paddleWidth)) + 1;
 		}
 
 
-		for (int repeat = 0; repeat < repeats; repeat++) {
+		for (int repeat = 0; repeat < orgRepeats; repeat++) {
 
 			//get worldX and start height for pattern;
 			int worldX = Random::getInt(worldXMin, worldXMax);
@@ -696,16 +698,16 @@ void BlockCatchWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze, i
 	//double rawR = ENT::MutualEntropy(worldStateSet, brainAfterStateSet);
 	//org->dataMap.append("rawR", rawR);
 	/*
-	double earlyRawR50 = ENT::MutualEntropy(TS::trimTimeSeries(worldStateSet, { 0,.5 }, patternsCount * repeats), TS::trimTimeSeries(brainAfterStateSet, { 0,.5 }, patternsCount * repeats));
+	double earlyRawR50 = ENT::MutualEntropy(TS::trimTimeSeries(worldStateSet, { 0,.5 }, patternsCount * orgRepeats), TS::trimTimeSeries(brainAfterStateSet, { 0,.5 }, patternsCount * orgRepeats));
 	org->dataMap.append("earlyRawR50", earlyRawR50);
 
-	double earlyRawR20 = ENT::MutualEntropy(TS::trimTimeSeries(worldStateSet, { 0,.2 }, patternsCount * repeats), TS::trimTimeSeries(brainAfterStateSet, { 0,.2 }, patternsCount * repeats));
+	double earlyRawR20 = ENT::MutualEntropy(TS::trimTimeSeries(worldStateSet, { 0,.2 }, patternsCount * orgRepeats), TS::trimTimeSeries(brainAfterStateSet, { 0,.2 }, patternsCount * orgRepeats));
 	org->dataMap.append("earlyRawR20", earlyRawR20);
 
-	double lateRawR50 = ENT::MutualEntropy(TS::trimTimeSeries(worldStateSet, { .5,1 }, patternsCount * repeats), TS::trimTimeSeries(brainAfterStateSet, { .5,1 }, patternsCount * repeats));
+	double lateRawR50 = ENT::MutualEntropy(TS::trimTimeSeries(worldStateSet, { .5,1 }, patternsCount * orgRepeats), TS::trimTimeSeries(brainAfterStateSet, { .5,1 }, patternsCount * orgRepeats));
 	org->dataMap.append("lateRawR50", lateRawR50);
 
-	double lateRawR20 = ENT::MutualEntropy(TS::trimTimeSeries(worldStateSet, { .8,1 }, patternsCount * repeats), TS::trimTimeSeries(brainAfterStateSet, { .8,1 }, patternsCount * repeats));
+	double lateRawR20 = ENT::MutualEntropy(TS::trimTimeSeries(worldStateSet, { .8,1 }, patternsCount * orgRepeats), TS::trimTimeSeries(brainAfterStateSet, { .8,1 }, patternsCount * orgRepeats));
 	org->dataMap.append("lateRawR20", lateRawR20);
 	*/
 
@@ -801,7 +803,7 @@ void BlockCatchWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze, i
 		for (double i = 0; i <= 1; i += .1) {
 			std::cout << i << " : ";
 			for (double j = i + .1; j <= 1; j += .1) {
-				std::cout << ENT::MutualEntropy(TS::trimTimeSeries(worldStateSet, { i,j }, patternsCount * repeats), TS::trimTimeSeries(brainAfterStateSet, { i,j }, patternsCount * repeats)) / ENT::Entropy(TS::trimTimeSeries(worldStateSet, { i,j }, patternsCount * repeats)) << " , ";
+				std::cout << ENT::MutualEntropy(TS::trimTimeSeries(worldStateSet, { i,j }, patternsCount * orgRepeats), TS::trimTimeSeries(brainAfterStateSet, { i,j }, patternsCount * orgRepeats)) / ENT::Entropy(TS::trimTimeSeries(worldStateSet, { i,j }, patternsCount * orgRepeats)) << " , ";
 			}
 			std::cout << std::endl;
 		}
@@ -849,44 +851,49 @@ void BlockCatchWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze, i
 void BlockCatchWorld::evaluate(std::map<std::string, std::shared_ptr<Group>>& groups, int analyse, int visualize, int debug) {
 	int popSize = groups[groupName]->population.size();
 
-	for (int i = 0; i < popSize; i++) {
-		evaluateSolo(groups[groupName]->population[i], analyse, visualize, AbstractWorld::debugPL->get(PT));
-
-		if (testMutants > 0) {
-			std::vector<double> mutantScores;
-			double mutantScoreSum = 0;
-			for (int j = 0; j < testMutants; j++) {
-				auto mutantOffspring = groups[groupNamePL->get(PT)]->population[i]->makeMutatedOffspringFrom(groups[groupNamePL->get(PT)]->population[i]);
-				evaluateSolo(mutantOffspring, 0, 0, 0);
-				auto s = mutantOffspring->dataMap.getAverage("score");
-				mutantScores.push_back(s);
-				mutantScoreSum += s;
-			}
-			//std::cout << "score: " << groups[groupNamePL->get(PT)]->population[i]->dataMap.getAverage("score") << "  mutantAveScore(" << testMutants << "): " << mutantScoreSum / testMutants << std::endl;
-			//std::ofstream mutantScoreFile;
-			//mutantScoreFile.open("mutantScoreFile.csv",
-		//		std::ios::out |
-	//			std::ios::app);
-			//mutantScoreFile << mutantScoreSum / testMutants << std::endl;
-			//mutantScoreFile.close();
+	if (testMutants == 0) { // organisms do not interact, so they may be evaluated in parallel
+		evaluateParallel(groups[groupName]->population, analyse, visualize, AbstractWorld::debugPL->get(PT));
+	}
+	else {
+		for (int i = 0; i < popSize; i++) {
+			evaluateSolo(groups[groupName]->population[i], analyse, visualize, AbstractWorld::debugPL->get(PT));
+
+			if (testMutants > 0) {
+				std::vector<double> mutantScores;
+				double mutantScoreSum = 0;
+				for (int j = 0; j < testMutants; j++) {
+					auto mutantOffspring = groups[groupNamePL->get(PT)]->population[i]->makeMutatedOffspringFrom(groups[groupNamePL->get(PT)]->population[i]);
+					evaluateSolo(mutantOffspring, 0, 0, 0);
+					auto s = mutantOffspring->dataMap.getAverage("score");
+					mutantScores.push_back(s);
+					mutantScoreSum += s;
+				}
+				//std::cout << "score: " << groups[groupNamePL->get(PT)]->population[i]->dataMap.getAverage("score") << "  mutantAveScore(" << testMutants << "): " << mutantScoreSum / testMutants << std::endl;
+				//std::ofstream mutantScoreFile;
+				//mutantScoreFile.open("mutantScoreFile.csv",
+			//		std::ios::out |
+		//			std::ios::app);
+				//mutantScoreFile << mutantScoreSum / testMutants << std::endl;
+				//mutantScoreFile.close();
 
 
-                        std::cout << "score: " << groups[groupNamePL->get(PT)]->population[i]->dataMap.getAverage("score") << "  mutantAveScore(" << testMutants << "): " << mutantScoreSum / testMutants << std::endl;
-                        //std::ofstream mutantScoreFile;
-                        //mutantScoreFile.open("mutantScoreFile.csv",
-                        //        std::ios::out |
-                        //        std::ios::app);
-                        //mutantScoreFile << groups[groupNamePL->get(PT)]->population[i]->dataMap.getAverage("score") << "," << mutantScoreSum / testMutants << std::endl;
-                        //mutantScoreFile.close();
-			FileManager::writeToFile("mutantScoreFile.txt", std::to_string(groups[groupNamePL->get(PT)]->population[i]->dataMap.getAverage("score")) + "," + std::to_string(mutantScoreSum / testMutants));
+	                        std::cout << "score: " << groups[groupNamePL->get(PT)]->population[i]->dataMap.getAverage("score") << "  mutantAveScore(" << testMutants << "): " << mutantScoreSum / testMutants << std::endl;
+	                        //std::ofstream mutantScoreFile;
+	                        //mutantScoreFile.open("mutantScoreFile.csv",
+	                        //        std::ios::out |
+	                        //        std::ios::app);
+	                        //mutantScoreFile << groups[groupNamePL->get(PT)]->population[i]->dataMap.getAverage("score") << "," << mutantScoreSum / testMutants << std::endl;
+	                        //mutantScoreFile.close();
+				FileManager::writeToFile("mutantScoreFile.txt", std::to_string(groups[groupNamePL->get(PT)]->population[i]->dataMap.getAverage("score")) + "," + std::to_string(mutantScoreSum / testMutants));
 
 
 
 
 
 
-		}
+			}
 
+		}
 	}
 
 	if (visualizeBest > 0 && Global::update % visualizeBest == 0 && Global::update > 0) {
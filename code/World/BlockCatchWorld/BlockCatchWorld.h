@@ -98,8 +98,8 @@ public:
 
     BlockCatchWorld (std::shared_ptr<ParametersTable> _PT = nullptr);
     ~BlockCatchWorld () = default;
-	void evaluateSolo(std::shared_ptr<Organism> org, int analyse, int visualize, int debug);
-	void evaluate(std::map<std::string, std::shared_ptr<Group>>& groups, int analyse, int visualize, int debug);
+	void evaluateSolo(std::shared_ptr<Organism> org, int analyse, int visualize, int debug) override;
+	void evaluate(std::map<std::string, std::shared_ptr<Group>>& groups, int analyse, int visualize, int debug) override;
 
 	void debugDisplay(int worldX, int time, std::vector<std::vector<int>> patternBuffer, int frameIndex, std::vector<int> sensorArray, std::vector<int> gapArray);
 	void visualizeDisplay(bool catchPattern, int worldX, int startYMax, int endTime, int time, int patternIndex, int catchPatternsCount,
@@ -155,10 +155,7 @@ void Logic16World::evaluate(std::map<std::string, std::shared_ptr<Group>> &group
 		} // else do nothing, we already checked for bad shuffle type in constructor
 	}
 
-	int popSize = groups[groupName]->population.size();
-	for (int i = 0; i < popSize; i++) {
-		evaluateSolo(groups[groupName]->population[i], analyze, visualize, debug);
-	}
+	evaluateParallel(groups[groupName]->population, analyze, visualize, debug);
 }
 
 
@@ -169,28 +166,44 @@ void Logic16World::evaluateSolo(std::shared_ptr<Organism> org, int analyze, int
 	std::vector<double> logicScores;
 	logicScores.resize(16);
 
-	for (int repeats = evaluationsPerGeneration; repeats > 0; --repeats) {
-		brain->resetBrain();
+	// if the brain is reset between inputs, the four inputs are separate runs
+	// of the brain and can be run together
+	std::vector<std::vector<double>> batchInputs, batchOutputs;
+	if (resetBrainBetweenInputs) {
+		batchInputs.assign(4, std::vector<double>(brain->nrInputValues, 0.0));
 		for (int InputIndex = 0; InputIndex < 4; InputIndex++) {
+			batchInputs[InputIndex][0] = questions[InputIndex][0];
+			batchInputs[InputIndex][1] = questions[InputIndex][1];
+		}
+	}
 
-			if (resetBrainBetweenInputs) {
-				brain->resetBrain();
-			}
+	for (int repeats = evaluationsPerGeneration; repeats > 0; --repeats) {
+		if (resetBrainBetweenInputs) {
+			brain->updateBatch(batchInputs, batchOutputs, brainUpdates);
+		}
+		else {
+			brain->resetBrain();
+		}
+		for (int InputIndex = 0; InputIndex < 4; InputIndex++) {
 
 			bool in0 = questions[InputIndex][0];
 			bool in1 = questions[InputIndex][1];
 
-			brain->setInput(0, in0);
-			brain->setInput(1, in1);
+			if (!resetBrainBetweenInputs) {
+				brain->setInput(0, in0);
+				brain->setInput(1, in1);
 
-			for (int i = 0; i < brainUpdates; i++) { // call update on brain one or more times
-				brain->update();
+				for (int i = 0; i < brainUpdates; i++) { // call update on brain one or more times
+					brain->update();
+				}
 			}
 
 			int outputCount = 0;
 			for (auto logic : testLogic) {
+				double output = resetBrainBetweenInputs ? batchOutputs[InputIndex][outputCount] : brain->readOutput(outputCount);
+				outputCount++;
 				// for each logic being tested, see if the brain generated the correct output for the current input
-				logicScores[logic] += (double)(logic_tables[logic][in0][in1] == Bit(brain->readOutput(outputCount++)));
+				logicScores[logic] += (double)(logic_tables[logic][in0][in1] == Bit(output));
 			}
 		}
 	}
@@ -79,7 +79,7 @@ public:
 	virtual ~Logic16World() = default;
 
 	virtual void evaluate(std::map<std::string, std::shared_ptr<Group>> &groups, int analyze, int visualize, int debug);
-	void evaluateSolo(std::shared_ptr<Organism> org, int analyze, int visualize, int debug);
+	void evaluateSolo(std::shared_ptr<Organism> org, int analyze, int visualize, int debug) override;
 
 	virtual std::unordered_map<std::string, std::unordered_set<std::string>>
 		requiredGroups() override;
@@ -172,33 +172,38 @@ void NBackWorld::evaluate(std::map<std::string, std::shared_ptr<Group>> &groups,
 	}
 
 	int popSize = groups[groupNamePL->get(PT)]->population.size();
-	for (int i = 0; i < popSize; i++) {
-		// eval this agent
-		evaluateSolo(groups[groupNamePL->get(PT)]->population[i], analyze, visualize, debug);
-		// now lets test some god damn dirty mutants!
-
-		if (testMutants > 0) {
-			std::vector<double> mutantScores;
-			double mutantScoreSum = 0;
-			for (int j = 0; j < testMutants; j++) {
-				auto mutantOffspring = groups[groupNamePL->get(PT)]->population[i]->makeMutatedOffspringFrom(groups[groupNamePL->get(PT)]->population[i]);
-				evaluateSolo(mutantOffspring, 0, 0, 0);
-				auto s = mutantOffspring->dataMap.getAverage("score");
-				mutantScores.push_back(s);
-				mutantScoreSum += s;
-			}
-			std::cout << "score: " << groups[groupNamePL->get(PT)]->population[i]->dataMap.getAverage("score") << "  mutantAveScore(" << testMutants << "): " << mutantScoreSum / testMutants << std::endl;
-			//std::ofstream mutantScoreFile;
-			//mutantScoreFile.open("mutantScoreFile.csv",
-			//	std::ios::out |
-			//	std::ios::app);
-			//mutantScoreFile << groups[groupNamePL->get(PT)]->population[i]->dataMap.getAverage("score") << "," << mutantScoreSum / testMutants << std::endl;
-			//mutantScoreFile.close();
-			FileManager::writeToFile("mutantScoreFile.txt", std::to_string(groups[groupNamePL->get(PT)]->population[i]->dataMap.getAverage("score")) + "," + std::to_string(mutantScoreSum / testMutants));
+	if (testMutants == 0) { // organisms do not interact, so they may be evaluated in parallel
+		evaluateParallel(groups[groupNamePL->get(PT)]->population, analyze, visualize, debug);
+	}
+	else {
+		for (int i = 0; i < popSize; i++) {
+			// eval this agent
+			evaluateSolo(groups[groupNamePL->get(PT)]->population[i], analyze, visualize, debug);
+			// now lets test some god damn dirty mutants!
+
+			if (testMutants > 0) {
+				std::vector<double> mutantScores;
+				double mutantScoreSum = 0;
+				for (int j = 0; j < testMutants; j++) {
+					auto mutantOffspring = groups[groupNamePL->get(PT)]->population[i]->makeMutatedOffspringFrom(groups[groupNamePL->get(PT)]->population[i]);
+					evaluateSolo(mutantOffspring, 0, 0, 0);
+					auto s = mutantOffspring->dataMap.getAverage("score");
+					mutantScores.push_back(s);
+					mutantScoreSum += s;
+				}
+				std::cout << "score: " << groups[groupNamePL->get(PT)]->population[i]->dataMap.getAverage("score") << "  mutantAveScore(" << testMutants << "): " << mutantScoreSum / testMutants << std::endl;
+				//std::ofstream mutantScoreFile;
+				//mutantScoreFile.open("mutantScoreFile.csv",
+				//	std::ios::out |
+				//	std::ios::app);
+				//mutantScoreFile << groups[groupNamePL->get(PT)]->population[i]->dataMap.getAverage("score") << "," << mutantScoreSum / testMutants << std::endl;
+				//mutantScoreFile.close();
+				FileManager::writeToFile("mutantScoreFile.txt", std::to_string(groups[groupNamePL->get(PT)]->population[i]->dataMap.getAverage("score")) + "," + std::to_string(mutantScoreSum / testMutants));
 
 
-		}
+			}
 
+		}
 	}
 	
 	
@@ -75,9 +75,9 @@ public:
     virtual ~NBackWorld() = default;
 
     void evaluateSolo(std::shared_ptr<Organism> org, int analyze,
-        int visualize, int debug);
+        int visualize, int debug) override;
     void evaluate(std::map<std::string, std::shared_ptr<Group>>& groups,
-        int analyze, int visualize, int debug);
+        int analyze, int visualize, int debug) override;
 
     virtual std::unordered_map<std::string, std::unordered_set<std::string>>
         requiredGroups() override;
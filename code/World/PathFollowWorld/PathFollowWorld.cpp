@@ -341,17 +341,13 @@ PathFollowWorld::PathFollowWorld(shared_ptr<ParametersTable> PT_) : AbstractWorl
 // the evaluate function gets called every generation. evaluate should set values on organisms datamaps
 // that will be used by other parts of MABE for things like reproduction and archiving
 // here we pick turn symbols once and these are used for all agents (to make sure we are doing a fair evaluation)
-// then agents are tested (one-at-a-time) on each map and given a normalized score.
+// then agents are tested (see evaluateSolo) on each map and given a normalized score.
 auto PathFollowWorld::evaluate(map<string, shared_ptr<Group>>& groups, int analyze, int visualize, int debug) -> void {
     
     if (analyze && saveVisual) {
         visualize = true;
     }
 
-    int sign2; // remapping for 2s in the map (left)
-    int sign3; // remapping for 3s in the map (right)
-
-    
     // if randomizeTurnSigns, create a pair of random signals for each map
     if (randomTurnSymbols == 1) {
         for (int t = 0; t < evaluationsPerGeneration * maps.size(); t++) {
@@ -367,17 +363,21 @@ auto PathFollowWorld::evaluate(map<string, shared_ptr<Group>>& groups, int analy
         }
     }
     
-    int popSize = groups["root::"]->population.size();
-    
-    // in this world, organisms do not interact, so we can just iterate over the population
-    // on each iteration, each agent will run though every map evaluationsPerGeneration times
+    // in this world, organisms do not interact, so they may be evaluated in parallel
+    // on each evaluation, each agent will run though every map evaluationsPerGeneration times
     // each runthough of a map will use different randomValues
-    for (int orgID = 0; orgID < popSize; orgID++) {
+    evaluateParallel(groups["root::"]->population, analyze, visualize, debug);
+}
+
+// evaluate a single organism on every map (evaluationsPerGeneration times)
+auto PathFollowWorld::evaluateSolo(shared_ptr<Organism> org, int analyze, int visualize, int debug) -> void {
+
+        int sign2; // remapping for 2s in the map (left)
+        int sign3; // remapping for 3s in the map (right)
 
         TS::intTimeSeries worldStates;
 
-        // create a shortcut to access the organism and organisms brain
-        auto org = groups["root::"]->population[orgID];
+        // create a shortcut to access the organisms brain
         auto brain = org->brains["root::"];
 
         if (analyze) {
@@ -847,7 +847,6 @@ auto PathFollowWorld::evaluate(map<string, shared_ptr<Group>>& groups, int analy
             } 
             std::cout << "  ... analyze done" << std::endl;
         } // end analyze
-    } // end of population loop
 }
 
 // the requiredGroups function lets MABE know how to set up populations of organisms that this world needs
@@ -317,6 +317,7 @@ public:
     void loadMaps(std::vector<string>& mapNames, std::vector<Vector2d<int>>& maps, std::vector<std::pair<int, int>>& mapSizes, std::vector<int>& initalDirections, std::vector<std::pair<int, int>>& startLocations);
     
 	virtual auto evaluate(map<string, shared_ptr<Group>>& /*groups*/, int /*analyze*/, int /*visualize*/, int /*debug*/) -> void override;
+	virtual auto evaluateSolo(shared_ptr<Organism> /*org*/, int /*analyze*/, int /*visualize*/, int /*debug*/) -> void override;
 
 	virtual auto requiredGroups() -> unordered_map<string,unordered_set<string>> override;
 };
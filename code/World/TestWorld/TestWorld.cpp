@@ -39,6 +39,13 @@ std::shared_ptr<ParameterLink<std::string>> TestWorld::brainNamePL =
 TestWorld::TestWorld(std::shared_ptr<ParametersTable> PT_)
     : AbstractWorld(PT_) {
 
+  // parameters are looked up here (not in evaluateSolo) so that organisms
+  // can be evaluated on several threads
+  mode = modePL->get(PT);
+  evaluationsPerGeneration = evaluationsPerGenerationPL->get(PT);
+  groupName = groupNamePL->get(PT);
+  brainName = brainNamePL->get(PT);
+
   // columns to be added to ave file
   popFileColumns.clear();
   popFileColumns.push_back("score");
@@ -49,14 +56,14 @@ TestWorld::TestWorld(std::shared_ptr<ParametersTable> PT_)
 
 void TestWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze,
                              int visualize, int debug) {
-  auto brain = org->brains[brainNamePL->get(PT)];
-  for (int r = 0; r < evaluationsPerGenerationPL->get(PT); r++) {
+  auto brain = org->brains[brainName];
+  for (int r = 0; r < evaluationsPerGeneration; r++) {
     brain->resetBrain();
     brain->setInput(0, 1); // give the brain a constant 1 (for wire brain)
     brain->update();
     double score = 0.0;
     for (int i = 0; i < brain->nrOutputValues; i++) {
-      if (modePL->get(PT) == 0)
+      if (mode == 0)
         score += Bit(brain->readOutput(i));
       else
         score += brain->readOutput(i);
@@ -72,11 +79,7 @@ void TestWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze,
 
 void TestWorld::evaluate(std::map<std::string, std::shared_ptr<Group>> &groups,
                       int analyze, int visualize, int debug) {
-  int popSize = groups[groupNamePL->get(PT)]->population.size();
-  for (int i = 0; i < popSize; i++) {
-    evaluateSolo(groups[groupNamePL->get(PT)]->population[i], analyze,
-                 visualize, debug);
-  }
+  evaluateParallel(groups[groupName]->population, analyze, visualize, debug);
 }
 
 std::unordered_map<std::string, std::unordered_set<std::string>>
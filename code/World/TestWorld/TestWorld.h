@@ -23,22 +23,21 @@ public:
   static std::shared_ptr<ParameterLink<int>> numberOfOutputsPL;
   static std::shared_ptr<ParameterLink<int>> evaluationsPerGenerationPL;
 
-  // int mode;
-  // int numberOfOutputs;
-  // int evaluationsPerGeneration;
+  int mode;
+  int evaluationsPerGeneration;
 
   static std::shared_ptr<ParameterLink<std::string>> groupNamePL;
   static std::shared_ptr<ParameterLink<std::string>> brainNamePL;
-  // string groupName;
-  // string brainName;
+  std::string groupName;
+  std::string brainName;
 
   TestWorld(std::shared_ptr<ParametersTable> PT_ = nullptr);
   virtual ~TestWorld() = default;
 
   void evaluateSolo(std::shared_ptr<Organism> org, int analyze,
-                            int visualize, int debug);
+                            int visualize, int debug) override;
   void evaluate(std::map<std::string, std::shared_ptr<Group>> &groups,
-                int analyze, int visualize, int debug);
+                int analyze, int visualize, int debug) override;
 
   virtual std::unordered_map<std::string, std::unordered_set<std::string>>
     requiredGroups() override;
@@ -19,6 +19,7 @@
 #include <Utilities/MTree.h>
 #include <Utilities/Parameters.h>
 #include <Utilities/Random.h>
+#include <Utilities/Timing.h>
 #include <Utilities/Utilities.h>
 #include <Utilities/gitversion.h>
 #include <Utilities/Filesystem.h>
@@ -124,6 +125,11 @@ int main(int argc, const char *argv[]) {
     exit(1);
   }
   FileManager::outputPrefix = output_prefix;
+  if (Global::asyncOutputPL->get()) {
+    FileManager::startAsyncOutput(
+        static_cast<size_t>(std::max(Global::outputQueueSizePL->get(), 1)) *
+        1024 * 1024);
+  }
 
   // set up random number generator
   if (Global::randomSeedPL->get() == -1) {
@@ -136,10 +142,10 @@ int main(int argc, const char *argv[]) {
 #else
     int temp = rd();
 #endif
-    Random::getCommonGenerator().seed(temp);
+    Random::seed(temp);
     std::cout << "Generating Random Seed\n  " << temp << "\n";
   } else {
-    Random::getCommonGenerator().seed(Global::randomSeedPL->get());
+    Random::seed(Global::randomSeedPL->get());
     std::cout << "Using Random Seed: " << Global::randomSeedPL->get() << "\n";
   }
 
@@ -164,32 +170,57 @@ int main(int argc, const char *argv[]) {
 
     // in run mode we evolve organsims
     auto done = false;
+    Timing::enabled() = Global::recordTimingPL->get();
+    Timing::startRun();
     while ((!done) && (!userExitFlag)) { //! groups[defaultGroup]->archivist->finished) {
-      world->evaluate(groups, false, false,
-                      AbstractWorld::debugPL->get()); // evaluate each organism
-                                                      // in the population using
-                                                      // a World
+      {
+        Timing::ScopedTimer timer(Timing::EVALUATE);
+        world->evaluate(groups, false, false,
+                        AbstractWorld::debugPL->get()); // evaluate each organism
+                                                        // in the population
+                                                        // using a World
+      }
       std::cout << "update: " << Global::update << "   " << std::flush;
       done = true; // until we find out otherwise, assume we are done.
       for (auto const &group : groups) {
         if (!group.second->archivist->finished_) {
-          group.second->optimize(); // create the next updates population
-          group.second->archive(); // save data, update memory and delete unneeded data;
+          {
+            Timing::ScopedTimer timer(Timing::OPTIMIZE);
+            group.second->optimize(); // create the next updates population
+          }
+          {
+            Timing::ScopedTimer timer(Timing::ARCHIVE);
+            group.second->archive(); // save data, update memory and delete unneeded data;
+          }
           if (!group.second->archivist->finished_) {
             done = false; // if any groups archivist says we are not done, then
                           // we are not done
           }
+          Timing::ScopedTimer timer(Timing::CLEANUP);
           group.second->optimizer->cleanup(group.second->population);
         }
+      }
+      FileManager::flush(); // let the files on disk catch up with this update
+      auto poolUsage = Timing::finishUpdate(Global::update);
+      if (Global::reportAllocationsPL->get()) {
+        std::cout << "   pool heap allocations: " << poolUsage.allocations
+                  << " (" << poolUsage.bytes / 1024 << " KB)";
       }
 	  std::cout << std::endl;
       Global::update++; // advance time to create new population(s)
     }
 
-    // the run is finished... flush any data that has not been output yet
+    // the run is finished (or ctrl-c was pressed)... flush any data that has
+    // not been output yet
     for (auto const &group : groups) {
       group.second->archive(1);
     }
+    if (userExitFlag) {
+      std::cout << "Writing remaining output before quitting..." << std::endl;
+    }
+    if (Timing::enabled()) {
+      Timing::printSummary();
+    }
   } else if (Global::modePL->get() == "visualize") {
     ////////////////////////////////////////////////////////////////////////////////////
     // visualize mode
@@ -213,6 +244,7 @@ int main(int argc, const char *argv[]) {
               << std::endl;
     exit(1);
   }
+  FileManager::closeAll(); // wait for all output to be written
   return 0;
 }
 